@@ -0,0 +1,94 @@
+// Measures how multi-file parsing scales with the number of workers.
+//
+// Writes a corpus of files with skewed sizes to a temporary directory, then
+// parses it with pools of one worker up to the hardware thread count and
+// reports files per second and the speedup over one worker.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "syntax/driver/front_end.h"
+#include "syntax/driver/time_report.h"
+#include "syntax/util/thread_pool.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kFiles = 256;
+constexpr size_t kRounds = 5;
+
+// A chain of `terms` operands, cycling through the operators.
+std::string MakeChain(const size_t terms) {
+  static constexpr char kOperators[] = {'+', '*', '-', '/', '%'};
+
+  std::string chain;
+  for (size_t i = 0; i < terms; ++i) {
+    if (i > 0) {
+      chain += ' ';
+      chain += kOperators[i % sizeof(kOperators)];
+      chain += ' ';
+    }
+    chain += static_cast<char>('1' + i % 9);
+  }
+  return chain;
+}
+
+// Most files are small and a few are large, as in a real source tree.
+std::vector<std::filesystem::path> WriteCorpus(
+    const std::filesystem::path& directory) {
+  std::filesystem::create_directories(directory);
+
+  std::vector<std::filesystem::path> paths;
+  for (size_t i = 0; i < kFiles; ++i) {
+    const size_t terms = i % 32 == 0 ? 200000 : 1000 + (i * 7919) % 20000;
+    paths.push_back(directory / ("file_" + std::to_string(i) + ".orn"));
+    std::ofstream(paths.back(), std::ios::binary) << MakeChain(terms);
+  }
+  return paths;
+}
+
+// Parses the corpus `kRounds` times, returning files per second.
+double Rate(const std::vector<std::filesystem::path>& paths,
+            const size_t threads) {
+  orion::syntax::ThreadPool pool(threads);
+  orion::syntax::FrontEnd(paths, pool).RunThrough(orion::syntax::Phase::kBuild);
+
+  const Clock::time_point start = Clock::now();
+  for (size_t i = 0; i < kRounds; ++i) {
+    orion::syntax::FrontEnd(paths, pool)
+        .RunThrough(orion::syntax::Phase::kBuild);
+  }
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+  return static_cast<double>(paths.size() * kRounds) / elapsed.count();
+}
+}  // namespace
+
+int main() {
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "orion_driver_bench";
+  const std::vector<std::filesystem::path> paths = WriteCorpus(directory);
+
+  std::printf("%8s %12s %8s\n", "threads", "files/s", "speedup");
+  // Powers of two, then the hardware thread count if it is not one.
+  const size_t max_threads =
+      orion::syntax::ThreadPool::DefaultThreadCount();
+  std::vector<size_t> counts;
+  for (size_t threads = 1; threads < max_threads; threads *= 2) {
+    counts.push_back(threads);
+  }
+  counts.push_back(max_threads);
+
+  const double baseline = Rate(paths, 1);
+  for (const size_t threads : counts) {
+    const double rate = threads == 1 ? baseline : Rate(paths, threads);
+    std::printf("%8zu %12.0f %7.2fx\n", threads, rate, rate / baseline);
+  }
+
+  std::filesystem::remove_all(directory);
+  return 0;
+}
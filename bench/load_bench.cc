@@ -0,0 +1,70 @@
+// Measures how much of the front end's time goes to loading a source file.
+//
+// Writes one large file, mostly ASCII with a multi-byte identifier on every
+// line, then times opening it (mapping, validating and finding CRLFs),
+// decoding it and lexing it, and reports each in megabytes per second.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "syntax/io/source_file.h"
+#include "syntax/lexer/lexer.h"
+#include "syntax/lexer/token.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kLines = 1 << 20;
+constexpr size_t kRounds = 5;
+
+std::filesystem::path WriteSource(const std::filesystem::path& path) {
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  for (size_t i = 0; i < kLines; ++i) {
+    stream << "(alpha + " << i << ") * caf\xC3\xA9 - 42 / beta\r\n";
+  }
+  return path;
+}
+
+// Runs `body` `kRounds` times, returning megabytes per second.
+template <typename Body>
+double Throughput(const size_t bytes, Body body) {
+  body();
+  const Clock::time_point start = Clock::now();
+  for (size_t i = 0; i < kRounds; ++i) {
+    body();
+  }
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+  return static_cast<double>(bytes * kRounds) / elapsed.count() / 1e6;
+}
+}  // namespace
+
+int main() {
+  const std::filesystem::path path = WriteSource(
+      std::filesystem::temp_directory_path() / "orion_load_bench.orn");
+  const orion::syntax::SourceFile file = orion::syntax::SourceFile::Open(path);
+  const std::u32string text = file.Decode();
+  const size_t bytes = file.Bytes().size();
+
+  const double open = Throughput(bytes, [&path] {
+    static_cast<void>(orion::syntax::SourceFile::Open(path));
+  });
+  const double decode =
+      Throughput(bytes, [&file] { static_cast<void>(file.Decode()); });
+  const double lex = Throughput(bytes, [&text] {
+    orion::syntax::Lexer lexer(text);
+    static_cast<void>(lexer.Tokenize());
+  });
+
+  std::printf("%zu MB, %zu CRLFs\n", bytes / 1000000,
+              file.CrlfOffsets().size());
+  std::printf("%8s %10s\n", "phase", "MB/s");
+  std::printf("%8s %10.0f\n", "open", open);
+  std::printf("%8s %10.0f\n", "decode", decode);
+  std::printf("%8s %10.0f\n", "lex", lex);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,256 @@
+// Measures expression parsing throughput on long arithmetic chains and on
+// deeply nested groups.
+//
+// Each case lexes, parses and builds the tree of one chain repeatedly for a
+// fixed time, reusing one builder, and reports expressions per second. Lexing
+// is timed separately so the parser's share can be read off.
+//
+// The last section reports what the tree costs to keep and to read: the size
+// of the types holding text positions, the bytes per unique green node, and
+// how many elements per second the green and red preorder walks visit.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "syntax/lexer/lexer.h"
+#include "syntax/lexer/token.h"
+#include "syntax/parser/build_green.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/parser.h"
+#include "syntax/parser/reparse.h"
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_preorder.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_node_data.h"
+#include "syntax/parser/rgtree/syntax/syntax_preorder.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr std::chrono::milliseconds kCaseDuration(500);
+
+// `1 + 2 * 3 - 4 / 5 % 6 + ...`, cycling through every operator. With a
+// nonzero `gap`, every `gap`-th operand is left out.
+std::u32string MakeChain(const size_t terms, const size_t gap = 0) {
+  static constexpr char32_t kOperators[] = {U'+', U'*', U'-', U'/', U'%'};
+
+  std::u32string chain;
+  for (size_t i = 0; i < terms; ++i) {
+    if (i > 0) {
+      chain += U' ';
+      chain += kOperators[i % std::size(kOperators)];
+      chain += U' ';
+    }
+    if (gap == 0 || i % gap != gap - 1) {
+      chain += static_cast<char32_t>(U'1' + i % 9);
+    }
+  }
+  return chain;
+}
+
+// `(1 + 2 * 3) + (1 + 2 * 3) + ...`, for edits inside one group.
+std::u32string MakeGroups(const size_t groups) {
+  std::u32string source;
+  for (size_t i = 0; i < groups; ++i) {
+    source += i > 0 ? U" + (1 + 2 * 3)" : U"(1 + 2 * 3)";
+  }
+  return source;
+}
+
+// `(1 + (1 + (... x)))`, nested `depth` groups deep.
+std::u32string MakeNested(const size_t depth) {
+  std::u32string source;
+  for (size_t i = 0; i < depth; ++i) {
+    source += U"(1 + ";
+  }
+  source += U"x";
+  source.append(depth, U')');
+  return source;
+}
+
+// Runs `step` until the case duration passes, returning calls per second.
+template <typename Step>
+double Rate(const Step& step) {
+  size_t iterations = 0;
+  const Clock::time_point start = Clock::now();
+  Clock::duration elapsed{};
+  do {
+    step();
+    ++iterations;
+    elapsed = Clock::now() - start;
+  } while (elapsed < kCaseDuration);
+
+  return static_cast<double>(iterations) /
+         std::chrono::duration<double>(elapsed).count();
+}
+
+// Written by the walk cases so their work is not optimized away.
+volatile size_t sink = 0;
+
+// The heap bytes of every distinct node below `root`, per node. Shared
+// subtrees are counted once, as they are stored once.
+double BytesPerNode(const orion::syntax::GreenNode& root) {
+  std::unordered_set<const orion::syntax::GreenNodeData*> seen;
+  size_t bytes = 0;
+  for (const auto& event : root.Preorder()) {
+    const orion::syntax::GreenNode& node = *event.value.element->AsNode();
+    if (event.IsEnter() && seen.insert(&node.Data()).second) {
+      bytes += sizeof(orion::syntax::GreenNodeData) +
+               node.Children().size() * (sizeof(orion::syntax::GreenElement) +
+                                         sizeof(orion::syntax::TextSize));
+    }
+  }
+  return static_cast<double>(bytes) / static_cast<double>(seen.size());
+}
+}  // namespace
+
+int main() {
+  std::printf("%10s %14s %14s %14s\n", "terms", "lex/s", "parse/s",
+              "expressions/s");
+
+  orion::syntax::GreenBuilder builder;
+  for (const size_t terms : {16, 256, 4096, 65536}) {
+    const std::u32string chain = MakeChain(terms);
+    const std::vector<orion::syntax::Token> tokens =
+        orion::syntax::Lexer(chain).Tokenize();
+
+    const double lexes = Rate([&chain] {
+      (void)orion::syntax::Lexer(chain).Tokenize();
+    });
+    const double parses = Rate([&tokens, &builder] {
+      const std::vector<orion::syntax::Event> events =
+          orion::syntax::Parser(tokens).Parse();
+      (void)orion::syntax::BuildGreen(events, tokens, builder);
+    });
+    const double expressions = Rate([&chain, &builder] {
+      (void)orion::syntax::ParseExpression(chain, builder);
+    });
+
+    std::printf("%10zu %14.0f %14.0f %14.0f\n", terms, lexes, parses,
+                expressions);
+  }
+
+  // Edits inside the middle group: relexing its `2`, and reparsing it after
+  // changing its `+`. Full parses of the same source are the baseline.
+  std::printf("\n%10s %14s %14s %14s\n", "groups", "full/s", "relex/s",
+              "reparse/s");
+  for (const size_t groups : {16, 256, 4096}) {
+    const std::u32string source = MakeGroups(groups);
+    const auto root = orion::syntax::SyntaxNode::CreateRoot(
+        orion::syntax::ParseExpression(source, builder).root);
+    const size_t group = groups / 2 * 14;
+
+    const double full = Rate([&source, &builder] {
+      (void)orion::syntax::ParseExpression(source, builder);
+    });
+    const double relexes = Rate([&root, &builder, group] {
+      std::vector<orion::syntax::Diagnostic> diagnostics;
+      (void)orion::syntax::Reparse(root,
+                                   orion::syntax::TextRange::At(
+                                       orion::syntax::TextSize::Of(group + 5),
+                                       orion::syntax::TextSize(1)),
+                                   U"5", builder, diagnostics);
+    });
+    const double reparses = Rate([&root, &builder, group] {
+      std::vector<orion::syntax::Diagnostic> diagnostics;
+      (void)orion::syntax::Reparse(root,
+                                   orion::syntax::TextRange::At(
+                                       orion::syntax::TextSize::Of(group + 3),
+                                       orion::syntax::TextSize(1)),
+                                   U"-", builder, diagnostics);
+    });
+
+    std::printf("%10zu %14.0f %14.0f %14.0f\n", groups, full, relexes,
+                reparses);
+  }
+
+  // The same chains with every eighth operand missing, which recovery
+  // should parse about as fast as the valid ones.
+  std::printf("\n%10s %14s %14s\n", "terms", "valid/s", "broken/s");
+  for (const size_t terms : {256, 4096, 65536}) {
+    const std::u32string valid = MakeChain(terms);
+    const std::u32string broken = MakeChain(terms, 8);
+
+    const double valids = Rate([&valid, &builder] {
+      (void)orion::syntax::ParseExpression(valid, builder);
+    });
+    const double brokens = Rate([&broken, &builder] {
+      (void)orion::syntax::ParseExpression(broken, builder);
+    });
+
+    std::printf("%10zu %14.0f %14.0f\n", terms, valids, brokens);
+  }
+
+  // Deeply nested groups, parsed in full and with a depth limit of 64 that
+  // skips everything below it as one error node.
+  std::printf("\n%10s %14s %14s\n", "depth", "nested/s", "limited/s");
+  for (const size_t depth : {10, 1000, 100'000}) {
+    const std::u32string source = MakeNested(depth);
+
+    const double nested = Rate([&source, &builder, depth] {
+      (void)orion::syntax::ParseExpression(source, builder, 2 * depth + 1);
+    });
+    const double limited = Rate([&source, &builder] {
+      (void)orion::syntax::ParseExpression(source, builder, 64);
+    });
+
+    std::printf("%10zu %14.0f %14.0f\n", depth, nested, limited);
+  }
+
+  // Tree size and walk throughput, in elements (nodes and tokens) visited
+  // per second.
+  std::printf("\n%-16s %6s\n", "type", "bytes");
+  std::printf("%-16s %6zu\n", "TextRange", sizeof(orion::syntax::TextRange));
+  std::printf("%-16s %6zu\n", "Token", sizeof(orion::syntax::Token));
+  std::printf("%-16s %6zu\n", "GreenNodeData",
+              sizeof(orion::syntax::GreenNodeData));
+  std::printf("%-16s %6zu\n", "GreenTokenData",
+              sizeof(orion::syntax::GreenTokenData));
+  std::printf("%-16s %6zu\n", "SyntaxNodeData",
+              sizeof(orion::syntax::SyntaxNodeData));
+
+  std::printf("\n%10s %10s %12s %14s %14s\n", "terms", "elements",
+              "bytes/node", "green walk/s", "red walk/s");
+  for (const size_t terms : {256, 4096, 65536}) {
+    const orion::syntax::GreenNode green =
+        orion::syntax::ParseExpression(MakeChain(terms), builder).root;
+    const orion::syntax::SyntaxNode red =
+        orion::syntax::SyntaxNode::CreateRoot(green);
+
+    size_t elements = 0;
+    for (const auto& event : green.PreorderWithTokens()) {
+      elements += event.IsEnter() ? 1 : 0;
+    }
+
+    const double green_walks = Rate([&green] {
+      size_t width = 0;
+      for (const auto& event : green.PreorderWithTokens()) {
+        width += static_cast<size_t>(event.value.offset);
+      }
+      sink = width;
+    });
+    const double red_walks = Rate([&red] {
+      size_t width = 0;
+      for (const auto& event : red.PreorderWithTokens()) {
+        width += static_cast<size_t>(event.value.Range().Start());
+      }
+      sink = width;
+    });
+
+    const auto count = static_cast<double>(elements);
+    std::printf("%10zu %10zu %12.1f %14.0f %14.0f\n", terms, elements,
+                BytesPerNode(green), green_walks * count, red_walks * count);
+  }
+  return 0;
+}
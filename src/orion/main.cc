@@ -1,6 +1,516 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
 
-int main() {
-  std::cout << "Hello World" << std::endl;
+#include "syntax/driver/compile_server.h"
+#include "syntax/driver/front_end.h"
+#include "syntax/driver/parse_cache.h"
+#include "syntax/driver/time_report.h"
+#include "syntax/io/unix_socket.h"
+#include "syntax/lexer/token.h"
+#include "syntax/lexer/token_kind.h"
+#include "syntax/parser/rgtree/green/green_cache.h"
+#include "syntax/parser/rgtree/syntax/syntax_element.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_preorder.h"
+#include "syntax/parser/rgtree/walk_event.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/text/text_range.h"
+#include "syntax/util/thread_pool.h"
+
+namespace {
+using orion::syntax::Phase;
+using orion::syntax::SourceUnit;
+
+constexpr std::string_view kUsage =
+    "usage: orion COMMAND [OPTION]... PATH...\n"
+    "       orion serve --socket=SOCKET [--memory-budget=MIB] [-j N]\n"
+    "                   [--adaptive-node-cache]\n"
+    "       orion stop --socket=SOCKET\n"
+    "\n"
+    "Commands:\n"
+    "  lex                 print the tokens of each file\n"
+    "  parse               report the syntax errors in each file\n"
+    "  dump-tree           print the syntax tree of each file\n"
+    "  serve               answer parse requests on SOCKET, keeping\n"
+    "                      unchanged files in memory\n"
+    "  stop                stop the server on SOCKET\n"
+    "\n"
+    "A directory stands for every .orn file below it.\n"
+    "\n"
+    "Options:\n"
+    "  --time-report[=text|json]\n"
+    "                      print per-phase timings to stderr\n"
+    "  --time-report-file=FILE\n"
+    "                      write the timings to FILE instead\n"
+    "  -j N, --jobs=N      run on N threads\n"
+    "  --adaptive-node-cache\n"
+    "                      tune per node kind which nodes are deduplicated,\n"
+    "                      instead of a fixed size limit\n"
+    "  --socket=SOCKET     parse through the server on SOCKET; with\n"
+    "                      --time-report, print its summary instead\n"
+    "  --memory-budget=MIB keep at most MIB mebibytes of results in the\n"
+    "                      server (default 512)\n"
+    "  --cache-dir=DIR     reuse the results for unchanged sources from DIR;\n"
+    "                      not with --socket\n"
+    "  --cache-size=MIB    keep DIR within MIB mebibytes (default 1024)\n";
+
+/** The extension of the files a directory is searched for. */
+constexpr std::string_view kSourceExtension = ".orn";
+
+/** The default `--memory-budget`, in mebibytes. */
+constexpr size_t kDefaultMemoryBudget = 512;
+
+/** The default `--cache-size`, in mebibytes. */
+constexpr size_t kDefaultCacheSize = 1024;
+
+/** The largest size in mebibytes whose byte count still fits a `size_t`. */
+constexpr size_t kMaxMebibytes = std::numeric_limits<size_t>::max() >> 20;
+
+/** How long `serve` waits on one client before giving up on it. */
+constexpr std::chrono::seconds kClientTimeout(10);
+
+/** The largest request `serve` reads, far more than any list of paths. */
+constexpr size_t kMaxRequestBytes = size_t{16} * 1024 * 1024;
+
+enum class Command { kLex, kParse, kDumpTree, kServe, kStop };
+
+enum class ReportFormat { kNone, kText, kJson };
+
+struct Options {
+  Command command = Command::kParse;
+  ReportFormat report = ReportFormat::kNone;
+  std::filesystem::path report_file;
+  size_t jobs = orion::syntax::ThreadPool::DefaultThreadCount();
+  std::filesystem::path socket;
+  size_t memory_budget = kDefaultMemoryBudget;
+  std::filesystem::path cache_dir;
+  std::optional<size_t> cache_size;
+  orion::syntax::NodeCachePolicy node_cache_policy =
+      orion::syntax::NodeCachePolicy::kFixed;
+  std::vector<std::filesystem::path> inputs;
+};
+
+// Reads a positive count, such as a number of threads.
+std::optional<size_t> ParseCount(const std::string_view text) {
+  size_t count = 0;
+  const auto [end, error] =
+      std::from_chars(text.data(), text.data() + text.size(), count);
+  if (error != std::errc() || end != text.data() + text.size() || count == 0) {
+    return std::nullopt;
+  }
+  return count;
+}
+
+// Reads the command line, or explains what is wrong with it in `error`.
+std::optional<Options> ParseArguments(const std::span<char* const> args,
+                                      std::string& error) {
+  if (args.empty()) {
+    error = "missing command";
+    return std::nullopt;
+  }
+
+  Options options;
+  const std::string_view command = args[0];
+  if (command == "lex") {
+    options.command = Command::kLex;
+  } else if (command == "parse") {
+    options.command = Command::kParse;
+  } else if (command == "dump-tree") {
+    options.command = Command::kDumpTree;
+  } else if (command == "serve") {
+    options.command = Command::kServe;
+  } else if (command == "stop") {
+    options.command = Command::kStop;
+  } else {
+    error = "unknown command '" + std::string(command) + "'";
+    return std::nullopt;
+  }
+
+  for (size_t i = 1; i < args.size(); ++i) {
+    const std::string_view arg = args[i];
+    std::optional<std::string_view> jobs;
+    if (arg == "--time-report" || arg == "--time-report=text") {
+      options.report = ReportFormat::kText;
+    } else if (arg == "--time-report=json") {
+      options.report = ReportFormat::kJson;
+    } else if (arg.starts_with("--time-report-file=")) {
+      options.report_file = arg.substr(19);
+      if (options.report == ReportFormat::kNone) {
+        options.report = ReportFormat::kText;
+      }
+    } else if (arg == "-j" && i + 1 < args.size()) {
+      jobs = args[++i];
+    } else if (arg.starts_with("--jobs=")) {
+      jobs = arg.substr(7);
+    } else if (arg.starts_with("--socket=")) {
+      options.socket = arg.substr(9);
+    } else if (arg.starts_with("--memory-budget=")) {
+      const std::optional<size_t> budget = ParseCount(arg.substr(16));
+      if (!budget.has_value() || *budget > kMaxMebibytes) {
+        error = "invalid memory budget '" + std::string(arg.substr(16)) + "'";
+        return std::nullopt;
+      }
+      options.memory_budget = *budget;
+    } else if (arg == "--adaptive-node-cache") {
+      options.node_cache_policy = orion::syntax::NodeCachePolicy::kAdaptive;
+    } else if (arg.starts_with("--cache-dir=")) {
+      options.cache_dir = arg.substr(12);
+    } else if (arg.starts_with("--cache-size=")) {
+      const std::optional<size_t> size = ParseCount(arg.substr(13));
+      if (!size.has_value() || *size > kMaxMebibytes) {
+        error = "invalid cache size '" + std::string(arg.substr(13)) + "'";
+        return std::nullopt;
+      }
+      options.cache_size = *size;
+    } else if (arg.starts_with("-") && arg != "-") {
+      error = "unknown option '" + std::string(arg) + "'";
+      return std::nullopt;
+    } else {
+      options.inputs.emplace_back(arg);
+    }
+
+    if (jobs.has_value()) {
+      const std::optional<size_t> count = ParseCount(*jobs);
+      if (!count.has_value()) {
+        error = "invalid thread count '" + std::string(*jobs) + "'";
+        return std::nullopt;
+      }
+      options.jobs = *count;
+    }
+  }
+
+  const bool server = options.command == Command::kServe ||
+                      options.command == Command::kStop;
+  if (server && options.socket.empty()) {
+    error = "missing --socket";
+    return std::nullopt;
+  }
+  if (!server && !options.socket.empty() &&
+      options.command != Command::kParse) {
+    error = "--socket only works with parse, serve and stop";
+    return std::nullopt;
+  }
+  if ((server || !options.socket.empty()) &&
+      (!options.cache_dir.empty() || options.cache_size.has_value())) {
+    error = "--cache-dir and --cache-size do not work with --socket";
+    return std::nullopt;
+  }
+  if (server && !options.inputs.empty()) {
+    error = "unexpected input files";
+    return std::nullopt;
+  }
+  if (!server && options.inputs.empty()) {
+    error = "no input files";
+    return std::nullopt;
+  }
+  return options;
+}
+
+// Expands directories into the source files below them, in a stable order.
+// Paths that are not directories are kept as given, so a missing file is
+// reported when it is read.
+std::vector<std::filesystem::path> CollectFiles(
+    const std::vector<std::filesystem::path>& inputs) {
+  std::vector<std::filesystem::path> files;
+  for (const std::filesystem::path& input : inputs) {
+    if (!std::filesystem::is_directory(input)) {
+      files.push_back(input);
+      continue;
+    }
+
+    std::vector<std::filesystem::path> found;
+    for (const std::filesystem::directory_entry& entry :
+         std::filesystem::recursive_directory_iterator(input)) {
+      if (entry.is_regular_file() &&
+          entry.path().extension() == kSourceExtension) {
+        found.push_back(entry.path());
+      }
+    }
+    std::ranges::sort(found);
+    files.insert(files.end(), found.begin(), found.end());
+  }
+  return files;
+}
+
+// Quotes token text, escaping what would break the line.
+std::string Quote(const std::string_view text) {
+  std::string quoted = "\"";
+  for (const char c : text) {
+    switch (c) {
+      case '\n':
+        quoted += "\\n";
+        break;
+      case '\r':
+        quoted += "\\r";
+        break;
+      case '\t':
+        quoted += "\\t";
+        break;
+      case '"':
+      case '\\':
+        quoted += '\\';
+        quoted += c;
+        break;
+      default:
+        quoted += c;
+    }
+  }
+  return quoted + "\"";
+}
+
+std::string FormatRange(const orion::syntax::TextRange range) {
+  return std::to_string(static_cast<size_t>(range.Start())) + ".." +
+         std::to_string(static_cast<size_t>(range.End()));
+}
+
+void PrintTokens(const SourceUnit& unit) {
+  for (const orion::syntax::Token& token : unit.tokens) {
+    std::cout << unit.path.string() << ":" << FormatRange(token.Span()) << " "
+              << orion::syntax::KindName(
+                     token.GetKind<orion::syntax::TokenKind>())
+              << " " << Quote(token.Text()) << "\n";
+  }
+}
+
+// Prints one line per node and token, indented by depth.
+void PrintTree(const SourceUnit& unit) {
+  std::cout << unit.path.string() << "\n";
+
+  const orion::syntax::SyntaxNode root =
+      orion::syntax::SyntaxNode::CreateRoot(*unit.root);
+  size_t depth = 0;
+  for (const orion::syntax::WalkEvent<orion::syntax::SyntaxElement>& event :
+       root.PreorderWithTokens()) {
+    if (event.IsLeave()) {
+      --depth;
+      continue;
+    }
+
+    const orion::syntax::SyntaxElement& element = event.value;
+    std::cout << std::string(2 * depth, ' ')
+              << orion::syntax::KindName(element.Kind()) << "@"
+              << FormatRange(element.Range());
+    if (const orion::syntax::SyntaxToken* token = element.AsToken()) {
+      std::cout << " " << Quote(token->Text());
+    }
+    std::cout << "\n";
+    ++depth;
+  }
+}
+
+// Reports a file's problems on stderr, returning whether it had any.
+bool PrintProblems(const SourceUnit& unit) {
+  if (!unit.error.empty()) {
+    std::cerr << unit.path.string() << ": " << unit.error << "\n";
+    return true;
+  }
+
+  for (const orion::syntax::Diagnostic& diagnostic : unit.diagnostics) {
+    std::cerr << unit.path.string() << ":"
+              << static_cast<size_t>(diagnostic.range.Start()) << ": "
+              << diagnostic.message << "\n";
+  }
+  return !unit.diagnostics.empty();
+}
+
+// Writes a report where the options ask for it, returning whether it could.
+bool WriteReport(const Options& options, const std::string& text) {
+  if (options.report_file.empty()) {
+    std::cerr << text;
+  } else if (!(std::ofstream(options.report_file) << text)) {
+    std::cerr << "orion: cannot write " << options.report_file.string()
+              << "\n";
+    return false;
+  }
+  return true;
+}
+
+// Answers requests until a client asks the server to stop.
+int Serve(const Options& options) {
+  orion::syntax::ThreadPool pool(options.jobs);
+  orion::syntax::CompileServer server(options.memory_budget * 1024 * 1024,
+                                      pool, options.node_cache_policy);
+  const orion::syntax::UnixSocket listener =
+      orion::syntax::UnixSocket::Listen(options.socket);
+  // The socket file goes however the server ends.
+  struct RemoveSocket {
+    const std::filesystem::path& path;
+    ~RemoveSocket() {
+      std::error_code error;
+      std::filesystem::remove(path, error);
+    }
+  } remove_socket{options.socket};
+  std::cerr << "orion: serving on " << options.socket.string() << std::endl;
+
+  while (!server.Stopping()) {
+    std::optional<orion::syntax::UnixSocket> client;
+    try {
+      client.emplace(listener.Accept());
+    } catch (const std::system_error& e) {
+      // Most often out of descriptors; back off until some are closed.
+      std::cerr << "orion: " << e.what() << std::endl;
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      continue;
+    }
+
+    // A stalled or oversized request, or a failure while handling it, costs
+    // only that request.
+    std::string reply;
+    try {
+      client->SetTimeout(kClientTimeout);
+      reply = server.Handle(client->ReadAll(kMaxRequestBytes));
+    } catch (const std::exception& e) {
+      std::cerr << "orion: " << e.what() << std::endl;
+      reply = "stderr orion: " + std::string(e.what()) + "\nexit 1\n";
+    }
+    try {
+      client->WriteAll(reply);
+    } catch (const std::system_error& e) {
+      // A client that goes away only loses its own reply.
+      std::cerr << "orion: " << e.what() << std::endl;
+    }
+  }
   return 0;
-}
\ No newline at end of file
+}
+
+// Sends the command to the server and prints its reply as if it had run
+// here. Paths are made absolute, since the server has its own directory.
+int RunRemote(const Options& options) {
+  std::string request =
+      options.command == Command::kStop ? "stop\n" : "parse\n";
+  for (const std::filesystem::path& file : CollectFiles(options.inputs)) {
+    request += std::filesystem::absolute(file).string() + "\n";
+  }
+
+  const orion::syntax::UnixSocket socket =
+      orion::syntax::UnixSocket::Connect(options.socket);
+  socket.WriteAll(request);
+  socket.FinishWriting();
+  const std::string reply = socket.ReadAll();
+
+  std::optional<int> status;
+  std::string_view rest = reply;
+  while (!rest.empty()) {
+    const size_t end = std::min(rest.find('\n'), rest.size());
+    const std::string_view line = rest.substr(0, end);
+    rest.remove_prefix(std::min(end + 1, rest.size()));
+
+    if (line.starts_with("stdout ")) {
+      std::cout << line.substr(7) << "\n";
+    } else if (line.starts_with("stderr ")) {
+      std::cerr << line.substr(7) << "\n";
+    } else if (line.starts_with("summary ") &&
+               options.report != ReportFormat::kNone &&
+               !WriteReport(options, std::string(line.substr(8)) + "\n")) {
+      status = 1;
+    } else if (line.starts_with("exit ") && !status.has_value()) {
+      status = line == "exit 0" ? 0 : ParseCount(line.substr(5)).value_or(1);
+    }
+  }
+  std::cout.flush();
+
+  if (!status.has_value()) {
+    std::cerr << "orion: the server closed the connection without replying\n";
+    return 1;
+  }
+  return *status;
+}
+
+int Run(const Options& options) {
+  if (options.command == Command::kServe) {
+    return Serve(options);
+  }
+  if (!options.socket.empty()) {
+    return RunRemote(options);
+  }
+
+  const std::vector<std::filesystem::path> files =
+      CollectFiles(options.inputs);
+  std::optional<orion::syntax::ParseCache> cache;
+  if (!options.cache_dir.empty()) {
+    cache.emplace(options.cache_dir,
+                  uint64_t{options.cache_size.value_or(kDefaultCacheSize)}
+                      << 20);
+  }
+  orion::syntax::ThreadPool pool(options.jobs);
+  orion::syntax::FrontEnd front_end(files, pool,
+                                    cache.has_value() ? &*cache : nullptr,
+                                    options.node_cache_policy);
+  front_end.RunThrough(options.command == Command::kLex ? Phase::kLex
+                                                        : Phase::kBuild);
+  if (cache.has_value()) {
+    cache->Trim();
+  }
+
+  int status = 0;
+  for (const SourceUnit& unit : front_end.Units()) {
+    if (PrintProblems(unit)) {
+      status = 1;
+    }
+    if (!unit.error.empty()) {
+      continue;
+    }
+
+    switch (options.command) {
+      case Command::kLex:
+        PrintTokens(unit);
+        break;
+      case Command::kParse:
+        if (unit.diagnostics.empty()) {
+          std::cout << unit.path.string() << ": ok\n";
+        }
+        break;
+      case Command::kDumpTree:
+        PrintTree(unit);
+        break;
+      case Command::kServe:
+      case Command::kStop:
+        break;
+    }
+  }
+  std::cout.flush();
+
+  if (options.report == ReportFormat::kNone) {
+    return status;
+  }
+
+  const orion::syntax::TimeReport report = front_end.Report();
+  const std::string text = options.report == ReportFormat::kJson
+                               ? orion::syntax::FormatTimeReportJson(report)
+                               : orion::syntax::FormatTimeReport(report);
+  return WriteReport(options, text) ? status : 1;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string error;
+  const std::optional<Options> options =
+      ParseArguments(std::span<char* const>(argv + 1, argv + argc), error);
+  if (!options.has_value()) {
+    std::cerr << "orion: " << error << "\n\n" << kUsage;
+    return 2;
+  }
+
+  try {
+    return Run(*options);
+  } catch (const std::exception& e) {
+    std::cerr << "orion: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,40 @@
+#include "syntax/ast/ast.h"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+
+#include "syntax/parser/rgtree/syntax/syntax_element.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/syntax_kind.h"
+
+namespace orion::syntax::ast {
+std::optional<SyntaxElement> SlotChild(const SyntaxNode& node,
+                                       const std::span<const SlotKind> slots,
+                                       const size_t index) {
+  size_t slot = 0;
+  for (const SyntaxElement& child : node.ChildrenWithTokens()) {
+    if (IsTrivia(child.Kind())) {
+      continue;
+    }
+
+    const SlotKind kind = child.IsNode() ? SlotKind::kNode : SlotKind::kToken;
+    size_t next = slot;
+    while (next < slots.size() && slots[next] != kind) {
+      ++next;
+    }
+    if (next == slots.size()) {
+      continue;
+    }
+
+    if (next == index) {
+      return child;
+    }
+    if (next > index) {
+      return std::nullopt;
+    }
+    slot = next + 1;
+  }
+  return std::nullopt;
+}
+}  // namespace orion::syntax::ast
@@ -0,0 +1,204 @@
+#ifndef SYNTAX_AST_AST_H_
+#define SYNTAX_AST_AST_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "syntax/parser/rgtree/syntax/syntax_element.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_token.h"
+#include "syntax/parser/syntax_kind.h"
+
+/**
+ * Typed views over syntax nodes, one class per node kind in `grammar.def`.
+ *
+ * A view is a `SyntaxNode` whose kind has been checked once, by `Cast`, so
+ * its accessors can name children by their role, such as `BinaryExpr::Lhs`,
+ * instead of by position. Views dispatch on `SyntaxKind` alone and carry
+ * nothing beyond the node handle.
+ */
+namespace orion::syntax::ast {
+
+/**
+ * @brief Whether a slot of a node holds a child node or a token.
+ */
+enum class SlotKind : uint8_t { kNode, kToken };
+
+/**
+ * @brief Returns the child filling a slot of a node, or `nullopt` if the slot
+ * is empty.
+ *
+ * Trivia is skipped, and the remaining children are matched to the slots in
+ * order. A child of the wrong sort for its slot means the slot is missing, as
+ * the left operand in `* 2` is, so the child fills the next slot of its sort.
+ * A child that fits no later slot, such as an error node, fills nothing.
+ *
+ * @param node The node to search.
+ * @param slots The shape of the node's kind.
+ * @param index The slot to find.
+ */
+[[nodiscard]] std::optional<SyntaxElement> SlotChild(
+    const SyntaxNode& node, std::span<const SlotKind> slots, size_t index);
+
+/**
+ * @brief A node of any kind in a category, such as any expression.
+ */
+template <NodeCategory kCategory>
+class AnyOf {
+ public:
+  /**
+   * @brief Checks if a node of a kind can be viewed as this type.
+   */
+  [[nodiscard]] static constexpr bool CanCast(const SyntaxKind kind) noexcept {
+    return KindInfo(kind).category == kCategory;
+  }
+
+  /**
+   * @brief Views a node as this type, or returns `nullopt` if its kind is in
+   * another category.
+   */
+  [[nodiscard]] static std::optional<AnyOf> Cast(SyntaxNode node) {
+    if (!CanCast(node.Kind())) {
+      return std::nullopt;
+    }
+    return AnyOf(std::move(node));
+  }
+
+  /**
+   * @brief Returns the kind of the underlying node.
+   */
+  [[nodiscard]] SyntaxKind Kind() const noexcept { return syntax_.Kind(); }
+
+  /**
+   * @brief Returns the underlying node.
+   */
+  [[nodiscard]] const SyntaxNode& Syntax() const noexcept { return syntax_; }
+
+  /**
+   * @brief Views the node as a specific kind, or returns `nullopt` if it has
+   * another kind.
+   */
+  template <typename T>
+  [[nodiscard]] std::optional<T> As() const {
+    return T::Cast(syntax_);
+  }
+
+ private:
+  explicit AnyOf(SyntaxNode syntax) noexcept : syntax_(std::move(syntax)) {}
+
+  SyntaxNode syntax_;
+};
+
+/** Any expression. */
+using Expr = AnyOf<NodeCategory::kExpr>;
+
+/**
+ * @brief The base of the view of one node kind.
+ *
+ * @tparam Derived The view, which lists its slots in `kSlots`.
+ * @tparam kKind The kind of node it views.
+ */
+template <typename Derived, SyntaxKind kKind>
+class Node {
+ public:
+  /**
+   * @brief Checks if a node of a kind can be viewed as this type.
+   */
+  [[nodiscard]] static constexpr bool CanCast(const SyntaxKind kind) noexcept {
+    return kind == kKind;
+  }
+
+  /**
+   * @brief Views a node as this type, or returns `nullopt` if it has another
+   * kind.
+   */
+  [[nodiscard]] static std::optional<Derived> Cast(SyntaxNode node) {
+    if (!CanCast(node.Kind())) {
+      return std::nullopt;
+    }
+    return Derived(std::move(node));
+  }
+
+  /**
+   * @brief Returns the underlying node.
+   */
+  [[nodiscard]] const SyntaxNode& Syntax() const noexcept { return syntax_; }
+
+ protected:
+  explicit Node(SyntaxNode syntax) noexcept : syntax_(std::move(syntax)) {}
+
+  /**
+   * @brief Returns the node in a slot, or `nullopt` if it is missing or is
+   * not a `T`.
+   */
+  template <typename T>
+  [[nodiscard]] std::optional<T> NodeSlot(const size_t index) const {
+    const std::optional<SyntaxElement> child =
+        SlotChild(syntax_, Derived::kSlots, index);
+    if (!child.has_value() || !child->IsNode()) {
+      return std::nullopt;
+    }
+    return T::Cast(*child->AsNode());
+  }
+
+  /**
+   * @brief Returns the token in a slot, or `nullopt` if it is missing.
+   */
+  [[nodiscard]] std::optional<SyntaxToken> TokenSlot(const size_t index) const {
+    const std::optional<SyntaxElement> child =
+        SlotChild(syntax_, Derived::kSlots, index);
+    if (!child.has_value() || !child->IsToken()) {
+      return std::nullopt;
+    }
+    return *child->AsToken();
+  }
+
+ private:
+  SyntaxNode syntax_;
+};
+
+// The slots of each node kind, in order. A slot's type must be `Expr` or a
+// view declared earlier in `grammar.def`.
+#define NODE_SLOT(index, Type, Accessor) SlotKind::kNode,
+#define TOKEN_SLOT(index, Accessor) SlotKind::kToken,
+#define SYNTAX_NODE(Name, category, slots) \
+  inline constexpr std::array k##Name##Slots = {slots};
+#include "syntax/grammar/grammar.def"
+#undef NODE_SLOT
+#undef TOKEN_SLOT
+
+#define NODE_SLOT(index, Type, Accessor)                         \
+  static_assert(kSlots[index] == SlotKind::kNode);               \
+  [[nodiscard]] std::optional<Type> Accessor() const {           \
+    return NodeSlot<Type>(index);                                \
+  }
+#define TOKEN_SLOT(index, Accessor)                              \
+  static_assert(kSlots[index] == SlotKind::kToken);              \
+  [[nodiscard]] std::optional<SyntaxToken> Accessor() const {    \
+    return TokenSlot(index);                                     \
+  }
+#define SYNTAX_NODE(Name, category, slots)                       \
+  class Name : public Node<Name, SyntaxKind::k##Name> {          \
+   public:                                                       \
+    static constexpr std::span<const SlotKind> kSlots =          \
+        k##Name##Slots;                                          \
+                                                                 \
+    slots                                                        \
+                                                                 \
+   private:                                                      \
+    friend Node;                                                 \
+                                                                 \
+    explicit Name(SyntaxNode syntax) noexcept                    \
+        : Node(std::move(syntax)) {}                             \
+  };
+#include "syntax/grammar/grammar.def"
+#undef NODE_SLOT
+#undef TOKEN_SLOT
+
+}  // namespace orion::syntax::ast
+
+#endif  // SYNTAX_AST_AST_H_
@@ -0,0 +1,301 @@
+#include "syntax/driver/compile_server.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "syntax/interner/interner.h"
+#include "syntax/io/source_file.h"
+#include "syntax/lexer/lexer.h"
+#include "syntax/lexer/token.h"
+#include "syntax/parser/build_green.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/parser.h"
+#include "syntax/parser/rgtree/green/green_cache.h"
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/rgtree/tree_reclaimer.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/text/text_size.h"
+#include "syntax/util/hash.h"
+#include "syntax/util/thread_pool.h"
+
+namespace orion::syntax {
+namespace {
+constexpr double kMebibyte = 1024.0 * 1024.0;
+
+// Approximate size of a `std::shared_ptr` control block.
+constexpr size_t kControlBlockBytes = 2 * sizeof(void*);
+
+// Approximate per-entry cost of the LRU list node and the index slot.
+constexpr size_t kBookkeepingBytes = 8 * sizeof(void*);
+
+// The bytes a tree keeps alive. Subtrees shared with other entries through
+// the green caches are counted in each, so the estimate errs high.
+size_t TreeBytes(const GreenNode& root) {
+  size_t bytes = 0;
+  std::vector<const GreenNodeData*> stack = {&root.Data()};
+  while (!stack.empty()) {
+    const GreenNodeData& node = *stack.back();
+    stack.pop_back();
+    bytes += sizeof(GreenNodeData) + kControlBlockBytes +
+             node.Children().size() * (sizeof(GreenElement) + sizeof(TextSize));
+    for (const GreenElement& child : node.Children()) {
+      if (const GreenNode* child_node = child.AsNode()) {
+        stack.push_back(&child_node->Data());
+      } else {
+        bytes += sizeof(GreenTokenData) + kControlBlockBytes;
+      }
+    }
+  }
+  return bytes;
+}
+
+// Splits a request into its lines, dropping empty ones.
+std::vector<std::string_view> Lines(std::string_view text) {
+  std::vector<std::string_view> lines;
+  while (!text.empty()) {
+    const size_t end = std::min(text.find('\n'), text.size());
+    if (end > 0) {
+      lines.push_back(text.substr(0, end));
+    }
+    text.remove_prefix(std::min(end + 1, text.size()));
+  }
+  return lines;
+}
+}  // namespace
+
+CompileServer::CompileServer(const size_t memory_budget, ThreadPool& pool,
+                             const NodeCachePolicy policy)
+    : interner_owner_(Interner::Global()),
+      memory_budget_(memory_budget),
+      pool_(pool) {
+  builders_.reserve(pool.Size());
+  for (size_t i = 0; i < pool.Size(); ++i) {
+    builders_.emplace_back(policy);
+  }
+}
+
+std::string CompileServer::Handle(const std::string_view request) {
+  std::vector<std::string_view> lines = Lines(request);
+  const std::string_view command = lines.empty() ? "" : lines.front();
+  if (command == "parse") {
+    lines.erase(lines.begin());
+    return Parse(lines);
+  }
+  if (command == "stop") {
+    stopping_ = true;
+    return "exit 0\n";
+  }
+  return "stderr orion: unknown request '" + std::string(command) +
+         "'\nexit 2\n";
+}
+
+std::string CompileServer::Parse(const std::vector<std::string_view>& paths) {
+  const auto start = std::chrono::steady_clock::now();
+
+  struct Lookup {
+    std::optional<SourceFile> file;
+    uint64_t content_hash = 0;
+    std::string error;
+
+    /** The cached entry, if the contents are unchanged. */
+    const Entry* cached = nullptr;
+
+    /** The fresh result, if they are new. */
+    std::optional<Entry> parsed;
+  };
+  std::vector<Lookup> lookups(paths.size());
+
+  // Hashing reads every byte, so it runs in parallel too.
+  ParallelFor(pool_, paths.size(), [&](size_t, const size_t i) {
+    Lookup& lookup = lookups[i];
+    try {
+      lookup.file = SourceFile::Open(std::filesystem::path(paths[i]));
+      const std::string_view bytes = lookup.file->Bytes();
+      lookup.content_hash = HashBytes(bytes.data(), bytes.size());
+    } catch (const std::exception& e) {
+      lookup.error = e.what();
+    }
+  });
+
+  std::vector<size_t> misses;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    Lookup& lookup = lookups[i];
+    if (!lookup.error.empty()) {
+      continue;
+    }
+
+    const auto found = index_.find(paths[i]);
+    if (found != index_.end() &&
+        found->second->content_hash == lookup.content_hash) {
+      entries_.splice(entries_.begin(), entries_, found->second);
+      lookup.cached = &*found->second;
+      lookup.file.reset();
+    } else {
+      misses.push_back(i);
+    }
+  }
+
+  // Largest first, so a big file does not start last and stretch the tail.
+  std::ranges::stable_sort(misses, [&lookups](const size_t a, const size_t b) {
+    return lookups[a].file->Bytes().size() > lookups[b].file->Bytes().size();
+  });
+  // A file that fails to parse, such as one too large for 32-bit offsets, is
+  // reported on its own and not cached; the rest of the request goes on.
+  ParallelFor(pool_, misses.size(), [&](const size_t slot, const size_t k) {
+    const size_t i = misses[k];
+    Lookup& lookup = lookups[i];
+    try {
+      const std::u32string text = lookup.file->Decode();
+      const std::vector<Diagnostic> encoding = lookup.file->Diagnostics();
+      lookup.file.reset();
+
+      Lexer lexer(text);
+      const std::vector<Token> tokens = lexer.Tokenize();
+      Parser parser(tokens);
+      const std::vector<Event> events = parser.Parse();
+      Entry entry{std::string(paths[i]), lookup.content_hash,
+                  BuildGreen(events, tokens, builders_[slot]),
+                  MergeDiagnostics(encoding,
+                                   MergeDiagnostics(lexer.Diagnostics(),
+                                                    parser.Diagnostics())),
+                  0};
+      entry.memory = sizeof(Entry) + kBookkeepingBytes + entry.path.size() +
+                     entry.diagnostics.size() * sizeof(Diagnostic) +
+                     TreeBytes(entry.root);
+      lookup.parsed = std::move(entry);
+    } catch (const std::exception& e) {
+      lookup.file.reset();
+      lookup.error = e.what();
+    }
+  });
+
+  // The reply is written before anything is inserted or evicted, so every
+  // cached entry it reads is still alive.
+  std::ostringstream reply;
+  int status = 0;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const Lookup& lookup = lookups[i];
+    if (!lookup.error.empty()) {
+      reply << "stderr " << paths[i] << ": " << lookup.error << '\n';
+      status = 1;
+      continue;
+    }
+
+    const Entry& entry =
+        lookup.cached != nullptr ? *lookup.cached : *lookup.parsed;
+    for (const Diagnostic& diagnostic : entry.diagnostics) {
+      reply << "stderr " << paths[i] << ':'
+            << static_cast<size_t>(diagnostic.range.Start()) << ": "
+            << diagnostic.message << '\n';
+      status = 1;
+    }
+    if (entry.diagnostics.empty()) {
+      reply << "stdout " << paths[i] << ": ok\n";
+    }
+  }
+
+  for (Lookup& lookup : lookups) {
+    if (lookup.parsed.has_value()) {
+      Insert(std::move(*lookup.parsed));
+    }
+  }
+  Evict();
+
+  ++stats_.requests;
+  stats_.files += paths.size();
+  stats_.misses += misses.size();
+  stats_.hits += static_cast<uint64_t>(std::ranges::count_if(
+      lookups, [](const Lookup& lookup) { return lookup.cached != nullptr; }));
+
+  const double milliseconds =
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+  reply << std::fixed << std::setprecision(3) << "summary " << paths.size()
+        << " files, " << paths.size() - misses.size() << " from memory, "
+        << misses.size() << " parsed in " << milliseconds << " ms; "
+        << entries_.size() << " cached, " << std::setprecision(1)
+        << static_cast<double>(memory_used_ + CacheMemoryUsed() +
+                               Interner::Global().Bytes()) /
+               kMebibyte
+        << " of " << static_cast<double>(memory_budget_) / kMebibyte
+        << " MiB, "
+        << static_cast<double>(Interner::Global().Bytes()) / kMebibyte
+        << " MiB of it interned\n"
+        << "exit " << status << '\n';
+  return reply.str();
+}
+
+void CompileServer::Insert(Entry entry) {
+  if (const auto found = index_.find(entry.path); found != index_.end()) {
+    // The key views the old entry's path, so it goes first.
+    const std::list<Entry>::iterator old = found->second;
+    index_.erase(found);
+    memory_used_ -= old->memory;
+    TreeReclaimer::Global().Defer(std::move(old->root));
+    entries_.erase(old);
+  }
+
+  memory_used_ += entry.memory;
+  entries_.push_front(std::move(entry));
+  index_.emplace(entries_.front().path, entries_.begin());
+}
+
+size_t CompileServer::CacheMemoryUsed() const noexcept {
+  size_t bytes = 0;
+  for (const GreenBuilder& builder : builders_) {
+    bytes += builder.Cache().MemoryUsage();
+  }
+  return bytes;
+}
+
+void CompileServer::Evict() {
+  const Interner& interner = Interner::Global();
+
+  // Interned text outlives the entries that used it and is only released all
+  // at once. Left to grow, it would take the budget from the entries until
+  // every request evicted everything, so it is released as soon as it is the
+  // larger share. That needs every entry gone and the caches cleared, so no
+  // symbol is resolved again; trees still queued on the reclaimer only
+  // release their nodes.
+  const bool reset_interner = interner.Bytes() > memory_budget_ / 2;
+
+  // The caches only speed up parsing, so they go before any result does.
+  if (reset_interner ||
+      memory_used_ + CacheMemoryUsed() + interner.Bytes() > memory_budget_) {
+    for (GreenBuilder& builder : builders_) {
+      builder.Cache().Clear(TreeReclaimer::Global());
+    }
+    ++stats_.cache_clears;
+  }
+
+  while ((reset_interner ||
+          memory_used_ + interner.Bytes() > memory_budget_) &&
+         !entries_.empty()) {
+    Entry& oldest = entries_.back();
+    index_.erase(oldest.path);
+    memory_used_ -= oldest.memory;
+    TreeReclaimer::Global().Defer(std::move(oldest.root));
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+
+  if (reset_interner) {
+    interner_owner_.Clear();
+    ++stats_.interner_resets;
+  }
+}
+}  // namespace orion::syntax
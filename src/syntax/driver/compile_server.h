@@ -0,0 +1,197 @@
+#ifndef SYNTAX_DRIVER_COMPILE_SERVER_H_
+#define SYNTAX_DRIVER_COMPILE_SERVER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "syntax/interner/interner.h"
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_cache.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/util/thread_pool.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief Counters describing how much work a `CompileServer` was spared.
+ */
+struct CompileServerStats {
+  /** Requests handled. */
+  uint64_t requests = 0;
+
+  /** Files named by those requests. */
+  uint64_t files = 0;
+
+  /** Files answered from memory because their contents had not changed. */
+  uint64_t hits = 0;
+
+  /** Files that were new or changed and had to be parsed. */
+  uint64_t misses = 0;
+
+  /** Entries dropped to stay within the memory budget. */
+  uint64_t evictions = 0;
+
+  /** Times the builders' green caches were cleared to stay within it. */
+  uint64_t cache_clears = 0;
+
+  /** Times the interned token text was released to stay within it. */
+  uint64_t interner_resets = 0;
+};
+
+/**
+ * @brief The state behind `orion serve`: parse results kept warm between
+ * requests.
+ *
+ * Each file's tree and diagnostics are kept under its path along with a hash
+ * of its contents. A request maps every file and hashes it, answers those
+ * whose hash is unchanged from memory, and parses only the rest, on the pool
+ * and with builders whose green caches also live across requests. Entries
+ * are kept in least-recently-used order.
+ *
+ * The memory budget covers the entries, the green caches and the token text
+ * interned in the global `Interner` together. A green cache keeps every
+ * element it has seen alive, including those of evicted entries, so once the
+ * total is over budget the caches are cleared first and then the oldest
+ * entries are dropped until the rest fit. Interned text is not freed with the
+ * entries that used it, and would crowd out ever more of them as dead
+ * spellings pile up; once it takes over half the budget, the caches and every
+ * entry are dropped and the interner is cleared. The server therefore holds the global
+ * interner's `Interner::Owner` for its lifetime, so a second server or a
+ * `FrontEnd` in the same process fails rather than keeping symbols it would
+ * invalidate. Dropped trees and cache
+ * contents are handed to `TreeReclaimer::Global()`, so freeing them does not
+ * add to the request's latency.
+ *
+ * Requests and replies are plain text, one item per line. A request is a
+ * command, `parse` or `stop`, followed for `parse` by the files:
+ *
+ * @code
+ * parse
+ * /abs/path/a.orn
+ * /abs/path/b.orn
+ * @endcode
+ *
+ * A `parse` reply mirrors what `orion parse` prints, each line prefixed with
+ * the stream it belongs on, then a summary and the exit status:
+ *
+ * @code
+ * stdout /abs/path/a.orn: ok
+ * stderr /abs/path/b.orn:3: expected an operand
+ * summary 2 files, 1 from memory, 1 parsed in 0.210 ms; ...
+ * exit 1
+ * @endcode
+ *
+ * Paths cannot contain line breaks. The server is not thread-safe: requests
+ * are handled one at a time, each using the whole pool.
+ */
+class CompileServer {
+ public:
+  /**
+   * @brief Starts with nothing cached.
+   *
+   * @param memory_budget The size in bytes the cached entries may reach.
+   * @param pool The pool to parse on, which must outlive the server.
+   * @param policy How the builders' green caches decide which nodes to
+   * deduplicate.
+   * @throws std::logic_error If the global interner already has an owner.
+   */
+  CompileServer(size_t memory_budget, ThreadPool& pool,
+                NodeCachePolicy policy = NodeCachePolicy::kFixed);
+
+  /**
+   * @brief Handles one request and returns the reply.
+   *
+   * Files that cannot be read are reported in the reply, not thrown.
+   */
+  [[nodiscard]] std::string Handle(std::string_view request);
+
+  /**
+   * @brief Returns whether a `stop` request has been handled.
+   */
+  [[nodiscard]] bool Stopping() const noexcept { return stopping_; }
+
+  /**
+   * @brief Returns the estimated size in bytes of the cached entries.
+   */
+  [[nodiscard]] size_t MemoryUsed() const noexcept { return memory_used_; }
+
+  /**
+   * @brief Returns the estimated size in bytes of the builders' green caches.
+   */
+  [[nodiscard]] size_t CacheMemoryUsed() const noexcept;
+
+  /**
+   * @brief Returns the number of files cached.
+   */
+  [[nodiscard]] size_t EntryCount() const noexcept { return entries_.size(); }
+
+  /**
+   * @brief Returns the counters since the server started.
+   */
+  [[nodiscard]] const CompileServerStats& Stats() const noexcept {
+    return stats_;
+  }
+
+ private:
+  /**
+   * @brief The cached result for one file.
+   */
+  struct Entry {
+    std::string path;
+    uint64_t content_hash;
+    GreenNode root;
+    std::vector<Diagnostic> diagnostics;
+
+    /** The estimated size of the entry and the tree it keeps alive. */
+    size_t memory;
+  };
+
+  /**
+   * @brief Answers a `parse` request for `paths`.
+   */
+  std::string Parse(const std::vector<std::string_view>& paths);
+
+  /**
+   * @brief Caches `entry` as the most recently used, replacing any older
+   * entry for its path.
+   */
+  void Insert(Entry entry);
+
+  /**
+   * @brief Clears the green caches if the entries, caches and interned text
+   * together are over budget, then drops the least recently used entries
+   * until the rest fit. If the interned text takes over half the budget,
+   * drops everything and clears the interner instead.
+   */
+  void Evict();
+
+  /** Reserves the global interner, so `Evict` may clear it. Declared first
+   * so it is released after everything holding symbols. */
+  Interner::Owner interner_owner_;
+
+  size_t memory_budget_;
+  ThreadPool& pool_;
+
+  /** One builder per pool thread, kept so their caches stay warm. */
+  std::vector<GreenBuilder> builders_;
+
+  /** The entries, most recently used first. */
+  std::list<Entry> entries_;
+
+  /** The entries by path. */
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+
+  size_t memory_used_ = 0;
+  CompileServerStats stats_;
+  bool stopping_ = false;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_DRIVER_COMPILE_SERVER_H_
@@ -0,0 +1,211 @@
+#include "syntax/driver/front_end.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "syntax/driver/parse_cache.h"
+#include "syntax/driver/time_report.h"
+#include "syntax/interner/interner.h"
+#include "syntax/io/source_file.h"
+#include "syntax/lexer/lexer.h"
+#include "syntax/parser/build_green.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/parser.h"
+#include "syntax/parser/rgtree/green/green_cache.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/util/thread_pool.h"
+
+namespace orion::syntax {
+namespace {
+void AddStats(GreenCacheStats& total, const GreenCacheStats& stats) noexcept {
+  total.node_lookups += stats.node_lookups;
+  total.node_hits += stats.node_hits;
+  total.node_misses += stats.node_misses;
+  total.node_skips += stats.node_skips;
+  total.token_lookups += stats.token_lookups;
+  total.token_hits += stats.token_hits;
+  total.token_misses += stats.token_misses;
+  total.hash_collisions += stats.hash_collisions;
+  total.bytes_saved += stats.bytes_saved;
+  for (size_t i = 0; i < total.child_counts.size(); ++i) {
+    total.child_counts[i] += stats.child_counts[i];
+  }
+}
+
+uint64_t CountNodes(const std::vector<Event>& events) noexcept {
+  return static_cast<uint64_t>(
+      std::ranges::count(events, EventKind::kStart, &Event::kind));
+}
+}  // namespace
+
+FrontEnd::FrontEnd(const std::span<const std::filesystem::path> paths,
+                   ThreadPool& pool, ParseCache* const cache,
+                   const NodeCachePolicy policy)
+    : pool_(pool), cache_(cache), policy_(policy), units_(paths.size()) {
+  if (Interner::Global().Owned()) {
+    throw std::logic_error("the global interner is owned by another user");
+  }
+
+  builders_.reserve(pool.Size());
+  for (size_t i = 0; i < pool.Size(); ++i) {
+    builders_.emplace_back(policy);
+  }
+
+  std::vector<uintmax_t> sizes(paths.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    units_[i].path = paths[i];
+
+    // A file that cannot be sized is still read, to report why.
+    std::error_code error;
+    sizes[i] = std::filesystem::file_size(paths[i], error);
+    if (error) {
+      sizes[i] = 0;
+    }
+  }
+
+  order_.resize(paths.size());
+  std::iota(order_.begin(), order_.end(), 0);
+  std::stable_sort(order_.begin(), order_.end(),
+                   [&sizes](const size_t a, const size_t b) {
+                     return sizes[a] > sizes[b];
+                   });
+}
+
+void FrontEnd::RunThrough(const Phase last) {
+  for (size_t phase = timings_.size(); phase <= static_cast<size_t>(last);
+       ++phase) {
+    timings_.push_back(RunPhase(static_cast<Phase>(phase)));
+  }
+}
+
+TimeReport FrontEnd::Report() const {
+  TimeReport report{timings_, PeakRssBytes(), {}, policy_, {}};
+  for (const GreenBuilder& builder : builders_) {
+    AddStats(report.cache, builder.Cache().Stats());
+  }
+  if (cache_ != nullptr) {
+    report.parse_cache = cache_->Stats();
+  }
+  return report;
+}
+
+template <typename Step>
+void FrontEnd::ForEachUnit(const Step& step) {
+  // `builders_` has one builder per pool thread, so each slot owns one.
+  ParallelFor(pool_, order_.size(), [this, &step](const size_t slot,
+                                                   const size_t index) {
+    SourceUnit& unit = units_[order_[index]];
+    if (!unit.error.empty() || unit.cached) {
+      return;
+    }
+    // A file that fails in any phase is reported on its own, and the rest of
+    // the run goes on without it.
+    try {
+      step(slot, unit);
+    } catch (const std::exception& e) {
+      unit.error = e.what();
+    }
+  });
+}
+
+PhaseTiming FrontEnd::RunPhase(const Phase phase) {
+  const auto wall_start = std::chrono::steady_clock::now();
+  const double cpu_start = ProcessCpuSeconds();
+
+  switch (phase) {
+    case Phase::kRead:
+      ForEachUnit([this](size_t, SourceUnit& unit) {
+        const SourceFile file = SourceFile::Open(unit.path);
+        unit.bytes = file.Bytes().size();
+        if (cache_ != nullptr) {
+          unit.cache_key = ParseCache::Key(file.Bytes());
+          std::optional<CachedParse> cached =
+              cache_->Load(unit.cache_key, unit.bytes);
+          if (cached.has_value()) {
+            unit.tokens = std::move(cached->tokens);
+            unit.root = std::move(cached->root);
+            unit.diagnostics = std::move(cached->diagnostics);
+            unit.cached = true;
+            return;
+          }
+        }
+        unit.text = file.Decode();
+        unit.diagnostics = file.Diagnostics();
+      });
+      break;
+
+    case Phase::kLex:
+      ForEachUnit([](size_t, SourceUnit& unit) {
+        Lexer lexer(unit.text);
+        unit.tokens = lexer.Tokenize();
+        unit.token_count = unit.tokens.size();
+        unit.diagnostics =
+            MergeDiagnostics(unit.diagnostics, lexer.Diagnostics());
+        // Tokens hold interned symbols rather than views into the text.
+        unit.text = std::u32string();
+      });
+      break;
+
+    case Phase::kParse:
+      ForEachUnit([](size_t, SourceUnit& unit) {
+        Parser parser(unit.tokens);
+        unit.events = parser.Parse();
+        unit.node_count = CountNodes(unit.events);
+        unit.diagnostics =
+            MergeDiagnostics(unit.diagnostics, parser.Diagnostics());
+      });
+      break;
+
+    case Phase::kBuild:
+      ForEachUnit([this](const size_t task, SourceUnit& unit) {
+        unit.root = BuildGreen(unit.events, unit.tokens, builders_[task]);
+        if (cache_ != nullptr) {
+          cache_->Store(unit.cache_key, unit.bytes, unit.tokens, *unit.root,
+                        unit.diagnostics);
+        }
+        unit.events = std::vector<Event>();
+        unit.tokens = std::vector<Token>();
+      });
+      for (SourceUnit& unit : units_) {
+        if (unit.cached) {
+          unit.tokens = std::vector<Token>();
+        }
+      }
+      break;
+  }
+
+  PhaseTiming timing;
+  timing.phase = phase;
+  timing.wall_seconds = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - wall_start)
+                            .count();
+  timing.cpu_seconds = ProcessCpuSeconds() - cpu_start;
+
+  // Counted after the clocks stop, so the counting is not timed. Files from
+  // the cache only count towards the read phase, the one that loaded them.
+  for (const SourceUnit& unit : units_) {
+    if (unit.cached && phase != Phase::kRead) {
+      continue;
+    }
+    timing.bytes += unit.bytes;
+    if (phase != Phase::kRead) {
+      timing.tokens += unit.token_count;
+    }
+    if (phase == Phase::kParse || phase == Phase::kBuild) {
+      timing.nodes += unit.node_count;
+    }
+  }
+  return timing;
+}
+}  // namespace orion::syntax
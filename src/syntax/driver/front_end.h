@@ -0,0 +1,152 @@
+#ifndef SYNTAX_DRIVER_FRONT_END_H_
+#define SYNTAX_DRIVER_FRONT_END_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "syntax/driver/parse_cache.h"
+#include "syntax/driver/time_report.h"
+#include "syntax/lexer/token.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_cache.h"
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/util/thread_pool.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief One file on its way through the front end.
+ *
+ * Each phase fills in its own fields and releases those no later phase
+ * needs, so a run over many files does not hold every file's buffers at
+ * once: the text goes once lexed, and the tokens and events once built. A
+ * caller that stops after lexing therefore still has the tokens. A file
+ * found in the parse cache gets its tokens, tree and diagnostics when read
+ * and never has its text decoded or its events recorded; its tokens go in
+ * the build phase like the others'.
+ */
+struct SourceUnit {
+  /** The file. */
+  std::filesystem::path path;
+
+  /** The size of the file in bytes, once read. */
+  uint64_t bytes = 0;
+
+  /** The decoded text, from reading until lexed. */
+  std::u32string text;
+
+  /** The tokens, from lexing until built. */
+  std::vector<Token> tokens;
+
+  /** The parser's events, from parsing until built. */
+  std::vector<Event> events;
+
+  /** The number of tokens, kept after `tokens` is released. */
+  uint64_t token_count = 0;
+
+  /** The number of nodes the events open, kept after `events` is released. */
+  uint64_t node_count = 0;
+
+  /** The `kRoot` node, once built. */
+  std::optional<GreenNode> root;
+
+  /** The lexer's diagnostics, joined by the parser's once parsed. */
+  std::vector<Diagnostic> diagnostics;
+
+  /** Why a phase failed on the file, if one did. Later phases skip it. */
+  std::string error;
+
+  /** The file's `ParseCache::Key`, once read with a cache. */
+  uint64_t cache_key = 0;
+
+  /** Whether the results came from the cache. Later phases skip it. */
+  bool cached = false;
+};
+
+/**
+ * @brief Runs files through the front end one phase at a time, timing each.
+ *
+ * Every file finishes a phase before any starts the next, so each phase's
+ * time is its own and not blurred with the others. Within a phase the files
+ * run in parallel, largest first, so the longest start early and the small
+ * ones fill in around them. Each task builds with its own `GreenBuilder`, so
+ * no cache is shared between threads and the cache counters can be summed
+ * afterwards. A file that fails in any phase gets an error and does not stop
+ * the others.
+ *
+ * With a `ParseCache`, the read phase looks every file up by its contents and
+ * the build phase stores the files that were not found.
+ */
+class FrontEnd {
+ public:
+  /**
+   * @brief Prepares to process files.
+   *
+   * @param paths The files, in the order results are reported.
+   * @param pool The pool to run on, which must outlive the front end.
+   * @param cache The parse cache to use, if any, which must outlive the
+   * front end.
+   * @param policy How the builders' green caches decide which nodes to
+   * deduplicate.
+   * @throws std::logic_error If the global interner has an owner, which
+   * could clear it under the front end's trees.
+   */
+  FrontEnd(std::span<const std::filesystem::path> paths,
+           ThreadPool& pool, ParseCache* cache = nullptr,
+           NodeCachePolicy policy = NodeCachePolicy::kFixed);
+
+  /**
+   * @brief Runs each phase up to and including `last` that has not run yet.
+   */
+  void RunThrough(Phase last);
+
+  /**
+   * @brief Returns the files, in the order they were given.
+   */
+  [[nodiscard]] std::span<const SourceUnit> Units() const noexcept {
+    return units_;
+  }
+
+  /**
+   * @brief Returns the measurements of the phases run so far.
+   */
+  [[nodiscard]] TimeReport Report() const;
+
+ private:
+  /**
+   * @brief Runs `step` on every readable file not found in the cache on the
+   * pool, passing the index of the task it runs on.
+   */
+  template <typename Step>
+  void ForEachUnit(const Step& step);
+
+  /**
+   * @brief Runs one phase over every file.
+   */
+  PhaseTiming RunPhase(Phase phase);
+
+  ThreadPool& pool_;
+  ParseCache* cache_;
+  NodeCachePolicy policy_;
+  std::vector<SourceUnit> units_;
+
+  /** The files by size, largest first. */
+  std::vector<size_t> order_;
+
+  /** One builder per task, so no cache is shared between threads. */
+  std::vector<GreenBuilder> builders_;
+
+  std::vector<PhaseTiming> timings_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_DRIVER_FRONT_END_H_
@@ -0,0 +1,362 @@
+#include "syntax/driver/parse_cache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "syntax/interner/interner.h"
+#include "syntax/io/mapped_file.h"
+#include "syntax/lexer/token_kind.h"
+#include "syntax/parser/rgtree/green/green_archive.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+#include "syntax/util/hash.h"
+
+namespace orion::syntax {
+namespace {
+constexpr char kMagic[4] = {'O', 'P', 'C', 'E'};
+
+/** The extension of entry files; temporary files never end with it. */
+constexpr std::string_view kEntryExtension = ".opc";
+
+/** The alignment of the archive inside an entry. */
+constexpr size_t kArchiveAlignment = 8;
+
+static_assert(sizeof(ParseCacheHeader) == 40);
+static_assert(sizeof(ParseCacheToken) == 20);
+static_assert(sizeof(ParseCacheDiagnostic) == 16);
+
+// Pointers to the records of a validated entry.
+struct EntryRecords {
+  const ParseCacheHeader* header;
+  const ParseCacheToken* tokens;
+  const ParseCacheDiagnostic* diagnostics;
+  std::string_view strings;
+  size_t archive_offset;
+};
+
+[[noreturn]] void Corrupt(const char* reason) {
+  throw std::invalid_argument(std::string("corrupt parse cache entry: ") +
+                              reason);
+}
+
+bool InStrings(const std::string_view strings, const uint32_t offset,
+               const uint32_t size) noexcept {
+  return uint64_t{offset} + size <= strings.size();
+}
+
+EntryRecords Validate(const std::string_view bytes, const uint64_t key,
+                      const uint64_t source_size) {
+  if (bytes.size() < sizeof(ParseCacheHeader)) {
+    Corrupt("truncated header");
+  }
+
+  EntryRecords records{};
+  records.header = reinterpret_cast<const ParseCacheHeader*>(bytes.data());
+  const ParseCacheHeader& header = *records.header;
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    Corrupt("bad magic");
+  }
+  if (header.version != kFrontEndVersion || header.key != key ||
+      header.source_size != source_size) {
+    Corrupt("written for another source");
+  }
+
+  const uint64_t records_end =
+      sizeof(ParseCacheHeader) +
+      uint64_t{header.token_count} * sizeof(ParseCacheToken) +
+      uint64_t{header.diagnostic_count} * sizeof(ParseCacheDiagnostic) +
+      header.strings_size;
+  const uint64_t archive_offset =
+      (records_end + kArchiveAlignment - 1) / kArchiveAlignment *
+      kArchiveAlignment;
+  if (archive_offset > bytes.size()) {
+    Corrupt("size does not match header");
+  }
+
+  const char* cursor = bytes.data() + sizeof(ParseCacheHeader);
+  records.tokens = reinterpret_cast<const ParseCacheToken*>(cursor);
+  cursor += size_t{header.token_count} * sizeof(ParseCacheToken);
+  records.diagnostics = reinterpret_cast<const ParseCacheDiagnostic*>(cursor);
+  cursor += size_t{header.diagnostic_count} * sizeof(ParseCacheDiagnostic);
+  records.strings = std::string_view(cursor, header.strings_size);
+  records.archive_offset = static_cast<size_t>(archive_offset);
+
+  // Kinds index `kTokenKindNames`. A source has no more code points than
+  // bytes, so no span can end beyond its size.
+  for (const ParseCacheToken& token :
+       std::span(records.tokens, header.token_count)) {
+    if (token.kind >= kTokenKindCount) {
+      Corrupt("token kind out of range");
+    }
+    if (token.start > token.end || token.end > source_size ||
+        !InStrings(records.strings, token.text_offset, token.text_size)) {
+      Corrupt("token out of range");
+    }
+  }
+  for (const ParseCacheDiagnostic& diagnostic :
+       std::span(records.diagnostics, header.diagnostic_count)) {
+    if (diagnostic.start > diagnostic.end || diagnostic.end > source_size) {
+      Corrupt("diagnostic out of range");
+    }
+    if (diagnostic.message >= kDiagnosticMessages.size()) {
+      Corrupt("unknown diagnostic message");
+    }
+  }
+  return records;
+}
+
+template <typename T>
+void AppendRecords(std::string& out, const std::vector<T>& records) {
+  out.append(reinterpret_cast<const char*>(records.data()),
+             records.size() * sizeof(T));
+}
+
+uint32_t CheckedSize(const size_t size) {
+  if (size > UINT32_MAX) {
+    throw std::length_error("source is too large to cache");
+  }
+  return static_cast<uint32_t>(size);
+}
+
+std::string Serialize(const uint64_t key, const uint64_t source_size,
+                      const std::span<const Token> tokens,
+                      const GreenNode& root,
+                      const std::span<const Diagnostic> diagnostics) {
+  std::string strings;
+  std::unordered_map<uint32_t, uint32_t> text_offsets;
+  std::vector<ParseCacheToken> token_records;
+  token_records.reserve(tokens.size());
+  for (const Token& token : tokens) {
+    auto [text, inserted] = text_offsets.try_emplace(
+        token.Symbol().Id(), CheckedSize(strings.size()));
+    if (inserted) {
+      strings.append(token.Text());
+    }
+    token_records.push_back(
+        {token.GetKind<uint16_t>(), 0,
+         token.Span().Start().Raw(), token.Span().End().Raw(), text->second,
+         CheckedSize(token.Text().size())});
+  }
+
+  std::vector<ParseCacheDiagnostic> diagnostic_records;
+  diagnostic_records.reserve(diagnostics.size());
+  for (const Diagnostic& diagnostic : diagnostics) {
+    const std::optional<uint32_t> message =
+        DiagnosticMessageIndex(diagnostic.message);
+    if (!message.has_value()) {
+      throw std::invalid_argument("diagnostic message is not in the table");
+    }
+    diagnostic_records.push_back({diagnostic.range.Start().Raw(),
+                                  diagnostic.range.End().Raw(), *message, 0});
+  }
+
+  ParseCacheHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kFrontEndVersion;
+  header.key = key;
+  header.source_size = source_size;
+  header.token_count = CheckedSize(token_records.size());
+  header.diagnostic_count = CheckedSize(diagnostic_records.size());
+  header.strings_size = CheckedSize(strings.size());
+
+  std::string out;
+  out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  AppendRecords(out, token_records);
+  AppendRecords(out, diagnostic_records);
+  out.append(strings);
+  out.resize((out.size() + kArchiveAlignment - 1) / kArchiveAlignment *
+             kArchiveAlignment);
+  out.append(SerializeGreenTree(root, key));
+  return out;
+}
+
+// A name no other writer will pick, so concurrent stores of one entry never
+// write to the same temporary file.
+std::filesystem::path TemporaryPath(const std::filesystem::path& path) {
+  thread_local std::mt19937_64 random(std::random_device{}());
+  std::ostringstream suffix;
+  suffix << ".tmp-" << std::hex << random();
+  return path.string() + suffix.str();
+}
+}  // namespace
+
+ParseCache::ParseCache(std::filesystem::path directory,
+                       const uint64_t max_bytes)
+    : directory_(std::move(directory)), max_bytes_(max_bytes) {
+  std::filesystem::create_directories(directory_);
+}
+
+uint64_t ParseCache::Key(const std::string_view source) noexcept {
+  // Seeding with the versions and the fingerprints of both kind lists and of
+  // the messages keeps a front end from reading results it would not have
+  // produced.
+  static const uint64_t seed = [] {
+    uint64_t messages = kDiagnosticMessages.size();
+    for (const std::string_view message : kDiagnosticMessages) {
+      messages = HashBytes(message.data(), message.size(), messages);
+    }
+    const uint64_t versions[] = {kFrontEndVersion, kGreenArchiveVersion,
+                                 kSyntaxKindCount, kSyntaxKindHash,
+                                 kTokenKindCount,  kTokenKindHash,
+                                 messages};
+    return HashBytes(versions, sizeof(versions));
+  }();
+  return HashBytes(source.data(), source.size(), seed);
+}
+
+std::filesystem::path ParseCache::EntryPath(const uint64_t key) const {
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << key
+       << kEntryExtension;
+  return directory_ / name.str();
+}
+
+std::optional<CachedParse> ParseCache::Load(const uint64_t key,
+                                            const uint64_t source_size) {
+  if constexpr (std::endian::native != std::endian::little) {
+    ++misses_;
+    return std::nullopt;
+  }
+
+  const std::filesystem::path path = EntryPath(key);
+  try {
+    MappedFile file = MappedFile::Open(path);
+    const EntryRecords records = Validate(file.Bytes(), key, source_size);
+
+    Interner& interner = Interner::Global();
+    std::vector<Token> tokens;
+    tokens.reserve(records.header->token_count);
+    for (const ParseCacheToken& token :
+         std::span(records.tokens, records.header->token_count)) {
+      tokens.emplace_back(token.kind,
+                          TextRange(TextSize(token.start), TextSize(token.end)),
+                          interner.Intern(records.strings.substr(
+                              token.text_offset, token.text_size)));
+    }
+
+    std::vector<Diagnostic> diagnostics;
+    diagnostics.reserve(records.header->diagnostic_count);
+    for (const ParseCacheDiagnostic& diagnostic :
+         std::span(records.diagnostics, records.header->diagnostic_count)) {
+      diagnostics.push_back({TextRange(TextSize(diagnostic.start),
+                                       TextSize(diagnostic.end)),
+                             kDiagnosticMessages[diagnostic.message]});
+    }
+
+    const size_t archive_offset = records.archive_offset;
+    GreenNode root =
+        GreenArchive::FromMappedFile(std::move(file), archive_offset)
+            .Materialize();
+
+    // Reading counts as a use, so `Trim` keeps the entry.
+    std::error_code error;
+    std::filesystem::last_write_time(
+        path, std::filesystem::file_time_type::clock::now(), error);
+
+    ++hits_;
+    return CachedParse{std::move(tokens), std::move(root),
+                       std::move(diagnostics)};
+  } catch (const std::invalid_argument&) {
+    // A damaged or colliding entry is replaced by the next `Store`.
+    std::error_code error;
+    std::filesystem::remove(path, error);
+  } catch (const std::system_error&) {
+    // Most often the entry does not exist.
+  } catch (const std::exception&) {
+    // Anything else, such as a full interner shard, is left to the parse the
+    // miss leads to, which reports it if it recurs there.
+  }
+  ++misses_;
+  return std::nullopt;
+}
+
+bool ParseCache::Store(const uint64_t key, const uint64_t source_size,
+                       const std::span<const Token> tokens,
+                       const GreenNode& root,
+                       const std::span<const Diagnostic> diagnostics) {
+  const std::filesystem::path path = EntryPath(key);
+  const std::filesystem::path temporary = TemporaryPath(path);
+  try {
+    const std::string bytes =
+        Serialize(key, source_size, tokens, root, diagnostics);
+    {
+      std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+      stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+      if (!stream.flush()) {
+        throw std::system_error(std::make_error_code(std::errc::io_error),
+                                temporary.string());
+      }
+    }
+    std::filesystem::rename(temporary, path);
+  } catch (const std::exception&) {
+    std::error_code error;
+    std::filesystem::remove(temporary, error);
+    return false;
+  }
+  ++stores_;
+  return true;
+}
+
+void ParseCache::Trim() {
+  struct EntryFile {
+    std::filesystem::path path;
+    uintmax_t size;
+    std::filesystem::file_time_type used;
+  };
+
+  std::vector<EntryFile> entries;
+  uint64_t total = 0;
+  std::error_code error;
+  for (const std::filesystem::directory_entry& entry :
+       std::filesystem::directory_iterator(directory_, error)) {
+    std::error_code entry_error;
+    if (!entry.is_regular_file(entry_error) ||
+        entry.path().extension() != kEntryExtension) {
+      continue;
+    }
+    const uintmax_t size = entry.file_size(entry_error);
+    const std::filesystem::file_time_type used =
+        entry.last_write_time(entry_error);
+    if (!entry_error) {
+      entries.push_back({entry.path(), size, used});
+      total += size;
+    }
+  }
+  if (total <= max_bytes_) {
+    return;
+  }
+
+  std::ranges::sort(entries, {}, &EntryFile::used);
+  for (const EntryFile& entry : entries) {
+    if (total <= max_bytes_) {
+      break;
+    }
+    if (std::filesystem::remove(entry.path, error)) {
+      ++evictions_;
+    }
+    total -= entry.size;
+  }
+}
+
+ParseCacheStats ParseCache::Stats() const noexcept {
+  return {hits_.load(), misses_.load(), stores_.load(), evictions_.load()};
+}
+}  // namespace orion::syntax
@@ -0,0 +1,218 @@
+#ifndef SYNTAX_DRIVER_PARSE_CACHE_H_
+#define SYNTAX_DRIVER_PARSE_CACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "syntax/lexer/token.h"
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/text/diagnostic.h"
+
+// Layout of a parse cache entry. All fields are little-endian:
+//
+//   ParseCacheHeader
+//   ParseCacheToken[token_count]
+//   ParseCacheDiagnostic[diagnostic_count]
+//   char strings[strings_size]            (token text)
+//   padding to a multiple of eight
+//   green archive                         (see green_archive.h)
+namespace orion::syntax {
+
+/**
+ * @brief The front end's version, part of every cache key.
+ *
+ * Bump it whenever the lexer or parser changes what it produces for the same
+ * source, so entries written by an older build are never read.
+ */
+inline constexpr uint32_t kFrontEndVersion = 2;
+
+/**
+ * @brief The fixed-size header at the start of every cache entry.
+ */
+struct ParseCacheHeader {
+  /** Always `"OPCE"`. */
+  char magic[4];
+
+  /** The front end that wrote the entry, `kFrontEndVersion`. */
+  uint32_t version;
+
+  /** The key the entry is stored under. */
+  uint64_t key;
+
+  /** The size of the source, checked as a guard against key collisions. */
+  uint64_t source_size;
+
+  /** Number of tokens. */
+  uint32_t token_count;
+
+  /** Number of diagnostics. */
+  uint32_t diagnostic_count;
+
+  /** Number of bytes of token text. */
+  uint32_t strings_size;
+
+  /** Reserved, always zero. */
+  uint32_t reserved;
+};
+
+/**
+ * @brief A token record in a cache entry.
+ */
+struct ParseCacheToken {
+  /** The `TokenKind`. */
+  uint16_t kind;
+
+  /** Reserved, always zero. */
+  uint16_t reserved;
+
+  /** The token's span in the source. */
+  uint32_t start;
+  uint32_t end;
+
+  /** The token's text in the strings section. */
+  uint32_t text_offset;
+  uint32_t text_size;
+};
+
+/**
+ * @brief A diagnostic record in a cache entry.
+ */
+struct ParseCacheDiagnostic {
+  /** The range the diagnostic covers. */
+  uint32_t start;
+  uint32_t end;
+
+  /** The index of the message in `kDiagnosticMessages`. */
+  uint32_t message;
+
+  /** Reserved, always zero. */
+  uint32_t reserved;
+};
+
+/**
+ * @brief What the front end produced for one source, as read back from the
+ * cache.
+ */
+struct CachedParse {
+  std::vector<Token> tokens;
+  GreenNode root;
+
+  /** The lexer's and parser's diagnostics, merged. */
+  std::vector<Diagnostic> diagnostics;
+};
+
+/**
+ * @brief Counters describing how effective a `ParseCache` has been.
+ */
+struct ParseCacheStats {
+  /** Sources found in the cache. */
+  uint64_t hits = 0;
+
+  /** Sources that were not, including unreadable or corrupt entries. */
+  uint64_t misses = 0;
+
+  /** Entries written. */
+  uint64_t stores = 0;
+
+  /** Entries removed by `Trim`. */
+  uint64_t evictions = 0;
+};
+
+/**
+ * @brief A directory of front-end results keyed by a hash of the source.
+ *
+ * A source's key is a hash of its bytes seeded with `kFrontEndVersion` and
+ * fingerprints of the syntax and token kinds (`kSyntaxKindHash`,
+ * `kTokenKindHash`), so byte-identical files share one entry wherever they
+ * live and a new front end never reads an old one's results. An entry holds the
+ * tokens, diagnostics and green tree, and is read back through a memory
+ * mapping.
+ *
+ * Entries are written to a temporary file and renamed into place, so
+ * concurrent builds sharing a directory only ever see whole entries. Reading
+ * an entry refreshes its modification time, and `Trim` removes the least
+ * recently used entries once the directory outgrows its cap.
+ *
+ * The cache is only an accelerator: entries that cannot be read or written
+ * count as misses and are never reported as errors. `Load` and `Store` may
+ * be called from several threads at once.
+ */
+class ParseCache {
+ public:
+  /**
+   * @brief Opens a cache directory, creating it if needed.
+   *
+   * @param directory The directory holding the entries.
+   * @param max_bytes The size `Trim` keeps the entries within.
+   * @throws std::filesystem::filesystem_error If the directory cannot be
+   * created.
+   */
+  ParseCache(std::filesystem::path directory, uint64_t max_bytes);
+
+  /** Deleted copy and move constructors and assignment operators. */
+  ParseCache(const ParseCache&) = delete;
+  ParseCache(ParseCache&&) = delete;
+  ParseCache& operator=(const ParseCache&) = delete;
+  ParseCache& operator=(ParseCache&&) = delete;
+
+  /**
+   * @brief Returns the key of a source.
+   *
+   * @param source The source's UTF-8 bytes.
+   */
+  [[nodiscard]] static uint64_t Key(std::string_view source) noexcept;
+
+  /**
+   * @brief Reads the entry for a source.
+   *
+   * @param key The source's `Key`.
+   * @param source_size The size of the source in bytes.
+   * @return The cached results, or nothing on a miss.
+   */
+  [[nodiscard]] std::optional<CachedParse> Load(uint64_t key,
+                                                uint64_t source_size);
+
+  /**
+   * @brief Writes the entry for a source, replacing any existing one.
+   *
+   * @return Whether the entry was written.
+   */
+  bool Store(uint64_t key, uint64_t source_size, std::span<const Token> tokens,
+             const GreenNode& root, std::span<const Diagnostic> diagnostics);
+
+  /**
+   * @brief Removes the least recently used entries until the rest fit within
+   * the cap.
+   */
+  void Trim();
+
+  /**
+   * @brief Returns the counters since the cache was opened.
+   */
+  [[nodiscard]] ParseCacheStats Stats() const noexcept;
+
+  /**
+   * @brief Returns the file an entry is stored in.
+   */
+  [[nodiscard]] std::filesystem::path EntryPath(uint64_t key) const;
+
+ private:
+  std::filesystem::path directory_;
+  uint64_t max_bytes_;
+
+  std::atomic<uint64_t> hits_ = 0;
+  std::atomic<uint64_t> misses_ = 0;
+  std::atomic<uint64_t> stores_ = 0;
+  std::atomic<uint64_t> evictions_ = 0;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_DRIVER_PARSE_CACHE_H_
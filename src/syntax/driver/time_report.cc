@@ -0,0 +1,196 @@
+#include "syntax/driver/time_report.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "syntax/driver/parse_cache.h"
+#include "syntax/parser/rgtree/green/green_cache.h"
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace orion::syntax {
+namespace {
+constexpr double kMebibyte = 1024.0 * 1024.0;
+
+double PerSecond(const uint64_t count, const double seconds) noexcept {
+  return seconds > 0 ? static_cast<double>(count) / seconds : 0;
+}
+
+double Ratio(const uint64_t part, const uint64_t whole) noexcept {
+  return whole > 0 ? static_cast<double>(part) / static_cast<double>(whole)
+                   : 0;
+}
+
+std::string_view PolicyName(const NodeCachePolicy policy) noexcept {
+  return policy == NodeCachePolicy::kAdaptive ? "adaptive" : "fixed";
+}
+
+// A rate column, or `-` for a phase that never sees the unit.
+void WriteRate(std::ostream& out, const int width, const uint64_t count,
+               const double seconds, const double scale) {
+  out << std::setw(width);
+  if (count == 0) {
+    out << "-";
+  } else {
+    out << PerSecond(count, seconds) / scale;
+  }
+}
+
+void WriteTextRow(std::ostream& out, const std::string_view name,
+                  const PhaseTiming& timing) {
+  out << std::left << std::setw(8) << name << std::right << std::setw(12)
+      << timing.wall_seconds * 1000 << std::setw(12)
+      << timing.cpu_seconds * 1000;
+  WriteRate(out, 12, timing.bytes, timing.wall_seconds, kMebibyte);
+  WriteRate(out, 16, timing.tokens, timing.wall_seconds, 1);
+  WriteRate(out, 16, timing.nodes, timing.wall_seconds, 1);
+  out << '\n';
+}
+
+// The phases added together: times are summed, and counts are the largest
+// any phase saw, since every phase goes over the same files.
+PhaseTiming Total(const TimeReport& report) {
+  PhaseTiming total;
+  for (const PhaseTiming& timing : report.phases) {
+    total.wall_seconds += timing.wall_seconds;
+    total.cpu_seconds += timing.cpu_seconds;
+    total.bytes = std::max(total.bytes, timing.bytes);
+    total.tokens = std::max(total.tokens, timing.tokens);
+    total.nodes = std::max(total.nodes, timing.nodes);
+  }
+  return total;
+}
+
+void WriteJsonTiming(std::ostream& out, const PhaseTiming& timing) {
+  out << "\"wall_seconds\":" << timing.wall_seconds
+      << ",\"cpu_seconds\":" << timing.cpu_seconds
+      << ",\"bytes\":" << timing.bytes << ",\"tokens\":" << timing.tokens
+      << ",\"nodes\":" << timing.nodes << ",\"bytes_per_second\":"
+      << PerSecond(timing.bytes, timing.wall_seconds)
+      << ",\"tokens_per_second\":"
+      << PerSecond(timing.tokens, timing.wall_seconds)
+      << ",\"nodes_per_second\":"
+      << PerSecond(timing.nodes, timing.wall_seconds);
+}
+}  // namespace
+
+std::string_view PhaseName(const Phase phase) noexcept {
+  switch (phase) {
+    case Phase::kRead:
+      return "read";
+    case Phase::kLex:
+      return "lex";
+    case Phase::kParse:
+      return "parse";
+    case Phase::kBuild:
+      return "build";
+  }
+  return "unknown";
+}
+
+#if defined(_WIN32)
+double ProcessCpuSeconds() noexcept {
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+uint64_t PeakRssBytes() noexcept { return 0; }
+#else
+double ProcessCpuSeconds() noexcept {
+  rusage usage{};
+  ::getrusage(RUSAGE_SELF, &usage);
+  const auto seconds = [](const timeval& time) {
+    return static_cast<double>(time.tv_sec) +
+           static_cast<double>(time.tv_usec) / 1e6;
+  };
+  return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+uint64_t PeakRssBytes() noexcept {
+  rusage usage{};
+  ::getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  // Linux reports kibibytes.
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+#endif
+
+std::string FormatTimeReport(const TimeReport& report) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  out << std::left << std::setw(8) << "phase" << std::right << std::setw(12)
+      << "wall ms" << std::setw(12) << "cpu ms" << std::setw(12) << "MiB/s"
+      << std::setw(16) << "tokens/s" << std::setw(16) << "nodes/s" << '\n';
+  for (const PhaseTiming& timing : report.phases) {
+    WriteTextRow(out, PhaseName(timing.phase), timing);
+  }
+  WriteTextRow(out, "total", Total(report));
+
+  const GreenCacheStats& cache = report.cache;
+  out << std::setprecision(1) << '\n'
+      << "peak RSS          " << static_cast<double>(report.peak_rss_bytes) /
+                                     kMebibyte
+      << " MiB\n"
+      << "node cache policy " << PolicyName(report.node_cache_policy) << '\n'
+      << "node cache hits   " << cache.node_hits << " / " << cache.node_lookups
+      << " (" << Ratio(cache.node_hits, cache.node_lookups) * 100 << "%)\n"
+      << "token cache hits  " << cache.token_hits << " / "
+      << cache.token_lookups << " ("
+      << Ratio(cache.token_hits, cache.token_lookups) * 100 << "%)\n";
+
+  const ParseCacheStats& parse_cache = report.parse_cache;
+  const uint64_t lookups = parse_cache.hits + parse_cache.misses;
+  if (lookups > 0) {
+    out << "parse cache hits  " << parse_cache.hits << " / " << lookups
+        << " (" << Ratio(parse_cache.hits, lookups) * 100 << "%), "
+        << parse_cache.stores << " stored, " << parse_cache.evictions
+        << " evicted\n";
+  }
+  return out.str();
+}
+
+std::string FormatTimeReportJson(const TimeReport& report) {
+  std::ostringstream out;
+  out << std::setprecision(9);
+  out << "{\"phases\":[";
+  for (size_t i = 0; i < report.phases.size(); ++i) {
+    const PhaseTiming& timing = report.phases[i];
+    out << (i > 0 ? "," : "") << "{\"name\":\"" << PhaseName(timing.phase)
+        << "\",";
+    WriteJsonTiming(out, timing);
+    out << '}';
+  }
+  out << "],\"total\":{";
+  WriteJsonTiming(out, Total(report));
+
+  const GreenCacheStats& cache = report.cache;
+  out << "},\"peak_rss_bytes\":" << report.peak_rss_bytes
+      << ",\"green_cache\":{\"policy\":\""
+      << PolicyName(report.node_cache_policy)
+      << "\",\"node_lookups\":" << cache.node_lookups
+      << ",\"node_hits\":" << cache.node_hits
+      << ",\"node_skips\":" << cache.node_skips
+      << ",\"node_hit_rate\":" << Ratio(cache.node_hits, cache.node_lookups)
+      << ",\"token_lookups\":" << cache.token_lookups
+      << ",\"token_hits\":" << cache.token_hits
+      << ",\"token_hit_rate\":"
+      << Ratio(cache.token_hits, cache.token_lookups)
+      << ",\"bytes_saved\":" << cache.bytes_saved << '}';
+
+  const ParseCacheStats& parse_cache = report.parse_cache;
+  out << ",\"parse_cache\":{\"hits\":" << parse_cache.hits
+      << ",\"misses\":" << parse_cache.misses
+      << ",\"stores\":" << parse_cache.stores
+      << ",\"evictions\":" << parse_cache.evictions << "}}\n";
+  return out.str();
+}
+}  // namespace orion::syntax
@@ -0,0 +1,115 @@
+#ifndef SYNTAX_DRIVER_TIME_REPORT_H_
+#define SYNTAX_DRIVER_TIME_REPORT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "syntax/driver/parse_cache.h"
+#include "syntax/parser/rgtree/green/green_cache.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief The stages of the front end, in the order they run.
+ */
+enum class Phase : uint8_t {
+  /**
+   * Mapping a file and decoding it from UTF-8, or loading its results from
+   * the parse cache.
+   */
+  kRead,
+
+  /** Splitting the text into tokens. */
+  kLex,
+
+  /** Turning the tokens into tree events. */
+  kParse,
+
+  /** Building the green tree from the events. */
+  kBuild,
+};
+
+/** The number of `Phase`s. */
+inline constexpr size_t kPhaseCount = static_cast<size_t>(Phase::kBuild) + 1;
+
+/**
+ * @brief Returns the lowercase name of a phase, such as `lex`.
+ */
+[[nodiscard]] std::string_view PhaseName(Phase phase) noexcept;
+
+/**
+ * @brief How long one phase took over every file, and how much it did.
+ *
+ * Rates are taken over wall time, since the files of a phase run in
+ * parallel. CPU time is the whole process's, so it exceeds wall time when
+ * several threads are busy.
+ */
+struct PhaseTiming {
+  Phase phase = Phase::kRead;
+
+  /** Elapsed real time. */
+  double wall_seconds = 0;
+
+  /** User and system time of every thread in the process. */
+  double cpu_seconds = 0;
+
+  /** Source bytes the phase went through. */
+  uint64_t bytes = 0;
+
+  /** Tokens the phase produced or consumed, or zero if it saw none. */
+  uint64_t tokens = 0;
+
+  /** Tree nodes the phase produced, or zero if it made none. */
+  uint64_t nodes = 0;
+};
+
+/**
+ * @brief The measurements of one front-end run, ready to print.
+ */
+struct TimeReport {
+  /** The phases that ran, in order. */
+  std::vector<PhaseTiming> phases;
+
+  /** The most memory the process has had resident, or zero if unknown. */
+  uint64_t peak_rss_bytes = 0;
+
+  /** The counters of every green cache the run built with, summed. */
+  GreenCacheStats cache;
+
+  /** How those caches decided which nodes to deduplicate. */
+  NodeCachePolicy node_cache_policy = NodeCachePolicy::kFixed;
+
+  /** The counters of the parse cache, all zero if the run used none. */
+  ParseCacheStats parse_cache;
+};
+
+/**
+ * @brief Returns the CPU time the process has used so far, in seconds.
+ */
+[[nodiscard]] double ProcessCpuSeconds() noexcept;
+
+/**
+ * @brief Returns the peak resident set size of the process, or zero if the
+ * platform does not report it.
+ */
+[[nodiscard]] uint64_t PeakRssBytes() noexcept;
+
+/**
+ * @brief Formats a report as an aligned table for people to read.
+ */
+[[nodiscard]] std::string FormatTimeReport(const TimeReport& report);
+
+/**
+ * @brief Formats a report as one JSON object, for tools and tickets.
+ *
+ * Every phase lists its raw counts next to the rates derived from them, so
+ * reports can be compared without recomputing.
+ */
+[[nodiscard]] std::string FormatTimeReportJson(const TimeReport& report);
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_DRIVER_TIME_REPORT_H_
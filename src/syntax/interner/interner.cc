@@ -0,0 +1,246 @@
+#include "syntax/interner/interner.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "syntax/interner/symbol.h"
+#include "syntax/util/flat_hash_table.h"
+#include "syntax/util/hash.h"
+#include "syntax/util/utf8.h"
+
+// https://matklad.github.io/2020/03/22/fast-simple-rust-interner.html
+namespace orion::syntax {
+namespace {
+/** Number of entries in the first entry chunk; each later chunk doubles. */
+constexpr size_t kFirstChunkSize = 256;
+
+/** Number of entry chunks per shard. */
+constexpr size_t kMaxChunks = 24;
+
+/** Size of a text arena block. Longer strings get a block of their own. */
+constexpr size_t kBlockSize = 64 * 1024;
+
+/** Returns the chunk holding `index` and the index within that chunk. */
+constexpr std::pair<size_t, size_t> ChunkOf(const size_t index) noexcept {
+  const size_t chunk = std::bit_width(index / kFirstChunkSize + 1) - 1;
+  const size_t chunk_start = kFirstChunkSize * ((size_t{1} << chunk) - 1);
+  return {chunk, index - chunk_start};
+}
+}  // namespace
+
+struct Interner::Shard {
+  ~Shard() { Clear(); }
+
+  /** Drops every entry and the text behind them. */
+  void Clear() noexcept {
+    for (std::atomic<Entry*>& chunk : chunks) {
+      delete[] chunk.exchange(nullptr, std::memory_order_relaxed);
+    }
+    table.Clear();
+    count.store(0, std::memory_order_relaxed);
+    bytes.store(0, std::memory_order_relaxed);
+    blocks.clear();
+    cursor = nullptr;
+    remaining = 0;
+  }
+
+  /** Returns the entry at `index`, which must already be published. */
+  [[nodiscard]] const Entry& At(const size_t index) const noexcept {
+    const auto [chunk, offset] = ChunkOf(index);
+    return chunks[chunk].load(std::memory_order_acquire)[offset];
+  }
+
+  /** Copies `text` into the arena. Must be called with `mutex` held. */
+  const char* Store(const std::string_view text) {
+    if (text.size() > remaining) {
+      const size_t size = std::max(kBlockSize, text.size());
+      blocks.push_back(std::make_unique<char[]>(size));
+      cursor = blocks.back().get();
+      remaining = size;
+    }
+
+    char* data = cursor;
+    std::memcpy(data, text.data(), text.size());
+    cursor += text.size();
+    remaining -= text.size();
+    bytes.fetch_add(text.size(), std::memory_order_relaxed);
+
+    return data;
+  }
+
+  /** Appends an entry and returns its index. Must be called with `mutex`
+   * held. */
+  size_t Append(const Entry& entry) {
+    const size_t index = count.load(std::memory_order_relaxed);
+    const auto [chunk, offset] = ChunkOf(index);
+    if (index >= kMaxEntries) {
+      throw std::length_error("interner shard is full");
+    }
+
+    Entry* entries = chunks[chunk].load(std::memory_order_relaxed);
+    if (entries == nullptr) {
+      entries = new Entry[kFirstChunkSize << chunk];
+      chunks[chunk].store(entries, std::memory_order_release);
+    }
+
+    entries[offset] = entry;
+    count.store(index + 1, std::memory_order_release);
+
+    return index;
+  }
+
+  /** Entries a symbol can address: `index + 1` must fit above the shard
+   * bits. */
+  static constexpr size_t kMaxEntries = (size_t{1} << (32 - kShardBits)) - 1;
+  static_assert(ChunkOf(kMaxEntries - 1).first < kMaxChunks);
+
+  /** Guards insertion into this shard. */
+  std::mutex mutex;
+
+  /** Maps text to entry indices. */
+  FlatHashTable<uint32_t> table;
+
+  /** Entry storage; chunk `k` holds `kFirstChunkSize << k` entries. */
+  std::array<std::atomic<Entry*>, kMaxChunks> chunks{};
+
+  /** Number of entries. */
+  std::atomic<size_t> count{0};
+
+  /** Number of text bytes stored. */
+  std::atomic<size_t> bytes{0};
+
+  /** Arena blocks holding the text. */
+  std::vector<std::unique_ptr<char[]>> blocks;
+
+  /** Next free byte in the current block. */
+  char* cursor = nullptr;
+
+  /** Free bytes left in the current block. */
+  size_t remaining = 0;
+};
+
+Interner::Interner() {
+  for (std::unique_ptr<Shard>& shard : shards_) {
+    shard = std::make_unique<Shard>();
+  }
+}
+
+Interner::~Interner() = default;
+
+Interner& Interner::Global() {
+  // Intentionally leaked so that symbols stay resolvable from other static
+  // destructors and detached threads during shutdown.
+  static Interner* const interner = new Interner();
+  return *interner;
+}
+
+Symbol Interner::Intern(const std::string_view text) {
+  if (text.empty()) {
+    return Symbol();
+  }
+
+  const uint64_t hash = HashBytes(text.data(), text.size());
+  const size_t shard_index = hash >> (64 - kShardBits);
+  Shard& shard = *shards_[shard_index];
+
+  const std::lock_guard lock(shard.mutex);
+
+  const auto matches = [&](const uint32_t index) {
+    const Entry& entry = shard.At(index);
+    return entry.size == text.size() &&
+           std::memcmp(entry.data, text.data(), text.size()) == 0;
+  };
+
+  const auto [index, _] = shard.table.FindOrInsert(hash, matches, [&] {
+    // Checked before storing the text so a full shard leaves nothing behind.
+    if (shard.count.load(std::memory_order_relaxed) >= Shard::kMaxEntries) {
+      throw std::length_error("interner shard is full");
+    }
+    const Entry entry = {shard.Store(text), static_cast<uint32_t>(text.size()),
+                         static_cast<uint32_t>(CountCodepoints(text)), hash};
+    return static_cast<uint32_t>(shard.Append(entry));
+  });
+
+  // Index zero of shard zero would collide with the empty symbol, so indices
+  // are stored off by one.
+  return Symbol(static_cast<uint32_t>((*index + 1) << kShardBits) |
+                static_cast<uint32_t>(shard_index));
+}
+
+Symbol Interner::Intern(const std::u32string_view text) {
+  thread_local std::string scratch;
+
+  scratch.clear();
+  for (const char32_t ch : text) {
+    AppendUtf8(scratch, ch);
+  }
+
+  return Intern(std::string_view(scratch));
+}
+
+const Interner::Entry& Interner::Lookup(const Symbol symbol) const noexcept {
+  const Shard& shard = *shards_[symbol.Id() & (kShardCount - 1)];
+  return shard.At((symbol.Id() >> kShardBits) - 1);
+}
+
+std::string_view Interner::Resolve(const Symbol symbol) const noexcept {
+  if (symbol.IsEmpty()) {
+    return {};
+  }
+
+  const Entry& entry = Lookup(symbol);
+  return {entry.data, entry.size};
+}
+
+uint32_t Interner::Width(const Symbol symbol) const noexcept {
+  return symbol.IsEmpty() ? 0 : Lookup(symbol).width;
+}
+
+uint64_t Interner::Hash(const Symbol symbol) const noexcept {
+  return symbol.IsEmpty() ? HashBytes("", 0) : Lookup(symbol).hash;
+}
+
+Interner::Owner::Owner(Interner& interner) : interner_(interner) {
+  if (interner_.owned_.exchange(true, std::memory_order_acq_rel)) {
+    throw std::logic_error("interner already has an owner");
+  }
+}
+
+Interner::Owner::~Owner() {
+  interner_.owned_.store(false, std::memory_order_release);
+}
+
+void Interner::Owner::Clear() noexcept { interner_.Clear(); }
+
+void Interner::Clear() noexcept {
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    shard->Clear();
+  }
+}
+
+size_t Interner::Size() const noexcept {
+  size_t size = 0;
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    size += shard->count.load(std::memory_order_relaxed);
+  }
+  return size;
+}
+
+size_t Interner::Bytes() const noexcept {
+  size_t bytes = 0;
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    bytes += shard->bytes.load(std::memory_order_relaxed);
+  }
+  return bytes;
+}
+}  // namespace orion::syntax
@@ -0,0 +1,208 @@
+#ifndef SYNTAX_INTERNER_INTERNER_H_
+#define SYNTAX_INTERNER_INTERNER_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "syntax/interner/symbol.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief Stores each distinct string once and hands out `Symbol`s for it.
+ *
+ * Text is stored as UTF-8 in arena blocks that are never moved, so the views
+ * returned by `Resolve` stay valid for the lifetime of the interner. The hash
+ * and code point width of every string are computed once, when it is first
+ * interned.
+ *
+ * The interner is split into independently locked shards selected by hash, so
+ * it can be shared by lexers running on different threads. Resolving a symbol
+ * never takes a lock.
+ *
+ * Releasing the text invalidates every symbol, so it is reserved to an
+ * `Owner`: at most one exists per interner at a time, and code that keeps
+ * symbols of its own in the global interner refuses to run while it is owned.
+ */
+class Interner {
+ public:
+  /**
+   * @brief Exclusive ownership of an interner, which is needed to clear it.
+   */
+  class Owner {
+   public:
+    /**
+     * @brief Takes ownership of `interner`, which must outlive the owner.
+     *
+     * @throws std::logic_error If `interner` already has an owner.
+     */
+    explicit Owner(Interner& interner);
+
+    /**
+     * @brief Gives up ownership.
+     */
+    ~Owner();
+
+    /** Deleted copy and move constructors and assignment operators. */
+    Owner(const Owner&) = delete;
+    Owner(Owner&&) = delete;
+    Owner& operator=(const Owner&) = delete;
+    Owner& operator=(Owner&&) = delete;
+
+    /**
+     * @brief Forgets every interned string and releases its storage.
+     *
+     * Every symbol created so far becomes invalid, so the owner must have
+     * dropped them all, including those held by tokens and green trees. Must
+     * not run concurrently with any other call on the interner.
+     */
+    void Clear() noexcept;
+
+   private:
+    Interner& interner_;
+  };
+
+  /**
+   * @brief Constructs an empty interner.
+   */
+  Interner();
+
+  /**
+   * @brief Releases every interned string.
+   */
+  ~Interner();
+
+  /**
+   * @brief Deleted copy and move constructors.
+   *
+   * Symbols are only meaningful relative to the interner that created them.
+   */
+  Interner(const Interner&) = delete;
+  Interner(Interner&&) = delete;
+  Interner& operator=(const Interner&) = delete;
+  Interner& operator=(Interner&&) = delete;
+
+  /**
+   * @brief Returns the process-wide interner.
+   *
+   * Tokens produced by the lexer and the green tree carry symbols from this
+   * interner.
+   *
+   * @return A reference to the global `Interner`.
+   */
+  [[nodiscard]] static Interner& Global();
+
+  /**
+   * @brief Interns UTF-8 text.
+   *
+   * @param text The text to intern.
+   * @return The symbol for `text`.
+   * @throws std::length_error If the shard `text` hashes to has no free
+   * symbol ids left.
+   */
+  [[nodiscard]] Symbol Intern(std::string_view text);
+
+  /**
+   * @brief Interns UTF-32 text, storing it as UTF-8.
+   *
+   * @param text The text to intern.
+   * @return The symbol for `text`.
+   * @throws std::length_error As for the UTF-8 overload.
+   */
+  [[nodiscard]] Symbol Intern(std::u32string_view text);
+
+  /**
+   * @brief Returns the UTF-8 text of a symbol.
+   *
+   * @param symbol A symbol created by this interner.
+   * @return A view of the interned text.
+   */
+  [[nodiscard]] std::string_view Resolve(Symbol symbol) const noexcept;
+
+  /**
+   * @brief Returns the number of code points in a symbol's text.
+   *
+   * @param symbol A symbol created by this interner.
+   * @return The code point count of the interned text.
+   */
+  [[nodiscard]] uint32_t Width(Symbol symbol) const noexcept;
+
+  /**
+   * @brief Returns the hash computed when a symbol was interned.
+   *
+   * @param symbol A symbol created by this interner.
+   * @return The 64-bit hash of the interned text.
+   */
+  [[nodiscard]] uint64_t Hash(Symbol symbol) const noexcept;
+
+  /**
+   * @brief Returns whether an `Owner` currently holds the interner.
+   */
+  [[nodiscard]] bool Owned() const noexcept {
+    return owned_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Returns the number of distinct non-empty strings interned.
+   *
+   * @return The number of symbols.
+   */
+  [[nodiscard]] size_t Size() const noexcept;
+
+  /**
+   * @brief Returns the number of text bytes stored.
+   *
+   * @return The total UTF-8 size of every interned string.
+   */
+  [[nodiscard]] size_t Bytes() const noexcept;
+
+ private:
+  /** Number of bits of a symbol identifying its shard. */
+  static constexpr uint32_t kShardBits = 4;
+
+  /** Number of independently locked shards. */
+  static constexpr size_t kShardCount = size_t{1} << kShardBits;
+
+  /**
+   * @brief Metadata for one interned string.
+   */
+  struct Entry {
+    /** Pointer to the UTF-8 bytes in the arena. */
+    const char* data;
+
+    /** Number of bytes. */
+    uint32_t size;
+
+    /** Number of code points. */
+    uint32_t width;
+
+    /** Hash of the bytes. */
+    uint64_t hash;
+  };
+
+  struct Shard;
+
+  /**
+   * @brief Returns the entry for a non-empty symbol.
+   */
+  [[nodiscard]] const Entry& Lookup(Symbol symbol) const noexcept;
+
+  /**
+   * @brief Drops every shard's entries and text. Reached through `Owner`.
+   */
+  void Clear() noexcept;
+
+  /** The shards, indexed by the low bits of a symbol. */
+  std::array<std::unique_ptr<Shard>, kShardCount> shards_;
+
+  /** Whether an `Owner` holds the interner. */
+  std::atomic<bool> owned_{false};
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_INTERNER_INTERNER_H_
@@ -0,0 +1,68 @@
+#ifndef SYNTAX_INTERNER_SYMBOL_H_
+#define SYNTAX_INTERNER_SYMBOL_H_
+
+#include <cstdint>
+#include <functional>
+
+namespace orion::syntax {
+
+/**
+ * @brief A 32-bit handle to a string stored in an `Interner`.
+ *
+ * Two symbols from the same interner are equal exactly when their text is
+ * equal, so comparing symbols is an integer comparison. A default-constructed
+ * `Symbol` refers to the empty string.
+ */
+class Symbol {
+ public:
+  /**
+   * @brief Constructs the symbol of the empty string.
+   */
+  constexpr Symbol() noexcept : id_(0) {}
+
+  /**
+   * @brief Constructs a symbol from its raw identifier.
+   *
+   * @param id The identifier previously returned by `Id()`.
+   */
+  constexpr explicit Symbol(const uint32_t id) noexcept : id_(id) {}
+
+  /**
+   * @brief Returns the raw identifier of the symbol.
+   *
+   * @return The 32-bit identifier.
+   */
+  [[nodiscard]] constexpr uint32_t Id() const noexcept { return id_; }
+
+  /**
+   * @brief Checks if the symbol refers to the empty string.
+   *
+   * @return `true` if the symbol is the empty string, otherwise `false`.
+   */
+  [[nodiscard]] constexpr bool IsEmpty() const noexcept { return id_ == 0; }
+
+  /**
+   * @brief Compares two symbols for equality.
+   *
+   * @param other The other `Symbol` to compare with.
+   * @return `true` if both symbols refer to the same text, otherwise `false`.
+   */
+  constexpr bool operator==(const Symbol& other) const noexcept {
+    return id_ == other.id_;
+  }
+
+ private:
+  /** The identifier of the interned string. */
+  uint32_t id_;
+};
+
+}  // namespace orion::syntax
+
+template <>
+struct std::hash<orion::syntax::Symbol> {
+  size_t operator()(const orion::syntax::Symbol& symbol) const noexcept {
+    return std::hash<uint32_t>{}(symbol.Id());
+  }
+};
+
+#endif  // SYNTAX_INTERNER_SYMBOL_H_
@@ -0,0 +1,93 @@
+#include "syntax/io/mapped_file.h"
+
+#include <cerrno>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace orion::syntax {
+#if defined(_WIN32)
+// Without POSIX mmap the file is read into a heap buffer instead.
+MappedFile MappedFile::Open(const std::filesystem::path& path) {
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream) {
+    throw std::system_error(std::make_error_code(std::errc::io_error),
+                            path.string());
+  }
+
+  const std::string contents((std::istreambuf_iterator<char>(stream)),
+                             std::istreambuf_iterator<char>());
+  char* data = contents.empty() ? nullptr : new char[contents.size()];
+  std::copy(contents.begin(), contents.end(), data);
+
+  return MappedFile(data, contents.size());
+}
+
+void MappedFile::Release() noexcept { delete[] data_; }
+#else
+MappedFile MappedFile::Open(const std::filesystem::path& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), path.string());
+  }
+
+  struct stat status{};
+  if (::fstat(fd, &status) != 0) {
+    const int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), path.string());
+  }
+
+  const auto size = static_cast<size_t>(status.st_size);
+  if (size == 0) {
+    ::close(fd);
+    return MappedFile(nullptr, 0);
+  }
+
+  void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  const int error = errno;
+
+  // The mapping keeps the file contents alive; the descriptor is not needed.
+  ::close(fd);
+
+  if (data == MAP_FAILED) {
+    throw std::system_error(error, std::generic_category(), path.string());
+  }
+
+  return MappedFile(static_cast<const char*>(data), size);
+}
+
+void MappedFile::Release() noexcept {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+}
+#endif
+
+MappedFile::~MappedFile() { Release(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+}  // namespace orion::syntax
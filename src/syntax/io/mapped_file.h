@@ -0,0 +1,82 @@
+#ifndef SYNTAX_IO_MAPPED_FILE_H_
+#define SYNTAX_IO_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace orion::syntax {
+
+/**
+ * @brief A read-only, memory-mapped view of a file.
+ *
+ * The mapping is released when the `MappedFile` is destroyed. Views returned
+ * by `Bytes()` must not outlive it.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Maps a file into memory.
+   *
+   * @param path The file to map.
+   * @return The mapped file.
+   * @throws std::system_error If the file cannot be opened or mapped.
+   */
+  [[nodiscard]] static MappedFile Open(const std::filesystem::path& path);
+
+  /**
+   * @brief Deleted default constructor.
+   *
+   * A `MappedFile` is only created by `Open`.
+   */
+  MappedFile() = delete;
+
+  /**
+   * @brief Releases the mapping.
+   */
+  ~MappedFile();
+
+  /** Deleted copy constructor and copy assignment. */
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /** Move constructor and move assignment, transferring the mapping. */
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /**
+   * @brief Returns the mapped bytes.
+   *
+   * @return A view of the whole file.
+   */
+  [[nodiscard]] std::string_view Bytes() const noexcept {
+    return {data_, size_};
+  }
+
+  /**
+   * @brief Returns the size of the file.
+   *
+   * @return The number of mapped bytes.
+   */
+  [[nodiscard]] size_t Size() const noexcept { return size_; }
+
+ private:
+  /**
+   * @brief Takes ownership of an existing mapping.
+   */
+  explicit MappedFile(const char* data, size_t size) noexcept
+      : data_(data), size_(size) {}
+
+  /** Releases the mapping, if any. */
+  void Release() noexcept;
+
+  /** The first mapped byte, or `nullptr` for an empty file. */
+  const char* data_;
+
+  /** The number of mapped bytes. */
+  size_t size_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_IO_MAPPED_FILE_H_
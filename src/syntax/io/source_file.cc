@@ -0,0 +1,46 @@
+#include "syntax/io/source_file.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "syntax/io/mapped_file.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+#include "syntax/util/utf8.h"
+
+namespace orion::syntax {
+SourceFile SourceFile::Open(const std::filesystem::path& path) {
+  return SourceFile(MappedFile::Open(path));
+}
+
+SourceFile::SourceFile(MappedFile file)
+    : file_(std::move(file)), has_bom_(file_.Bytes().starts_with(kBom)) {
+  const std::string_view text = Text();
+  if (const size_t invalid = ValidateUtf8(text); invalid != text.size()) {
+    invalid_offset_ = invalid;
+  }
+
+  // Finding one character is a `memchr`, which the C library vectorizes.
+  for (size_t cr = text.find('\r'); cr != std::string_view::npos;
+       cr = text.find('\r', cr + 1)) {
+    if (cr + 1 < text.size() && text[cr + 1] == '\n') {
+      crlf_offsets_.push_back(cr);
+    }
+  }
+}
+
+std::vector<Diagnostic> SourceFile::Diagnostics() const {
+  if (!invalid_offset_.has_value()) {
+    return {};
+  }
+  const size_t start = CountCodepoints(Text().substr(0, *invalid_offset_));
+  return {{TextRange::At(TextSize::Of(start), TextSize(1)), "invalid UTF-8"}};
+}
+
+std::u32string SourceFile::Decode() const { return DecodeUtf8(Text()); }
+}  // namespace orion::syntax
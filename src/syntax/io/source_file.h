@@ -0,0 +1,108 @@
+#ifndef SYNTAX_IO_SOURCE_FILE_H_
+#define SYNTAX_IO_SOURCE_FILE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "syntax/io/mapped_file.h"
+#include "syntax/text/diagnostic.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief A source file, mapped into memory and checked once on opening.
+ *
+ * Opening a file maps it, steps over a UTF-8 byte order mark, validates the
+ * rest as UTF-8 and records where its CRLF line breaks are. The bytes are
+ * never rewritten or copied: `Text()` views the mapping. The lexer takes a
+ * `\r\n` as one line break; a caller that wants LF-only line breaks accounts
+ * for `CrlfOffsets()` instead.
+ */
+class SourceFile {
+ public:
+  /**
+   * @brief Maps and checks a source file.
+   *
+   * @param path The file to open.
+   * @return The source file.
+   * @throws std::system_error If the file cannot be opened or mapped.
+   */
+  [[nodiscard]] static SourceFile Open(const std::filesystem::path& path);
+
+  /**
+   * @brief Deleted default constructor.
+   *
+   * A `SourceFile` is only created by `Open`.
+   */
+  SourceFile() = delete;
+
+  /**
+   * @brief Returns every byte of the file, including a byte order mark.
+   */
+  [[nodiscard]] std::string_view Bytes() const noexcept {
+    return file_.Bytes();
+  }
+
+  /**
+   * @brief Returns the text of the file, after any byte order mark.
+   */
+  [[nodiscard]] std::string_view Text() const noexcept {
+    return file_.Bytes().substr(HasBom() ? kBom.size() : 0);
+  }
+
+  /**
+   * @brief Returns whether the file starts with a UTF-8 byte order mark.
+   */
+  [[nodiscard]] bool HasBom() const noexcept { return has_bom_; }
+
+  /**
+   * @brief Returns the byte offset in `Text()` of the first malformed UTF-8
+   * sequence, or nothing if the text is valid.
+   */
+  [[nodiscard]] std::optional<size_t> InvalidUtf8Offset() const noexcept {
+    return invalid_offset_;
+  }
+
+  /**
+   * @brief Returns the byte offsets in `Text()` of the `\r` of every `\r\n`,
+   * in order.
+   */
+  [[nodiscard]] std::span<const size_t> CrlfOffsets() const noexcept {
+    return crlf_offsets_;
+  }
+
+  /**
+   * @brief Returns the problems found on opening, in source order.
+   *
+   * Malformed UTF-8 is reported once, at its first code point, with the
+   * range measured in code points like every other diagnostic.
+   */
+  [[nodiscard]] std::vector<Diagnostic> Diagnostics() const;
+
+  /**
+   * @brief Decodes the text for the lexer.
+   *
+   * Malformed sequences decode to U+FFFD.
+   */
+  [[nodiscard]] std::u32string Decode() const;
+
+  /** The UTF-8 encoding of U+FEFF. */
+  static constexpr std::string_view kBom = "\xEF\xBB\xBF";
+
+ private:
+  explicit SourceFile(MappedFile file);
+
+  MappedFile file_;
+  bool has_bom_;
+  std::optional<size_t> invalid_offset_;
+  std::vector<size_t> crlf_offsets_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_IO_SOURCE_FILE_H_
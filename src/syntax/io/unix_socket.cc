@@ -0,0 +1,216 @@
+#include "syntax/io/unix_socket.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace orion::syntax {
+#if defined(_WIN32)
+// Without Unix domain sockets there is no server to listen or connect to.
+namespace {
+[[noreturn]] void Unsupported(const std::string& what) {
+  throw std::system_error(
+      std::make_error_code(std::errc::function_not_supported), what);
+}
+}  // namespace
+
+UnixSocket UnixSocket::Listen(const std::filesystem::path& path) {
+  Unsupported(path.string());
+}
+
+UnixSocket UnixSocket::Connect(const std::filesystem::path& path) {
+  Unsupported(path.string());
+}
+
+UnixSocket UnixSocket::Accept() const { Unsupported("accept"); }
+
+void UnixSocket::SetTimeout(std::chrono::milliseconds) const {
+  Unsupported("timeout");
+}
+
+std::string UnixSocket::ReadAll(size_t) const { Unsupported("read"); }
+
+void UnixSocket::WriteAll(std::string_view) const { Unsupported("write"); }
+
+void UnixSocket::FinishWriting() const noexcept {}
+
+void UnixSocket::Release() noexcept {}
+#else
+namespace {
+[[noreturn]] void ThrowErrno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+sockaddr_un Address(const std::filesystem::path& path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  const std::string& name = path.native();
+  if (name.size() >= sizeof(address.sun_path)) {
+    throw std::system_error(
+        std::make_error_code(std::errc::filename_too_long), name);
+  }
+  std::memcpy(address.sun_path, name.c_str(), name.size() + 1);
+  return address;
+}
+
+// Not every platform has `SOCK_CLOEXEC` or `accept4`, so close-on-exec is
+// set apart.
+int CloseOnExec(const int fd) noexcept {
+  ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  return fd;
+}
+
+int OpenSocket() {
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    ThrowErrno("socket");
+  }
+  return CloseOnExec(fd);
+}
+
+// Returns whether a server answers at `path`.
+bool IsListening(const std::filesystem::path& path) {
+  try {
+    (void)UnixSocket::Connect(path);
+    return true;
+  } catch (const std::system_error&) {
+    return false;
+  }
+}
+}  // namespace
+
+UnixSocket UnixSocket::Listen(const std::filesystem::path& path) {
+  const sockaddr_un address = Address(path);
+  if (std::filesystem::is_socket(path)) {
+    if (IsListening(path)) {
+      throw std::system_error(
+          std::make_error_code(std::errc::address_in_use), path.string());
+    }
+    std::filesystem::remove(path);
+  }
+
+  UnixSocket socket(OpenSocket());
+  if (::bind(socket.fd_, reinterpret_cast<const sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+      ::listen(socket.fd_, SOMAXCONN) != 0) {
+    ThrowErrno(path.string());
+  }
+  return socket;
+}
+
+UnixSocket UnixSocket::Connect(const std::filesystem::path& path) {
+  const sockaddr_un address = Address(path);
+  UnixSocket socket(OpenSocket());
+  if (::connect(socket.fd_, reinterpret_cast<const sockaddr*>(&address),
+                sizeof(address)) != 0) {
+    ThrowErrno(path.string());
+  }
+  return socket;
+}
+
+UnixSocket UnixSocket::Accept() const {
+  while (true) {
+    const int fd = ::accept(fd_, nullptr, nullptr);
+    if (fd >= 0) {
+      return UnixSocket(CloseOnExec(fd));
+    }
+    if (errno != EINTR) {
+      ThrowErrno("accept");
+    }
+  }
+}
+
+void UnixSocket::SetTimeout(const std::chrono::milliseconds timeout) const {
+  const auto seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  timeval time{};
+  time.tv_sec = static_cast<time_t>(seconds.count());
+  time.tv_usec = static_cast<suseconds_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(timeout - seconds)
+          .count());
+  if (::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &time, sizeof(time)) != 0 ||
+      ::setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &time, sizeof(time)) != 0) {
+    ThrowErrno("timeout");
+  }
+}
+
+std::string UnixSocket::ReadAll(const size_t max_size) const {
+  std::string data;
+  char buffer[64 * 1024];
+  while (true) {
+    const ssize_t count = ::read(fd_, buffer, sizeof(buffer));
+    if (count > 0) {
+      if (static_cast<size_t>(count) > max_size - data.size()) {
+        throw std::system_error(
+            std::make_error_code(std::errc::message_size), "read");
+      }
+      data.append(buffer, static_cast<size_t>(count));
+    } else if (count == 0) {
+      return data;
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      throw std::system_error(std::make_error_code(std::errc::timed_out),
+                              "read");
+    } else if (errno != EINTR) {
+      ThrowErrno("read");
+    }
+  }
+}
+
+void UnixSocket::WriteAll(std::string_view data) const {
+#if defined(MSG_NOSIGNAL)
+  constexpr int kFlags = MSG_NOSIGNAL;
+#else
+  constexpr int kFlags = 0;
+  const int enable = 1;
+  ::setsockopt(fd_, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+  while (!data.empty()) {
+    const ssize_t count = ::send(fd_, data.data(), data.size(), kFlags);
+    if (count >= 0) {
+      data.remove_prefix(static_cast<size_t>(count));
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      throw std::system_error(std::make_error_code(std::errc::timed_out),
+                              "write");
+    } else if (errno != EINTR) {
+      ThrowErrno("write");
+    }
+  }
+}
+
+void UnixSocket::FinishWriting() const noexcept { ::shutdown(fd_, SHUT_WR); }
+
+void UnixSocket::Release() noexcept {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+#endif
+
+UnixSocket::~UnixSocket() { Release(); }
+
+UnixSocket::UnixSocket(UnixSocket&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)) {}
+
+UnixSocket& UnixSocket::operator=(UnixSocket&& other) noexcept {
+  if (this != &other) {
+    Release();
+    fd_ = std::exchange(other.fd_, -1);
+  }
+  return *this;
+}
+}  // namespace orion::syntax
@@ -0,0 +1,117 @@
+#ifndef SYNTAX_IO_UNIX_SOCKET_H_
+#define SYNTAX_IO_UNIX_SOCKET_H_
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace orion::syntax {
+
+/**
+ * @brief A connected or listening Unix domain stream socket.
+ *
+ * Messages are framed by the connection itself: a client writes its whole
+ * request, shuts down its writing side with `FinishWriting`, then reads the
+ * reply until the server closes the connection.
+ *
+ * On platforms without Unix domain sockets every factory throws.
+ */
+class UnixSocket {
+ public:
+  /**
+   * @brief Creates a socket file at `path` and listens on it.
+   *
+   * A socket file left behind by a server that is no longer running is
+   * replaced.
+   *
+   * @throws std::system_error If the path is too long, another server is
+   * listening on it, or the socket cannot be created.
+   */
+  [[nodiscard]] static UnixSocket Listen(const std::filesystem::path& path);
+
+  /**
+   * @brief Connects to a server listening at `path`.
+   *
+   * @throws std::system_error If nothing is listening there.
+   */
+  [[nodiscard]] static UnixSocket Connect(const std::filesystem::path& path);
+
+  /**
+   * @brief Deleted default constructor.
+   *
+   * A `UnixSocket` is only created by `Listen`, `Connect` and `Accept`.
+   */
+  UnixSocket() = delete;
+
+  /**
+   * @brief Closes the socket.
+   */
+  ~UnixSocket();
+
+  /** Deleted copy constructor and copy assignment. */
+  UnixSocket(const UnixSocket&) = delete;
+  UnixSocket& operator=(const UnixSocket&) = delete;
+
+  /** Move constructor and move assignment, transferring the descriptor. */
+  UnixSocket(UnixSocket&& other) noexcept;
+  UnixSocket& operator=(UnixSocket&& other) noexcept;
+
+  /**
+   * @brief Waits for the next client of a listening socket.
+   *
+   * @throws std::system_error If accepting fails.
+   */
+  [[nodiscard]] UnixSocket Accept() const;
+
+  /**
+   * @brief Bounds how long any one read or write may wait for the peer.
+   *
+   * @throws std::system_error If the timeout cannot be set.
+   */
+  void SetTimeout(std::chrono::milliseconds timeout) const;
+
+  /**
+   * @brief Reads until the peer stops writing.
+   *
+   * @param max_size The most bytes to accept.
+   * @throws std::system_error If reading fails or times out, or the peer
+   * writes more than `max_size` bytes.
+   */
+  [[nodiscard]] std::string ReadAll(
+      size_t max_size = std::numeric_limits<size_t>::max()) const;
+
+  /**
+   * @brief Writes every byte of `data`.
+   *
+   * A peer that has gone away is reported as an error rather than by a
+   * `SIGPIPE`.
+   *
+   * @throws std::system_error If writing fails.
+   */
+  void WriteAll(std::string_view data) const;
+
+  /**
+   * @brief Tells the peer nothing more will be written, so its `ReadAll`
+   * returns.
+   */
+  void FinishWriting() const noexcept;
+
+ private:
+  /**
+   * @brief Takes ownership of an open descriptor.
+   */
+  explicit UnixSocket(int fd) noexcept : fd_(fd) {}
+
+  /** Closes the descriptor, if any. */
+  void Release() noexcept;
+
+  /** The descriptor, or -1 once moved from. */
+  int fd_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_IO_UNIX_SOCKET_H_
@@ -22,7 +22,8 @@ bool AbstractLexer::IsCurrent(const std::u32string& value,
     return false;
   }
 
-  const std::u32string substring = source_.substr(end_ + offset, value.size());
+  const std::u32string_view substring =
+      source_.substr(end_ + offset, value.size());
 
   return substring == value;
 }
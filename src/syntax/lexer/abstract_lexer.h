@@ -1,12 +1,16 @@
 #ifndef ORION_SYNTAX_LEXER_ABSTRACT_LEXER_H_
 #define ORION_SYNTAX_LEXER_ABSTRACT_LEXER_H_
 
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "syntax/lexer/token.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
 
 // https://en.cppreference.com/w/cpp/string/multibyte
 namespace orion::syntax {
@@ -18,18 +22,23 @@ class AbstractLexer {
   virtual std::optional<Token> TryNextToken() = 0;
 
  protected:
-  explicit AbstractLexer(std::u32string source)
-      : source_(std::move(source)),
-        source_length_(source_.length()),
+  // The source is viewed rather than copied, so it must outlive the lexer.
+  explicit AbstractLexer(const std::u32string_view source)
+      : source_(source),
+        source_length_(TextSize::Of(source_.length())),
         start_(0),
         end_(0) {}
+  explicit AbstractLexer(std::u32string&& source) = delete;
 
   // Utils
   template <typename TokenKind = uint16_t>
   Token CreateToken(TokenKind kind) {
     const size_t distance = end_ - start_;
-    const std::u32string source = source_.substr(start_, distance);
-    const auto span = Span(start_, end_);
+    const std::u32string_view source = source_.substr(start_, distance);
+    // Both positions are bounded by `source_length_`, which was checked to
+    // fit in a `TextSize` on construction.
+    const auto span = Span(TextSize(static_cast<uint32_t>(start_)),
+                           TextSize(static_cast<uint32_t>(end_)));
     const auto token = Token(static_cast<uint16_t>(kind), span, source);
 
     start_ = end_;
@@ -42,9 +51,15 @@ class AbstractLexer {
     return CreateToken<TokenKind>(kind);
   }
 
+  // The text consumed since the last token, for diagnostics.
+  [[nodiscard]] TextRange Lexeme() const {
+    return TextRange(TextSize(static_cast<uint32_t>(start_)),
+                     TextSize(static_cast<uint32_t>(end_)));
+  }
+
   // State Management
   [[nodiscard]] bool AtEnd(size_t offset = 0) const {
-    return end_ + offset >= source_length_;
+    return end_ + offset >= static_cast<size_t>(source_length_);
   }
 
   // Peek
@@ -69,8 +84,8 @@ class AbstractLexer {
   void TryConsume2(char32_t ch1, char32_t ch2);
 
  private:
-  const std::u32string source_;
-  const size_t source_length_;
+  const std::u32string_view source_;
+  const TextSize source_length_;
   size_t start_;
   size_t end_;
 };
@@ -2,12 +2,14 @@
 
 #include <cwctype>
 #include <functional>
-#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "lexer.h"
 #include "syntax/lexer/token.h"
 #include "syntax/lexer/token_kind.h"
+#include "syntax/text/diagnostic.h"
 
 namespace orion::syntax {
 constexpr char32_t kBUpper = U'B';
@@ -35,6 +37,7 @@ constexpr char32_t kBackslash = '\\';
 
 constexpr char32_t kSpace = U' ';
 constexpr char32_t kNewline = U'\n';
+constexpr char32_t kCarriageReturn = U'\r';
 constexpr char32_t kTab = U'\t';
 
 constexpr char32_t kDot = U'.';
@@ -44,6 +47,8 @@ constexpr char32_t kMinus = U'-';
 constexpr char32_t kAsterisk = U'*';
 constexpr char32_t kSlash = U'/';
 constexpr char32_t kPercent = U'%';
+constexpr char32_t kLParen = U'(';
+constexpr char32_t kRParen = U')';
 
 const std::u32string kTrueKeyword = U"true";
 const std::u32string kFalseKeyword = U"false";
@@ -56,6 +61,10 @@ enum class NumericKind {
 };
 
 std::optional<Token> Lexer::TryNextToken() {
+  if (AtEnd()) {
+    return std::nullopt;
+  }
+
   if (const std::optional<Token> whitespace = TryWhitespace();
       whitespace.has_value()) {
     return whitespace;
@@ -84,7 +93,22 @@ std::optional<Token> Lexer::TryNextToken() {
     return ConsumeAndCreateToken(TokenKind::kDot);
   }
 
-  return TryLiteral();
+  if (const std::optional<Token> literal = TryLiteral(); literal.has_value()) {
+    return literal;
+  }
+
+  // Skip one character, so the tokens still cover the whole source.
+  Consume();
+  Report("unexpected character");
+  return CreateToken(TokenKind::kError);
+}
+
+std::vector<Token> Lexer::Tokenize() {
+  std::vector<Token> tokens;
+  while (std::optional<Token> token = TryNextToken()) {
+    tokens.push_back(*token);
+  }
+  return tokens;
 }
 
 std::optional<Token> Lexer::TryWhitespace() {
@@ -93,8 +117,19 @@ std::optional<Token> Lexer::TryWhitespace() {
     return CreateToken(TokenKind::kWhitespace);
   }
 
-  if (IsCurrent(kNewline)) {
-    ConsumeWhile([](const char32_t ch) { return ch == kNewline; });
+  // A `\r\n` is one line break, so CRLF sources lex like LF-only ones. A lone
+  // `\r` is still an unexpected character.
+  const auto line_break_length = [this]() -> size_t {
+    if (IsCurrent(kNewline)) {
+      return 1;
+    }
+    return IsCurrent(kCarriageReturn) && IsCurrent(kNewline, 1) ? 2 : 0;
+  };
+  if (line_break_length() != 0) {
+    for (size_t length = line_break_length(); length != 0;
+         length = line_break_length()) {
+      Consume(length);
+    }
     return CreateToken(TokenKind::kNewline);
   }
 
@@ -118,6 +153,12 @@ std::optional<Token> Lexer::TryOperator() {
     case kPercent:
       return ConsumeAndCreateToken(TokenKind::kPercent);
 
+    case kLParen:
+      return ConsumeAndCreateToken(TokenKind::kLParen);
+
+    case kRParen:
+      return ConsumeAndCreateToken(TokenKind::kRParen);
+
     default:
       return std::nullopt;
   }
@@ -161,9 +202,10 @@ std::optional<Token> Lexer::TryStringLiteral() {
   Consume();  // Eat delimiter.
 
   bool is_escaped = false;
-  ConsumeWhile([this, is_escaped](const char32_t ch) mutable {
+  bool invalid_escape = false;
+  ConsumeWhile([is_escaped, &invalid_escape](const char32_t ch) mutable {
     if (is_escaped) {
-      switch (GetCurrent()) {
+      switch (ch) {
         case kTLower:
         case kBLower:
         case kNLower:
@@ -172,11 +214,14 @@ std::optional<Token> Lexer::TryStringLiteral() {
         case kQuote:
         case kDoubleQuote:
         case kBackslash:
-          is_escaped = false;
-          return true;
+          break;
         default:
-          throw std::invalid_argument("invalid escape sequence");
+          // Keep the character in the literal, which is reported below.
+          invalid_escape = true;
+          break;
       }
+      is_escaped = false;
+      return true;
     }
 
     if (ch == kBackslash) {
@@ -187,8 +232,14 @@ std::optional<Token> Lexer::TryStringLiteral() {
     return ch != delimiter;
   });
 
+  if (invalid_escape) {
+    Report("invalid escape sequence");
+  }
+
+  // An unclosed literal runs to the end of the source.
   if (!IsCurrent(delimiter)) {
-    throw std::invalid_argument("unclosed string literal");
+    Report("unclosed string literal");
+    return CreateToken(TokenKind::kStringLiteral);
   }
 
   Consume();  // Eat delimiter.
@@ -224,6 +275,7 @@ std::optional<Token> Lexer::TryNumericLiteral(const bool consume_digits) {
     case kDot: {
       Consume();  // Eat '.'
 
+      // Digits after the point are optional, as in `1.`.
       numericKind = NumericKind::kApprox;
       ConsumeDigits();
       ConsumeExponent();
@@ -274,37 +326,29 @@ void Lexer::ConsumeExponent() {
     return;
   }
 
+  // Without digits, the `E` is not part of the literal.
+  const auto is_digit = [](const char32_t ch) { return std::iswdigit(ch); };
+  if (!IsCurrent(is_digit, 1) &&
+      !(IsCurrent2(kPlus, kMinus, 1) && IsCurrent(is_digit, 2))) {
+    return;
+  }
+
   Consume();                   // Eat 'E'
   TryConsume2(kPlus, kMinus);  // Eat '[+-]?'
   ConsumeDigits();
 }
 
-// Grammar: [0-9]+
+// Grammar: [0-9]*
 void Lexer::ConsumeDigits() {
-  if (AtEnd()) {
-    throw std::invalid_argument(
-        "expected at least one digit in fragment, but at end");
-  }
-
-  if (!std::iswdigit(GetCurrent())) {
-    throw std::invalid_argument("expected at least one digit in fragment");
-  }
-
   ConsumeWhile([](const char32_t ch) { return std::iswdigit(ch); });
 }
 
-// Grammar: [a-zA-Z]+
+// Grammar: [a-zA-Z]*
 void Lexer::ConsumeLetters() {
-  if (AtEnd()) {
-    throw std::invalid_argument(
-        "expected at least one letter in fragment, but at end");
-  }
-
-  if (!std::iswalpha(
-          GetCurrent())) {  // Fix: should check for letters, not digits
-    throw std::invalid_argument("expected at least one letter in fragment");
-  }
-
   ConsumeWhile([](const char32_t ch) { return std::iswalpha(ch); });
 }
+
+void Lexer::Report(const std::string_view message) {
+  diagnostics_.push_back({Lexeme(), message});
+}
 }  // namespace orion::syntax
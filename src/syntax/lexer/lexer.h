@@ -1,20 +1,71 @@
 #ifndef ORION_SYNTAX_LEXER_LEXER_H_
 #define ORION_SYNTAX_LEXER_LEXER_H_
 
+#include <cstddef>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "syntax/lexer/abstract_lexer.h"
 #include "syntax/lexer/token.h"
+#include "syntax/text/diagnostic.h"
 
 namespace orion::syntax {
 class Lexer final : public AbstractLexer {
  public:
-  explicit Lexer(const std::u32string &source) : AbstractLexer(source) {}
+  /**
+   * @brief Prepares to lex a source.
+   *
+   * @param source The text, which is viewed rather than copied and so must
+   * outlive the lexer.
+   */
+  explicit Lexer(const std::u32string_view source) : AbstractLexer(source) {}
+
+  /**
+   * @brief Prepares to lex a string literal, which lives as long as the
+   * program.
+   *
+   * Without this overload a literal would convert equally well to a view and
+   * to a temporary string, and be ambiguous.
+   */
+  template <size_t N>
+  explicit Lexer(const char32_t (&source)[N])
+      : AbstractLexer(std::u32string_view(source)) {}
+
+  /**
+   * @brief Deleted, since the lexer would view a string destroyed before it
+   * is used.
+   */
+  explicit Lexer(std::u32string&& source) = delete;
+
   Lexer() = delete;
 
+  /**
+   * @brief Lexes the next token.
+   *
+   * Never fails: a character that starts no token becomes a one-character
+   * `kError` token, and a malformed token is kept whole. Both are reported
+   * in `Diagnostics()`.
+   *
+   * @return The token, or `std::nullopt` at the end of the source.
+   */
   std::optional<Token> TryNextToken() override;
 
+  /**
+   * @brief Lexes the rest of the source.
+   *
+   * @return Every remaining token, in order, covering the whole source.
+   */
+  std::vector<Token> Tokenize();
+
+  /**
+   * @brief Returns the problems found in the tokens lexed so far.
+   */
+  [[nodiscard]] const std::vector<Diagnostic> &Diagnostics() const noexcept {
+    return diagnostics_;
+  }
+
  private:
   // Token
   std::optional<Token> TryWhitespace();
@@ -29,6 +80,11 @@ class Lexer final : public AbstractLexer {
   void ConsumeExponent();
   void ConsumeDigits();
   void ConsumeLetters();
+
+  // Reports a problem with the text consumed for the current token.
+  void Report(std::string_view message);
+
+  std::vector<Diagnostic> diagnostics_;
 };
 }  // namespace orion::syntax
 #endif  // ORION_SYNTAX_LEXER_LEXER_H_
\ No newline at end of file
@@ -2,9 +2,10 @@
 #define ORION_SYNTAX_LEXER_TOKEN_H_
 
 #include <cstdint>
-#include <string>
-#include <utility>
+#include <string_view>
 
+#include "syntax/interner/interner.h"
+#include "syntax/interner/symbol.h"
 #include "syntax/lexer/span.h"
 
 namespace orion::syntax {
@@ -13,22 +14,37 @@ namespace orion::syntax {
  * @brief Represents a lexical token in the source text.
  *
  * A `Token` consists of a kind (denoting its type), a span (indicating its
- * position in the source text), and the actual text content.
+ * position in the source text), and the actual text content. The text is held
+ * as a `Symbol` in the global `Interner`, so repeated tokens share storage and
+ * compare as integers.
  */
 class Token {
  public:
   /**
-   * @brief Constructs a `Token` with a specified kind, span, and source text.
+   * @brief Constructs a `Token` with a specified kind, span, and interned text.
    *
    * @param kind The numeric identifier representing the token's type.
    * @param span The range of text covered by this token in the source input.
-   * @param source The actual text content of the token.
+   * @param symbol The interned text content of the token.
    *
    * @note The constructor is explicit to prevent unintended implicit
    * conversions.
    */
-  explicit Token(const uint16_t kind, const Span span, std::u32string source)
-      : kind_(kind), span_(span), source_(std::move(source)) {}
+  explicit Token(const uint16_t kind, const Span span, const Symbol symbol)
+      : kind_(kind), span_(span), symbol_(symbol) {}
+
+  /**
+   * @brief Constructs a `Token` with a specified kind, span, and source text.
+   *
+   * The text is interned in the global `Interner`.
+   *
+   * @param kind The numeric identifier representing the token's type.
+   * @param span The range of text covered by this token in the source input.
+   * @param source The actual text content of the token.
+   */
+  explicit Token(const uint16_t kind, const Span span,
+                 const std::u32string_view source)
+      : Token(kind, span, Interner::Global().Intern(source)) {}
 
   /**
    * @brief Deleted default constructor.
@@ -59,12 +75,21 @@ class Token {
    */
   [[nodiscard]] orion::syntax::Span Span() const { return span_; }
 
+  /**
+   * @brief Returns the interned text of the token.
+   *
+   * @return The `Symbol` of the token's text.
+   */
+  [[nodiscard]] orion::syntax::Symbol Symbol() const { return symbol_; }
+
   /**
    * @brief Returns the actual text content of the token.
    *
-   * @return A reference to the token's source string.
+   * @return A view of the token's UTF-8 text in the global `Interner`.
    */
-  [[nodiscard]] const std::u32string& Source() const { return source_; }
+  [[nodiscard]] std::string_view Text() const {
+    return Interner::Global().Resolve(symbol_);
+  }
 
   /**
    * @brief Checks if two tokens are equal.
@@ -74,7 +99,7 @@ class Token {
    *         otherwise `false`.
    */
   bool operator==(const Token& other) const {
-    return kind_ == other.kind_ && source_ == other.source_ &&
+    return kind_ == other.kind_ && symbol_ == other.symbol_ &&
            span_ == other.span_;
   }
 
@@ -85,8 +110,8 @@ class Token {
   /** The span indicating the token's position in the source. */
   const orion::syntax::Span span_;
 
-  /** The actual text content of the token. */
-  const std::u32string source_;
+  /** The interned text content of the token. */
+  const orion::syntax::Symbol symbol_;
 };
 }  // namespace orion::syntax
 #endif  // ORION_SYNTAX_LEXER_TOKEN_H_
\ No newline at end of file
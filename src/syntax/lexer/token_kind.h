@@ -1,8 +1,13 @@
 #ifndef ORION_SYNTAX_LEXER_TOKEN_KIND_H_
 #define ORION_SYNTAX_LEXER_TOKEN_KIND_H_
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
+
+#include "syntax/util/hash.h"
 
 namespace orion::syntax {
 
@@ -11,46 +16,46 @@ namespace orion::syntax {
  *
  * This enum class categorizes various token types encountered during
  * lexical analysis, including literals, operators, punctuation, and keywords.
+ * The kinds are listed in `grammar.def`.
  */
 enum class TokenKind : uint16_t {
-  // --- Trivia ---
-  kWhitespace,
-  kNewline,
-  kComment,
-
-  // --- Keywords ---
-
-  // --- Punctuation ---
-  kDot,
-
-  kPlus,
-  kMinus,
-  kAsterisk,
-  kSlash,
-  kPercent,
-
-  // --- Boolean Literals ---
-  kBooleanLiteral,
-
-  // --- String Literals ---
-  kStringLiteral,
+#define LEXER_TOKEN(Name, Syntax) k##Name,
+#include "syntax/grammar/grammar.def"
+};
 
-  // --- Exact Numeric Literals ---
-  kIntLiteral,
-  kBigIntLiteral,
-  kSmallIntLiteral,
-  kTinyIntLiteral,
+/** The number of `TokenKind`s, which size tables indexed by them. */
+inline constexpr size_t kTokenKindCount =
+    static_cast<size_t>(TokenKind::kEof) + 1;
 
-  // --- Approx Numeric Literals ---
-  kFloatLiteral,
-  kDoubleLit,
-  kBigDecimalLiteral,
+/** The name of every `TokenKind`, without the `k`, indexed by kind. */
+inline constexpr std::array<std::string_view, kTokenKindCount>
+    kTokenKindNames = {
+#define LEXER_TOKEN(Name, Syntax) #Name,
+#include "syntax/grammar/grammar.def"
+};
 
-  // --- Other ---
-  kIdentifier,
+/**
+ * @brief A fingerprint of the token kinds' names and order.
+ *
+ * Like `kSyntaxKindHash`, anything that stores token kinds by number records
+ * this, so swapping two kinds invalidates the data even though every number
+ * stays in range.
+ */
+inline constexpr uint32_t kTokenKindHash = [] {
+  // Each name and its terminator.
+  uint32_t hash = kFnv1aBasis;
+  for (const std::string_view name : kTokenKindNames) {
+    hash = Fnv1a(Fnv1a(hash, name), '\0');
+  }
+  return hash;
+}();
 
-  // --- Special ---
-  kEof,
-};
+/**
+ * @brief Returns the name of a kind, such as `IntLiteral`.
+ */
+[[nodiscard]] constexpr std::string_view KindName(
+    const TokenKind kind) noexcept {
+  return kTokenKindNames[static_cast<size_t>(kind)];
+}
 }  // namespace orion::syntax
 #endif  // ORION_SYNTAX_LEXER_TOKEN_KIND_H_
@@ -1 +1,85 @@
 #include "syntax/parser/abstract_parser.h"
+
+#include <span>
+#include <string_view>
+
+#include "syntax/lexer/token.h"
+#include "syntax/lexer/token_kind.h"
+#include "syntax/parser/event_sink.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace orion::syntax {
+AbstractParser::AbstractParser(const std::span<const Token> tokens) noexcept
+    : tokens_(tokens) {
+  SkipTrivia();
+}
+
+void AbstractParser::Bump() {
+  BumpTrivia();
+  if (position_ == tokens_.size()) {
+    return;
+  }
+
+  sink_.Token(ToSyntaxKind(tokens_[position_].GetKind<TokenKind>()));
+  ++position_;
+  SkipTrivia();
+}
+
+void AbstractParser::BumpTrivia() {
+  for (; position_ < significant_; ++position_) {
+    sink_.Token(ToSyntaxKind(tokens_[position_].GetKind<TokenKind>()));
+  }
+}
+
+bool AbstractParser::Expect(const TokenKind kind,
+                            const std::string_view message) {
+  if (!At(kind)) {
+    Error(message);
+    return false;
+  }
+
+  Bump();
+  return true;
+}
+
+void AbstractParser::Error(const std::string_view message) {
+  if (significant_ < tokens_.size()) {
+    diagnostics_.push_back({tokens_[significant_].Span(), message});
+    return;
+  }
+
+  // Something is missing at the end of the source.
+  const TextSize end =
+      tokens_.empty() ? TextSize() : tokens_.back().Span().End();
+  diagnostics_.push_back({TextRange::Empty(end), message});
+}
+
+CompletedMarker AbstractParser::ErrorAndBump(const std::string_view message) {
+  if (!At(TokenKind::kError)) {
+    Error(message);
+  }
+
+  const Marker error = Start();
+  Bump();
+  return Complete(error, SyntaxKind::kError);
+}
+
+Marker AbstractParser::Start() {
+  // Leading trivia belongs inside the outermost node, since the tree needs a
+  // single root.
+  if (!sink_.Events().empty()) {
+    BumpTrivia();
+  }
+  return sink_.Start();
+}
+
+void AbstractParser::SkipTrivia() noexcept {
+  significant_ = position_;
+  while (significant_ < tokens_.size() &&
+         IsTrivia(tokens_[significant_].GetKind<TokenKind>())) {
+    ++significant_;
+  }
+}
+}  // namespace orion::syntax
@@ -1,12 +1,186 @@
-//
-// Created by tamiyo on 3/8/25.
-//
+#ifndef SYNTAX_PARSER_ABSTRACT_PARSER_H_
+#define SYNTAX_PARSER_ABSTRACT_PARSER_H_
 
-#ifndef SYNTAX_PARSER_PARSER_H_
-#define SYNTAX_PARSER_PARSER_H_
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "syntax/lexer/token.h"
+#include "syntax/lexer/token_kind.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/event_sink.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/text/text_range.h"
 
 namespace orion::syntax {
-class AbstractParser {};
+
+/** The kind each lexer token is recorded as in the tree, by `TokenKind`. */
+inline constexpr std::array<SyntaxKind, kTokenKindCount> kTokenSyntaxKinds = {
+#define LEXER_TOKEN(Name, Syntax) SyntaxKind::k##Syntax,
+#include "syntax/grammar/grammar.def"
+};
+
+/**
+ * @brief Returns the kind a lexer token is recorded as in the tree.
+ */
+[[nodiscard]] constexpr SyntaxKind ToSyntaxKind(const TokenKind kind) noexcept {
+  return kTokenSyntaxKinds[static_cast<size_t>(kind)];
+}
+
+/**
+ * @brief Checks if a token is trivia, which parsers skip over.
+ */
+[[nodiscard]] constexpr bool IsTrivia(const TokenKind kind) noexcept {
+  return IsTrivia(ToSyntaxKind(kind));
+}
+
+/**
+ * @brief The token cursor and event recording shared by parsers.
+ *
+ * A parser looks only at significant tokens: whitespace, newlines and
+ * comments are trivia, which `Current` skips over. Trivia is still recorded,
+ * so the tree covers the whole source: it is attached to whichever node is
+ * open when the next significant token or node starts.
+ *
+ * Parsers never fail: a syntax error is recorded as a diagnostic, and the
+ * tokens that cannot be placed are wrapped in `kError` nodes, so the events
+ * always describe one tree that covers every token.
+ */
+class AbstractParser {
+ public:
+  AbstractParser() = delete;
+  virtual ~AbstractParser() = default;
+
+  /**
+   * @brief Parses every token.
+   *
+   * @return The events describing the tree, for `BuildGreen`.
+   */
+  [[nodiscard]] virtual std::vector<Event> Parse() = 0;
+
+  /**
+   * @brief Returns the syntax errors found so far, in source order.
+   */
+  [[nodiscard]] const std::vector<Diagnostic>& Diagnostics() const noexcept {
+    return diagnostics_;
+  }
+
+ protected:
+  /**
+   * @brief Constructs a parser over lexer tokens.
+   *
+   * @param tokens The tokens to parse, which must outlive the parser.
+   */
+  explicit AbstractParser(std::span<const Token> tokens) noexcept;
+
+  // Peek
+
+  /**
+   * @brief Returns the kind of the next significant token, or `kEof`.
+   */
+  [[nodiscard]] TokenKind Current() const noexcept {
+    return significant_ < tokens_.size()
+               ? tokens_[significant_].GetKind<TokenKind>()
+               : TokenKind::kEof;
+  }
+
+  [[nodiscard]] bool At(const TokenKind kind) const noexcept {
+    return Current() == kind;
+  }
+
+  [[nodiscard]] bool AtEnd() const noexcept { return At(TokenKind::kEof); }
+
+  // Consume
+
+  /**
+   * @brief Records the pending trivia and then the current token.
+   */
+  void Bump();
+
+  /**
+   * @brief Records the trivia before the current token.
+   */
+  void BumpTrivia();
+
+  /**
+   * @brief Bumps the current token if it is of `kind`, or reports `message`
+   * at it.
+   *
+   * @return Whether the token was there.
+   */
+  bool Expect(TokenKind kind, std::string_view message);
+
+  // Errors
+
+  /**
+   * @brief Reports a syntax error at the current token, or at the end of the
+   * source.
+   *
+   * @param message A string literal describing the error.
+   */
+  void Error(std::string_view message);
+
+  /**
+   * @brief Reports an error and wraps the current token in a `kError` node.
+   *
+   * A `kError` token from the lexer was already reported, so it is wrapped
+   * without a second diagnostic.
+   *
+   * @param message A string literal describing the error.
+   * @return The `kError` node.
+   */
+  CompletedMarker ErrorAndBump(std::string_view message);
+
+  // Nodes
+
+  /**
+   * @brief Starts a node at the current token, after the pending trivia.
+   *
+   * The first node starts before any trivia, so it covers the whole source.
+   */
+  [[nodiscard]] Marker Start();
+
+  CompletedMarker Complete(const Marker marker, const SyntaxKind kind) {
+    return sink_.Complete(marker, kind);
+  }
+
+  [[nodiscard]] Marker Precede(const CompletedMarker& completed) {
+    return sink_.Precede(completed);
+  }
+
+  /**
+   * @brief Moves the recorded events out of the parser.
+   */
+  [[nodiscard]] std::vector<Event> TakeEvents() noexcept {
+    return sink_.Take();
+  }
+
+ private:
+  /**
+   * @brief Moves `significant_` to the first non-trivia token at or after
+   * `position_`.
+   */
+  void SkipTrivia() noexcept;
+
+  /** The tokens being parsed. */
+  std::span<const Token> tokens_;
+
+  /** The index of the first token not yet recorded. */
+  size_t position_ = 0;
+
+  /** The index of the next significant token. */
+  size_t significant_ = 0;
+
+  /** The recorded events. */
+  EventSink sink_;
+
+  /** The reported syntax errors. */
+  std::vector<Diagnostic> diagnostics_;
+};
+
 }  // namespace orion::syntax
 
-#endif  // SYNTAX_PARSER_PARSER_H_
+#endif  // SYNTAX_PARSER_ABSTRACT_PARSER_H_
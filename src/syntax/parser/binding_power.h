@@ -0,0 +1,77 @@
+#ifndef SYNTAX_PARSER_BINDING_POWER_H_
+#define SYNTAX_PARSER_BINDING_POWER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "syntax/lexer/token_kind.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief How tightly an infix operator binds its left and right operands.
+ *
+ * An operator takes the operand between it and a neighbouring operator if
+ * its power on that side is higher. Making the right power one above the
+ * left makes an operator left-associative. A left power of zero marks a
+ * token that is not an infix operator.
+ */
+struct BindingPower {
+  /** The power on the operator's left operand. */
+  uint8_t left = 0;
+
+  /** The power on the operator's right operand. */
+  uint8_t right = 0;
+
+  /**
+   * @brief Checks if the token is an infix operator.
+   */
+  [[nodiscard]] constexpr bool IsInfix() const noexcept { return left != 0; }
+};
+
+/** The binding powers of infix operators, indexed by `TokenKind`. */
+inline constexpr std::array<BindingPower, kTokenKindCount>
+    kInfixBindingPowers = [] {
+      std::array<BindingPower, kTokenKindCount> powers{};
+      const auto set = [&powers](const TokenKind kind,
+                                 const BindingPower power) {
+        powers[static_cast<size_t>(kind)] = power;
+      };
+
+#define INFIX(Name, left, right) set(TokenKind::k##Name, {left, right});
+#include "syntax/grammar/grammar.def"
+      return powers;
+    }();
+
+/** Whether each token is a prefix operator, indexed by `TokenKind`. */
+inline constexpr std::array<bool, kTokenKindCount> kPrefixOperators = [] {
+  std::array<bool, kTokenKindCount> prefix{};
+#define PREFIX(Name) prefix[static_cast<size_t>(TokenKind::k##Name)] = true;
+#include "syntax/grammar/grammar.def"
+  return prefix;
+}();
+
+/**
+ * @brief Returns the binding power of a token as an infix operator.
+ */
+[[nodiscard]] constexpr BindingPower InfixBindingPower(
+    const TokenKind kind) noexcept {
+  return kInfixBindingPowers[static_cast<size_t>(kind)];
+}
+
+/**
+ * @brief Checks if a token is a prefix operator.
+ */
+[[nodiscard]] constexpr bool IsPrefixOperator(const TokenKind kind) noexcept {
+  return kPrefixOperators[static_cast<size_t>(kind)];
+}
+
+static_assert(InfixBindingPower(TokenKind::kAsterisk).left >
+                  InfixBindingPower(TokenKind::kPlus).right,
+              "multiplicative operators must bind tighter than additive ones");
+static_assert(!InfixBindingPower(TokenKind::kIntLiteral).IsInfix());
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_BINDING_POWER_H_
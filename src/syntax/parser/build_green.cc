@@ -0,0 +1,117 @@
+#include "syntax/parser/build_green.h"
+
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "syntax/interner/interner.h"
+#include "syntax/interner/symbol.h"
+#include "syntax/lexer/token.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/util/small_vector.h"
+
+namespace orion::syntax {
+namespace {
+// A forward-parent chain is as long as the number of left-recursive wrappers
+// starting at one position. The inline size only covers short chains: a
+// left-associative `a + b + c + ...` gets one wrapper per operator, all
+// starting at `a`, and longer chains fall back to the heap.
+constexpr size_t kInlineForwardParents = 16;
+
+Symbol JoinTokens(const std::span<const Token> tokens) {
+  if (tokens.size() == 1) {
+    return tokens.front().Symbol();
+  }
+
+  std::string text;
+  for (const Token& token : tokens) {
+    text.append(token.Text());
+  }
+  return Interner::Global().Intern(text);
+}
+}  // namespace
+
+GreenNode BuildGreen(const std::span<const Event> events,
+                     const std::span<const Token> tokens,
+                     GreenBuilder& builder) {
+  builder.Reset();
+
+  // Starts reached through a forward-parent link are opened early, and must
+  // be skipped when the loop reaches them. Both scratch buffers are kept per
+  // thread, so a thread that builds many trees allocates them once.
+  thread_local std::vector<bool> opened;
+  thread_local SmallVector<SyntaxKind, kInlineForwardParents> kinds;
+  opened.assign(events.size(), false);
+  size_t next_token = 0;
+
+  for (size_t i = 0; i < events.size(); ++i) {
+    const Event& event = events[i];
+    switch (event.kind) {
+      case EventKind::kTombstone:
+        break;
+
+      case EventKind::kStart: {
+        if (opened[i]) {
+          break;
+        }
+
+        // Walk the chain of wrapping nodes, innermost first, then open them
+        // outermost first.
+        kinds.Clear();
+        kinds.PushBack(event.syntax_kind);
+        for (size_t parent = i + event.forward_parent;
+             parent != i && parent < events.size();) {
+          const Event& wrapper = events[parent];
+          if (wrapper.kind == EventKind::kStart) {
+            kinds.PushBack(wrapper.syntax_kind);
+            opened[parent] = true;
+          }
+          if (wrapper.forward_parent == 0) {
+            break;
+          }
+          parent += wrapper.forward_parent;
+        }
+
+        for (size_t k = kinds.Size(); k-- > 0;) {
+          builder.StartNode(kinds[k]);
+        }
+        break;
+      }
+
+      case EventKind::kFinish:
+        builder.FinishNode();
+        break;
+
+      case EventKind::kToken: {
+        if (event.token_count == 0 ||
+            event.token_count > tokens.size() - next_token) {
+          throw std::invalid_argument("token event exceeds the token stream");
+        }
+
+        builder.Token(event.syntax_kind,
+                      JoinTokens(tokens.subspan(next_token,
+                                                event.token_count)));
+        next_token += event.token_count;
+        break;
+      }
+    }
+  }
+
+  if (builder.ChildrenSize() != 1) {
+    throw std::invalid_argument("events do not describe a single tree");
+  }
+
+  return builder.Finish();
+}
+
+GreenNode BuildGreen(const std::span<const Event> events,
+                     const std::span<const Token> tokens) {
+  GreenBuilder builder;
+  return BuildGreen(events, tokens, builder);
+}
+}  // namespace orion::syntax
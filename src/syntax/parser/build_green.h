@@ -0,0 +1,46 @@
+#ifndef SYNTAX_PARSER_BUILD_GREEN_H_
+#define SYNTAX_PARSER_BUILD_GREEN_H_
+
+#include <span>
+
+#include "syntax/lexer/token.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief Builds a green tree from parser events.
+ *
+ * Tokens are consumed from `tokens` in order: each `kToken` event takes the
+ * next `token_count` lexer tokens and joins their text into one green token.
+ * Nodes linked by `forward_parent` are opened outermost first.
+ *
+ * @param events The events recorded by the parser.
+ * @param tokens The lexer tokens the events refer to.
+ * @param builder The builder to build with. It is reset first, so a builder
+ * (and its cache) can be reused across calls.
+ * @return The root of the tree.
+ * @throws std::invalid_argument If the events do not describe a single tree
+ * or consume more tokens than given.
+ */
+[[nodiscard]] GreenNode BuildGreen(std::span<const Event> events,
+                                   std::span<const Token> tokens,
+                                   GreenBuilder& builder);
+
+/**
+ * @brief Builds a green tree from parser events with a fresh builder.
+ *
+ * @param events The events recorded by the parser.
+ * @param tokens The lexer tokens the events refer to.
+ * @return The root of the tree.
+ * @throws std::invalid_argument If the events do not describe a single tree
+ * or consume more tokens than given.
+ */
+[[nodiscard]] GreenNode BuildGreen(std::span<const Event> events,
+                                   std::span<const Token> tokens);
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_BUILD_GREEN_H_
@@ -0,0 +1,59 @@
+#ifndef SYNTAX_PARSER_EVENT_H_
+#define SYNTAX_PARSER_EVENT_H_
+
+#include <cstdint>
+
+#include "syntax/parser/syntax_kind.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief The kind of a parser `Event`.
+ */
+enum class EventKind : uint8_t {
+  /** A placeholder left by a started but abandoned or unfinished node. */
+  kTombstone,
+
+  /** Opens a node of `Event::syntax_kind`. */
+  kStart,
+
+  /** Closes the innermost open node. */
+  kFinish,
+
+  /** Consumes `Event::token_count` lexer tokens as one green token. */
+  kToken,
+};
+
+/**
+ * @brief A single step of parser output.
+ *
+ * A parser records a flat sequence of events instead of building a tree as it
+ * goes, so the parse loop never hashes or allocates tree nodes. The tree is
+ * built afterwards by `BuildGreen`, possibly on another thread, or not at all
+ * when only diagnostics are needed.
+ *
+ * A node that must wrap an already finished node (for example, the binary
+ * expression around a left operand) is recorded as a later `kStart` event.
+ * The earlier node's `kStart` points to it through `forward_parent`, and
+ * `BuildGreen` opens the outer node first.
+ */
+struct Event {
+  /** The kind of event. */
+  EventKind kind = EventKind::kTombstone;
+
+  /** The node kind for `kStart`, or the token kind for `kToken`. */
+  SyntaxKind syntax_kind = SyntaxKind::kError;
+
+  /**
+   * For `kStart`, the distance to the `kStart` event of the node which wraps
+   * this one, or `0` if there is none.
+   */
+  uint32_t forward_parent = 0;
+
+  /** For `kToken`, the number of lexer tokens glued into the green token. */
+  uint32_t token_count = 0;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_EVENT_H_
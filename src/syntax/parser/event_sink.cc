@@ -0,0 +1,51 @@
+#include "syntax/parser/event_sink.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "syntax/parser/event.h"
+#include "syntax/parser/syntax_kind.h"
+
+// https://github.com/rust-lang/rust-analyzer/blob/master/crates/parser/src/event.rs
+namespace orion::syntax {
+Marker EventSink::Start() {
+  const auto position = static_cast<uint32_t>(events_.size());
+  events_.push_back({});
+  return Marker(position);
+}
+
+CompletedMarker EventSink::Complete(const Marker marker,
+                                    const SyntaxKind kind) {
+  Event& start = events_.at(marker.Position());
+  if (start.kind != EventKind::kTombstone) {
+    throw std::invalid_argument("marker was already completed");
+  }
+
+  start.kind = EventKind::kStart;
+  start.syntax_kind = kind;
+  events_.push_back({.kind = EventKind::kFinish});
+
+  return CompletedMarker(marker.Position(), kind);
+}
+
+void EventSink::Abandon(const Marker marker) noexcept {
+  // A trailing placeholder can simply be dropped; otherwise it stays as a
+  // tombstone which `BuildGreen` skips.
+  if (marker.Position() + 1 == events_.size()) {
+    events_.pop_back();
+  }
+}
+
+Marker EventSink::Precede(const CompletedMarker& completed) {
+  const Marker parent = Start();
+  events_[completed.Position()].forward_parent =
+      parent.Position() - completed.Position();
+  return parent;
+}
+
+void EventSink::Token(const SyntaxKind kind, const uint32_t token_count) {
+  events_.push_back({.kind = EventKind::kToken,
+                     .syntax_kind = kind,
+                     .token_count = token_count});
+}
+}  // namespace orion::syntax
@@ -0,0 +1,157 @@
+#ifndef SYNTAX_PARSER_EVENT_SINK_H_
+#define SYNTAX_PARSER_EVENT_SINK_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "syntax/parser/event.h"
+#include "syntax/parser/syntax_kind.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief A node that has been started but not yet completed.
+ */
+class Marker {
+ public:
+  /**
+   * @brief Constructs a marker for the event at `position`.
+   *
+   * @param position The index of the node's placeholder event.
+   */
+  explicit Marker(const uint32_t position) noexcept : position_(position) {}
+
+  /**
+   * @brief Returns the index of the node's placeholder event.
+   */
+  [[nodiscard]] uint32_t Position() const noexcept { return position_; }
+
+ private:
+  /** The index of the node's placeholder event. */
+  uint32_t position_;
+};
+
+/**
+ * @brief A node that has been completed, which may still be wrapped by a new
+ * parent with `EventSink::Precede`.
+ */
+class CompletedMarker {
+ public:
+  /**
+   * @brief Constructs a marker for the completed node at `position`.
+   *
+   * @param position The index of the node's `kStart` event.
+   * @param kind The kind of the node.
+   */
+  explicit CompletedMarker(const uint32_t position,
+                           const SyntaxKind kind) noexcept
+      : position_(position), kind_(kind) {}
+
+  /**
+   * @brief Returns the index of the node's `kStart` event.
+   */
+  [[nodiscard]] uint32_t Position() const noexcept { return position_; }
+
+  /**
+   * @brief Returns the kind of the completed node.
+   */
+  [[nodiscard]] SyntaxKind Kind() const noexcept { return kind_; }
+
+ private:
+  /** The index of the node's `kStart` event. */
+  uint32_t position_;
+
+  /** The kind of the node. */
+  SyntaxKind kind_;
+};
+
+/**
+ * @brief Records the events produced by a parser.
+ *
+ * Nodes are opened with `Start`, which returns a `Marker`, and closed with
+ * `Complete`. Since the kind of a node is only chosen when it is completed,
+ * a parser can start a node before it knows what it will be, and `Abandon` it
+ * if it turns out to be unnecessary. `Precede` wraps a completed node in a new
+ * one, which is how left-recursive constructs are built.
+ *
+ * Like `GreenBuilder`, a sink may be reused: `Clear()` keeps the capacity of
+ * the event buffer.
+ */
+class EventSink {
+ public:
+  /**
+   * @brief Constructs an empty sink.
+   */
+  EventSink() = default;
+
+  /**
+   * @brief Starts a new node.
+   *
+   * @return A marker to complete or abandon the node with.
+   */
+  [[nodiscard]] Marker Start();
+
+  /**
+   * @brief Completes a started node.
+   *
+   * @param marker The marker returned by `Start` or `Precede`.
+   * @param kind The kind of the node.
+   * @return A marker for the completed node.
+   */
+  CompletedMarker Complete(Marker marker, SyntaxKind kind);
+
+  /**
+   * @brief Discards a started node, leaving its children to its parent.
+   *
+   * @param marker The marker returned by `Start` or `Precede`.
+   */
+  void Abandon(Marker marker) noexcept;
+
+  /**
+   * @brief Starts a new node which will wrap a completed node.
+   *
+   * @param completed The node to wrap.
+   * @return A marker for the new parent node.
+   */
+  [[nodiscard]] Marker Precede(const CompletedMarker& completed);
+
+  /**
+   * @brief Records a token.
+   *
+   * @param kind The kind of the green token.
+   * @param token_count The number of lexer tokens glued into the token.
+   */
+  void Token(SyntaxKind kind, uint32_t token_count = 1);
+
+  /**
+   * @brief Returns the events recorded so far.
+   *
+   * @return A view of the events, invalidated by any further recording.
+   */
+  [[nodiscard]] std::span<const Event> Events() const noexcept {
+    return events_;
+  }
+
+  /**
+   * @brief Moves the recorded events out of the sink.
+   *
+   * @return The events.
+   */
+  [[nodiscard]] std::vector<Event> Take() noexcept {
+    return std::move(events_);
+  }
+
+  /**
+   * @brief Discards the recorded events, keeping the buffer's capacity.
+   */
+  void Clear() noexcept { events_.clear(); }
+
+ private:
+  /** The recorded events. */
+  std::vector<Event> events_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_EVENT_SINK_H_
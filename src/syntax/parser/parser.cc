@@ -0,0 +1,256 @@
+#include "syntax/parser/parser.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "syntax/lexer/lexer.h"
+#include "syntax/lexer/token.h"
+#include "syntax/lexer/token_kind.h"
+#include "syntax/parser/binding_power.h"
+#include "syntax/parser/build_green.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/event_sink.h"
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/parser/token_set.h"
+#include "syntax/text/diagnostic.h"
+
+// https://matklad.github.io/2020/04/13/simple-but-powerful-pratt-parsing.html
+namespace orion::syntax {
+namespace {
+/**
+ * Tokens a missing operand leaves for an enclosing rule: an infix operator
+ * that goes on without it, a `)` closing a group, or the end of the source.
+ * Prefix operators never get here, since they start an operand.
+ */
+constexpr TokenSet kOperandRecovery = {
+    TokenKind::kAsterisk, TokenKind::kSlash, TokenKind::kPercent,
+    TokenKind::kRParen,   TokenKind::kEof,
+};
+
+/** Tokens that can start an operand. */
+constexpr TokenSet kOperandFirst = {
+    TokenKind::kPlus,           TokenKind::kMinus,
+    TokenKind::kLParen,         TokenKind::kBooleanLiteral,
+    TokenKind::kStringLiteral,  TokenKind::kIntLiteral,
+    TokenKind::kBigIntLiteral,  TokenKind::kSmallIntLiteral,
+    TokenKind::kTinyIntLiteral, TokenKind::kFloatLiteral,
+    TokenKind::kDoubleLit,      TokenKind::kBigDecimalLiteral,
+    TokenKind::kIdentifier,
+};
+}  // namespace
+
+std::vector<Event> Parser::Parse() {
+  const Marker root = Start();
+  Expression(0);
+  SkipToClosing(TokenKind::kEof);
+
+  BumpTrivia();
+  Complete(root, SyntaxKind::kRoot);
+  return TakeEvents();
+}
+
+std::vector<Event> Parser::ParseParenExpr() {
+  const Marker paren = Start();
+  ParenBody();
+  while (!AtEnd()) {
+    ErrorAndBump("expected the end of the expression");
+  }
+
+  BumpTrivia();
+  Complete(paren, SyntaxKind::kParenExpr);
+  return TakeEvents();
+}
+
+std::optional<CompletedMarker> Parser::Expression(const uint8_t min_power) {
+  // Frames below `base` belong to an enclosing call, through SkipToClosing.
+  const size_t base = frames_.size();
+  uint8_t power = min_power;
+  std::optional<CompletedMarker> lhs;
+  bool at_operand = true;
+
+  while (true) {
+    if (at_operand) {
+      // Prefix operators bind tighter than any infix operator, so each one
+      // takes exactly the operand after it.
+      const size_t first_prefix = prefixes_.size();
+      while (IsPrefixOperator(Current()) && Depth() < max_depth_) {
+        prefixes_.push_back(Start());
+        Bump();
+      }
+
+      if (IsPrefixOperator(Current()) ||
+          (At(TokenKind::kLParen) && Depth() >= max_depth_)) {
+        lhs = SkipTooDeep();
+      } else if (At(TokenKind::kLParen)) {
+        const Marker paren = Start();
+        Bump();
+        frames_.push_back({FrameKind::kParen, paren, power,
+                           static_cast<uint32_t>(first_prefix)});
+        power = 0;
+        continue;
+      } else {
+        lhs = Atom();
+      }
+      lhs = CompletePrefixes(lhs, first_prefix);
+      at_operand = false;
+    }
+
+    const BindingPower binding = InfixBindingPower(Current());
+    // Operator frames are not limited: between two prefix operators or
+    // parentheses there are at most as many as there are precedence levels.
+    if (binding.IsInfix() && binding.left >= power) {
+      // A missing left operand was reported, and the expression starts at
+      // the operator instead.
+      const Marker binary = lhs.has_value() ? Precede(*lhs) : Start();
+      Bump();
+      frames_.push_back({FrameKind::kOperator, binary, power, 0});
+      power = binding.right;
+      at_operand = true;
+      continue;
+    }
+
+    // The innermost expression has ended, so resume the frame around it.
+    if (frames_.size() == base) {
+      return lhs;
+    }
+
+    if (frames_.back().kind == FrameKind::kOperator) {
+      power = frames_.back().min_power;
+      lhs = Complete(frames_.back().marker, SyntaxKind::kBinaryExpr);
+      frames_.pop_back();
+      continue;
+    }
+
+    if (frames_.back().kind == FrameKind::kStray) {
+      Complete(Precede(*lhs), SyntaxKind::kError);
+      frames_.pop_back();
+    }
+
+    // The top frame is now a group whose expression has ended.
+    if (SkipToStray(TokenKind::kRParen)) {
+      frames_.push_back({FrameKind::kStray, Marker(0), 0, 0});
+      power = 0;
+      at_operand = true;
+      continue;
+    }
+
+    Expect(TokenKind::kRParen, "expected ')'");
+    const Frame paren = frames_.back();
+    frames_.pop_back();
+    power = paren.min_power;
+    lhs = CompletePrefixes(Complete(paren.marker, SyntaxKind::kParenExpr),
+                           paren.first_prefix);
+  }
+}
+
+std::optional<CompletedMarker> Parser::Atom() {
+  SyntaxKind kind;
+  switch (ToSyntaxKind(Current())) {
+    case SyntaxKind::kBooleanLiteral:
+    case SyntaxKind::kStringLiteral:
+    case SyntaxKind::kNumericLiteral:
+      kind = SyntaxKind::kLiteral;
+      break;
+
+    case SyntaxKind::kIdentifier:
+      kind = SyntaxKind::kNameRef;
+      break;
+
+    default:
+      if (kOperandRecovery.Contains(Current())) {
+        Error("expected an operand");
+        return std::nullopt;
+      }
+      return ErrorAndBump("expected an operand");
+  }
+
+  const Marker atom = Start();
+  Bump();
+  return Complete(atom, kind);
+}
+
+std::optional<CompletedMarker> Parser::CompletePrefixes(
+    std::optional<CompletedMarker> operand, const size_t first) {
+  for (size_t i = prefixes_.size(); i-- > first;) {
+    operand = Complete(prefixes_[i], SyntaxKind::kPrefixExpr);
+  }
+  prefixes_.erase(prefixes_.begin() + static_cast<ptrdiff_t>(first),
+                  prefixes_.end());
+  return operand;
+}
+
+CompletedMarker Parser::SkipTooDeep() {
+  Error("expression nested too deeply");
+  const Marker error = Start();
+  while (IsPrefixOperator(Current())) {
+    Bump();
+  }
+
+  if (At(TokenKind::kLParen)) {
+    size_t open = 0;
+    do {
+      if (At(TokenKind::kLParen)) {
+        ++open;
+      } else if (At(TokenKind::kRParen)) {
+        --open;
+      }
+      Bump();
+    } while (open > 0 && !AtEnd());
+  } else if (kOperandFirst.Contains(Current())) {
+    Bump();
+  }
+  return Complete(error, SyntaxKind::kError);
+}
+
+void Parser::ParenBody() {
+  Expect(TokenKind::kLParen, "expected '('");
+  Expression(0);
+  SkipToClosing(TokenKind::kRParen);
+  Expect(TokenKind::kRParen, "expected ')'");
+}
+
+void Parser::SkipToClosing(const TokenKind closing) {
+  // Keep the structure of a stray expression, such as `2 * 3` in `1 2 * 3`,
+  // under one error node.
+  while (SkipToStray(closing)) {
+    Complete(Precede(*Expression(0)), SyntaxKind::kError);
+  }
+}
+
+bool Parser::SkipToStray(const TokenKind closing) {
+  while (!At(closing) && !AtEnd()) {
+    if (At(TokenKind::kRParen)) {
+      ErrorAndBump("unmatched ')'");
+    } else if (kOperandFirst.Contains(Current())) {
+      Error("expected an operator");
+      return true;
+    } else {
+      ErrorAndBump("expected an operator");
+    }
+  }
+  return false;
+}
+
+ParseResult ParseExpression(const std::u32string& source,
+                            GreenBuilder& builder, const size_t max_depth) {
+  Lexer lexer(source);
+  const std::vector<Token> tokens = lexer.Tokenize();
+  Parser parser(tokens, max_depth);
+  const std::vector<Event> events = parser.Parse();
+
+  std::vector<Diagnostic> diagnostics =
+      MergeDiagnostics(lexer.Diagnostics(), parser.Diagnostics());
+  return {BuildGreen(events, tokens, builder), std::move(diagnostics)};
+}
+
+ParseResult ParseExpression(const std::u32string& source) {
+  GreenBuilder builder;
+  return ParseExpression(source, builder);
+}
+}  // namespace orion::syntax
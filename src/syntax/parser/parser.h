@@ -0,0 +1,204 @@
+#ifndef SYNTAX_PARSER_PARSER_H_
+#define SYNTAX_PARSER_PARSER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "syntax/lexer/token.h"
+#include "syntax/parser/abstract_parser.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/event_sink.h"
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/text/diagnostic.h"
+
+namespace orion::syntax {
+
+/**
+ * How deeply nodes may nest by default. The parser and the tree algorithms
+ * use heap stacks, so this guards memory and recursive consumers rather than
+ * the parser itself.
+ */
+inline constexpr size_t kDefaultMaxDepth = 100'000;
+
+/**
+ * @brief Parses arithmetic expressions.
+ *
+ * The grammar is literals, names and parenthesized expressions combined
+ * with prefix `+ -` and infix `+ - * / %`. Precedence comes from the binding
+ * powers in `binding_power.h`, so adding an operator is a table entry.
+ *
+ * Parsing is a Pratt loop: after an operand, every following operator that
+ * binds at least as tightly as the caller allows wraps the operand so far in
+ * a `kBinaryExpr` through `Precede`, so left operands are never re-parsed and
+ * a left-associative chain is parsed by the loop rather than by recursion.
+ * Where a recursive parser would call itself, for a right operand or the
+ * inside of parentheses, this one pushes a frame onto a heap stack instead,
+ * so nesting is limited by `max_depth` rather than by the thread's stack. An
+ * operand nested deeper than that is reported and wrapped, unparsed, in a
+ * `kError` node.
+ *
+ * The tree is `kRoot` around one expression, with every token, trivia
+ * included. Syntax errors do not stop the parse: a missing operand or `)`
+ * is reported and left out, and tokens that fit nowhere are wrapped in
+ * `kError` nodes, skipping ahead only to a token an enclosing rule expects.
+ * Broken input therefore parses in one pass, as fast as valid input.
+ */
+class Parser final : public AbstractParser {
+ public:
+  /**
+   * @brief Constructs a parser over lexer tokens.
+   *
+   * @param tokens The tokens to parse, which must outlive the parser.
+   * @param max_depth The deepest nodes may nest before operands are skipped.
+   */
+  explicit Parser(const std::span<const Token> tokens,
+                  const size_t max_depth = kDefaultMaxDepth) noexcept
+      : AbstractParser(tokens), max_depth_(max_depth) {}
+  Parser() = delete;
+
+  /**
+   * @brief Parses the tokens as one expression.
+   *
+   * @return The events describing a `kRoot` node.
+   */
+  [[nodiscard]] std::vector<Event> Parse() override;
+
+  /**
+   * @brief Parses the tokens as one parenthesized expression, for reparsing
+   * a `kParenExpr` in place.
+   *
+   * Tokens after the closing `)` are reported and kept inside the node.
+   *
+   * @return The events describing a `kParenExpr` node.
+   */
+  [[nodiscard]] std::vector<Event> ParseParenExpr();
+
+ private:
+  /**
+   * @brief Parses an expression whose operators bind at least `min_power`.
+   *
+   * @return The expression, or `std::nullopt` if it is missing entirely.
+   */
+  std::optional<CompletedMarker> Expression(uint8_t min_power);
+
+  /** What an unfinished construct does once the expression in it ends. */
+  enum class FrameKind : uint8_t {
+    /** Completes a `kBinaryExpr` around its right operand. */
+    kOperator,
+
+    /** Skips to and consumes the `)`, then completes a `kParenExpr`. */
+    kParen,
+
+    /** Wraps a stray expression inside parentheses in a `kError` node. */
+    kStray,
+  };
+
+  /** An unfinished construct, waiting for the expression inside it. */
+  struct Frame {
+    FrameKind kind;
+
+    /** The node to complete, unless the frame is a `kStray`. */
+    Marker marker;
+
+    /** The power of the expression the construct is an operand of. */
+    uint8_t min_power;
+
+    /** For a `kParen`, where its prefix operators start in `prefixes_`. */
+    uint32_t first_prefix;
+  };
+
+  /**
+   * @brief Returns how deeply the next node would be nested.
+   */
+  [[nodiscard]] size_t Depth() const noexcept {
+    return frames_.size() + prefixes_.size();
+  }
+
+  /**
+   * @brief Parses a literal or a name.
+   */
+  std::optional<CompletedMarker> Atom();
+
+  /**
+   * @brief Completes the prefix operators from `first` onward around an
+   * operand, innermost first.
+   */
+  std::optional<CompletedMarker> CompletePrefixes(
+      std::optional<CompletedMarker> operand, size_t first);
+
+  /**
+   * @brief Wraps an operand nested deeper than `max_depth_`, prefix
+   * operators and parentheses included, in one `kError` node.
+   */
+  CompletedMarker SkipTooDeep();
+
+  /**
+   * @brief Parses the parentheses and the expression between them, into the
+   * open node.
+   */
+  void ParenBody();
+
+  /**
+   * @brief Wraps the tokens before `closing` or the end of the source in
+   * `kError` nodes, after a complete expression.
+   */
+  void SkipToClosing(TokenKind closing);
+
+  /**
+   * @brief Wraps tokens before `closing` or the end of the source in
+   * `kError` nodes, stopping early at a stray operand.
+   *
+   * @return Whether it stopped at a stray operand, which the caller parses
+   * and wraps.
+   */
+  bool SkipToStray(TokenKind closing);
+
+  size_t max_depth_;
+  std::vector<Frame> frames_;
+  std::vector<Marker> prefixes_;
+};
+
+/**
+ * @brief A tree together with the syntax errors found while building it.
+ */
+struct ParseResult {
+  /** The `kRoot` node, covering the whole source. */
+  GreenNode root;
+
+  /** The lexer and parser diagnostics, in source order. */
+  std::vector<Diagnostic> diagnostics;
+};
+
+/**
+ * @brief Lexes, parses and builds the tree of an expression.
+ *
+ * Any source parses: errors are returned as diagnostics next to a tree that
+ * still holds all of the source text.
+ *
+ * @param source The source text.
+ * @param builder The builder to build with, which is reset first.
+ * @param max_depth The deepest nodes may nest before operands are skipped.
+ * @return The tree and its diagnostics.
+ */
+[[nodiscard]] ParseResult ParseExpression(
+    const std::u32string& source, GreenBuilder& builder,
+    size_t max_depth = kDefaultMaxDepth);
+
+/**
+ * @brief Lexes, parses and builds the tree of an expression with a fresh
+ * builder.
+ *
+ * @param source The source text.
+ * @return The tree and its diagnostics.
+ */
+[[nodiscard]] ParseResult ParseExpression(const std::u32string& source);
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_PARSER_H_
@@ -0,0 +1,249 @@
+#include "syntax/parser/reparse.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "syntax/lexer/lexer.h"
+#include "syntax/lexer/token.h"
+#include "syntax/lexer/token_kind.h"
+#include "syntax/parser/abstract_parser.h"
+#include "syntax/parser/build_green.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/parser.h"
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/rgtree/syntax/syntax_editor.h"
+#include "syntax/parser/rgtree/syntax/syntax_element.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_text.h"
+#include "syntax/parser/rgtree/syntax/syntax_token.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/text/offset_map.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+#include "syntax/util/utf8.h"
+
+// https://github.com/rust-lang/rust-analyzer/blob/master/crates/syntax/src/parsing/reparsing.rs
+namespace orion::syntax {
+namespace {
+/**
+ * @brief The edit being applied, with its range in old offsets.
+ */
+struct Change {
+  TextRange range;
+  std::u32string_view text;
+};
+
+// Applies `change` to `source`, which starts at `origin` in the old text.
+std::u32string Apply(const std::string_view source, const TextSize origin,
+                     const Change& change) {
+  const std::u32string old = DecodeUtf8(source);
+  const auto start = static_cast<size_t>(change.range.Start() - origin);
+  const auto end = static_cast<size_t>(change.range.End() - origin);
+
+  std::u32string out;
+  out.reserve(old.size() - (end - start) + change.text.size());
+  out.append(old, 0, start);
+  out.append(change.text);
+  out.append(old, end);
+  return out;
+}
+
+// Checks that no old diagnostic is in or next to the region being reparsed,
+// so every old diagnostic survives the reparse unchanged.
+bool IsClean(const TextRange region,
+             const std::span<const Diagnostic> diagnostics) noexcept {
+  return std::ranges::none_of(diagnostics, [region](const Diagnostic& d) {
+    return d.range.Start() <= region.End() && region.Start() <= d.range.End();
+  });
+}
+
+// Tokens whose text may change without changing the shape of the tree.
+bool IsRelexable(const SyntaxKind kind) noexcept {
+  switch (kind) {
+    case SyntaxKind::kWhitespace:
+    case SyntaxKind::kNewline:
+    case SyntaxKind::kComment:
+    case SyntaxKind::kBooleanLiteral:
+    case SyntaxKind::kStringLiteral:
+    case SyntaxKind::kNumericLiteral:
+    case SyntaxKind::kIdentifier:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Checks that the tokens are one parenthesized group: the first token is a
+// `(` whose matching `)` is the last token.
+bool IsBalanced(const std::vector<Token>& tokens) noexcept {
+  if (tokens.empty() ||
+      tokens.front().GetKind<TokenKind>() != TokenKind::kLParen ||
+      tokens.back().GetKind<TokenKind>() != TokenKind::kRParen) {
+    return false;
+  }
+
+  size_t depth = 0;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    const auto kind = tokens[i].GetKind<TokenKind>();
+    if (kind == TokenKind::kLParen) {
+      ++depth;
+    } else if (kind == TokenKind::kRParen) {
+      if (depth == 0 || (--depth == 0 && i + 1 != tokens.size())) {
+        return false;
+      }
+    }
+  }
+  return depth == 0;
+}
+
+// Splices `replacement` into the tree in place of a child, mapping offsets
+// by the text edit itself rather than by the replaced child.
+SyntaxEdit Replace(const SyntaxNode& parent, const size_t index,
+                   GreenElement replacement, const Change& change) {
+  SyntaxEditor editor(parent);
+  editor.ReplaceChild(parent, index, std::move(replacement));
+  SyntaxEdit edit = editor.Finish();
+
+  edit.offsets = OffsetMap();
+  edit.offsets.Add(change.range, TextSize::Of(change.text.size()));
+  return edit;
+}
+
+std::optional<SyntaxEdit> RelexToken(
+    const SyntaxNode& root, const Change& change,
+    const std::span<const Diagnostic> diagnostics) {
+  const SyntaxElement covering = root.CoveringElement(change.range);
+  const SyntaxToken* token = covering.AsToken();
+  if (token == nullptr || !IsRelexable(token->Kind()) ||
+      !IsClean(token->Range(), diagnostics)) {
+    return std::nullopt;
+  }
+
+  std::u32string source = Apply(token->Text(), token->Offset(), change);
+  const size_t length = source.size();
+  if (length == 0) {
+    return std::nullopt;
+  }
+
+  // Lexing one more code point shows whether the new token would swallow
+  // the start of the next one.
+  const TextSize end = token->Range().End();
+  if (end < root.Range().End()) {
+    const SyntaxText next = root.Text().Slice(TextRange::At(end, TextSize(1)));
+    source.push_back(*next.CharAt(TextSize()));
+  }
+
+  Lexer lexer(source);
+  const std::optional<Token> relexed = lexer.TryNextToken();
+  if (!relexed.has_value() || !lexer.Diagnostics().empty() ||
+      static_cast<size_t>(relexed->Span().Len()) != length ||
+      ToSyntaxKind(relexed->GetKind<TokenKind>()) != token->Kind()) {
+    return std::nullopt;
+  }
+
+  return Replace(token->Parent(), token->IndexInParent(),
+                 GreenToken(token->Kind(), relexed->Symbol()), change);
+}
+
+std::optional<SyntaxEdit> ReparseParen(
+    const SyntaxNode& root, const Change& change,
+    const std::span<const Diagnostic> diagnostics, GreenBuilder& builder) {
+  const SyntaxElement covering = root.CoveringElement(change.range);
+  std::optional<SyntaxNode> node =
+      covering.IsNode() ? std::optional(*covering.AsNode())
+                        : covering.Parent();
+  while (node.has_value() && node->Kind() != SyntaxKind::kParenExpr) {
+    node = node->Parent();
+  }
+  if (!node.has_value() || !IsClean(node->Range(), diagnostics)) {
+    return std::nullopt;
+  }
+
+  // A group that was never closed has its errors reported at the end of the
+  // input, past the node's range, so `IsClean` cannot see them.
+  const std::optional<SyntaxElement> last = node->LastChildOrToken();
+  if (!last.has_value() || !last->IsToken() ||
+      last->Kind() != SyntaxKind::kRParen) {
+    return std::nullopt;
+  }
+
+  const std::u32string source =
+      Apply(node->Text().ToString(), node->Offset(), change);
+  Lexer lexer(source);
+  const std::vector<Token> tokens = lexer.Tokenize();
+  if (!lexer.Diagnostics().empty() || !IsBalanced(tokens)) {
+    return std::nullopt;
+  }
+
+  // Errors inside the group would need reporting, so they are left to a
+  // full parse.
+  Parser parser(tokens);
+  const std::vector<Event> events = parser.ParseParenExpr();
+  if (!parser.Diagnostics().empty()) {
+    return std::nullopt;
+  }
+
+  // A parenthesized expression is never the root.
+  return Replace(*node->Parent(), node->IndexInParent(),
+                 BuildGreen(events, tokens, builder), change);
+}
+
+SyntaxEdit ParseAll(const SyntaxNode& root, const Change& change,
+                    GreenBuilder& builder,
+                    std::vector<Diagnostic>& diagnostics) {
+  const std::u32string source =
+      Apply(root.Text().ToString(), root.Offset(), change);
+  ParseResult parse = ParseExpression(source, builder);
+  diagnostics = std::move(parse.diagnostics);
+
+  OffsetMap offsets;
+  offsets.Add(change.range, TextSize::Of(change.text.size()));
+  return {SyntaxNode::CreateRoot(std::move(parse.root)), std::move(offsets)};
+}
+}  // namespace
+
+SyntaxEdit Reparse(const SyntaxNode& root, const TextRange range,
+                   const std::u32string_view text, GreenBuilder& builder,
+                   std::vector<Diagnostic>& diagnostics) {
+  if (root.Parent().has_value()) {
+    throw std::invalid_argument("node is not a root");
+  }
+  if (!root.Range().ContainsRange(range)) {
+    throw std::invalid_argument("edit is outside the tree");
+  }
+
+  const Change change{range, text};
+  std::optional<SyntaxEdit> edit = RelexToken(root, change, diagnostics);
+  if (!edit.has_value()) {
+    edit = ReparseParen(root, change, diagnostics, builder);
+  }
+  if (!edit.has_value()) {
+    return ParseAll(root, change, builder, diagnostics);
+  }
+
+  // The reparsed region had no diagnostics before or after, so the others
+  // only move.
+  for (Diagnostic& diagnostic : diagnostics) {
+    diagnostic.range = edit->offsets.Map(diagnostic.range);
+  }
+  return std::move(*edit);
+}
+
+SyntaxEdit Reparse(const SyntaxNode& root, const TextRange range,
+                   const std::u32string_view text,
+                   std::vector<Diagnostic>& diagnostics) {
+  GreenBuilder builder;
+  return Reparse(root, range, text, builder, diagnostics);
+}
+}  // namespace orion::syntax
@@ -0,0 +1,71 @@
+#ifndef SYNTAX_PARSER_REPARSE_H_
+#define SYNTAX_PARSER_REPARSE_H_
+
+#include <string_view>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/syntax/syntax_editor.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/text/text_range.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief Applies a text edit to a parsed tree, reparsing as little of it as
+ * possible.
+ *
+ * Two regions are tried, smallest first:
+ *
+ * 1. A single token of a kind whose text can change without changing the
+ *    tree's shape (trivia, names, literals) is relexed on its own. The new
+ *    text must lex to one token of the same kind, which would not merge
+ *    with the token after it.
+ * 2. Otherwise, the smallest parenthesized expression containing the edit
+ *    is relexed and reparsed on its own, provided its new text still starts
+ *    with the `(` that closes last.
+ *
+ * The result is spliced into a new root that shares every untouched subtree
+ * with the old one, so the cost follows the size of the reparsed region and
+ * the depth of the tree rather than the size of the source. When neither
+ * region applies, the whole source is parsed again.
+ *
+ * A region is only reparsed on its own if it had no diagnostics and still
+ * has none, so the other diagnostics just move with the edit. Errors in or
+ * next to the edit are left to the full parse.
+ *
+ * @param root The root of a tree built by `ParseExpression`.
+ * @param range The range of old text to replace.
+ * @param text The replacement text.
+ * @param builder The builder to build reparsed regions with.
+ * @param diagnostics The diagnostics of `root`, replaced with those of the
+ * new root.
+ * @return The new root, and the mapping from old offsets to new ones.
+ * @throws std::invalid_argument If `root` is not a root or `range` is
+ * outside it.
+ */
+[[nodiscard]] SyntaxEdit Reparse(const SyntaxNode& root, TextRange range,
+                                 std::u32string_view text,
+                                 GreenBuilder& builder,
+                                 std::vector<Diagnostic>& diagnostics);
+
+/**
+ * @brief Applies a text edit to a parsed tree with a fresh builder.
+ *
+ * @param root The root of a tree built by `ParseExpression`.
+ * @param range The range of old text to replace.
+ * @param text The replacement text.
+ * @param diagnostics The diagnostics of `root`, replaced with those of the
+ * new root.
+ * @return The new root, and the mapping from old offsets to new ones.
+ * @throws std::invalid_argument If `root` is not a root or `range` is
+ * outside it.
+ */
+[[nodiscard]] SyntaxEdit Reparse(const SyntaxNode& root, TextRange range,
+                                 std::u32string_view text,
+                                 std::vector<Diagnostic>& diagnostics);
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_REPARSE_H_
@@ -0,0 +1,394 @@
+#include "syntax/parser/rgtree/green/green_archive.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "syntax/interner/interner.h"
+#include "syntax/io/mapped_file.h"
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/util/utf8.h"
+
+namespace orion::syntax {
+namespace {
+constexpr char kMagic[4] = {'O', 'G', 'R', 'N'};
+
+static_assert(sizeof(GreenArchiveHeader) == 40);
+static_assert(sizeof(GreenArchiveToken) == 16);
+static_assert(sizeof(GreenArchiveNode) == 16);
+
+// Records are read in place, so the archive is only portable between hosts
+// sharing the on-disk byte order.
+void RequireLittleEndian() {
+  if constexpr (std::endian::native != std::endian::little) {
+    throw std::runtime_error("green archives require a little-endian host");
+  }
+}
+
+uint32_t CheckedCount(const size_t count) {
+  if (count >= kGreenArchiveTokenBit) {
+    throw std::length_error("green tree is too large to archive");
+  }
+  return static_cast<uint32_t>(count);
+}
+
+template <typename T>
+void AppendRecords(std::string& out, const std::vector<T>& records) {
+  out.append(reinterpret_cast<const char*>(records.data()),
+             records.size() * sizeof(T));
+}
+
+// Collects the distinct nodes and tokens of a tree in post-order.
+class ArchiveWriter {
+ public:
+  void Write(const GreenNode& root) {
+    struct Frame {
+      const GreenNodeData* node;
+      size_t next_child;
+    };
+
+    // An explicit stack keeps deep trees from overflowing the call stack.
+    std::vector<Frame> stack{{&root.Data(), 0}};
+    while (!stack.empty()) {
+      Frame& frame = stack.back();
+      const auto& children = frame.node->Children();
+
+      if (frame.next_child < children.size()) {
+        const GreenElement& child = children[frame.next_child++];
+        if (const GreenToken* token = child.AsToken()) {
+          AddToken(*token);
+        } else if (const GreenNode* node = child.AsNode();
+                   !node_ids_.contains(&node->Data())) {
+          stack.push_back({&node->Data(), 0});
+        }
+        continue;
+      }
+
+      AddNode(*frame.node);
+      stack.pop_back();
+    }
+
+    root_ = node_ids_.at(&root.Data());
+  }
+
+  [[nodiscard]] std::string Finish(const uint64_t content_hash) const {
+    GreenArchiveHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kGreenArchiveVersion;
+    header.grammar = kSyntaxKindHash;
+    header.content_hash = content_hash;
+    header.text_size = CheckedCount(text_.size());
+    header.token_count = CheckedCount(tokens_.size());
+    header.node_count = CheckedCount(nodes_.size());
+    header.child_count = CheckedCount(children_.size());
+    header.root = root_;
+
+    std::string out;
+    out.reserve(sizeof(header) + tokens_.size() * sizeof(GreenArchiveToken) +
+                nodes_.size() * sizeof(GreenArchiveNode) +
+                children_.size() * 2 * sizeof(uint32_t) + text_.size());
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    AppendRecords(out, tokens_);
+    AppendRecords(out, nodes_);
+    AppendRecords(out, children_);
+    AppendRecords(out, child_offsets_);
+    out.append(text_);
+
+    return out;
+  }
+
+ private:
+  void AddToken(const GreenToken& token) {
+    // Tokens are keyed by value rather than identity, so equal tokens that
+    // were not deduplicated by a cache still share one record.
+    const uint64_t key = (static_cast<uint64_t>(token.Kind()) << 32) |
+                         token.Symbol().Id();
+    if (token_ids_.contains(key)) {
+      return;
+    }
+
+    auto [text, inserted] =
+        text_offsets_.try_emplace(token.Symbol().Id(), text_.size());
+    if (inserted) {
+      text_.append(token.Text());
+    }
+
+    token_ids_.emplace(key, CheckedCount(tokens_.size()));
+    tokens_.push_back({static_cast<uint16_t>(token.Kind()), 0,
+                       CheckedCount(text->second),
+                       static_cast<uint32_t>(token.Text().size()),
+                       token.Width().Raw()});
+  }
+
+  void AddNode(const GreenNodeData& node) {
+    const auto& children = node.Children();
+    const uint32_t first_child = CheckedCount(children_.size());
+
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (const GreenToken* token = children[i].AsToken()) {
+        const uint64_t key = (static_cast<uint64_t>(token->Kind()) << 32) |
+                             token->Symbol().Id();
+        children_.push_back(token_ids_.at(key) | kGreenArchiveTokenBit);
+      } else {
+        children_.push_back(node_ids_.at(&children[i].AsNode()->Data()));
+      }
+      child_offsets_.push_back(node.ChildOffset(i).Raw());
+    }
+
+    node_ids_.emplace(&node, CheckedCount(nodes_.size()));
+    nodes_.push_back({static_cast<uint16_t>(node.Kind()), 0,
+                      node.Width().Raw(), first_child,
+                      static_cast<uint32_t>(children.size())});
+  }
+
+  std::unordered_map<const GreenNodeData*, uint32_t> node_ids_;
+  std::unordered_map<uint64_t, uint32_t> token_ids_;
+  std::unordered_map<uint32_t, size_t> text_offsets_;
+
+  std::vector<GreenArchiveToken> tokens_;
+  std::vector<GreenArchiveNode> nodes_;
+  std::vector<uint32_t> children_;
+  std::vector<uint32_t> child_offsets_;
+  std::string text_;
+  uint32_t root_ = 0;
+};
+
+[[noreturn]] void Corrupt(const char* reason) {
+  throw std::invalid_argument(std::string("invalid green archive: ") + reason);
+}
+
+// Checks every record once, so views can later index without bounds checks.
+GreenArchiveSections Validate(const std::string_view bytes) {
+  RequireLittleEndian();
+
+  if (bytes.size() < sizeof(GreenArchiveHeader)) {
+    Corrupt("truncated header");
+  }
+
+  // Both mmap and heap allocations are suitably aligned, but a caller could
+  // hand over a buffer that is not.
+  if (reinterpret_cast<uintptr_t>(bytes.data()) %
+          alignof(GreenArchiveHeader) !=
+      0) {
+    Corrupt("misaligned buffer");
+  }
+
+  GreenArchiveSections sections{};
+  sections.header = reinterpret_cast<const GreenArchiveHeader*>(bytes.data());
+  const GreenArchiveHeader& header = *sections.header;
+
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    Corrupt("bad magic");
+  }
+  if (header.version != kGreenArchiveVersion) {
+    Corrupt("unsupported version");
+  }
+  if (header.grammar != kSyntaxKindHash) {
+    Corrupt("written with another grammar");
+  }
+
+  const uint64_t expected_size =
+      sizeof(GreenArchiveHeader) +
+      uint64_t{header.token_count} * sizeof(GreenArchiveToken) +
+      uint64_t{header.node_count} * sizeof(GreenArchiveNode) +
+      uint64_t{header.child_count} * 2 * sizeof(uint32_t) + header.text_size;
+  if (expected_size != bytes.size()) {
+    Corrupt("size does not match header");
+  }
+
+  const char* cursor = bytes.data() + sizeof(GreenArchiveHeader);
+  sections.tokens = reinterpret_cast<const GreenArchiveToken*>(cursor);
+  cursor += size_t{header.token_count} * sizeof(GreenArchiveToken);
+  sections.nodes = reinterpret_cast<const GreenArchiveNode*>(cursor);
+  cursor += size_t{header.node_count} * sizeof(GreenArchiveNode);
+  sections.children = reinterpret_cast<const uint32_t*>(cursor);
+  cursor += size_t{header.child_count} * sizeof(uint32_t);
+  sections.child_offsets = reinterpret_cast<const uint32_t*>(cursor);
+  cursor += size_t{header.child_count} * sizeof(uint32_t);
+  sections.text = cursor;
+
+  // Kinds index tables such as `kSyntaxKindInfos`, and views report offsets
+  // from the stored widths, so both are checked against what they describe.
+  for (uint32_t i = 0; i < header.token_count; ++i) {
+    const GreenArchiveToken& token = sections.tokens[i];
+    if (token.kind >= kSyntaxKindCount) {
+      Corrupt("token kind out of range");
+    }
+    if (uint64_t{token.text_offset} + token.text_size > header.text_size) {
+      Corrupt("token text out of bounds");
+    }
+    const std::string_view text(sections.text + token.text_offset,
+                                token.text_size);
+    if (CountCodepoints(text) != token.width) {
+      Corrupt("token width mismatch");
+    }
+  }
+
+  for (uint32_t i = 0; i < header.node_count; ++i) {
+    const GreenArchiveNode& node = sections.nodes[i];
+    if (node.kind >= kSyntaxKindCount) {
+      Corrupt("node kind out of range");
+    }
+    if (uint64_t{node.first_child} + node.child_count > header.child_count) {
+      Corrupt("node children out of bounds");
+    }
+
+    uint64_t offset = 0;
+    for (uint32_t j = 0; j < node.child_count; ++j) {
+      const uint32_t child = sections.children[node.first_child + j];
+      uint32_t width;
+      if ((child & kGreenArchiveTokenBit) != 0) {
+        const uint32_t id = child & ~kGreenArchiveTokenBit;
+        if (id >= header.token_count) {
+          Corrupt("token id out of bounds");
+        }
+        width = sections.tokens[id].width;
+      } else {
+        // Post-order guarantees acyclicity: children always precede parents.
+        if (child >= i) {
+          Corrupt("node id out of order");
+        }
+        width = sections.nodes[child].width;
+      }
+
+      if (sections.child_offsets[node.first_child + j] != offset) {
+        Corrupt("child offset mismatch");
+      }
+      offset += width;
+    }
+
+    if (offset != node.width) {
+      Corrupt("node width mismatch");
+    }
+  }
+
+  if (header.root >= header.node_count) {
+    Corrupt("root out of bounds");
+  }
+
+  return sections;
+}
+}  // namespace
+
+/**
+ * @brief The bytes backing an archive and the sections found in them.
+ *
+ * Held behind a `shared_ptr`, so the section pointers handed to views stay
+ * valid when the `GreenArchive` itself is moved.
+ */
+struct GreenArchive::Storage {
+  std::optional<MappedFile> file;
+  std::string buffer;
+  GreenArchiveSections sections{};
+};
+
+std::string SerializeGreenTree(const GreenNode& root,
+                               const uint64_t content_hash) {
+  RequireLittleEndian();
+
+  ArchiveWriter writer;
+  writer.Write(root);
+  return writer.Finish(content_hash);
+}
+
+void SaveGreenTree(const std::filesystem::path& path, const GreenNode& root,
+                   const uint64_t content_hash) {
+  const std::string bytes = SerializeGreenTree(root, content_hash);
+
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  if (!stream) {
+    throw std::system_error(std::make_error_code(std::errc::io_error),
+                            path.string());
+  }
+}
+
+GreenArchive GreenArchive::Open(const std::filesystem::path& path) {
+  return FromMappedFile(MappedFile::Open(path), 0);
+}
+
+GreenArchive GreenArchive::FromMappedFile(MappedFile file,
+                                          const size_t offset) {
+  if (offset > file.Size()) {
+    Corrupt("truncated header");
+  }
+
+  auto storage = std::make_shared<Storage>();
+  storage->file.emplace(std::move(file));
+  storage->sections = Validate(storage->file->Bytes().substr(offset));
+  return GreenArchive(std::move(storage));
+}
+
+GreenArchive GreenArchive::FromBytes(std::string bytes) {
+  auto storage = std::make_shared<Storage>();
+  storage->buffer = std::move(bytes);
+  storage->sections = Validate(storage->buffer);
+  return GreenArchive(std::move(storage));
+}
+
+uint64_t GreenArchive::ContentHash() const noexcept {
+  return storage_->sections.header->content_hash;
+}
+
+size_t GreenArchive::NodeCount() const noexcept {
+  return storage_->sections.header->node_count;
+}
+
+size_t GreenArchive::TokenCount() const noexcept {
+  return storage_->sections.header->token_count;
+}
+
+GreenNodeView GreenArchive::Root() const noexcept {
+  return GreenNodeView(&storage_->sections,
+                       storage_->sections.header->root);
+}
+
+GreenNode GreenArchive::Materialize() const {
+  const GreenArchiveSections& sections = storage_->sections;
+  const GreenArchiveHeader& header = *sections.header;
+
+  std::vector<GreenToken> tokens;
+  tokens.reserve(header.token_count);
+  for (uint32_t i = 0; i < header.token_count; ++i) {
+    const GreenTokenView view(&sections, i);
+    tokens.emplace_back(view.Kind(), Interner::Global().Intern(view.Text()));
+  }
+
+  // Node ids are in post-order, so every child is built before its parent.
+  std::vector<GreenNode> nodes;
+  nodes.reserve(header.node_count);
+  for (uint32_t i = 0; i < header.node_count; ++i) {
+    const GreenArchiveNode& record = sections.nodes[i];
+
+    std::vector<GreenElement> children;
+    children.reserve(record.child_count);
+    for (uint32_t j = 0; j < record.child_count; ++j) {
+      const uint32_t child = sections.children[record.first_child + j];
+      if ((child & kGreenArchiveTokenBit) != 0) {
+        children.emplace_back(tokens[child & ~kGreenArchiveTokenBit]);
+      } else {
+        children.emplace_back(nodes[child]);
+      }
+    }
+
+    nodes.emplace_back(static_cast<SyntaxKind>(record.kind),
+                       std::move(children));
+  }
+
+  return nodes[header.root];
+}
+}  // namespace orion::syntax
@@ -0,0 +1,471 @@
+#ifndef SYNTAX_PARSER_RGTREE_GREEN_GREEN_ARCHIVE_H_
+#define SYNTAX_PARSER_RGTREE_GREEN_GREEN_ARCHIVE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "syntax/io/mapped_file.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_size.h"
+
+// Layout of a green archive. All fields are little-endian and every section
+// is four-byte aligned:
+//
+//   GreenArchiveHeader
+//   GreenArchiveToken[token_count]
+//   GreenArchiveNode[node_count]
+//   uint32_t children[child_count]       (token ids have kGreenArchiveTokenBit)
+//   uint32_t child_offsets[child_count]  (relative to the parent)
+//   char text[text_size]
+//
+// Nodes are written in post-order, so every child id is smaller than the id of
+// its parent and a tree can be rebuilt in a single forward pass.
+namespace orion::syntax {
+
+/**
+ * Version of the archive layout; bumped on any incompatible change. Kind
+ * numbering is checked apart from it, through `GreenArchiveHeader::grammar`.
+ */
+constexpr uint32_t kGreenArchiveVersion = 2;
+
+/** Set on a child id that refers to a token rather than a node. */
+constexpr uint32_t kGreenArchiveTokenBit = uint32_t{1} << 31;
+
+/**
+ * @brief The fixed-size header at the start of every archive.
+ */
+struct GreenArchiveHeader {
+  /** Always `"OGRN"`. */
+  char magic[4];
+
+  /** The layout version, `kGreenArchiveVersion`. */
+  uint32_t version;
+
+  /** A caller-provided hash of the source the tree was parsed from. */
+  uint64_t content_hash;
+
+  /** Number of bytes of token text. */
+  uint32_t text_size;
+
+  /** Number of distinct tokens. */
+  uint32_t token_count;
+
+  /** Number of distinct nodes. */
+  uint32_t node_count;
+
+  /** Number of child references across all nodes. */
+  uint32_t child_count;
+
+  /** Id of the root node. */
+  uint32_t root;
+
+  /** The grammar the kinds are numbered by, `kSyntaxKindHash`. */
+  uint32_t grammar;
+};
+
+/**
+ * @brief A token record in an archive.
+ */
+struct GreenArchiveToken {
+  /** The token's `SyntaxKind`. */
+  uint16_t kind;
+
+  /** Reserved, always zero. */
+  uint16_t reserved;
+
+  /** Offset of the token's UTF-8 text in the text section. */
+  uint32_t text_offset;
+
+  /** Number of bytes of text. */
+  uint32_t text_size;
+
+  /** Width of the token in code points. */
+  uint32_t width;
+};
+
+/**
+ * @brief A node record in an archive.
+ */
+struct GreenArchiveNode {
+  /** The node's `SyntaxKind`. */
+  uint16_t kind;
+
+  /** Reserved, always zero. */
+  uint16_t reserved;
+
+  /** Width of the node in code points. */
+  uint32_t width;
+
+  /** Index of the node's first entry in the child sections. */
+  uint32_t first_child;
+
+  /** Number of children. */
+  uint32_t child_count;
+};
+
+/**
+ * @brief Pointers to the sections of a validated archive.
+ */
+struct GreenArchiveSections {
+  const GreenArchiveHeader* header;
+  const GreenArchiveToken* tokens;
+  const GreenArchiveNode* nodes;
+  const uint32_t* children;
+  const uint32_t* child_offsets;
+  const char* text;
+};
+
+/**
+ * @brief A read-only view of a token stored in an archive.
+ */
+class GreenTokenView {
+ public:
+  /**
+   * @brief Constructs a view of a token.
+   *
+   * @param sections The archive holding the token.
+   * @param id The token's id.
+   */
+  explicit GreenTokenView(const GreenArchiveSections* sections,
+                          const uint32_t id) noexcept
+      : sections_(sections), id_(id) {}
+
+  /**
+   * @brief Returns the kind of the token.
+   *
+   * @return The token's `SyntaxKind`.
+   */
+  [[nodiscard]] SyntaxKind Kind() const noexcept {
+    return static_cast<SyntaxKind>(Record().kind);
+  }
+
+  /**
+   * @brief Returns the token's text, pointing into the archive.
+   *
+   * @return A view of the token's UTF-8 text.
+   */
+  [[nodiscard]] std::string_view Text() const noexcept {
+    return {sections_->text + Record().text_offset, Record().text_size};
+  }
+
+  /**
+   * @brief Returns the width of the token.
+   *
+   * @return The width of the token in code points.
+   */
+  [[nodiscard]] TextSize Width() const noexcept {
+    return TextSize(Record().width);
+  }
+
+  /**
+   * @brief Returns the token's id within the archive.
+   *
+   * @return The token id.
+   */
+  [[nodiscard]] uint32_t Id() const noexcept { return id_; }
+
+ private:
+  [[nodiscard]] const GreenArchiveToken& Record() const noexcept {
+    return sections_->tokens[id_];
+  }
+
+  /** The archive holding the token. */
+  const GreenArchiveSections* sections_;
+
+  /** The token's id. */
+  uint32_t id_;
+};
+
+class GreenElementView;
+
+/**
+ * @brief A read-only view of a node stored in an archive.
+ */
+class GreenNodeView {
+ public:
+  /**
+   * @brief Constructs a view of a node.
+   *
+   * @param sections The archive holding the node.
+   * @param id The node's id.
+   */
+  explicit GreenNodeView(const GreenArchiveSections* sections,
+                         const uint32_t id) noexcept
+      : sections_(sections), id_(id) {}
+
+  /**
+   * @brief Returns the kind of the node.
+   *
+   * @return The node's `SyntaxKind`.
+   */
+  [[nodiscard]] SyntaxKind Kind() const noexcept {
+    return static_cast<SyntaxKind>(Record().kind);
+  }
+
+  /**
+   * @brief Returns the width of the node.
+   *
+   * @return The width of the node in code points.
+   */
+  [[nodiscard]] TextSize Width() const noexcept {
+    return TextSize(Record().width);
+  }
+
+  /**
+   * @brief Returns the number of children.
+   *
+   * @return The child count.
+   */
+  [[nodiscard]] size_t ChildCount() const noexcept {
+    return Record().child_count;
+  }
+
+  /**
+   * @brief Returns a child of the node.
+   *
+   * @param index The index of the child, less than `ChildCount()`.
+   * @return A view of the child.
+   */
+  [[nodiscard]] GreenElementView Child(size_t index) const noexcept;
+
+  /**
+   * @brief Returns the offset of a child relative to the start of the node.
+   *
+   * @param index The index of the child, less than `ChildCount()`.
+   * @return The relative offset of the child.
+   */
+  [[nodiscard]] TextSize ChildOffset(const size_t index) const noexcept {
+    return TextSize(sections_->child_offsets[Record().first_child + index]);
+  }
+
+  /**
+   * @brief Returns the node's id within the archive.
+   *
+   * @return The node id.
+   */
+  [[nodiscard]] uint32_t Id() const noexcept { return id_; }
+
+ private:
+  [[nodiscard]] const GreenArchiveNode& Record() const noexcept {
+    return sections_->nodes[id_];
+  }
+
+  /** The archive holding the node. */
+  const GreenArchiveSections* sections_;
+
+  /** The node's id. */
+  uint32_t id_;
+};
+
+/**
+ * @brief A read-only view of either a node or a token stored in an archive.
+ */
+class GreenElementView {
+ public:
+  /**
+   * @brief Constructs a view from an encoded child id.
+   *
+   * @param sections The archive holding the element.
+   * @param encoded The child id, with `kGreenArchiveTokenBit` set for tokens.
+   */
+  explicit GreenElementView(const GreenArchiveSections* sections,
+                            const uint32_t encoded) noexcept
+      : sections_(sections), encoded_(encoded) {}
+
+  /**
+   * @brief Checks if the element is a node.
+   */
+  [[nodiscard]] bool IsNode() const noexcept {
+    return (encoded_ & kGreenArchiveTokenBit) == 0;
+  }
+
+  /**
+   * @brief Checks if the element is a token.
+   */
+  [[nodiscard]] bool IsToken() const noexcept { return !IsNode(); }
+
+  /**
+   * @brief Returns the element as a node.
+   *
+   * @return The node view, or `nullopt` if the element is a token.
+   */
+  [[nodiscard]] std::optional<GreenNodeView> AsNode() const noexcept {
+    if (!IsNode()) {
+      return std::nullopt;
+    }
+    return GreenNodeView(sections_, encoded_);
+  }
+
+  /**
+   * @brief Returns the element as a token.
+   *
+   * @return The token view, or `nullopt` if the element is a node.
+   */
+  [[nodiscard]] std::optional<GreenTokenView> AsToken() const noexcept {
+    if (!IsToken()) {
+      return std::nullopt;
+    }
+    return GreenTokenView(sections_, encoded_ & ~kGreenArchiveTokenBit);
+  }
+
+  /**
+   * @brief Returns the width of the element.
+   *
+   * @return The width of the node or token.
+   */
+  [[nodiscard]] TextSize Width() const noexcept {
+    return IsNode() ? AsNode()->Width() : AsToken()->Width();
+  }
+
+ private:
+  /** The archive holding the element. */
+  const GreenArchiveSections* sections_;
+
+  /** The encoded child id. */
+  uint32_t encoded_;
+};
+
+inline GreenElementView GreenNodeView::Child(
+    const size_t index) const noexcept {
+  return GreenElementView(sections_,
+                          sections_->children[Record().first_child + index]);
+}
+
+/**
+ * @brief Serializes a green tree into the archive format.
+ *
+ * Nodes and tokens shared within the tree are written once and referenced by
+ * id, so the archive preserves the tree's DAG structure.
+ *
+ * @param root The root of the tree.
+ * @param content_hash A hash of the source text the tree was parsed from.
+ * @return The archive bytes.
+ */
+[[nodiscard]] std::string SerializeGreenTree(const GreenNode& root,
+                                             uint64_t content_hash);
+
+/**
+ * @brief Serializes a green tree and writes it to a file.
+ *
+ * @param path The file to write, replaced if it exists.
+ * @param root The root of the tree.
+ * @param content_hash A hash of the source text the tree was parsed from.
+ * @throws std::system_error If the file cannot be written.
+ */
+void SaveGreenTree(const std::filesystem::path& path, const GreenNode& root,
+                   uint64_t content_hash);
+
+/**
+ * @brief A loaded green archive.
+ *
+ * The archive validates its bytes once when loaded; afterwards, views read
+ * directly from the underlying buffer without copying or allocating. Views
+ * remain valid for as long as the archive (or any move of it) is alive.
+ */
+class GreenArchive {
+ public:
+  /**
+   * @brief Memory-maps and validates an archive file.
+   *
+   * @param path The archive file.
+   * @return The loaded archive.
+   * @throws std::system_error If the file cannot be mapped.
+   * @throws std::invalid_argument If the file is not a valid archive.
+   */
+  [[nodiscard]] static GreenArchive Open(const std::filesystem::path& path);
+
+  /**
+   * @brief Validates an archive that fills a mapped file from `offset` on.
+   *
+   * Lets a file that starts with records of its own still have its archive
+   * read in place.
+   *
+   * @param file The mapped file, which the archive takes ownership of.
+   * @param offset Where the archive starts, a multiple of eight.
+   * @return The loaded archive.
+   * @throws std::invalid_argument If the bytes are not a valid archive.
+   */
+  [[nodiscard]] static GreenArchive FromMappedFile(MappedFile file,
+                                                   size_t offset);
+
+  /**
+   * @brief Validates an archive held in memory.
+   *
+   * @param bytes The archive bytes.
+   * @return The loaded archive, which takes ownership of the bytes.
+   * @throws std::invalid_argument If the bytes are not a valid archive.
+   */
+  [[nodiscard]] static GreenArchive FromBytes(std::string bytes);
+
+  /**
+   * @brief Deleted default constructor.
+   *
+   * A `GreenArchive` is only created by `Open` or `FromBytes`.
+   */
+  GreenArchive() = delete;
+
+  /**
+   * @brief Returns the content hash recorded when the archive was written.
+   *
+   * @return The content hash.
+   */
+  [[nodiscard]] uint64_t ContentHash() const noexcept;
+
+  /**
+   * @brief Returns the number of distinct nodes in the archive.
+   */
+  [[nodiscard]] size_t NodeCount() const noexcept;
+
+  /**
+   * @brief Returns the number of distinct tokens in the archive.
+   */
+  [[nodiscard]] size_t TokenCount() const noexcept;
+
+  /**
+   * @brief Returns a view of the root node.
+   *
+   * @return The root node view.
+   */
+  [[nodiscard]] GreenNodeView Root() const noexcept;
+
+  /**
+   * @brief Rebuilds an owned green tree from the archive.
+   *
+   * Shared nodes and tokens remain shared in the rebuilt tree. Token text is
+   * interned in the global `Interner`.
+   *
+   * @return The root of the rebuilt tree.
+   */
+  [[nodiscard]] GreenNode Materialize() const;
+
+ private:
+  struct Storage;
+
+  explicit GreenArchive(std::shared_ptr<const Storage> storage) noexcept
+      : storage_(std::move(storage)) {}
+
+  /** The archive bytes and section pointers, shared by copies. */
+  std::shared_ptr<const Storage> storage_;
+};
+
+/**
+ * @brief Checks that an archive was written from the given content.
+ *
+ * @param archive The archive.
+ * @param content_hash The hash of the current source text.
+ * @return `true` if the archive's recorded hash matches.
+ */
+[[nodiscard]] inline bool IsArchiveCurrent(const GreenArchive& archive,
+                                           const uint64_t content_hash) {
+  return archive.ContentHash() == content_hash;
+}
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_RGTREE_GREEN_GREEN_ARCHIVE_H_
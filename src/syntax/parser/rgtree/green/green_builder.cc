@@ -2,9 +2,11 @@
 
 #include <algorithm>
 #include <stdexcept>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "syntax/interner/symbol.h"
 #include "syntax/parser/rgtree/green/green_cache.h"
 #include "syntax/parser/rgtree/green/green_element.h"
 #include "syntax/parser/syntax_kind.h"
@@ -12,28 +14,19 @@
 // https://github.com/rust-analyzer/rowan/tree/master/src/green
 namespace orion::syntax {
 void GreenBuilder::StartNode(const SyntaxKind kind) noexcept {
-  const std::pair<SyntaxKind, size_t> key =
-      std::make_pair(kind, children_.size());
-
-  parents_.emplace_back(key);
-  children_.clear();
+  parents_.PushBack({kind, children_.size()});
 }
 
 void GreenBuilder::FinishNode() {
-  if (parents_.empty()) {
+  if (parents_.Empty()) {
     throw std::invalid_argument("nodes list was empty");
   }
 
-  const auto [kind, first_child] = parents_.back();
-  parents_.pop_back();
-
-  const CachedGreenElement entry = cache_.GetNode(kind, children_, first_child);
-  children_.emplace_back(entry);
-}
+  const auto [kind, first_child] = parents_.Back();
+  parents_.PopBack();
 
-inline GreenBuilder::Checkpoint GreenBuilder::CreateCheckpoint()
-    const noexcept {
-  return {children_.size()};
+  CachedGreenElement entry = cache_->GetNode(kind, children_, first_child);
+  children_.push_back(std::move(entry));
 }
 
 void GreenBuilder::ApplyCheckpoint(const Checkpoint &checkpoint,
@@ -42,27 +35,31 @@ void GreenBuilder::ApplyCheckpoint(const Checkpoint &checkpoint,
     throw std::invalid_argument("checkpoint no longer valid");
   }
 
-  if (!parents_.empty()) {
-    const auto [_, first_child] = parents_.back();
-    if (checkpoint.index < first_child) {
-      throw std::invalid_argument("checkpoint no longer valid");
-    }
+  if (!parents_.Empty() && checkpoint.index < parents_.Back().first_child) {
+    throw std::invalid_argument("checkpoint no longer valid");
   }
 
-  parents_.emplace_back(kind, checkpoint.index);
+  parents_.PushBack({kind, checkpoint.index});
+}
+
+void GreenBuilder::Token(const SyntaxKind kind, const Symbol symbol) {
+  children_.push_back(cache_->GetToken(kind, symbol));
 }
 
 void GreenBuilder::Token(const SyntaxKind kind,
-                         const std::u32string &source) noexcept {
-  const CachedGreenElement token = cache_.GetToken(kind, source);
-  children_.emplace_back(token);
+                         const std::u32string_view source) {
+  children_.push_back(cache_->GetToken(kind, source));
 }
-  
+
 GreenNode GreenBuilder::Finish() {
-  if (!parents_.empty()) {
+  if (!parents_.Empty()) {
     throw std::invalid_argument("unexpected empty stack");
   }
 
+  if (children_.empty()) {
+    throw std::invalid_argument("no node was built");
+  }
+
   const auto [_, element] = children_.back();
   children_.pop_back();
 
@@ -74,4 +71,9 @@ GreenNode GreenBuilder::Finish() {
   }
 }
 
+void GreenBuilder::Reset() noexcept {
+  parents_.Clear();
+  children_.clear();
+}
+
 }  // namespace orion::syntax
\ No newline at end of file
@@ -1,23 +1,35 @@
 #ifndef SYNTAX_PARSER_RGTREE_GREEN_GREEN_BUILDER_H_
 #define SYNTAX_PARSER_RGTREE_GREEN_GREEN_BUILDER_H_
 
-#include <string>
+#include <cstddef>
+#include <memory>
+#include <string_view>
 #include <vector>
 
+#include "syntax/interner/symbol.h"
 #include "syntax/parser/rgtree/green/green_cache.h"
 #include "syntax/parser/rgtree/green/green_element.h"
 #include "syntax/parser/syntax_kind.h"
+#include "syntax/util/small_vector.h"
 
 namespace orion::syntax {
 
 /** Maximum number of child nodes a green node can have. */
 constexpr size_t kMaxNodeSize = 3;
 
+/** Number of open nodes a `GreenBuilder` tracks without allocating. */
+constexpr size_t kInlineParents = 32;
+
 /**
  * @brief Constructs and manages green nodes in the syntax tree.
  *
  * The `GreenBuilder` class provides methods for starting and finishing nodes,
  * managing checkpoints, and adding tokens to the syntax tree structure.
+ *
+ * A builder may be reused for many trees: `Reset()` discards any partial tree
+ * but keeps the capacity of its stacks, so once warmed up a builder performs
+ * no allocations of its own per tree. Building over a shared `GreenCache`
+ * additionally keeps common tokens and small nodes deduplicated across trees.
  */
 class GreenBuilder {
  public:
@@ -35,9 +47,22 @@ class GreenBuilder {
   /**
    * @brief Constructs a `GreenBuilder`.
    *
-   * Initializes the builder with a cache for reusing green elements.
+   * Initializes the builder with a cache for reusing green elements, owned by
+   * the builder.
+   *
+   * @param policy How the owned cache decides which nodes to deduplicate.
    */
-  explicit GreenBuilder() : cache_(GreenCache(kMaxNodeSize)) {}
+  explicit GreenBuilder(const NodeCachePolicy policy = NodeCachePolicy::kFixed)
+      : owned_cache_(std::make_unique<GreenCache>(kMaxNodeSize, policy)),
+        cache_(owned_cache_.get()) {}
+
+  /**
+   * @brief Constructs a `GreenBuilder` over an externally owned cache.
+   *
+   * @param cache The cache to intern elements into. It must outlive the
+   * builder.
+   */
+  explicit GreenBuilder(GreenCache& cache) noexcept : cache_(&cache) {}
 
   /**
    * @brief Starts a new node of the specified kind.
@@ -58,7 +83,9 @@ class GreenBuilder {
    *
    * @return A `Checkpoint` representing the current state of the builder.
    */
-  [[nodiscard]] Checkpoint CreateCheckpoint() const noexcept;
+  [[nodiscard]] Checkpoint CreateCheckpoint() const noexcept {
+    return {children_.size()};
+  }
 
   /**
    * @brief Applies a previously created checkpoint.
@@ -71,13 +98,21 @@ class GreenBuilder {
    */
   void ApplyCheckpoint(const Checkpoint& checkpoint, SyntaxKind kind);
 
+  /**
+   * @brief Adds a token to the current node.
+   *
+   * @param kind The kind of the token as defined by `SyntaxKind`.
+   * @param symbol The interned source text of the token.
+   */
+  void Token(SyntaxKind kind, Symbol symbol);
+
   /**
    * @brief Adds a token to the current node.
    *
    * @param kind The kind of the token as defined by `SyntaxKind`.
    * @param source The source text of the token.
    */
-  void Token(SyntaxKind kind, const std::u32string& source) noexcept;
+  void Token(SyntaxKind kind, std::u32string_view source);
 
   /**
    * @brief Finalizes the builder and returns the constructed green node.
@@ -86,12 +121,33 @@ class GreenBuilder {
    */
   [[nodiscard]] GreenNode Finish();
 
+  /**
+   * @brief Discards any partially built tree so the builder can be reused.
+   *
+   * The stacks keep their capacity and the cache keeps its contents.
+   */
+  void Reset() noexcept;
+
+  /**
+   * @brief Returns the cache the builder interns elements into.
+   *
+   * @return The owned or external cache.
+   */
+  [[nodiscard]] GreenCache& Cache() noexcept { return *cache_; }
+
+  /**
+   * @brief Returns the cache the builder interns elements into.
+   *
+   * @return The owned or external cache.
+   */
+  [[nodiscard]] const GreenCache& Cache() const noexcept { return *cache_; }
+
   /**
    * @brief Returns the number of parent nodes currently being constructed.
    *
    * @return The size of the parents vector.
    */
-  [[nodiscard]] size_t ParentsSize() const noexcept { return parents_.size(); }
+  [[nodiscard]] size_t ParentsSize() const noexcept { return parents_.Size(); }
 
   /**
    * @brief Returns the number of child elements for the current node.
@@ -103,14 +159,31 @@ class GreenBuilder {
   }
 
  private:
-  /** Vector holding pairs of SyntaxKind and the index of the first child. */
-  std::vector<std::pair<SyntaxKind, size_t>> parents_;
+  /**
+   * @brief A node that has been started but not finished.
+   */
+  struct Parent {
+    /** The kind of the node. */
+    SyntaxKind kind;
+
+    /** The index of the node's first child in `children_`. */
+    size_t first_child;
+  };
 
-  /** Vector holding cached green elements as children. */
+  /** Stack of open nodes. */
+  SmallVector<Parent, kInlineParents> parents_;
+
+  /**
+   * Vector holding cached green elements as children. This stays a
+   * `std::vector` since `GreenCache::GetNode` consumes children from one.
+   */
   std::vector<CachedGreenElement> children_;
 
+  /** The cache created by the default constructor, if any. */
+  std::unique_ptr<GreenCache> owned_cache_;
+
   /** Cache for reusing green elements. */
-  GreenCache cache_;
+  GreenCache* cache_;
 };
 
 }  // namespace orion::syntax
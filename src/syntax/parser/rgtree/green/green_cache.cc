@@ -1,45 +1,81 @@
 #include "syntax/parser/rgtree/green/green_cache.h"
 
-#include <memory>
-#include <optional>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <ranges>
-#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "syntax/interner/interner.h"
+#include "syntax/interner/symbol.h"
 #include "syntax/parser/rgtree/green/green_element.h"
 #include "syntax/parser/rgtree/green/green_node.h"
 #include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/rgtree/tree_reclaimer.h"
 #include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_size.h"
+#include "syntax/util/hash.h"
 
 // https://github.com/CAD97/sorbus/tree/main/src/green
 // https://github.com/rust-analyzer/rowan/tree/master/src/green
 namespace orion::syntax {
 namespace {
-size_t HashToken(const SyntaxKind kind, const std::u32string& source) noexcept {
-  size_t hash_value = std::hash<SyntaxKind>{}(kind);
-  hash_value ^= std::hash<std::u32string>{}(source) + 0x9e3779b9 +
-                (hash_value << 6) + (hash_value >> 2);
+// Under the adaptive policy, one in this many nodes just above a kind's limit
+// is looked up anyway to measure whether raising the limit would pay off.
+constexpr uint32_t kSampleInterval = 16;
 
-  return hash_value;
+// Number of sampled lookups at one size before the limit is reconsidered.
+constexpr uint32_t kAdaptWindow = 64;
+
+// Hit rates, in percent, above which the limit grows and below which it
+// shrinks.
+constexpr uint32_t kRaiseHitRate = 50;
+constexpr uint32_t kLowerHitRate = 10;
+
+// Approximate size of a `std::shared_ptr` control block.
+constexpr size_t kControlBlockBytes = 2 * sizeof(void*);
+
+size_t NodeBytes(const size_t children) noexcept {
+  return sizeof(GreenNodeData) + kControlBlockBytes +
+         children * (sizeof(GreenElement) + sizeof(TextSize));
+}
+
+size_t TokenBytes() noexcept {
+  return sizeof(GreenTokenData) + kControlBlockBytes;
+}
+
+// Approximate size of one table slot: its hash, value and control byte.
+constexpr size_t kSlotBytes = sizeof(size_t) + sizeof(GreenElement) + 1;
+
+// A hash of zero is reserved for elements that were not interned.
+size_t NonZero(const uint64_t hash) noexcept {
+  return hash == 0 ? 1 : static_cast<size_t>(hash);
+}
+
+// Symbols are unique per text, so the token hash never has to touch the text.
+size_t HashToken(const SyntaxKind kind, const Symbol symbol) noexcept {
+  return NonZero(HashCombine(static_cast<uint64_t>(kind), symbol.Id()));
 }
 
 size_t HashNode(const SyntaxKind kind,
                 const std::vector<CachedGreenElement>& children,
                 const size_t first_child) noexcept {
-  size_t hash_value = std::hash<SyntaxKind>{}(kind);
+  uint64_t hash_value = static_cast<uint64_t>(kind);
 
   for (auto begin_iter = children.begin() + static_cast<long>(first_child);
        begin_iter != children.end(); ++begin_iter) {
-    const auto& [h, _] = *begin_iter;
-    if (h == 0) {
+    // A child which was not cached has no stable identity, so neither does
+    // this node.
+    if (begin_iter->hash == 0) {
       return 0;
     }
-    hash_value ^= h;
+    hash_value = HashCombine(hash_value, begin_iter->hash);
   }
-  hash_value += 0x9e3779b9 + (hash_value << 6) + (hash_value >> 2);
 
-  return hash_value;
+  return NonZero(HashCombine(hash_value, children.size() - first_child));
 }
 
 GreenNode BuildNode(const SyntaxKind kind,
@@ -53,7 +89,7 @@ GreenNode BuildNode(const SyntaxKind kind,
   elements.reserve(size);
   std::ranges::move(children | std::views::drop(first_child) |
                         std::views::transform([](CachedGreenElement& cached) {
-                          return cached.element;
+                          return std::move(cached.element);
                         }),
                     std::back_inserter(elements));
 
@@ -62,68 +98,182 @@ GreenNode BuildNode(const SyntaxKind kind,
   children.erase(children.begin() + static_cast<long>(first_child),
                  children.end());
 
-  return GreenNode(kind, elements);
+  return GreenNode(kind, std::move(elements));
 }
 }  // namespace
 
 CachedGreenElement GreenCache::GetNode(
     const SyntaxKind kind, std::vector<CachedGreenElement>& children,
     const size_t first_child) {
+  const size_t size = children.size() - first_child;
+  ++stats_.node_lookups;
+  ++stats_.child_counts[std::min(size, kChildCountBuckets - 1)];
+
   // If the number of children is greater than some value (determined
   // heuristically), then it's cheaper to just construct a new node.
-  const size_t size = children.size() - first_child;
-  if (size > max_cached_node_size_) {
-    const auto node = BuildNode(kind, children, first_child);
-    return {0, node};
+  if (!ShouldLookUp(kind, size)) {
+    ++stats_.node_skips;
+    return {0, BuildNode(kind, children, first_child)};
   }
 
-  // Compute the hash of the node.
+  // Nodes with an uncached child cannot be deduplicated.
   const size_t hash = HashNode(kind, children, first_child);
-  const auto no_hash = NoHash{hash, GreenElement()};
-
-  // If the entry exists, then there might be a collision.
-  if (const auto entry = nodes_.find(no_hash); entry != nodes_.end()) {
-    std::vector<GreenElement> entry_elements;
-    entry_elements.reserve(size);
-
-    // Unlike BuildNode, we do not know if we should erase these children yet.
-    // Instead, we copy the children.
-    std::ranges::copy(children | std::views::drop(first_child) |
-                          std::views::transform([](CachedGreenElement& cached) {
-                            return cached.element;
-                          }),
-                      std::back_inserter(entry_elements));
-
-    // If the entry is the same as what we are trying to build, we should just
-    // used the cached node.
-    if (const std::optional<GreenNode> entry_node = entry->element.TryGetNode();
-        entry_node.has_value() && entry_node->Kind() == kind &&
-        entry_node->Children().size() == size &&
-        entry_node->Children() == entry_elements) {
-      // If the node already exists, then we can rease the children
-      // that "would have been" included in the new node.
-      children.erase(children.begin() + static_cast<long>(first_child),
-                     children.end());
-
-      return {entry->hash, entry->element};
-    }
+  if (hash == 0) {
+    ++stats_.node_skips;
+    return {0, BuildNode(kind, children, first_child)};
   }
 
-  // Otherwise, if the entry is not present then we insert an new node into the
-  // cache and return a copied reference.
-  const auto node = BuildNode(kind, children, first_child);
-  nodes_.insert({hash, node});
-  return {hash, node};
+  // Children are compared by identity, which is sufficient since they were
+  // themselves interned.
+  const auto matches = [&](const GreenElement& entry) {
+    // The table only calls this once the full hashes are equal.
+    const GreenNode* node = entry.AsNode();
+    const bool equal =
+        node != nullptr && node->Kind() == kind &&
+        node->Children().size() == size &&
+        std::ranges::equal(
+            node->Children(), children | std::views::drop(first_child),
+            [](const GreenElement& lhs, const CachedGreenElement& rhs) {
+              return lhs == rhs.element;
+            });
+    stats_.hash_collisions += equal ? 0 : 1;
+    return equal;
+  };
+
+  const auto [entry, inserted] =
+      nodes_.FindOrInsert(hash, matches, [&]() -> GreenElement {
+        return BuildNode(kind, children, first_child);
+      });
+
+  if (inserted) {
+    ++stats_.node_misses;
+    element_bytes_ += NodeBytes(size);
+  } else {
+    ++stats_.node_hits;
+    stats_.bytes_saved += NodeBytes(size);
+  }
+  RecordLookup(kind, size, !inserted);
+
+  // On a hit the children "would have been" included in the new node, so
+  // they are released here; on a miss `BuildNode` already consumed them.
+  children.erase(children.begin() + static_cast<long>(first_child),
+                 children.end());
+
+  return {hash, *entry};
 }
 
 CachedGreenElement GreenCache::GetToken(const SyntaxKind kind,
-                                        const std::u32string& source) {
-  const size_t hash_value = HashToken(kind, source);
-  const auto token = GreenToken(kind, source);
+                                        const Symbol symbol) {
+  const size_t hash = HashToken(kind, symbol);
+  ++stats_.token_lookups;
 
-  const auto no_hash = NoHash{hash_value, token};
-  auto [entry, _] = tokens_.insert(no_hash);
+  const auto matches = [&](const GreenElement& entry) {
+    const GreenToken* token = entry.AsToken();
+    const bool equal = token != nullptr && token->Kind() == kind &&
+                       token->Symbol() == symbol;
+    stats_.hash_collisions += equal ? 0 : 1;
+    return equal;
+  };
+
+  const auto [entry, inserted] =
+      tokens_.FindOrInsert(hash, matches, [&]() -> GreenElement {
+        return GreenToken(kind, symbol);
+      });
+
+  if (inserted) {
+    ++stats_.token_misses;
+    element_bytes_ += TokenBytes();
+  } else {
+    ++stats_.token_hits;
+    stats_.bytes_saved += TokenBytes();
+  }
+
+  return {hash, *entry};
+}
+
+CachedGreenElement GreenCache::GetToken(const SyntaxKind kind,
+                                        const std::u32string_view source) {
+  return GetToken(kind, Interner::Global().Intern(source));
+}
+
+size_t GreenCache::MemoryUsage() const noexcept {
+  return element_bytes_ +
+         (nodes_.Capacity() + tokens_.Capacity()) * kSlotBytes;
+}
+
+void GreenCache::Clear() noexcept {
+  nodes_.Clear();
+  tokens_.Clear();
+  element_bytes_ = 0;
+}
+
+void GreenCache::Clear(TreeReclaimer& reclaimer) {
+  reclaimer.Defer(std::exchange(nodes_, {}));
+  reclaimer.Defer(std::exchange(tokens_, {}));
+  element_bytes_ = 0;
+}
+
+size_t GreenCache::MaxCachedNodeSize(const SyntaxKind kind) const noexcept {
+  if (policy_ == NodeCachePolicy::kFixed) {
+    return max_cached_node_size_;
+  }
+
+  const auto index = static_cast<size_t>(kind);
+  return index < kind_policies_.size()
+             ? kind_policies_[index].max_cached_node_size
+             : std::min(max_cached_node_size_, kMaxAdaptiveNodeSize);
+}
+
+bool GreenCache::ShouldLookUp(const SyntaxKind kind, const size_t size) {
+  if (policy_ == NodeCachePolicy::kFixed) {
+    return size <= max_cached_node_size_;
+  }
+
+  if (size > kMaxAdaptiveNodeSize) {
+    return false;
+  }
+
+  const auto index = static_cast<size_t>(kind);
+  if (index >= kind_policies_.size()) {
+    kind_policies_.resize(
+        index + 1,
+        KindPolicy{std::min(max_cached_node_size_, kMaxAdaptiveNodeSize)});
+  }
+
+  KindPolicy& policy = kind_policies_[index];
+  if (size <= policy.max_cached_node_size) {
+    return true;
+  }
+
+  // Only the size just above the limit is sampled, so the limit grows one
+  // step at a time.
+  return size == policy.max_cached_node_size + 1 &&
+         ++policy.skipped % kSampleInterval == 0;
+}
+
+void GreenCache::RecordLookup(const SyntaxKind kind, const size_t size,
+                              const bool hit) {
+  if (policy_ == NodeCachePolicy::kFixed) {
+    return;
+  }
+
+  // `ShouldLookUp` created the entry and bounded `size`.
+  KindPolicy& policy = kind_policies_[static_cast<size_t>(kind)];
+  ++policy.lookups[size];
+  policy.hits[size] += hit ? 1 : 0;
+  if (policy.lookups[size] < kAdaptWindow) {
+    return;
+  }
+
+  const uint32_t hit_rate = policy.hits[size] * 100 / policy.lookups[size];
+  if (size == policy.max_cached_node_size + 1 && hit_rate >= kRaiseHitRate) {
+    ++policy.max_cached_node_size;
+  } else if (size == policy.max_cached_node_size && size > 0 &&
+             hit_rate < kLowerHitRate) {
+    --policy.max_cached_node_size;
+  }
 
-  return {hash_value, entry->element};
+  policy.lookups[size] = 0;
+  policy.hits[size] = 0;
 }
-}  // namespace orion::syntax
\ No newline at end of file
+}  // namespace orion::syntax
@@ -1,31 +1,97 @@
 #ifndef SYNTAX_PARSER_RGTREE_GREEN_GREEN_CACHE_H_
 #define SYNTAX_PARSER_RGTREE_GREEN_GREEN_CACHE_H_
 
-#include <memory>
-#include <string>
-#include <unordered_set>
-#include <utility>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 #include <vector>
 
+#include "syntax/interner/symbol.h"
 #include "syntax/parser/rgtree/green/green_element.h"
 #include "syntax/parser/rgtree/green/green_node.h"
 #include "syntax/parser/rgtree/green/green_token.h"
 #include "syntax/parser/syntax_kind.h"
+#include "syntax/util/flat_hash_table.h"
 
 namespace orion::syntax {
 
+class TreeReclaimer;
+
 /**
  * @brief Represents a cached green element with its corresponding hash.
  *
  * The `CachedGreenElement` struct is used to store a hash value along with
  * the associated `GreenElement`, allowing for efficient caching and lookup.
+ * A hash of `0` marks an element that was not interned in the cache.
  */
 struct CachedGreenElement {
   /** The hash value associated with the green element. */
-  const size_t hash;
+  size_t hash;
 
   /** The cached green element (either a node or a token). */
-  const GreenElement element;
+  GreenElement element;
+};
+
+/** Number of buckets in `GreenCacheStats::child_counts`. */
+constexpr size_t kChildCountBuckets = 17;
+
+/** Largest node size an adaptive `GreenCache` will ever deduplicate. */
+constexpr size_t kMaxAdaptiveNodeSize = kChildCountBuckets - 1;
+
+/**
+ * @brief How a `GreenCache` decides which nodes to deduplicate.
+ */
+enum class NodeCachePolicy : uint8_t {
+  /** Nodes up to the configured size are deduplicated, whatever their kind. */
+  kFixed,
+
+  /**
+   * The size limit starts at the configured size and is tuned per
+   * `SyntaxKind` from observed hit rates.
+   */
+  kAdaptive,
+};
+
+/**
+ * @brief Counters describing how effective a `GreenCache` has been.
+ */
+struct GreenCacheStats {
+  /** Calls to `GetNode`. */
+  uint64_t node_lookups = 0;
+
+  /** Node lookups that returned an existing node. */
+  uint64_t node_hits = 0;
+
+  /** Node lookups that inserted a new node. */
+  uint64_t node_misses = 0;
+
+  /** Nodes built without a lookup: too large, or with uncached children. */
+  uint64_t node_skips = 0;
+
+  /** Calls to `GetToken`. */
+  uint64_t token_lookups = 0;
+
+  /** Token lookups that returned an existing token. */
+  uint64_t token_hits = 0;
+
+  /** Token lookups that inserted a new token. */
+  uint64_t token_misses = 0;
+
+  /** Entries whose full 64-bit hash matched but whose contents did not. */
+  uint64_t hash_collisions = 0;
+
+  /**
+   * Estimated heap bytes not allocated thanks to hits: the node or token
+   * data, its children and the shared-pointer control block.
+   */
+  uint64_t bytes_saved = 0;
+
+  /**
+   * Number of `GetNode` calls by child count; the last bucket also counts
+   * every larger node.
+   */
+  std::array<uint64_t, kChildCountBuckets> child_counts{};
 };
 
 /**
@@ -34,6 +100,19 @@ struct CachedGreenElement {
  * The `GreenCache` class manages a cache of `GreenNode` and `GreenToken`
  * objects, allowing for quick retrieval and preventing unnecessary allocations
  * during parsing.
+ *
+ * Both caches are flat open-addressing tables (see `FlatHashTable`). Lookups
+ * hash the key once with an order-sensitive hash and always confirm a hit with
+ * a full equality check, so two different keys sharing a hash are never
+ * confused.
+ *
+ * Deduplicating a node costs a hash and a probe, and only pays off when the
+ * same node recurs. Small nodes (`a + 1`, `x`) recur often, large ones rarely,
+ * so nodes above a size limit are built directly. With
+ * `NodeCachePolicy::kAdaptive` that limit is tuned per kind: nodes just above
+ * a kind's limit are still sampled, and the limit is raised when they hit
+ * often enough or lowered when nodes at the limit rarely hit. `Stats()`
+ * reports the counters needed to judge either policy.
  */
 class GreenCache {
  public:
@@ -41,10 +120,13 @@ class GreenCache {
    * @brief Constructs a `GreenCache` with a specified maximum size for cached
    * nodes.
    *
-   * @param max_cached_node_size The maximum number of nodes to cache.
+   * @param max_cached_node_size The maximum number of children a node may have
+   * to be cached; with an adaptive policy, the initial limit for every kind.
+   * @param policy How the limit is applied.
    */
-  explicit GreenCache(const size_t max_cached_node_size)
-      : max_cached_node_size_(max_cached_node_size), nodes_({}), tokens_({}) {}
+  explicit GreenCache(const size_t max_cached_node_size,
+                      const NodeCachePolicy policy = NodeCachePolicy::kFixed)
+      : max_cached_node_size_(max_cached_node_size), policy_(policy) {}
 
   /**
    * @brief Deleted default constructor.
@@ -56,6 +138,9 @@ class GreenCache {
   /**
    * @brief Retrieves a cached node based on its kind and child elements.
    *
+   * The children in `[first_child, children.size())` are removed from
+   * `children` whether or not the node was found in the cache.
+   *
    * @param kind The kind of the node as defined by `SyntaxKind`.
    * @param children The vector of child `CachedGreenElement`s.
    * @param first_child The index of the first child element.
@@ -65,86 +150,153 @@ class GreenCache {
       SyntaxKind kind, std::vector<CachedGreenElement>& children,
       size_t first_child);
 
+  /**
+   * @brief Retrieves a cached token based on its kind and interned text.
+   *
+   * The lookup is performed directly on `(kind, symbol)`; a `GreenToken` is
+   * only allocated when the token is not already cached.
+   *
+   * @param kind The kind of the token as defined by `SyntaxKind`.
+   * @param symbol The interned source text of the token.
+   * @return A `CachedGreenElement` containing the cached token.
+   */
+  [[nodiscard]] CachedGreenElement GetToken(SyntaxKind kind, Symbol symbol);
+
   /**
    * @brief Retrieves a cached token based on its kind and source text.
    *
+   * The text is interned in the global `Interner` first.
+   *
    * @param kind The kind of the token as defined by `SyntaxKind`.
    * @param source The source text of the token.
    * @return A `CachedGreenElement` containing the cached token.
    */
   [[nodiscard]] CachedGreenElement GetToken(SyntaxKind kind,
-                                            const std::u32string& source);
+                                            std::u32string_view source);
+
+  /**
+   * @brief Returns how the cache decides which nodes to deduplicate.
+   *
+   * @return The policy the cache was constructed with.
+   */
+  [[nodiscard]] NodeCachePolicy Policy() const noexcept { return policy_; }
 
   /**
    * @brief Returns the current size of the cached nodes.
    *
    * @return The number of cached nodes.
    */
-  [[nodiscard]] size_t NodeSize() const noexcept { return nodes_.size(); }
+  [[nodiscard]] size_t NodeSize() const noexcept { return nodes_.Size(); }
 
   /**
    * @brief Returns the current size of the cached tokens.
    *
    * @return The number of cached tokens.
    */
-  [[nodiscard]] size_t TokenSize() const noexcept { return tokens_.size(); }
+  [[nodiscard]] size_t TokenSize() const noexcept { return tokens_.Size(); }
 
- private:
   /**
-   * @brief Helper struct to store elements without a hash function.
+   * @brief Returns the estimated heap bytes held by the cache.
    *
-   * The `NoHash` struct is used in the cache to facilitate storage in
-   * unordered sets without relying on a hashing function for `GreenElement`.
+   * This covers the tables and every cached node and token. Elements the
+   * cache shares with live trees are counted too, so the estimate errs high.
    *
-   * This structure, while similar, is distinctly different than
-   * `CachedGreenNode`. To prevent misuse this structure should be used
-   * internally instead of `CachedGreenNode`.
+   * @return The estimated size in bytes.
    */
-  struct NoHash {
-    /** The hash value associated with the element. */
-    const size_t hash;
+  [[nodiscard]] size_t MemoryUsage() const noexcept;
 
-    /**<The element being cached. */
-    const GreenElement element;
+  /**
+   * @brief Drops every cached element and releases the tables' memory.
+   *
+   * Elements still referenced by trees stay alive; the rest are freed.
+   * Adaptive limits and statistics are kept.
+   */
+  void Clear() noexcept;
 
-    /**
-     * @brief Compares two `NoHash` objects for equality.
-     *
-     * @param other The other `NoHash` to compare with.
-     * @return `true` if both hash values are equal, otherwise `false`.
-     */
-    bool operator==(const NoHash& other) const noexcept {
-      return hash == other.hash;
-    }
-  };
+  /**
+   * @brief Like `Clear()`, but the dropped elements are freed on
+   * `reclaimer`'s thread instead of the caller's.
+   *
+   * @param reclaimer The reclaimer to hand the elements to.
+   */
+  void Clear(TreeReclaimer& reclaimer);
 
   /**
-   * @brief Custom hash function for `NoHash` objects.
+   * @brief Returns the largest node of a kind which is currently
+   * deduplicated.
    *
-   * The `NoHashHasher` struct provides a way to obtain the hash value of a
-   * `NoHash` object for use in unordered sets.
+   * @param kind The node kind.
+   * @return The size limit for `kind`.
    */
-  struct NoHashHasher {
-    /**
-     * @brief Computes the hash of a `NoHash` key.
-     *
-     * @param key The `NoHash` object to hash.
-     * @return The hash value of the key.
-     */
-    size_t operator()(const NoHash& key) const noexcept { return key.hash; }
+  [[nodiscard]] size_t MaxCachedNodeSize(SyntaxKind kind) const noexcept;
+
+  /**
+   * @brief Returns the counters accumulated since construction or the last
+   * `ResetStats()`.
+   *
+   * @return The cache statistics.
+   */
+  [[nodiscard]] const GreenCacheStats& Stats() const noexcept {
+    return stats_;
+  }
+
+  /**
+   * @brief Zeroes the statistics. Adaptive limits are kept.
+   */
+  void ResetStats() noexcept { stats_ = {}; }
+
+ private:
+  /**
+   * @brief Hit-rate samples for the nodes of one kind under the adaptive
+   * policy.
+   */
+  struct KindPolicy {
+    /** The current size limit. */
+    size_t max_cached_node_size;
+
+    /** Nodes above the limit seen since the last sampled lookup. */
+    uint32_t skipped = 0;
+
+    /** Sampled lookups by child count. */
+    std::array<uint32_t, kChildCountBuckets> lookups{};
+
+    /** Sampled hits by child count. */
+    std::array<uint32_t, kChildCountBuckets> hits{};
   };
 
+  /**
+   * @brief Decides whether a node should be looked up.
+   */
+  [[nodiscard]] bool ShouldLookUp(SyntaxKind kind, size_t size);
+
+  /**
+   * @brief Records the outcome of a lookup for the adaptive policy.
+   */
+  void RecordLookup(SyntaxKind kind, size_t size, bool hit);
+
   /** The maximum number of children that can be cached before creating a new
-   * node. */
+   * node, or the initial limit under the adaptive policy. */
   const size_t max_cached_node_size_;
 
-  /** Set of cached nodes. */
-  std::unordered_set<NoHash, NoHashHasher> nodes_;
+  /** How `max_cached_node_size_` is applied. */
+  const NodeCachePolicy policy_;
+
+  /** Adaptive limits, indexed by kind and grown on demand. */
+  std::vector<KindPolicy> kind_policies_;
+
+  /** Counters reported by `Stats()`. */
+  GreenCacheStats stats_;
+
+  /** Estimated heap bytes of the cached nodes and tokens. */
+  size_t element_bytes_ = 0;
+
+  /** Table of cached nodes. */
+  FlatHashTable<GreenElement> nodes_;
 
-  /** Set of cached tokens. */
-  std::unordered_set<NoHash, NoHashHasher> tokens_;
+  /** Table of cached tokens. */
+  FlatHashTable<GreenElement> tokens_;
 };
 
 }  // namespace orion::syntax
 
-#endif  // SYNTAX
+#endif  // SYNTAX_PARSER_RGTREE_GREEN_GREEN_CACHE_H_
@@ -0,0 +1,204 @@
+#include "syntax/parser/rgtree/green/green_diff.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace orion::syntax {
+namespace {
+// Above this many cells the children are paired by position instead of
+// aligned, bounding the quadratic alignment table.
+constexpr size_t kMaxAlignmentCells = size_t{1} << 16;
+
+// Shared data is the common case for trees built through the same cache; the
+// structural hash catches equal subtrees that were built separately.
+bool IsUnchanged(const GreenElement& lhs, const GreenElement& rhs) noexcept {
+  return lhs == rhs ||
+         (lhs.Hash() == rhs.Hash() && lhs.Width() == rhs.Width() &&
+          lhs.IsNode() == rhs.IsNode());
+}
+
+// A pair of elements still to be compared. A missing side turns the task
+// into an insertion or deletion at the given offset.
+struct Task {
+  const GreenElement* old_element;
+  TextSize old_offset;
+  const GreenElement* new_element;
+  TextSize new_offset;
+};
+
+class Differ {
+ public:
+  std::vector<GreenEdit> Run(const GreenElement& old_root,
+                             const GreenElement& new_root) {
+    // Tasks are pushed in reverse so they are popped, and edits emitted, in
+    // offset order.
+    stack_.push_back({&old_root, TextSize(), &new_root, TextSize()});
+    while (!stack_.empty()) {
+      const Task task = stack_.back();
+      stack_.pop_back();
+      Visit(task);
+    }
+
+    return std::move(edits_);
+  }
+
+ private:
+  void Visit(const Task& task) {
+    if (task.old_element == nullptr) {
+      Emit(GreenEditKind::kInsert, task);
+      return;
+    }
+
+    if (task.new_element == nullptr) {
+      Emit(GreenEditKind::kDelete, task);
+      return;
+    }
+
+    if (IsUnchanged(*task.old_element, *task.new_element)) {
+      return;
+    }
+
+    const GreenNode* old_node = task.old_element->AsNode();
+    const GreenNode* new_node = task.new_element->AsNode();
+    if (old_node == nullptr || new_node == nullptr ||
+        old_node->Kind() != new_node->Kind()) {
+      Emit(GreenEditKind::kReplace, task);
+      return;
+    }
+
+    DiffChildren(*old_node, task.old_offset, *new_node, task.new_offset);
+  }
+
+  void Emit(const GreenEditKind kind, const Task& task) {
+    const GreenElement empty;
+    const GreenElement& old_element =
+        task.old_element != nullptr ? *task.old_element : empty;
+    const GreenElement& new_element =
+        task.new_element != nullptr ? *task.new_element : empty;
+
+    edits_.push_back({kind,
+                      TextRange::At(task.old_offset, old_element.Width()),
+                      TextRange::At(task.new_offset, new_element.Width()),
+                      old_element, new_element});
+  }
+
+  void DiffChildren(const GreenNode& old_node, const TextSize old_start,
+                    const GreenNode& new_node, const TextSize new_start) {
+    const auto& old_children = old_node.Children();
+    const auto& new_children = new_node.Children();
+
+    // Edits are usually local, so most children are skipped here without
+    // building an alignment.
+    size_t prefix = 0;
+    const size_t shortest = std::min(old_children.size(), new_children.size());
+    while (prefix < shortest &&
+           IsUnchanged(old_children[prefix], new_children[prefix])) {
+      ++prefix;
+    }
+
+    size_t suffix = 0;
+    while (suffix < shortest - prefix &&
+           IsUnchanged(old_children[old_children.size() - 1 - suffix],
+                       new_children[new_children.size() - 1 - suffix])) {
+      ++suffix;
+    }
+
+    const size_t old_end = old_children.size() - suffix;
+    const size_t new_end = new_children.size() - suffix;
+
+    const auto old_offset = [&](const size_t index) {
+      return old_start + (index < old_children.size()
+                              ? old_node.ChildOffset(index)
+                              : old_node.Width());
+    };
+    const auto new_offset = [&](const size_t index) {
+      return new_start + (index < new_children.size()
+                              ? new_node.ChildOffset(index)
+                              : new_node.Width());
+    };
+
+    // Builds the tasks for one run of unaligned children: pairs by position
+    // first, then deletes the leftover old children and inserts the leftover
+    // new ones.
+    std::vector<Task> tasks;
+    const auto add_gap = [&](size_t old_index, const size_t old_stop,
+                             size_t new_index, const size_t new_stop) {
+      while (old_index < old_stop && new_index < new_stop) {
+        tasks.push_back({&old_children[old_index], old_offset(old_index),
+                         &new_children[new_index], new_offset(new_index)});
+        ++old_index;
+        ++new_index;
+      }
+      for (; old_index < old_stop; ++old_index) {
+        tasks.push_back({&old_children[old_index], old_offset(old_index),
+                         nullptr, new_offset(new_index)});
+      }
+      for (; new_index < new_stop; ++new_index) {
+        tasks.push_back({nullptr, old_offset(old_index),
+                         &new_children[new_index], new_offset(new_index)});
+      }
+    };
+
+    const size_t old_count = old_end - prefix;
+    const size_t new_count = new_end - prefix;
+    if (old_count == new_count || old_count == 0 || new_count == 0 ||
+        (old_count + 1) * (new_count + 1) > kMaxAlignmentCells) {
+      add_gap(prefix, old_end, prefix, new_end);
+    } else {
+      // Longest common subsequence over the remaining children, so that an
+      // inserted or removed child does not turn every later sibling into a
+      // replacement.
+      const size_t columns = new_count + 1;
+      std::vector<uint32_t> lengths((old_count + 1) * columns, 0);
+      for (size_t i = old_count; i-- > 0;) {
+        for (size_t j = new_count; j-- > 0;) {
+          lengths[i * columns + j] =
+              IsUnchanged(old_children[prefix + i], new_children[prefix + j])
+                  ? lengths[(i + 1) * columns + j + 1] + 1
+                  : std::max(lengths[(i + 1) * columns + j],
+                             lengths[i * columns + j + 1]);
+        }
+      }
+
+      size_t i = 0;
+      size_t j = 0;
+      size_t gap_i = 0;
+      size_t gap_j = 0;
+      while (i < old_count && j < new_count) {
+        if (IsUnchanged(old_children[prefix + i], new_children[prefix + j])) {
+          add_gap(prefix + gap_i, prefix + i, prefix + gap_j, prefix + j);
+          gap_i = ++i;
+          gap_j = ++j;
+        } else if (lengths[(i + 1) * columns + j] >=
+                   lengths[i * columns + j + 1]) {
+          ++i;
+        } else {
+          ++j;
+        }
+      }
+      add_gap(prefix + gap_i, old_end, prefix + gap_j, new_end);
+    }
+
+    stack_.insert(stack_.end(), tasks.rbegin(), tasks.rend());
+  }
+
+  std::vector<Task> stack_;
+  std::vector<GreenEdit> edits_;
+};
+}  // namespace
+
+std::vector<GreenEdit> GreenDiff(const GreenNode& old_root,
+                                 const GreenNode& new_root) {
+  const GreenElement old_element(old_root);
+  const GreenElement new_element(new_root);
+
+  Differ differ;
+  return differ.Run(old_element, new_element);
+}
+}  // namespace orion::syntax
@@ -0,0 +1,70 @@
+#ifndef SYNTAX_PARSER_RGTREE_GREEN_GREEN_DIFF_H_
+#define SYNTAX_PARSER_RGTREE_GREEN_GREEN_DIFF_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/text/text_range.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief The kind of change described by a `GreenEdit`.
+ */
+enum class GreenEditKind : uint8_t {
+  /** A subtree of the old tree was replaced by a subtree of the new tree. */
+  kReplace,
+
+  /** A subtree was added to the new tree. */
+  kInsert,
+
+  /** A subtree of the old tree was removed. */
+  kDelete,
+};
+
+/**
+ * @brief A single changed subtree found by `GreenDiff`.
+ *
+ * Ranges are absolute offsets in the respective tree. An insertion has an
+ * empty `old_range` at the point of insertion, and a deletion has an empty
+ * `new_range`.
+ */
+struct GreenEdit {
+  /** The kind of change. */
+  GreenEditKind kind;
+
+  /** The range covered by `old_element` in the old tree. */
+  TextRange old_range;
+
+  /** The range covered by `new_element` in the new tree. */
+  TextRange new_range;
+
+  /** The removed or replaced subtree; empty for an insertion. */
+  GreenElement old_element;
+
+  /** The inserted or replacing subtree; empty for a deletion. */
+  GreenElement new_element;
+};
+
+/**
+ * @brief Computes the subtrees that differ between two green trees.
+ *
+ * Subtrees that share data, or that have equal kind, width and structural
+ * hash, are treated as unchanged without being visited, so the cost is
+ * proportional to the size of the change rather than the size of the trees.
+ * Nodes of the same kind are compared child by child: common prefixes and
+ * suffixes are skipped, the remaining children are aligned on their hashes,
+ * and unaligned children are reported as insertions and deletions.
+ *
+ * @param old_root The root of the old tree.
+ * @param new_root The root of the new tree.
+ * @return The changed subtrees, ordered by offset.
+ */
+[[nodiscard]] std::vector<GreenEdit> GreenDiff(const GreenNode& old_root,
+                                               const GreenNode& new_root);
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_RGTREE_GREEN_GREEN_DIFF_H_
@@ -1,12 +1,17 @@
 #ifndef SYNTAX_PARSER_RGTREE_GREEN_GREEN_ELEMENT_H_
 #define SYNTAX_PARSER_RGTREE_GREEN_GREEN_ELEMENT_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <span>
 #include <utility>
 #include <variant>
 
 #include "syntax/parser/rgtree/green/green_node.h"
 #include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/text/text_size.h"
 
 namespace orion::syntax {
 
@@ -24,46 +29,27 @@ class GreenElement {
    *
    * @param node The `GreenNode` to be stored in the element.
    */
-  explicit GreenElement(GreenNode node) : variant_(std::move(node)) {}
+  GreenElement(GreenNode node) : variant_(std::move(node)) {}
 
   /**
    * @brief Constructs a `GreenElement` from a `GreenToken`.
    *
    * @param token The `GreenToken` to be stored in the element.
    */
-  explicit GreenElement(GreenToken token) : variant_(std::move(token)) {}
+  GreenElement(GreenToken token) : variant_(std::move(token)) {}
 
   /**
    * @brief Default constructor that initializes the element to an empty state.
    */
   explicit GreenElement() : variant_(std::monostate()) {}
 
-  /**
-   * @brief Constructs a `GreenElement` from a const reference to a `GreenNode`.
-   *
-   * @param node The `GreenNode` to be stored in the element.
-   */
-  GreenElement(const GreenNode& node) : variant_(std::move(node)) {}
-
-  /**
-   * @brief Constructs a `GreenElement` from a const reference to a
-   * `GreenToken`.
-   *
-   * @param token The `GreenToken` to be stored in the element.
-   */
-  GreenElement(const GreenToken& token) : variant_(std::move(token)) {}
-
   /** Defaulted copy and move constructors. */
   GreenElement(const GreenElement&) = default;
   GreenElement(GreenElement&&) = default;
 
-  /**
-   * @brief Move assignment operator.
-   *
-   * @param other The `GreenElement` to move from.
-   * @return A reference to this `GreenElement`.
-   */
-  GreenElement& operator=(GreenElement&& other) noexcept { return other; }
+  /** Defaulted copy and move assignment operators. */
+  GreenElement& operator=(const GreenElement&) = default;
+  GreenElement& operator=(GreenElement&&) noexcept = default;
 
   /**
    * @brief Checks if the element holds a `GreenNode`.
@@ -111,6 +97,58 @@ class GreenElement {
     return std::nullopt;
   }
 
+  /**
+   * @brief Returns the stored `GreenNode` without copying it.
+   *
+   * @return A pointer to the node if one is stored, otherwise `nullptr`.
+   */
+  [[nodiscard]] const GreenNode* AsNode() const noexcept {
+    return std::get_if<GreenNode>(&variant_);
+  }
+
+  /**
+   * @brief Returns the stored `GreenToken` without copying it.
+   *
+   * @return A pointer to the token if one is stored, otherwise `nullptr`.
+   */
+  [[nodiscard]] const GreenToken* AsToken() const noexcept {
+    return std::get_if<GreenToken>(&variant_);
+  }
+
+  /**
+   * @brief Returns the width of the stored node or token.
+   *
+   * @return The width of the element, or `0` for an empty element.
+   */
+  [[nodiscard]] TextSize Width() const noexcept {
+    if (const GreenNode* node = AsNode(); node != nullptr) {
+      return node->Width();
+    }
+
+    if (const GreenToken* token = AsToken(); token != nullptr) {
+      return token->Width();
+    }
+
+    return {};
+  }
+
+  /**
+   * @brief Returns the structural hash of the stored node or token.
+   *
+   * @return The hash of the element, or `0` for an empty element.
+   */
+  [[nodiscard]] uint64_t Hash() const noexcept {
+    if (const GreenNode* node = AsNode(); node != nullptr) {
+      return node->Hash();
+    }
+
+    if (const GreenToken* token = AsToken(); token != nullptr) {
+      return token->Hash();
+    }
+
+    return 0;
+  }
+
   /**
    * @brief Returns the current use count of the stored element's data.
    *
@@ -142,9 +180,154 @@ class GreenElement {
  private:
   /** Variant that can hold either a `GreenNode`, `GreenToken`, or a
    * `monostate`. */
-  const std::variant<GreenNode, GreenToken, std::monostate> variant_;
+  std::variant<GreenNode, GreenToken, std::monostate> variant_;
+};
+
+/**
+ * @brief A child of a green node paired with its position in the node.
+ */
+struct GreenChild {
+  /** The index of the child in its parent. */
+  size_t index;
+
+  /** The offset of the child relative to the start of its parent. */
+  TextSize offset;
+
+  /** The child element. */
+  const GreenElement& element;
 };
 
+/**
+ * @brief A range over the children of a green node and their relative
+ * offsets.
+ *
+ * The offsets are read from the node rather than recomputed, so iterating is
+ * as cheap as iterating `Children()`.
+ */
+class GreenChildren {
+ public:
+  /**
+   * @brief Iterator yielding a `GreenChild` for each child.
+   */
+  class Iterator {
+   public:
+    using value_type = GreenChild;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+
+    /**
+     * @brief Constructs an iterator at a child index.
+     *
+     * @param node The node whose children are iterated.
+     * @param index The index of the current child.
+     */
+    explicit Iterator(const GreenNodeData* node, const size_t index) noexcept
+        : node_(node), index_(index) {}
+
+    GreenChild operator*() const {
+      return {index_, node_->ChildOffset(index_), node_->Children()[index_]};
+    }
+
+    Iterator& operator++() noexcept {
+      ++index_;
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+      Iterator copy = *this;
+      ++index_;
+      return copy;
+    }
+
+    bool operator==(const Iterator& other) const noexcept {
+      return index_ == other.index_;
+    }
+
+   private:
+    /** The node whose children are iterated. */
+    const GreenNodeData* node_ = nullptr;
+
+    /** The index of the current child. */
+    size_t index_ = 0;
+  };
+
+  /**
+   * @brief Constructs the range over every child of a node.
+   *
+   * @param node The node whose children are iterated.
+   */
+  explicit GreenChildren(const GreenNodeData& node) noexcept : node_(&node) {}
+
+  [[nodiscard]] Iterator begin() const noexcept { return Iterator(node_, 0); }
+
+  [[nodiscard]] Iterator end() const noexcept {
+    return Iterator(node_, node_->Children().size());
+  }
+
+  /**
+   * @brief Returns the number of children.
+   *
+   * @return The size of the range.
+   */
+  [[nodiscard]] size_t size() const noexcept {
+    return node_->Children().size();
+  }
+
+ private:
+  /** The node whose children are iterated. */
+  const GreenNodeData* node_;
+};
+
+inline std::span<const GreenElement> GreenNodeData::Children()
+    const noexcept {
+  return const_cast<GreenNodeData*>(this)->MutableChildren();
+}
+
+inline size_t GreenNodeData::OffsetsBytes(const size_t count) noexcept {
+  // Rounded up so the children after the offsets stay aligned.
+  constexpr size_t kAlign = alignof(GreenElement);
+  return (count * sizeof(TextSize) + kAlign - 1) / kAlign * kAlign;
+}
+
+inline std::span<GreenElement> GreenNodeData::MutableChildren() noexcept {
+  std::byte* const offsets = reinterpret_cast<std::byte*>(this + 1);
+  return {reinterpret_cast<GreenElement*>(offsets + OffsetsBytes(count_)),
+          count_};
+}
+
+inline bool GreenNodeData::operator==(const GreenNodeData& other) const {
+  return kind_ == other.kind_ && width_ == other.width_ &&
+         std::ranges::equal(Children(), other.Children());
+}
+
+inline std::optional<GreenChild> GreenNodeData::ChildAtOffset(
+    const TextSize offset) const {
+  const std::optional<size_t> index = ChildIndexAtOffset(offset);
+  if (!index.has_value()) {
+    return std::nullopt;
+  }
+
+  return GreenChild{*index, ChildOffset(*index), Children()[*index]};
+}
+
+inline GreenChildren GreenNodeData::ChildrenWithOffsets() const noexcept {
+  return GreenChildren(*this);
+}
+
+inline std::span<const GreenElement> GreenNode::Children() const noexcept {
+  return data_->Children();
+}
+
+inline std::optional<GreenChild> GreenNode::ChildAtOffset(
+    const TextSize offset) const {
+  return data_->ChildAtOffset(offset);
+}
+
+inline GreenChildren GreenNode::ChildrenWithOffsets() const noexcept {
+  return data_->ChildrenWithOffsets();
+}
+
 }  // namespace orion::syntax
 
 #endif  // SYNTAX_PARSER_RGTREE_GREEN_GREEN_ELEMENT_H_
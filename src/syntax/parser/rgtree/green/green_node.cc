@@ -1,27 +1,101 @@
 #include "syntax/parser/rgtree/green/green_node.h"
 
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
 #include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/util/hash.h"
 
 namespace orion::syntax {
-size_t GreenNode::ComputeWidth(const std::vector<GreenElement>& children) {
-  size_t width = 0;
+// The node's fields are followed directly by its offsets and children.
+static_assert(sizeof(GreenNodeData) % alignof(TextSize) == 0);
+static_assert(alignof(GreenElement) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
 
+std::shared_ptr<GreenNodeData> GreenNodeData::Create(
+    const SyntaxKind kind, std::vector<GreenElement> children) {
   for (const GreenElement& child : children) {
-    if (const std::optional<GreenNode> node = child.TryGetNode();
-        node.has_value()) {
-      width += node.value().Width();
-      continue;
+    if (!child.IsNode() && !child.IsToken()) {
+      throw std::invalid_argument("unknown with object");
     }
+  }
+
+  // Summed before allocating, so an overflow reaches the caller rather than
+  // escaping the noexcept constructor.
+  TextSize width;
+  for (const GreenElement& child : children) {
+    width += child.Width();
+  }
 
-    if (const std::optional<GreenToken> token = child.TryGetToken();
-        token.has_value()) {
-      width += token.value().Source().size();
-      continue;
+  const size_t bytes = sizeof(GreenNodeData) + OffsetsBytes(children.size()) +
+                       children.size() * sizeof(GreenElement);
+  void* const memory = ::operator new(bytes);
+  return std::shared_ptr<GreenNodeData>(new (memory)
+                                            GreenNodeData(kind, width, children),
+                                        Deleter());
+}
+
+GreenNodeData::GreenNodeData(const SyntaxKind kind, const TextSize width,
+                             std::vector<GreenElement>& children) noexcept
+    : kind_(kind),
+      count_(static_cast<uint32_t>(children.size())),
+      width_(width),
+      hash_(static_cast<uint64_t>(kind)) {
+  auto* const offsets = reinterpret_cast<TextSize*>(this + 1);
+  GreenElement* const slots = MutableChildren().data();
+
+  // Every prefix is at most `width`, so the unchecked sum cannot wrap.
+  uint32_t offset = 0;
+  for (size_t i = 0; i < children.size(); ++i) {
+    new (&offsets[i]) TextSize(offset);
+    offset += children[i].Width().Raw();
+    hash_ = HashCombine(hash_, children[i].Hash());
+    new (&slots[i]) GreenElement(std::move(children[i]));
+  }
+
+  hash_ = HashCombine(hash_, children.size());
+}
+
+GreenNodeData::~GreenNodeData() {
+  const std::span<GreenElement> children = MutableChildren();
+  const auto is_node = [](const GreenElement& child) { return child.IsNode(); };
+  if (std::ranges::any_of(children, is_node)) {
+    // Children whose data is owned only by this subtree would be destroyed
+    // recursively by their own destructors. Instead, their children are
+    // moved onto the worklist first, so each node dies with no children
+    // left.
+    std::vector<GreenElement> pending;
+    for (GreenElement& child : children) {
+      pending.push_back(std::exchange(child, GreenElement()));
     }
+    while (!pending.empty()) {
+      const GreenElement element = std::move(pending.back());
+      pending.pop_back();
+
+      const GreenNode* node = element.AsNode();
+      if (node == nullptr || node->data_.use_count() != 1) {
+        continue;
+      }
 
-    throw std::invalid_argument("unknown with object");
+      for (GreenElement& child : node->data_->MutableChildren()) {
+        pending.push_back(std::exchange(child, GreenElement()));
+      }
+    }
   }
 
-  return width;
+  std::destroy(children.begin(), children.end());
+}
+
+void GreenNodeData::Deleter::operator()(GreenNodeData* const data) const
+    noexcept {
+  data->~GreenNodeData();
+  ::operator delete(data);
 }
-}  // namespace orion::syntax
\ No newline at end of file
+
+GreenNode::GreenNode(const SyntaxKind kind, std::vector<GreenElement> children)
+    : data_(GreenNodeData::Create(kind, std::move(children))) {}
+}  // namespace orion::syntax
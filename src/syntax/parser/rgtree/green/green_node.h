@@ -1,16 +1,30 @@
 #ifndef SYNTAX_PARSER_RGTREE_GREEN_GREEN_NODE_H_
 #define SYNTAX_PARSER_RGTREE_GREEN_GREEN_NODE_H_
 
-#include <functional>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <utility>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_size.h"
 
 namespace orion::syntax {
 
 class GreenElement;
+class GreenChildren;
+struct GreenChild;
+template <bool kWithTokens>
+class GreenWalk;
+
+/** A preorder walk over the nodes of a green tree. */
+using GreenPreorder = GreenWalk<false>;
+
+/** A preorder walk over the nodes and tokens of a green tree. */
+using GreenPreorderWithTokens = GreenWalk<true>;
 
 /**
  * @brief Represents the data associated with a green node.
@@ -18,32 +32,50 @@ class GreenElement;
  * `GreenNodeData` holds information about the kind of node, its width,
  * and its child elements. This structure is used during parsing and
  * tree construction.
+ *
+ * Alongside the children, the node stores the offset of every child relative
+ * to the start of the node (a prefix sum of the child widths). This makes
+ * finding the child covering an offset a binary search rather than a scan.
+ *
+ * Both arrays live in the node's own allocation, right after its fields:
+ * first the offsets, then the children. A node is therefore only created
+ * through `Create`, and cannot be copied or moved.
+ *
+ * @note Accessors returning `GreenChild` or `GreenChildren` are defined in
+ * `green_element.h`, since they require a complete `GreenElement`.
  */
 class GreenNodeData {
  public:
   /**
-   * @brief Constructs a `GreenNodeData` with the specified token kind, width,
-   * and child elements.
+   * @brief Allocates a `GreenNodeData` with the specified kind and child
+   * elements, computing the width and child offsets.
    *
    * @param kind The type of the node as defined by `SyntaxKind`.
-   * @param width The width of the node in terms of layout.
    * @param children The child elements contained within this node.
+   * @return The shared node data.
+   * @throws std::invalid_argument If a child is neither a node nor a token.
+   * @throws std::overflow_error If the children's widths sum past 32 bits.
    */
-  explicit GreenNodeData(SyntaxKind kind, size_t width,
-                         std::vector<GreenElement> children)
-      : kind_(kind), width_(width), children_(std::move(children)) {}
+  [[nodiscard]] static std::shared_ptr<GreenNodeData> Create(
+      SyntaxKind kind, std::vector<GreenElement> children);
 
   /**
    * @brief Deleted default constructor.
    *
-   * A `GreenNodeData` must always be constructed with a kind, width, and
-   * children.
+   * A `GreenNodeData` must always be constructed with a kind and children.
    */
   GreenNodeData() = delete;
 
-  /** Defaulted copy and move constructors. */
-  GreenNodeData(const GreenNodeData&) = default;
-  GreenNodeData(GreenNodeData&&) = default;
+  /** Deleted copy and move constructors and assignment operators. */
+  GreenNodeData(const GreenNodeData&) = delete;
+  GreenNodeData(GreenNodeData&&) = delete;
+  GreenNodeData& operator=(const GreenNodeData&) = delete;
+  GreenNodeData& operator=(GreenNodeData&&) = delete;
+
+  /**
+   * @brief Releases the node's subtree iteratively.
+   */
+  ~GreenNodeData();
 
   /**
    * @brief Returns the kind of the node.
@@ -57,17 +89,71 @@ class GreenNodeData {
    *
    * @return The width of the node.
    */
-  [[nodiscard]] size_t Width() const { return width_; }
+  [[nodiscard]] TextSize Width() const { return width_; }
+
+  /**
+   * @brief Returns the structural hash of the node.
+   *
+   * @return The hash of the node's kind and, recursively, its children.
+   */
+  [[nodiscard]] uint64_t Hash() const noexcept { return hash_; }
 
   /**
    * @brief Returns the child elements of the node.
    *
-   * @return A reference to the vector of child `GreenElement`s.
+   * @return A view of the child `GreenElement`s, valid while the node lives.
+   * @note Defined in `green_element.h`.
+   */
+  [[nodiscard]] std::span<const GreenElement> Children() const noexcept;
+
+  /**
+   * @brief Returns the offset of a child relative to the start of the node.
+   *
+   * @param index The index of the child.
+   * @return The relative offset of the child.
+   */
+  [[nodiscard]] TextSize ChildOffset(const size_t index) const {
+    return Offsets()[index];
+  }
+
+  /**
+   * @brief Finds the index of the child covering a relative offset.
+   *
+   * A child covers the offsets `[start, start + width)`. When children are
+   * empty, the last child starting at `offset` is returned.
+   *
+   * @param offset The offset relative to the start of the node.
+   * @return The index of the covering child, or `nullopt` if `offset` is not
+   * less than the node's width.
    */
-  [[nodiscard]] const std::vector<GreenElement>& Children() const {
-    return children_;
+  [[nodiscard]] std::optional<size_t> ChildIndexAtOffset(
+      const TextSize offset) const noexcept {
+    if (offset >= width_) {
+      return std::nullopt;
+    }
+
+    const std::span<const TextSize> offsets = Offsets();
+    const auto after = std::upper_bound(offsets.begin(), offsets.end(), offset);
+    return static_cast<size_t>(after - offsets.begin()) - 1;
   }
 
+  /**
+   * @brief Finds the child covering a relative offset.
+   *
+   * @param offset The offset relative to the start of the node.
+   * @return The covering child and its offset, or `nullopt` if `offset` is not
+   * less than the node's width.
+   */
+  [[nodiscard]] std::optional<GreenChild> ChildAtOffset(TextSize offset) const;
+
+  /**
+   * @brief Returns a range over the children paired with their relative
+   * offsets.
+   *
+   * @return A `GreenChildren` range.
+   */
+  [[nodiscard]] GreenChildren ChildrenWithOffsets() const noexcept;
+
   /**
    * @brief Compares two `GreenNodeData` objects for equality.
    *
@@ -75,20 +161,56 @@ class GreenNodeData {
    * @return `true` if both nodes have the same kind, width, and children,
    * otherwise `false`.
    */
-  bool operator==(const GreenNodeData& other) const {
-    return kind_ == other.kind_ && width_ == other.width_ &&
-           children_ == other.children_;
-  }
+  bool operator==(const GreenNodeData& other) const;
 
  private:
+  /**
+   * @brief Frees a node made by `Create`.
+   */
+  struct Deleter {
+    void operator()(GreenNodeData* data) const noexcept;
+  };
+
+  /**
+   * @brief Moves `children` into the arrays after the node's fields, which
+   * `Create` has allocated.
+   *
+   * @param width The sum of the children's widths, already checked by
+   * `Create`.
+   */
+  GreenNodeData(SyntaxKind kind, TextSize width,
+                std::vector<GreenElement>& children) noexcept;
+
+  /**
+   * @brief Returns the bytes taken by `count` offsets and the padding after
+   * them.
+   */
+  [[nodiscard]] static size_t OffsetsBytes(size_t count) noexcept;
+
+  /**
+   * @brief Returns the offsets stored right after the node's fields.
+   */
+  [[nodiscard]] std::span<const TextSize> Offsets() const noexcept {
+    return {reinterpret_cast<const TextSize*>(this + 1), count_};
+  }
+
+  /**
+   * @brief Returns the children stored after the offsets. Only for
+   * construction and destruction.
+   */
+  [[nodiscard]] std::span<GreenElement> MutableChildren() noexcept;
+
   /**< The type of the node. */
   const SyntaxKind kind_;
 
+  /**< The number of children. */
+  const uint32_t count_;
+
   /**< The width of the node. */
-  const size_t width_;
+  TextSize width_;
 
-  /**< The child elements of the node. */
-  const std::vector<GreenElement> children_;
+  /**< The structural hash of the node. */
+  uint64_t hash_;
 };
 
 /**
@@ -105,9 +227,7 @@ class GreenNode {
    * @param kind The type of the node as defined by `SyntaxKind`.
    * @param children The child elements contained within this node.
    */
-  explicit GreenNode(SyntaxKind kind, const std::vector<GreenElement>& children)
-      : data_(std::make_shared<GreenNodeData>(
-            GreenNodeData(kind, ComputeWidth(children), children))) {}
+  explicit GreenNode(SyntaxKind kind, std::vector<GreenElement> children);
 
   /**
    * @brief Deleted default constructor.
@@ -120,6 +240,10 @@ class GreenNode {
   GreenNode(const GreenNode&) = default;
   GreenNode(GreenNode&&) noexcept = default;
 
+  /** Defaulted copy and move assignment operators. */
+  GreenNode& operator=(const GreenNode&) = default;
+  GreenNode& operator=(GreenNode&&) noexcept = default;
+
   /**
    * @brief Returns the kind of the node.
    *
@@ -132,17 +256,82 @@ class GreenNode {
    *
    * @return The width of the node.
    */
-  [[nodiscard]] size_t Width() const { return data_->Width(); }
+  [[nodiscard]] TextSize Width() const { return data_->Width(); }
+
+  /**
+   * @brief Returns the structural hash of the node.
+   *
+   * @return The hash of the node's kind and, recursively, its children.
+   */
+  [[nodiscard]] uint64_t Hash() const noexcept { return data_->Hash(); }
 
   /**
    * @brief Returns the child elements of the node.
    *
-   * @return A reference to the vector of child `GreenElement`s.
+   * @return A view of the child `GreenElement`s, valid while the node lives.
+   * @note Defined in `green_element.h`.
+   */
+  [[nodiscard]] std::span<const GreenElement> Children() const noexcept;
+
+  /**
+   * @brief Returns the offset of a child relative to the start of the node.
+   *
+   * @param index The index of the child.
+   * @return The relative offset of the child.
    */
-  [[nodiscard]] const std::vector<GreenElement>& Children() const {
-    return data_->Children();
+  [[nodiscard]] TextSize ChildOffset(const size_t index) const {
+    return data_->ChildOffset(index);
   }
 
+  /**
+   * @brief Finds the index of the child covering a relative offset.
+   *
+   * @param offset The offset relative to the start of the node.
+   * @return The index of the covering child, or `nullopt`.
+   */
+  [[nodiscard]] std::optional<size_t> ChildIndexAtOffset(
+      const TextSize offset) const noexcept {
+    return data_->ChildIndexAtOffset(offset);
+  }
+
+  /**
+   * @brief Finds the child covering a relative offset.
+   *
+   * @param offset The offset relative to the start of the node.
+   * @return The covering child and its offset, or `nullopt`.
+   */
+  [[nodiscard]] std::optional<GreenChild> ChildAtOffset(TextSize offset) const;
+
+  /**
+   * @brief Returns a range over the children paired with their relative
+   * offsets.
+   *
+   * @return A `GreenChildren` range.
+   */
+  [[nodiscard]] GreenChildren ChildrenWithOffsets() const noexcept;
+
+  /**
+   * @brief Returns a preorder walk over this node and the nodes below it.
+   *
+   * @note Defined in `green_preorder.h`.
+   */
+  [[nodiscard]] GreenPreorder Preorder() const;
+
+  /**
+   * @brief Returns a preorder walk over this node and the nodes and tokens
+   * below it.
+   *
+   * @note Defined in `green_preorder.h`.
+   */
+  [[nodiscard]] GreenPreorderWithTokens PreorderWithTokens() const;
+
+  /**
+   * @brief Returns the shared node data.
+   *
+   * @return A reference to the `GreenNodeData`, valid while this node lives.
+   */
+  [[nodiscard]] const GreenNodeData& Data() const noexcept { return *data_; }
+
   /**
    * @brief Returns the current use count of the shared node data.
    *
@@ -161,17 +350,12 @@ class GreenNode {
   bool operator==(const GreenNode& other) const { return data_ == other.data_; }
 
  private:
-  /**
-   * @brief Computes the width of the node based on its children.
-   *
-   * @param children The child elements to compute the width for.
-   * @return The computed width of the node.
-   */
-  [[nodiscard]] static size_t ComputeWidth(
-      const std::vector<GreenElement>& children);
+  /** Allows the destructor of `GreenNodeData` to detach uniquely owned
+   * children. */
+  friend class GreenNodeData;
 
   /**< Shared data for the node. */
-  const std::shared_ptr<GreenNodeData> data_;
+  std::shared_ptr<GreenNodeData> data_;
 };
 
 }  // namespace orion::syntax
@@ -0,0 +1,209 @@
+#ifndef SYNTAX_PARSER_RGTREE_GREEN_GREEN_PREORDER_H_
+#define SYNTAX_PARSER_RGTREE_GREEN_GREEN_PREORDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/walk_event.h"
+#include "syntax/text/text_size.h"
+#include "syntax/util/small_vector.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief An element reached by a green preorder walk, with its absolute
+ * offset from the start of the walk's root.
+ */
+struct GreenWalkItem {
+  /** The element, valid while the walk's root lives. */
+  const GreenElement* element;
+
+  /** The offset of the element from the start of the root. */
+  TextSize offset;
+
+  bool operator==(const GreenWalkItem& other) const = default;
+};
+
+/**
+ * @brief A preorder walk over a green tree yielding `WalkEvent`s.
+ *
+ * The walk keeps an explicit stack of the nodes it is inside, with the
+ * next child index and offset of each, so it neither recurses nor copies
+ * nodes. The stack lives inline up to `kInlineDepth` levels.
+ *
+ * The walk is its own range, and `SkipSubtree()` may be called between
+ * steps to prune:
+ *
+ * @code
+ * GreenPreorder walk = root.Preorder();
+ * for (const WalkEvent<GreenWalkItem>& event : walk) {
+ *   if (event.IsEnter() && IsOpaque(*event.value.element)) {
+ *     walk.SkipSubtree();
+ *   }
+ * }
+ * @endcode
+ *
+ * @tparam kWithTokens Whether tokens are yielded as well as nodes.
+ */
+template <bool kWithTokens>
+class GreenWalk {
+ public:
+  /** The depth up to which the walk does not allocate. */
+  static constexpr size_t kInlineDepth = 32;
+
+  /**
+   * @brief Iterator stepping the walk it belongs to.
+   */
+  class Iterator {
+   public:
+    using value_type = WalkEvent<GreenWalkItem>;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+
+    /**
+     * @brief Constructs an iterator over `walk`.
+     *
+     * @param walk The walk to step.
+     */
+    explicit Iterator(GreenWalk* walk) noexcept : walk_(walk) {}
+
+    const value_type& operator*() const noexcept { return *walk_->current_; }
+
+    const value_type* operator->() const noexcept {
+      return &*walk_->current_;
+    }
+
+    Iterator& operator++() {
+      walk_->Advance();
+      return *this;
+    }
+
+    void operator++(int) { walk_->Advance(); }
+
+    bool operator==(std::default_sentinel_t) const noexcept {
+      return !walk_->current_.has_value();
+    }
+
+   private:
+    /** The walk being stepped. */
+    GreenWalk* walk_ = nullptr;
+  };
+
+  /**
+   * @brief Constructs a walk starting with `Enter(root)`.
+   *
+   * @param root The root of the walk.
+   */
+  explicit GreenWalk(GreenNode root)
+      : root_(std::move(root)),
+        current_(WalkEvent<GreenWalkItem>{WalkEventKind::kEnter,
+                                          {&root_, TextSize()}}) {}
+
+  /** Deleted copy and move, since the walk points into its own root. */
+  GreenWalk(const GreenWalk&) = delete;
+  GreenWalk& operator=(const GreenWalk&) = delete;
+
+  [[nodiscard]] Iterator begin() noexcept { return Iterator(this); }
+
+  [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+  /**
+   * @brief Skips the children of the node just entered, so the next event
+   * leaves it. Does nothing after a `kLeave` event.
+   */
+  void SkipSubtree() noexcept {
+    if (current_.has_value() && current_->IsEnter()) {
+      skip_ = true;
+    }
+  }
+
+ private:
+  /**
+   * @brief A node the walk is inside.
+   */
+  struct Frame {
+    /** The node. */
+    const GreenElement* element;
+
+    /** The absolute offset of the node. */
+    TextSize offset;
+
+    /** The index of the next child to visit. */
+    uint32_t next_child;
+  };
+
+  /**
+   * @brief Moves to the next event.
+   */
+  void Advance() {
+    const GreenWalkItem item = current_->value;
+    if (current_->IsEnter()) {
+      if (item.element->IsNode() && !skip_) {
+        stack_.PushBack({item.element, item.offset, 0});
+        Step();
+      } else {
+        current_->kind = WalkEventKind::kLeave;
+      }
+      skip_ = false;
+      return;
+    }
+
+    Step();
+  }
+
+  /**
+   * @brief Enters the next child of the innermost node, or leaves that node
+   * once all of its children have been visited.
+   */
+  void Step() {
+    while (!stack_.Empty()) {
+      Frame& frame = stack_.Back();
+      const GreenNodeData& node = frame.element->AsNode()->Data();
+      if (frame.next_child == node.Children().size()) {
+        current_ = {WalkEventKind::kLeave, {frame.element, frame.offset}};
+        stack_.PopBack();
+        return;
+      }
+
+      const uint32_t index = frame.next_child++;
+      const GreenElement& child = node.Children()[index];
+      if (kWithTokens || child.IsNode()) {
+        current_ = {WalkEventKind::kEnter,
+                    {&child, frame.offset + node.ChildOffset(index)}};
+        return;
+      }
+    }
+
+    current_.reset();
+  }
+
+  /** The root, which every yielded element points into. */
+  const GreenElement root_;
+
+  /** The current event, or `nullopt` once the walk is done. */
+  std::optional<WalkEvent<GreenWalkItem>> current_;
+
+  /** The nodes the walk is inside, innermost last. */
+  SmallVector<Frame, kInlineDepth> stack_;
+
+  /** Whether the node just entered should be left without its children. */
+  bool skip_ = false;
+};
+
+inline GreenPreorder GreenNode::Preorder() const {
+  return GreenPreorder(*this);
+}
+
+inline GreenPreorderWithTokens GreenNode::PreorderWithTokens() const {
+  return GreenPreorderWithTokens(*this);
+}
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_RGTREE_GREEN_GREEN_PREORDER_H_
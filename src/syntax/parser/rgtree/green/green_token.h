@@ -1,31 +1,37 @@
 #ifndef SYNTAX_PARSER_RGTREE_GREEN_GREEN_TOKEN_H_
 #define SYNTAX_PARSER_RGTREE_GREEN_GREEN_TOKEN_H_
 
-#include <functional>
+#include <cstdint>
 #include <memory>
-#include <string>
-#include <utility>
+#include <string_view>
 
+#include "syntax/interner/interner.h"
+#include "syntax/interner/symbol.h"
 #include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_size.h"
+#include "syntax/util/hash.h"
 
 namespace orion::syntax {
 /**
  * @brief Represents the data associated with a green token.
  *
- * `GreenTokenData` holds the kind of token and its source text, which
- * are used during parsing and syntax tree construction.
+ * `GreenTokenData` holds the kind of token and its interned source text,
+ * which are used during parsing and syntax tree construction.
  */
 class GreenTokenData {
  public:
   /**
    * @brief Constructs a `GreenTokenData` with the specified token kind and
-   * source text.
+   * interned source text.
    *
    * @param kind The type of the token as defined by `SyntaxKind`.
-   * @param source The actual text content of the token.
+   * @param symbol The interned text content of the token.
    */
-  explicit GreenTokenData(const SyntaxKind kind, std::u32string source)
-      : kind_(kind), source_(std::move(source)) {}
+  explicit GreenTokenData(const SyntaxKind kind,
+                          const orion::syntax::Symbol symbol)
+      : kind_(kind),
+        symbol_(symbol),
+        width_(Interner::Global().Width(symbol)) {}
 
   /**
    * @brief Deleted default constructor.
@@ -45,12 +51,40 @@ class GreenTokenData {
    */
   [[nodiscard]] SyntaxKind Kind() const { return kind_; }
 
+  /**
+   * @brief Returns the interned source text of the token.
+   *
+   * @return The `Symbol` of the token's text.
+   */
+  [[nodiscard]] orion::syntax::Symbol Symbol() const { return symbol_; }
+
   /**
    * @brief Returns the source text of the token.
    *
-   * @return A reference to the token's source string.
+   * @return A view of the token's UTF-8 text in the global `Interner`.
    */
-  [[nodiscard]] const std::u32string& Source() const { return source_; }
+  [[nodiscard]] std::string_view Text() const {
+    return Interner::Global().Resolve(symbol_);
+  }
+
+  /**
+   * @brief Returns the width of the token in code points.
+   *
+   * @return The width of the token.
+   */
+  [[nodiscard]] TextSize Width() const { return width_; }
+
+  /**
+   * @brief Returns the structural hash of the token.
+   *
+   * Tokens with the same kind and text always have the same hash, whether or
+   * not they share data.
+   *
+   * @return The hash of the token's kind and text.
+   */
+  [[nodiscard]] uint64_t Hash() const noexcept {
+    return HashCombine(static_cast<uint64_t>(kind_), symbol_.Id());
+  }
 
   /**
    * @brief Compares two `GreenTokenData` objects for equality.
@@ -60,15 +94,18 @@ class GreenTokenData {
    * `false`.
    */
   bool operator==(const GreenTokenData& other) const {
-    return kind_ == other.kind_ && source_ == other.source_;
+    return kind_ == other.kind_ && symbol_ == other.symbol_;
   }
 
  private:
   /** The type of the token. */
   const SyntaxKind kind_;
 
-  /** The actual text content of the token. */
-  const std::u32string source_;
+  /** The interned text content of the token. */
+  const orion::syntax::Symbol symbol_;
+
+  /** The width of the token, cached from the interner. */
+  const TextSize width_;
 };
 
 /**
@@ -78,14 +115,26 @@ class GreenTokenData {
  */
 class GreenToken {
  public:
+  /**
+   * @brief Constructs a `GreenToken` with the specified kind and interned
+   * source text.
+   *
+   * @param kind The type of the token as defined by `SyntaxKind`.
+   * @param symbol The interned text content of the token.
+   */
+  explicit GreenToken(const SyntaxKind kind, const orion::syntax::Symbol symbol)
+      : data_(std::make_shared<GreenTokenData>(kind, symbol)) {}
+
   /**
    * @brief Constructs a `GreenToken` with the specified kind and source text.
    *
+   * The text is interned in the global `Interner`.
+   *
    * @param kind The type of the token as defined by `SyntaxKind`.
    * @param source The actual text content of the token.
    */
-  explicit GreenToken(const SyntaxKind kind, const std::u32string& source)
-      : data_(std::make_shared<GreenTokenData>(GreenTokenData(kind, source))) {}
+  explicit GreenToken(const SyntaxKind kind, const std::u32string_view source)
+      : GreenToken(kind, Interner::Global().Intern(source)) {}
 
   /**
    * @brief Deleted default constructor.
@@ -98,6 +147,10 @@ class GreenToken {
   GreenToken(const GreenToken&) = default;
   GreenToken(GreenToken&&) = default;
 
+  /** Defaulted copy and move assignment operators. */
+  GreenToken& operator=(const GreenToken&) = default;
+  GreenToken& operator=(GreenToken&&) noexcept = default;
+
   /**
    * @brief Returns the kind of the token.
    *
@@ -105,12 +158,33 @@ class GreenToken {
    */
   [[nodiscard]] SyntaxKind Kind() const { return data_->Kind(); }
 
+  /**
+   * @brief Returns the interned source text of the token.
+   *
+   * @return The `Symbol` of the token's text.
+   */
+  [[nodiscard]] orion::syntax::Symbol Symbol() const { return data_->Symbol(); }
+
   /**
    * @brief Returns the source text of the token.
    *
-   * @return A reference to the token's source string.
+   * @return A view of the token's UTF-8 text in the global `Interner`.
+   */
+  [[nodiscard]] std::string_view Text() const { return data_->Text(); }
+
+  /**
+   * @brief Returns the width of the token in code points.
+   *
+   * @return The width of the token.
+   */
+  [[nodiscard]] TextSize Width() const { return data_->Width(); }
+
+  /**
+   * @brief Returns the structural hash of the token.
+   *
+   * @return The hash of the token's kind and text.
    */
-  [[nodiscard]] const std::u32string& Source() const { return data_->Source(); }
+  [[nodiscard]] uint64_t Hash() const noexcept { return data_->Hash(); }
 
   /**
    * @brief Returns the current use count of the shared token data.
@@ -133,7 +207,7 @@ class GreenToken {
 
  private:
   /** Shared data for the token. */
-  const std::shared_ptr<GreenTokenData> data_;
+  std::shared_ptr<GreenTokenData> data_;
 };
 }  // namespace orion::syntax
 
@@ -0,0 +1,216 @@
+#include "syntax/parser/rgtree/syntax/syntax_editor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/text/offset_map.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace orion::syntax {
+namespace {
+/**
+ * @brief A node on the spine of at least one edit.
+ */
+struct SpineNode {
+  /** The old green node. */
+  GreenNode green;
+
+  /** The spine nodes of edited children, by child index. */
+  std::map<size_t, size_t> children;
+
+  /** The splices of this node's children. */
+  std::vector<size_t> splices;
+
+  /** The rebuilt node, once its children have been rebuilt. */
+  std::optional<GreenNode> rebuilt;
+};
+
+TextSize TotalWidth(const std::vector<GreenElement>& elements) {
+  TextSize width;
+  for (const GreenElement& element : elements) {
+    width += element.Width();
+  }
+  return width;
+}
+}  // namespace
+
+SyntaxEditor::SyntaxEditor(const SyntaxNode& node) : root_(node) {
+  while (std::optional<SyntaxNode> parent = root_.Parent()) {
+    root_ = std::move(*parent);
+  }
+}
+
+void SyntaxEditor::ReplaceChild(const SyntaxNode& parent, const size_t index,
+                                GreenElement replacement) {
+  std::vector<GreenElement> children;
+  children.push_back(std::move(replacement));
+  Add(parent, index, 1, std::move(children));
+}
+
+void SyntaxEditor::InsertChildren(const SyntaxNode& parent, const size_t index,
+                                  std::vector<GreenElement> children) {
+  Add(parent, index, 0, std::move(children));
+}
+
+void SyntaxEditor::RemoveChildren(const SyntaxNode& parent, const size_t index,
+                                  const size_t count) {
+  Add(parent, index, count, {});
+}
+
+void SyntaxEditor::Add(const SyntaxNode& parent, const size_t start,
+                       const size_t count,
+                       std::vector<GreenElement> children) {
+  const size_t size = parent.Green().Children().size();
+  if (start > size || count > size - start) {
+    throw std::invalid_argument("edit is out of range");
+  }
+
+  std::vector<size_t> path;
+  SyntaxNode top = parent;
+  while (std::optional<SyntaxNode> up = top.Parent()) {
+    path.push_back(top.IndexInParent());
+    top = std::move(*up);
+  }
+  if (top != root_) {
+    throw std::invalid_argument("node is not in the edited tree");
+  }
+  std::reverse(path.begin(), path.end());
+
+  const TextSize new_len = TotalWidth(children);
+  splices_.push_back({std::move(path), parent.Green(), parent.Offset(), start,
+                      count, std::move(children), new_len});
+}
+
+SyntaxEdit SyntaxEditor::Finish() {
+  std::vector<Splice> splices = std::move(splices_);
+  splices_.clear();
+
+  // Gather the spines into a trie. Every node is created after its parent,
+  // so walking the trie backwards rebuilds children first.
+  std::vector<SpineNode> spine;
+  spine.push_back({root_.Green(), {}, {}, std::nullopt});
+  for (size_t s = 0; s < splices.size(); ++s) {
+    size_t current = 0;
+    for (const size_t index : splices[s].path) {
+      const auto [it, inserted] =
+          spine[current].children.try_emplace(index, spine.size());
+      if (inserted) {
+        GreenNode child = *spine[current].green.Children()[index].AsNode();
+        spine.push_back({std::move(child), {}, {}, std::nullopt});
+      }
+      current = it->second;
+    }
+    spine[current].splices.push_back(s);
+  }
+
+  for (size_t n = spine.size(); n-- > 0;) {
+    SpineNode& node = spine[n];
+    std::stable_sort(node.splices.begin(), node.splices.end(),
+                     [&splices](const size_t lhs, const size_t rhs) {
+                       return std::pair(splices[lhs].start,
+                                        splices[lhs].count) <
+                              std::pair(splices[rhs].start,
+                                        splices[rhs].count);
+                     });
+
+    const std::span<const GreenElement> old = node.green.Children();
+    std::vector<GreenElement> children;
+    children.reserve(old.size());
+
+    // Copies old children up to `end`, substituting rebuilt ones.
+    size_t next = 0;
+    const auto copy_until = [&](const size_t end) {
+      for (; next < end; ++next) {
+        const auto edited = node.children.find(next);
+        if (edited == node.children.end()) {
+          children.push_back(old[next]);
+        } else {
+          children.emplace_back(*spine[edited->second].rebuilt);
+        }
+      }
+    };
+
+    for (const size_t s : node.splices) {
+      Splice& splice = splices[s];
+      if (splice.start < next) {
+        throw std::invalid_argument("edits overlap");
+      }
+
+      const auto inner = node.children.lower_bound(splice.start);
+      if (inner != node.children.end() &&
+          inner->first < splice.start + splice.count) {
+        throw std::invalid_argument("edit lies inside a removed child");
+      }
+
+      copy_until(splice.start);
+      std::move(splice.children.begin(), splice.children.end(),
+                std::back_inserter(children));
+      next = splice.start + splice.count;
+    }
+    copy_until(old.size());
+
+    node.rebuilt.emplace(node.green.Kind(), std::move(children));
+  }
+
+  // Record the replaced text ranges, which splices of different nodes may
+  // interleave, in order.
+  std::vector<TextEdit> edits;
+  edits.reserve(splices.size());
+  for (const Splice& splice : splices) {
+    const GreenNodeData& node = splice.node.Data();
+    const TextSize end = splice.start + splice.count < node.Children().size()
+                             ? node.ChildOffset(splice.start + splice.count)
+                             : node.Width();
+    const TextSize start = splice.start < node.Children().size()
+                               ? node.ChildOffset(splice.start)
+                               : node.Width();
+    edits.push_back({TextRange(splice.offset + start, splice.offset + end),
+                     splice.new_len});
+  }
+  std::sort(edits.begin(), edits.end(),
+            [](const TextEdit& lhs, const TextEdit& rhs) {
+              return std::pair(lhs.old_range.Start(), lhs.old_range.End()) <
+                     std::pair(rhs.old_range.Start(), rhs.old_range.End());
+            });
+
+  OffsetMap offsets;
+  for (const TextEdit& edit : edits) {
+    offsets.Add(edit.old_range, edit.new_len);
+  }
+
+  return {SyntaxNode::CreateRoot(std::move(*spine.front().rebuilt)),
+          std::move(offsets)};
+}
+
+SyntaxEdit SyntaxNode::ReplaceChild(const size_t index,
+                                    GreenElement replacement) const {
+  SyntaxEditor editor(*this);
+  editor.ReplaceChild(*this, index, std::move(replacement));
+  return editor.Finish();
+}
+
+SyntaxEdit SyntaxNode::InsertChildren(
+    const size_t index, std::vector<GreenElement> children) const {
+  SyntaxEditor editor(*this);
+  editor.InsertChildren(*this, index, std::move(children));
+  return editor.Finish();
+}
+
+SyntaxEdit SyntaxNode::RemoveChildren(const size_t index,
+                                      const size_t count) const {
+  SyntaxEditor editor(*this);
+  editor.RemoveChildren(*this, index, count);
+  return editor.Finish();
+}
+}  // namespace orion::syntax
@@ -0,0 +1,145 @@
+#ifndef SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_EDITOR_H_
+#define SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_EDITOR_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/text/offset_map.h"
+#include "syntax/text/text_size.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief The outcome of editing a tree.
+ */
+struct SyntaxEdit {
+  /** The root of the edited tree. */
+  SyntaxNode root;
+
+  /** Maps offsets in the old tree to offsets in the new one. */
+  OffsetMap offsets;
+};
+
+/**
+ * @brief Batches edits to a tree and applies them in one pass.
+ *
+ * Green nodes are immutable, so an edit rebuilds the spine from the edited
+ * node up to the root and shares every untouched subtree with the old tree.
+ * Batching rebuilds each node on the spines of several edits only once, so
+ * applying a batch costs O(depth * fan-out) per edited node, independent of
+ * the size of the tree.
+ *
+ * Edits are splices of the children of a node, given as indices into the
+ * node's old children. Splices of one node may not overlap, and no edit may
+ * lie inside a child that another edit replaces or removes.
+ *
+ * @code
+ * SyntaxEditor editor(root);
+ * editor.ReplaceChild(*root.FirstChild(), 0, GreenToken(kind, U"x"));
+ * editor.RemoveChildren(root, 2, 1);
+ * SyntaxEdit edit = editor.Finish();
+ * @endcode
+ */
+class SyntaxEditor {
+ public:
+  /**
+   * @brief Constructs an editor for the tree containing `node`.
+   *
+   * @param node Any node of the tree to edit.
+   */
+  explicit SyntaxEditor(const SyntaxNode& node);
+
+  /**
+   * @brief Replaces one child of a node.
+   *
+   * @param parent The node whose child is replaced.
+   * @param index The index of the child.
+   * @param replacement The new child.
+   * @throws std::invalid_argument If `parent` is not in the tree or `index`
+   * is out of range.
+   */
+  void ReplaceChild(const SyntaxNode& parent, size_t index,
+                    GreenElement replacement);
+
+  /**
+   * @brief Inserts children into a node.
+   *
+   * @param parent The node to insert into.
+   * @param index The index of the old child to insert before, or the number
+   * of children to append.
+   * @param children The new children.
+   * @throws std::invalid_argument If `parent` is not in the tree or `index`
+   * is out of range.
+   */
+  void InsertChildren(const SyntaxNode& parent, size_t index,
+                      std::vector<GreenElement> children);
+
+  /**
+   * @brief Removes a run of children from a node.
+   *
+   * @param parent The node to remove from.
+   * @param index The index of the first child to remove.
+   * @param count The number of children to remove.
+   * @throws std::invalid_argument If `parent` is not in the tree or the run
+   * is out of range.
+   */
+  void RemoveChildren(const SyntaxNode& parent, size_t index, size_t count);
+
+  /**
+   * @brief Applies every recorded edit.
+   *
+   * The editor is left empty, so it can record edits to the same old tree
+   * again.
+   *
+   * @return The new root and the offset mapping.
+   * @throws std::invalid_argument If edits overlap or one lies inside a child
+   * removed by another.
+   */
+  [[nodiscard]] SyntaxEdit Finish();
+
+ private:
+  /**
+   * @brief A splice of the children of one node.
+   */
+  struct Splice {
+    /** The child indices leading from the root to the node. */
+    std::vector<size_t> path;
+
+    /** The green node being edited, shared with the old tree. */
+    GreenNode node;
+
+    /** The absolute offset of the node. */
+    TextSize offset;
+
+    /** The index of the first old child replaced. */
+    size_t start;
+
+    /** The number of old children replaced. */
+    size_t count;
+
+    /** The new children. */
+    std::vector<GreenElement> children;
+
+    /** The total width of the new children. */
+    TextSize new_len;
+  };
+
+  /**
+   * @brief Records a splice after validating it.
+   */
+  void Add(const SyntaxNode& parent, size_t start, size_t count,
+           std::vector<GreenElement> children);
+
+  /** The root of the tree being edited. */
+  SyntaxNode root_;
+
+  /** The recorded splices, in order of recording. */
+  std::vector<Splice> splices_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_EDITOR_H_
@@ -0,0 +1,191 @@
+#ifndef SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_ELEMENT_H_
+#define SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_ELEMENT_H_
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <variant>
+
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_node_data.h"
+#include "syntax/parser/rgtree/syntax/syntax_token.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief Represents a syntax element, which is either a `SyntaxNode` or a
+ * `SyntaxToken`.
+ */
+class SyntaxElement {
+ public:
+  /**
+   * @brief Constructs an element from a node.
+   *
+   * @param node The node to store.
+   */
+  SyntaxElement(SyntaxNode node) noexcept : variant_(std::move(node)) {}
+
+  /**
+   * @brief Constructs an element from a token.
+   *
+   * @param token The token to store.
+   */
+  SyntaxElement(SyntaxToken token) noexcept : variant_(std::move(token)) {}
+
+  /**
+   * @brief Checks if the element is a node.
+   */
+  [[nodiscard]] bool IsNode() const noexcept {
+    return std::holds_alternative<SyntaxNode>(variant_);
+  }
+
+  /**
+   * @brief Checks if the element is a token.
+   */
+  [[nodiscard]] bool IsToken() const noexcept {
+    return std::holds_alternative<SyntaxToken>(variant_);
+  }
+
+  /**
+   * @brief Returns the stored node without copying it.
+   *
+   * @return A pointer to the node, or `nullptr` for a token.
+   */
+  [[nodiscard]] const SyntaxNode* AsNode() const noexcept {
+    return std::get_if<SyntaxNode>(&variant_);
+  }
+
+  /**
+   * @brief Returns the stored token without copying it.
+   *
+   * @return A pointer to the token, or `nullptr` for a node.
+   */
+  [[nodiscard]] const SyntaxToken* AsToken() const noexcept {
+    return std::get_if<SyntaxToken>(&variant_);
+  }
+
+  /**
+   * @brief Returns the kind of the node or token.
+   */
+  [[nodiscard]] SyntaxKind Kind() const noexcept {
+    return std::visit([](const auto& element) { return element.Kind(); },
+                      variant_);
+  }
+
+  /**
+   * @brief Returns the absolute offset of the node or token.
+   */
+  [[nodiscard]] TextSize Offset() const noexcept {
+    return std::visit([](const auto& element) { return element.Offset(); },
+                      variant_);
+  }
+
+  /**
+   * @brief Returns the range of text the node or token covers.
+   */
+  [[nodiscard]] TextRange Range() const {
+    return std::visit([](const auto& element) { return element.Range(); },
+                      variant_);
+  }
+
+  /**
+   * @brief Returns the index of the element among its parent's children.
+   */
+  [[nodiscard]] size_t IndexInParent() const noexcept {
+    return std::visit(
+        [](const auto& element) { return element.IndexInParent(); },
+        variant_);
+  }
+
+  /**
+   * @brief Returns the parent node, or `nullopt` for the root.
+   */
+  [[nodiscard]] std::optional<SyntaxNode> Parent() const noexcept {
+    if (const SyntaxNode* node = AsNode(); node != nullptr) {
+      return node->Parent();
+    }
+
+    return AsToken()->Parent();
+  }
+
+  /**
+   * @brief Returns the next sibling, node or token.
+   */
+  [[nodiscard]] std::optional<SyntaxElement> NextSiblingOrToken() const {
+    return std::visit(
+        [](const auto& element) { return element.NextSiblingOrToken(); },
+        variant_);
+  }
+
+  /**
+   * @brief Returns the previous sibling, node or token.
+   */
+  [[nodiscard]] std::optional<SyntaxElement> PrevSiblingOrToken() const {
+    return std::visit(
+        [](const auto& element) { return element.PrevSiblingOrToken(); },
+        variant_);
+  }
+
+  /**
+   * @brief Compares two elements by position.
+   *
+   * @param other The other element to compare with.
+   * @return `true` if both refer to the same node or token of the same tree.
+   */
+  bool operator==(const SyntaxElement& other) const noexcept {
+    return variant_ == other.variant_;
+  }
+
+ private:
+  friend class SyntaxNode;
+  friend class SyntaxToken;
+
+  /**
+   * @brief Wraps data in a node or token handle, adopting one reference.
+   *
+   * @param data The data of a child element.
+   * @return A `SyntaxElement` holding a node or a token.
+   */
+  [[nodiscard]] static SyntaxElement Adopt(SyntaxNodeData* data) noexcept {
+    if (data->Green().IsNode()) {
+      return SyntaxElement(SyntaxNode(data));
+    }
+
+    return SyntaxElement(SyntaxToken(data));
+  }
+
+  /**
+   * @brief Returns the sibling after the element described by `data`.
+   */
+  [[nodiscard]] static std::optional<SyntaxElement> NextSiblingOf(
+      const SyntaxNodeData& data);
+
+  /**
+   * @brief Returns the sibling before the element described by `data`.
+   */
+  [[nodiscard]] static std::optional<SyntaxElement> PrevSiblingOf(
+      const SyntaxNodeData& data);
+
+  /** The stored node or token. */
+  std::variant<SyntaxNode, SyntaxToken> variant_;
+};
+
+/**
+ * @brief Steps from an element to its next sibling, node or token.
+ */
+struct SyntaxElementNextSibling {
+  std::optional<SyntaxElement> operator()(const SyntaxElement& element) const {
+    return element.NextSiblingOrToken();
+  }
+};
+
+inline SyntaxElementChildren SyntaxNode::ChildrenWithTokens() const {
+  return SyntaxElementChildren(FirstChildOrToken());
+}
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_ELEMENT_H_
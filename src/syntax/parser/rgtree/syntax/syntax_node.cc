@@ -0,0 +1,375 @@
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_element.h"
+#include "syntax/parser/rgtree/syntax/syntax_node_data.h"
+#include "syntax/parser/rgtree/syntax/syntax_token.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+// https://github.com/rust-analyzer/rowan/blob/master/src/cursor.rs
+namespace orion::syntax {
+namespace {
+// Enough recycled data for the deepest paths and widest sibling walks seen in
+// practice; a thread that once held more frees the excess.
+constexpr size_t kMaxPooledData = 4096;
+
+// Set once this thread's pool has been destroyed. Handles released later in
+// thread or static teardown (for example, from another thread_local or a
+// namespace-scope object) then go straight to the heap. Being trivially
+// destructible, the flag itself outlives every thread_local object.
+thread_local bool pool_destroyed = false;
+
+/**
+ * @brief The per-thread free list of red element data.
+ */
+struct DataPool {
+  DataPool() { free.reserve(kMaxPooledData); }
+
+  ~DataPool() {
+    pool_destroyed = true;
+    for (const SyntaxNodeData* data : free) {
+      delete data;
+    }
+  }
+
+  std::vector<SyntaxNodeData*> free;
+
+  /** Data allocated because `free` was empty. */
+  uint64_t allocations = 0;
+};
+
+DataPool& Pool() {
+  thread_local DataPool pool;
+  return pool;
+}
+
+std::optional<size_t> NextNodeIndex(const GreenNodeData& node,
+                                    const size_t from) noexcept {
+  const std::span<const GreenElement> children = node.Children();
+  for (size_t i = from; i < children.size(); ++i) {
+    if (children[i].IsNode()) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<size_t> PrevNodeIndex(const GreenNodeData& node,
+                                    const size_t before) noexcept {
+  const std::span<const GreenElement> children = node.Children();
+  for (size_t i = before; i-- > 0;) {
+    if (children[i].IsNode()) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+// Finds the non-empty child covering the code point just before `offset`
+// (when `before` is set) or just after it. Offsets are relative to `node`.
+std::optional<size_t> ChildBeside(const GreenNodeData& node,
+                                  const TextSize offset,
+                                  const bool before) noexcept {
+  if (before) {
+    return offset == TextSize() ? std::nullopt
+                                : node.ChildIndexAtOffset(offset - TextSize(1));
+  }
+  return node.ChildIndexAtOffset(offset);
+}
+}  // namespace
+
+SyntaxNodeData* SyntaxNodeData::Allocate() {
+  if (pool_destroyed) {
+    return new SyntaxNodeData();
+  }
+
+  DataPool& pool = Pool();
+  std::vector<SyntaxNodeData*>& free = pool.free;
+  if (free.empty()) {
+    ++pool.allocations;
+    return new SyntaxNodeData();
+  }
+
+  SyntaxNodeData* data = free.back();
+  free.pop_back();
+  return data;
+}
+
+uint64_t SyntaxNodeData::HeapAllocations() noexcept {
+  return pool_destroyed ? 0 : Pool().allocations;
+}
+
+void SyntaxNodeData::Free(SyntaxNodeData* data) noexcept {
+  data->root_ = GreenElement();
+  data->parent_ = nullptr;
+  if (pool_destroyed) {
+    delete data;
+    return;
+  }
+
+  std::vector<SyntaxNodeData*>& free = Pool().free;
+  if (free.size() < kMaxPooledData) {
+    free.push_back(data);
+  } else {
+    delete data;
+  }
+}
+
+SyntaxNodeData* SyntaxNodeData::NewRoot(GreenNode green) {
+  SyntaxNodeData* data = Allocate();
+  data->ref_count_ = 1;
+  data->index_ = 0;
+  data->offset_ = TextSize();
+  data->root_ = std::move(green);
+  data->green_ = &data->root_;
+  return data;
+}
+
+SyntaxNodeData* SyntaxNodeData::NewChild(SyntaxNodeData* parent,
+                                         const size_t index) {
+  const GreenNodeData& green = parent->GreenData();
+
+  SyntaxNodeData* data = Allocate();
+  parent->Retain();
+  data->ref_count_ = 1;
+  data->index_ = static_cast<uint32_t>(index);
+  data->offset_ = parent->offset_ + green.ChildOffset(index);
+  data->parent_ = parent;
+  data->green_ = &green.Children()[index];
+  return data;
+}
+
+void SyntaxNodeData::Release(SyntaxNodeData* data) noexcept {
+  // Each element holds a reference to its parent, so freeing the last handle
+  // to a deep node may free the whole path above it. Walking up in a loop
+  // keeps that from recursing.
+  while (data != nullptr && --data->ref_count_ == 0) {
+    SyntaxNodeData* parent = data->parent_;
+    Free(data);
+    data = parent;
+  }
+}
+
+std::optional<SyntaxNode> SyntaxNode::Parent() const noexcept {
+  SyntaxNodeData* parent = data_->Parent();
+  if (parent == nullptr) {
+    return std::nullopt;
+  }
+
+  parent->Retain();
+  return SyntaxNode(parent);
+}
+
+std::optional<SyntaxNode> SyntaxNode::FirstChild() const {
+  const std::optional<size_t> index = NextNodeIndex(data_->GreenData(), 0);
+  if (!index.has_value()) {
+    return std::nullopt;
+  }
+
+  return SyntaxNode(SyntaxNodeData::NewChild(data_, *index));
+}
+
+std::optional<SyntaxNode> SyntaxNode::LastChild() const {
+  const GreenNodeData& green = data_->GreenData();
+  const std::optional<size_t> index =
+      PrevNodeIndex(green, green.Children().size());
+  if (!index.has_value()) {
+    return std::nullopt;
+  }
+
+  return SyntaxNode(SyntaxNodeData::NewChild(data_, *index));
+}
+
+std::optional<SyntaxNode> SyntaxNode::NextSibling() const {
+  SyntaxNodeData* parent = data_->Parent();
+  if (parent == nullptr) {
+    return std::nullopt;
+  }
+
+  const std::optional<size_t> index =
+      NextNodeIndex(parent->GreenData(), data_->Index() + 1);
+  if (!index.has_value()) {
+    return std::nullopt;
+  }
+
+  return SyntaxNode(SyntaxNodeData::NewChild(parent, *index));
+}
+
+std::optional<SyntaxNode> SyntaxNode::PrevSibling() const {
+  SyntaxNodeData* parent = data_->Parent();
+  if (parent == nullptr) {
+    return std::nullopt;
+  }
+
+  const std::optional<size_t> index =
+      PrevNodeIndex(parent->GreenData(), data_->Index());
+  if (!index.has_value()) {
+    return std::nullopt;
+  }
+
+  return SyntaxNode(SyntaxNodeData::NewChild(parent, *index));
+}
+
+std::optional<SyntaxElement> SyntaxNode::FirstChildOrToken() const {
+  if (data_->GreenData().Children().empty()) {
+    return std::nullopt;
+  }
+
+  return SyntaxElement::Adopt(SyntaxNodeData::NewChild(data_, 0));
+}
+
+std::optional<SyntaxElement> SyntaxNode::LastChildOrToken() const {
+  const size_t count = data_->GreenData().Children().size();
+  if (count == 0) {
+    return std::nullopt;
+  }
+
+  return SyntaxElement::Adopt(SyntaxNodeData::NewChild(data_, count - 1));
+}
+
+std::optional<SyntaxElement> SyntaxNode::NextSiblingOrToken() const {
+  return SyntaxElement::NextSiblingOf(*data_);
+}
+
+std::optional<SyntaxElement> SyntaxNode::PrevSiblingOrToken() const {
+  return SyntaxElement::PrevSiblingOf(*data_);
+}
+
+std::optional<SyntaxElement> SyntaxToken::NextSiblingOrToken() const {
+  return SyntaxElement::NextSiblingOf(*data_);
+}
+
+std::optional<SyntaxElement> SyntaxToken::PrevSiblingOrToken() const {
+  return SyntaxElement::PrevSiblingOf(*data_);
+}
+
+std::optional<SyntaxElement> SyntaxElement::NextSiblingOf(
+    const SyntaxNodeData& data) {
+  SyntaxNodeData* parent = data.Parent();
+  if (parent == nullptr ||
+      data.Index() + 1 >= parent->GreenData().Children().size()) {
+    return std::nullopt;
+  }
+
+  return Adopt(SyntaxNodeData::NewChild(parent, data.Index() + 1));
+}
+
+std::optional<SyntaxElement> SyntaxElement::PrevSiblingOf(
+    const SyntaxNodeData& data) {
+  SyntaxNodeData* parent = data.Parent();
+  if (parent == nullptr || data.Index() == 0) {
+    return std::nullopt;
+  }
+
+  return Adopt(SyntaxNodeData::NewChild(parent, data.Index() - 1));
+}
+
+TokensAtOffset SyntaxNode::TokenAtOffset(const TextSize offset) const {
+  if (!Range().ContainsInclusive(offset)) {
+    return TokensAtOffset();
+  }
+
+  // Follows the children on one side of the offset down to a token.
+  const auto descend = [offset](SyntaxElement element, const bool before) {
+    while (const SyntaxNode* node = element.AsNode()) {
+      const size_t index = *ChildBeside(node->data_->GreenData(),
+                                        offset - node->Offset(), before);
+      element = SyntaxElement::Adopt(
+          SyntaxNodeData::NewChild(node->data_, index));
+    }
+    return *element.AsToken();
+  };
+
+  SyntaxNode node = *this;
+  while (true) {
+    const GreenNodeData& green = node.data_->GreenData();
+    const TextSize relative = offset - node.Offset();
+    const std::optional<size_t> before = ChildBeside(green, relative, true);
+    const std::optional<size_t> after = ChildBeside(green, relative, false);
+
+    if (!before.has_value() && !after.has_value()) {
+      return TokensAtOffset();
+    }
+
+    // Two different children meet at the offset.
+    if (before.has_value() && after.has_value() && *before != *after) {
+      return TokensAtOffset(
+          descend(SyntaxElement::Adopt(
+                      SyntaxNodeData::NewChild(node.data_, *before)),
+                  true),
+          descend(SyntaxElement::Adopt(
+                      SyntaxNodeData::NewChild(node.data_, *after)),
+                  false));
+    }
+
+    const SyntaxElement child = SyntaxElement::Adopt(SyntaxNodeData::NewChild(
+        node.data_, before.has_value() ? *before : *after));
+    if (const SyntaxToken* token = child.AsToken(); token != nullptr) {
+      return TokensAtOffset(*token);
+    }
+    node = *child.AsNode();
+  }
+}
+
+SyntaxElement SyntaxNode::CoveringElement(const TextRange range) const {
+  if (!Range().ContainsRange(range)) {
+    throw std::invalid_argument("range is outside the node");
+  }
+
+  SyntaxElement element = *this;
+  while (const SyntaxNode* node = element.AsNode()) {
+    const GreenNodeData& green = node->data_->GreenData();
+    const TextSize start = range.Start() - node->Offset();
+
+    // An empty range on a boundary is covered by both neighbours; prefer the
+    // one ending there.
+    const std::optional<size_t> index =
+        ChildBeside(green, start, range.IsEmpty() && start != TextSize());
+    if (!index.has_value()) {
+      break;
+    }
+
+    const TextRange child =
+        TextRange::At(node->Offset() + green.ChildOffset(*index),
+                      green.Children()[*index].Width());
+    if (!child.ContainsRange(range)) {
+      break;
+    }
+
+    element = SyntaxElement::Adopt(
+        SyntaxNodeData::NewChild(node->data_, *index));
+  }
+
+  return element;
+}
+
+SyntaxNodeDescendants::Iterator& SyntaxNodeDescendants::Iterator::operator++() {
+  if (std::optional<SyntaxNode> child = current_->FirstChild();
+      child.has_value()) {
+    current_ = std::move(child);
+    return *this;
+  }
+
+  while (*current_ != *root_) {
+    if (std::optional<SyntaxNode> sibling = current_->NextSibling();
+        sibling.has_value()) {
+      current_ = std::move(sibling);
+      return *this;
+    }
+    current_ = current_->Parent();
+  }
+
+  current_.reset();
+  return *this;
+}
+}  // namespace orion::syntax
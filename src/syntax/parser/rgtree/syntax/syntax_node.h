@@ -1,162 +1,489 @@
 #ifndef SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_NODE_H_
 #define SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_NODE_H_
 
-#include <memory>
+#include <cstddef>
 #include <optional>
+#include <utility>
+#include <vector>
 
+#include "syntax/parser/rgtree/green/green_element.h"
 #include "syntax/parser/rgtree/green/green_node.h"
-#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_node_data.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
 
 namespace orion::syntax {
 
+class SyntaxElement;
+class SyntaxText;
+class SyntaxToken;
+class TokensAtOffset;
+struct SyntaxEdit;
+
+/**
+ * @brief A range which starts at an element and repeatedly steps from it.
+ *
+ * Each step produces the next element from the current one, so iterating
+ * only ever holds one element at a time.
+ *
+ * @tparam T The element type, `SyntaxNode` or `SyntaxElement`.
+ * @tparam Step A function object returning the `std::optional<T>` following
+ * an element, or `nullopt` at the end.
+ */
+template <typename T, typename Step>
+class SyntaxSuccessors {
+ public:
+  /**
+   * @brief Iterator holding the current element.
+   */
+  class Iterator {
+   public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+
+    /**
+     * @brief Constructs an iterator at an element, or the end for `nullopt`.
+     *
+     * @param current The current element.
+     */
+    explicit Iterator(std::optional<T> current) noexcept
+        : current_(std::move(current)) {}
+
+    const T& operator*() const noexcept { return *current_; }
+
+    const T* operator->() const noexcept { return &*current_; }
+
+    Iterator& operator++() {
+      current_ = Step()(*current_);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    bool operator==(const Iterator& other) const noexcept {
+      return current_ == other.current_;
+    }
+
+   private:
+    /** The current element, or `nullopt` at the end. */
+    std::optional<T> current_;
+  };
+
+  /**
+   * @brief Constructs the range starting at `first`.
+   *
+   * @param first The first element, or `nullopt` for an empty range.
+   */
+  explicit SyntaxSuccessors(std::optional<T> first) noexcept
+      : first_(std::move(first)) {}
+
+  [[nodiscard]] Iterator begin() const { return Iterator(first_); }
+
+  [[nodiscard]] Iterator end() const noexcept { return Iterator(); }
+
+ private:
+  /** The first element of the range. */
+  std::optional<T> first_;
+};
+
+struct SyntaxNodeNextSibling;
+struct SyntaxNodeParent;
+struct SyntaxElementNextSibling;
+class SyntaxNodeDescendants;
+template <typename T>
+class SyntaxWalk;
+
+class SyntaxNode;
+
+/** The child nodes of a node, skipping tokens. */
+using SyntaxNodeChildren = SyntaxSuccessors<SyntaxNode, SyntaxNodeNextSibling>;
+
+/** A node followed by each of its ancestors. */
+using SyntaxNodeAncestors = SyntaxSuccessors<SyntaxNode, SyntaxNodeParent>;
+
+/** The children of a node, including tokens. */
+using SyntaxElementChildren =
+    SyntaxSuccessors<SyntaxElement, SyntaxElementNextSibling>;
+
+/** A preorder walk over the nodes of a red tree. */
+using SyntaxPreorder = SyntaxWalk<SyntaxNode>;
+
+/** A preorder walk over the nodes and tokens of a red tree. */
+using SyntaxPreorderWithTokens = SyntaxWalk<SyntaxElement>;
+
 /**
- * @brief Represents the data associated with a syntax node.
+ * @brief Represents a syntax node in the syntax tree.
+ *
+ * A `SyntaxNode` is a cheap handle to a position in a green tree. Unlike the
+ * green node, it knows its parent and absolute offset, so it supports
+ * navigating up and sideways. Nodes are created on demand while navigating,
+ * from a pool, and moving to a sibling is O(1) since each node records its
+ * index in the parent.
  *
- * `SyntaxNodeData` holds the offset of the node, a pointer to its parent
- * syntax node, and the associated green node.
+ * Handles are reference counted without atomics: a red tree belongs to one
+ * thread (see `SyntaxNodeData`).
  */
-class SyntaxNodeData {
+class SyntaxNode {
  public:
   /**
-   * @brief Constructs a `SyntaxNodeData` with the specified offset, parent
-   * node, and green node.
+   * @brief Creates a root syntax node from a green node.
    *
-   * @param offset The offset of the node in the source.
-   * @param parent Pointer to the parent `SyntaxNode`.
-   * @param green The associated `GreenNode`.
+   * @param node The associated `GreenNode`.
+   * @return A new `SyntaxNode` representing the root.
    */
-  explicit SyntaxNodeData(const size_t offset,
-                          std::optional<SyntaxNode> parent,
-                          GreenNode green)
-      : offset_(offset), parent_(std::move(parent)), green_(std::move(green)) {}
+  static SyntaxNode CreateRoot(GreenNode node) {
+    return SyntaxNode(SyntaxNodeData::NewRoot(std::move(node)));
+  }
 
   /**
    * @brief Deleted default constructor.
    *
-   * A `SyntaxNodeData` must always be constructed with an offset and a green
-   * node.
+   * A `SyntaxNode` always refers to a node of a tree.
    */
-  SyntaxNodeData() = delete;
+  SyntaxNode() = delete;
 
-  /** Defaulted copy and move constructors. */
-  SyntaxNodeData(const SyntaxNodeData&) = default;
-  SyntaxNodeData(SyntaxNodeData&&) = default;
+  SyntaxNode(const SyntaxNode& other) noexcept : data_(other.data_) {
+    data_->Retain();
+  }
+
+  // Moving only shares the data, like a copy, so a moved-from handle stays
+  // valid and no handle is ever null.
+  SyntaxNode(SyntaxNode&& other) noexcept : data_(other.data_) {
+    data_->Retain();
+  }
+
+  SyntaxNode& operator=(const SyntaxNode& other) noexcept {
+    other.data_->Retain();
+    SyntaxNodeData::Release(data_);
+    data_ = other.data_;
+    return *this;
+  }
+
+  SyntaxNode& operator=(SyntaxNode&& other) noexcept {
+    std::swap(data_, other.data_);
+    return *this;
+  }
 
   /**
-   * @brief Returns the offset of the node.
+   * @brief Releases the handle, and its ancestors iteratively if it was the
+   * last reference to them.
+   */
+  ~SyntaxNode() { SyntaxNodeData::Release(data_); }
+
+  /**
+   * @brief Returns the kind of the node.
+   */
+  [[nodiscard]] SyntaxKind Kind() const noexcept { return Green().Kind(); }
+
+  /**
+   * @brief Returns the absolute offset of the node.
+   */
+  [[nodiscard]] TextSize Offset() const noexcept { return data_->Offset(); }
+
+  /**
+   * @brief Returns the range of text the node covers.
+   */
+  [[nodiscard]] TextRange Range() const {
+    return TextRange::At(Offset(), Green().Width());
+  }
+
+  /**
+   * @brief Returns a lazy view of the text the node covers.
    *
-   * @return The node's offset in the source.
+   * Defined in `syntax_text.h`, which callers must include.
    */
-  [[nodiscard]] size_t Offset() const { return offset_; }
+  [[nodiscard]] SyntaxText Text() const;
 
   /**
-   * @brief Returns the optional parent syntax node.
+   * @brief Returns the associated green node.
    *
-   * @return A reference to the optional parent `SyntaxNode`.
+   * @return A reference to the `GreenNode`, valid while this handle lives.
    */
-  [[nodiscard]] const std::optional<SyntaxNode>& Parent()
-      const {
-    return parent_;
+  [[nodiscard]] const GreenNode& Green() const noexcept {
+    return *data_->Green().AsNode();
   }
 
   /**
-   * @brief Returns the associated green node.
+   * @brief Returns the index of the node among its parent's children,
+   * counting tokens.
+   */
+  [[nodiscard]] size_t IndexInParent() const noexcept {
+    return data_->Index();
+  }
+
+  /**
+   * @brief Returns the parent node, or `nullopt` for the root.
+   */
+  [[nodiscard]] std::optional<SyntaxNode> Parent() const noexcept;
+
+  /**
+   * @brief Returns the first child node, skipping tokens.
+   */
+  [[nodiscard]] std::optional<SyntaxNode> FirstChild() const;
+
+  /**
+   * @brief Returns the last child node, skipping tokens.
+   */
+  [[nodiscard]] std::optional<SyntaxNode> LastChild() const;
+
+  /**
+   * @brief Returns the next sibling node, skipping tokens.
+   */
+  [[nodiscard]] std::optional<SyntaxNode> NextSibling() const;
+
+  /**
+   * @brief Returns the previous sibling node, skipping tokens.
+   */
+  [[nodiscard]] std::optional<SyntaxNode> PrevSibling() const;
+
+  /**
+   * @brief Returns the first child, node or token.
+   */
+  [[nodiscard]] std::optional<SyntaxElement> FirstChildOrToken() const;
+
+  /**
+   * @brief Returns the last child, node or token.
+   */
+  [[nodiscard]] std::optional<SyntaxElement> LastChildOrToken() const;
+
+  /**
+   * @brief Returns the next sibling, node or token.
+   */
+  [[nodiscard]] std::optional<SyntaxElement> NextSiblingOrToken() const;
+
+  /**
+   * @brief Returns the previous sibling, node or token.
+   */
+  [[nodiscard]] std::optional<SyntaxElement> PrevSiblingOrToken() const;
+
+  /**
+   * @brief Returns a range over the child nodes, skipping tokens.
+   */
+  [[nodiscard]] SyntaxNodeChildren Children() const;
+
+  /**
+   * @brief Returns a range over the children, including tokens.
    *
-   * @return A reference to the `GreenNode`.
+   * @note Defined in `syntax_element.h`.
    */
-  [[nodiscard]] const GreenNode& Green() const { return green_; }
+  [[nodiscard]] SyntaxElementChildren ChildrenWithTokens() const;
 
- private:
-  /** The offset of the node in the source. */
-  const size_t offset_;
+  /**
+   * @brief Returns a range over this node and then each of its ancestors.
+   */
+  [[nodiscard]] SyntaxNodeAncestors Ancestors() const;
 
-  /** The parent syntax node, if any. */
-  const std::optional<SyntaxNode> parent_;
+  /**
+   * @brief Returns a range over this node and every node below it, in
+   * preorder.
+   */
+  [[nodiscard]] SyntaxNodeDescendants Descendants() const;
 
-  /** The associated green node. */
-  const GreenNode green_;
-};
+  /**
+   * @brief Returns a preorder walk over this node and the nodes below it.
+   *
+   * @note Defined in `syntax_preorder.h`.
+   */
+  [[nodiscard]] SyntaxPreorder Preorder() const;
 
-/**
- * @brief Represents a syntax node in the syntax tree.
- *
- * `SyntaxNode` encapsulates `SyntaxNodeData` and provides access to
- * the node's properties and methods for interacting with the syntax tree.
- */
-class SyntaxNode {
- public:
   /**
-   * @brief Creates a root syntax node from a green node.
+   * @brief Returns a preorder walk over this node and the nodes and tokens
+   * below it.
    *
-   * @param node The associated `GreenNode`.
-   * @return A new `SyntaxNode` representing the root.
+   * @note Defined in `syntax_preorder.h`.
    */
-  static SyntaxNode CreateRoot(const GreenNode& node) {
-    return SyntaxNode(0, node);
-  }
+  [[nodiscard]] SyntaxPreorderWithTokens PreorderWithTokens() const;
 
   /**
-   * @brief Constructs a `SyntaxNode` with the specified offset, parent node,
-   * and green node.
+   * @brief Finds the tokens touching an offset.
+   *
+   * Only the children on the path to the offset are visited, each found by
+   * a binary search over the green child offsets, so the query costs
+   * O(depth * log(fan-out)) and creates only the red elements on that path.
    *
-   * @param offset The offset of the node in the source.
-   * @param parent Pointer to the parent `SyntaxNode`.
-   * @param green The associated `GreenNode`.
+   * @param offset The absolute offset to look up.
+   * @return The token containing the offset, both tokens on a boundary, or
+   * none if the offset is outside this node or the node is empty.
    */
-  explicit SyntaxNode(size_t offset, SyntaxNode parent,
-                      GreenNode green)
-      : data_(std::make_shared<SyntaxNodeData>(
-            offset, std::make_optional(std::move(parent)), std::move(green))) {}
+  [[nodiscard]] TokensAtOffset TokenAtOffset(TextSize offset) const;
 
   /**
-   * @brief Constructs a `SyntaxNode` with the specified offset and green node,
-   * with no parent.
+   * @brief Finds the deepest node or token containing a range.
    *
-   * @param offset The offset of the node in the source.
-   * @param green The associated `GreenNode`.
+   * Like `TokenAtOffset`, only the covering path is visited. An empty range
+   * on a boundary between two children resolves to the left child.
+   *
+   * @param range The absolute range to cover.
+   * @return The smallest element whose range contains `range`.
+   * @throws std::invalid_argument If this node does not contain `range`.
    */
-  explicit SyntaxNode(size_t offset, GreenNode green)
-      : data_(std::make_shared<SyntaxNodeData>(offset, std::nullopt,
-                                               std::move(green))) {}
+  [[nodiscard]] SyntaxElement CoveringElement(TextRange range) const;
 
   /**
-   * @brief Deleted default constructor.
+   * @brief Replaces one child, producing a new tree.
    *
-   * A `SyntaxNode` must always be constructed with an offset and a green node.
+   * Only the nodes from this one up to the root are rebuilt; everything
+   * else is shared with the old tree, which is left unchanged. To apply
+   * several edits with one rebuild, use `SyntaxEditor`.
+   *
+   * @param index The index of the child.
+   * @param replacement The new child.
+   * @return The new root and the offset mapping.
+   * @throws std::invalid_argument If `index` is out of range.
+   * @note Defined in `syntax_editor.cc`.
    */
-  SyntaxNode() = delete;
+  [[nodiscard]] SyntaxEdit ReplaceChild(size_t index,
+                                        GreenElement replacement) const;
 
   /**
-   * @brief Returns the offset of the node.
+   * @brief Inserts children, producing a new tree.
    *
-   * @return The node's offset in the source.
+   * @param index The index of the child to insert before, or the number of
+   * children to append.
+   * @param children The new children.
+   * @return The new root and the offset mapping.
+   * @throws std::invalid_argument If `index` is out of range.
    */
-  [[nodiscard]] size_t GetOffset() const noexcept { return data_->Offset(); }
+  [[nodiscard]] SyntaxEdit InsertChildren(
+      size_t index, std::vector<GreenElement> children) const;
 
   /**
-   * @brief Returns the optional parent syntax node.
+   * @brief Removes a run of children, producing a new tree.
    *
-   * @return A reference to the optional parent `SyntaxNode`.
+   * @param index The index of the first child to remove.
+   * @param count The number of children to remove.
+   * @return The new root and the offset mapping.
+   * @throws std::invalid_argument If the run is out of range.
    */
-  [[nodiscard]] const std::optional<SyntaxNode>& GetParent()
-      const noexcept {
-    return data_->Parent();
-  }
+  [[nodiscard]] SyntaxEdit RemoveChildren(size_t index, size_t count) const;
 
   /**
-   * @brief Returns the associated green node.
+   * @brief Compares two nodes by position.
    *
-   * @return A reference to the `GreenNode`.
+   * @param other The other node to compare with.
+   * @return `true` if both handles refer to the same node of the same tree.
+   */
+  bool operator==(const SyntaxNode& other) const noexcept {
+    return &data_->Green() == &other.data_->Green() &&
+           Offset() == other.Offset();
+  }
+
+ private:
+  friend class SyntaxElement;
+  friend class SyntaxToken;
+
+  /**
+   * @brief Adopts one reference to `data`.
    */
-  [[nodiscard]] const GreenNode& GetGreen() const noexcept {
-    return data_->Green();
+  explicit SyntaxNode(SyntaxNodeData* data) noexcept : data_(data) {}
+
+  /** The node data, never `nullptr`: moving shares it like a copy. */
+  SyntaxNodeData* data_;
+};
+
+/**
+ * @brief Steps from a node to its next sibling node.
+ */
+struct SyntaxNodeNextSibling {
+  std::optional<SyntaxNode> operator()(const SyntaxNode& node) const {
+    return node.NextSibling();
   }
+};
+
+/**
+ * @brief Steps from a node to its parent.
+ */
+struct SyntaxNodeParent {
+  std::optional<SyntaxNode> operator()(const SyntaxNode& node) const {
+    return node.Parent();
+  }
+};
+
+/**
+ * @brief A preorder range over a node and every node below it.
+ *
+ * The walk moves through first children, next siblings and parents, so it
+ * needs no stack, and every step recycles the node it leaves.
+ */
+class SyntaxNodeDescendants {
+ public:
+  /**
+   * @brief Iterator holding the walk's root and current node.
+   */
+  class Iterator {
+   public:
+    using value_type = SyntaxNode;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+
+    /**
+     * @brief Constructs an iterator at the start of a walk.
+     *
+     * @param root The node to walk below.
+     */
+    explicit Iterator(const SyntaxNode& root) : root_(root), current_(root) {}
+
+    const SyntaxNode& operator*() const noexcept { return *current_; }
+
+    const SyntaxNode* operator->() const noexcept { return &*current_; }
+
+    Iterator& operator++();
+
+    Iterator operator++(int) {
+      Iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    bool operator==(const Iterator& other) const noexcept {
+      return current_ == other.current_;
+    }
+
+   private:
+    /** The node the walk started from. */
+    std::optional<SyntaxNode> root_;
+
+    /** The current node, or `nullopt` at the end. */
+    std::optional<SyntaxNode> current_;
+  };
+
+  /**
+   * @brief Constructs the range below `root`.
+   *
+   * @param root The first node of the walk.
+   */
+  explicit SyntaxNodeDescendants(SyntaxNode root) noexcept
+      : root_(std::move(root)) {}
+
+  [[nodiscard]] Iterator begin() const { return Iterator(root_); }
+
+  [[nodiscard]] Iterator end() const noexcept { return Iterator(); }
 
  private:
-  /** Pointer to the node data. */
-  const std::shared_ptr<SyntaxNodeData> data_;
+  /** The first node of the walk. */
+  SyntaxNode root_;
 };
 
+inline SyntaxNodeChildren SyntaxNode::Children() const {
+  return SyntaxNodeChildren(FirstChild());
+}
+
+inline SyntaxNodeAncestors SyntaxNode::Ancestors() const {
+  return SyntaxNodeAncestors(*this);
+}
+
+inline SyntaxNodeDescendants SyntaxNode::Descendants() const {
+  return SyntaxNodeDescendants(*this);
+}
+
 }  // namespace orion::syntax
 
 #endif  // SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_NODE_H_
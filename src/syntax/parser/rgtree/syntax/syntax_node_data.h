@@ -0,0 +1,129 @@
+#ifndef SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_NODE_DATA_H_
+#define SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_NODE_DATA_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/text/text_size.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief The shared state behind a `SyntaxNode` or `SyntaxToken` handle.
+ *
+ * A red element is a cursor into a green tree: it records which child of its
+ * parent it is, where it starts, and holds a reference to its parent. The
+ * green element itself is borrowed from the parent's green node, which the
+ * parent keeps alive; only a root owns its green node.
+ *
+ * Red elements are created lazily while navigating and recycled through a
+ * per-thread free list, so walking a tree does no steady-state allocation.
+ * The reference count is not atomic: a red tree must stay on the thread that
+ * created it. Green trees may be shared freely, so a tree is moved between
+ * threads by handing over its green root.
+ */
+class SyntaxNodeData {
+ public:
+  /**
+   * @brief Creates the red root of a green tree.
+   *
+   * @param green The green root, which the returned data owns.
+   * @return Data with one reference.
+   */
+  [[nodiscard]] static SyntaxNodeData* NewRoot(GreenNode green);
+
+  /**
+   * @brief Creates the red element for a child of a node.
+   *
+   * @param parent The parent, which gains a reference.
+   * @param index The index of the child in the parent's green node.
+   * @return Data with one reference.
+   */
+  [[nodiscard]] static SyntaxNodeData* NewChild(SyntaxNodeData* parent,
+                                                size_t index);
+
+  /**
+   * @brief Adds a reference.
+   */
+  void Retain() noexcept { ++ref_count_; }
+
+  /**
+   * @brief Drops a reference, recycling the data and releasing its ancestors
+   * iteratively once no references are left.
+   *
+   * @param data The data to release, or `nullptr`.
+   */
+  static void Release(SyntaxNodeData* data) noexcept;
+
+  /**
+   * @brief Returns how many times this thread's free list was empty and data
+   * had to be allocated.
+   */
+  [[nodiscard]] static uint64_t HeapAllocations() noexcept;
+
+  /**
+   * @brief Returns the green element this data points at.
+   *
+   * @return A reference to the `GreenElement`, valid while this data lives.
+   */
+  [[nodiscard]] const GreenElement& Green() const noexcept { return *green_; }
+
+  /**
+   * @brief Returns the green node this data points at.
+   *
+   * @return A reference to the `GreenNodeData`. Only valid for nodes.
+   */
+  [[nodiscard]] const GreenNodeData& GreenData() const noexcept {
+    return green_->AsNode()->Data();
+  }
+
+  /**
+   * @brief Returns the parent, which is `nullptr` for a root.
+   */
+  [[nodiscard]] SyntaxNodeData* Parent() const noexcept { return parent_; }
+
+  /**
+   * @brief Returns the index of this element in its parent.
+   */
+  [[nodiscard]] size_t Index() const noexcept { return index_; }
+
+  /**
+   * @brief Returns the absolute offset of this element.
+   */
+  [[nodiscard]] TextSize Offset() const noexcept { return offset_; }
+
+ private:
+  /**
+   * @brief Takes data from the free list, or allocates it.
+   */
+  static SyntaxNodeData* Allocate();
+
+  /**
+   * @brief Returns data to the free list, or frees it.
+   */
+  static void Free(SyntaxNodeData* data) noexcept;
+
+  /** The number of handles and children referring to this data. */
+  uint32_t ref_count_ = 0;
+
+  /** The index of this element in its parent. */
+  uint32_t index_ = 0;
+
+  /** The absolute offset of this element. */
+  TextSize offset_;
+
+  /** The parent, holding one reference, or `nullptr` for a root. */
+  SyntaxNodeData* parent_ = nullptr;
+
+  /** The green element: a child of the parent's green node, or `root_`. */
+  const GreenElement* green_ = nullptr;
+
+  /** The green root, only set for roots. */
+  GreenElement root_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_NODE_DATA_H_
@@ -0,0 +1,173 @@
+#ifndef SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_PREORDER_H_
+#define SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_PREORDER_H_
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "syntax/parser/rgtree/syntax/syntax_element.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/walk_event.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief A preorder walk over a red tree yielding `WalkEvent`s.
+ *
+ * Red elements know their parent and index, so the walk moves through first
+ * children, next siblings and parents without any stack. Each step recycles
+ * the pooled element it leaves, so the walk does not allocate.
+ *
+ * As with `GreenWalk`, the walk is its own range and `SkipSubtree()` may be
+ * called between steps to prune.
+ *
+ * @tparam T `SyntaxNode` to walk nodes, or `SyntaxElement` to include tokens.
+ */
+template <typename T>
+class SyntaxWalk {
+ public:
+  /**
+   * @brief Iterator stepping the walk it belongs to.
+   */
+  class Iterator {
+   public:
+    using value_type = WalkEvent<T>;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+
+    /**
+     * @brief Constructs an iterator over `walk`.
+     *
+     * @param walk The walk to step.
+     */
+    explicit Iterator(SyntaxWalk* walk) noexcept : walk_(walk) {}
+
+    const value_type& operator*() const noexcept { return *walk_->current_; }
+
+    const value_type* operator->() const noexcept {
+      return &*walk_->current_;
+    }
+
+    Iterator& operator++() {
+      walk_->Advance();
+      return *this;
+    }
+
+    void operator++(int) { walk_->Advance(); }
+
+    bool operator==(std::default_sentinel_t) const noexcept {
+      return !walk_->current_.has_value();
+    }
+
+   private:
+    /** The walk being stepped. */
+    SyntaxWalk* walk_ = nullptr;
+  };
+
+  /**
+   * @brief Constructs a walk starting with `Enter(root)`.
+   *
+   * @param root The root of the walk.
+   */
+  explicit SyntaxWalk(const SyntaxNode& root)
+      : root_(root), current_(WalkEvent<T>{WalkEventKind::kEnter, T(root)}) {}
+
+  [[nodiscard]] Iterator begin() noexcept { return Iterator(this); }
+
+  [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+  /**
+   * @brief Skips the children of the element just entered, so the next event
+   * leaves it. Does nothing after a `kLeave` event.
+   */
+  void SkipSubtree() noexcept {
+    if (current_.has_value() && current_->IsEnter()) {
+      skip_ = true;
+    }
+  }
+
+ private:
+  /**
+   * @brief Moves to the next event.
+   */
+  void Advance() {
+    if (current_->IsEnter()) {
+      std::optional<T> child =
+          skip_ ? std::nullopt : FirstChild(current_->value);
+      skip_ = false;
+      if (child.has_value()) {
+        current_ = {WalkEventKind::kEnter, std::move(*child)};
+      } else {
+        current_->kind = WalkEventKind::kLeave;
+      }
+      return;
+    }
+
+    const T& left = current_->value;
+    if (IsRoot(left)) {
+      current_.reset();
+      return;
+    }
+
+    if (std::optional<T> sibling = NextSibling(left); sibling.has_value()) {
+      current_ = {WalkEventKind::kEnter, std::move(*sibling)};
+      return;
+    }
+
+    current_ = {WalkEventKind::kLeave, T(*left.Parent())};
+  }
+
+  static std::optional<SyntaxNode> FirstChild(const SyntaxNode& node) {
+    return node.FirstChild();
+  }
+
+  static std::optional<SyntaxElement> FirstChild(
+      const SyntaxElement& element) {
+    const SyntaxNode* node = element.AsNode();
+    return node != nullptr ? node->FirstChildOrToken() : std::nullopt;
+  }
+
+  static std::optional<SyntaxNode> NextSibling(const SyntaxNode& node) {
+    return node.NextSibling();
+  }
+
+  static std::optional<SyntaxElement> NextSibling(
+      const SyntaxElement& element) {
+    return element.NextSiblingOrToken();
+  }
+
+  /**
+   * @brief Returns whether `element` is the root of the walk.
+   */
+  bool IsRoot(const T& element) const noexcept {
+    if constexpr (std::is_same_v<T, SyntaxNode>) {
+      return element == root_;
+    } else {
+      return element.IsNode() && *element.AsNode() == root_;
+    }
+  }
+
+  /** The root of the walk. */
+  SyntaxNode root_;
+
+  /** The current event, or `nullopt` once the walk is done. */
+  std::optional<WalkEvent<T>> current_;
+
+  /** Whether the element just entered should be left without its children. */
+  bool skip_ = false;
+};
+
+inline SyntaxPreorder SyntaxNode::Preorder() const {
+  return SyntaxPreorder(*this);
+}
+
+inline SyntaxPreorderWithTokens SyntaxNode::PreorderWithTokens() const {
+  return SyntaxPreorderWithTokens(*this);
+}
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_PREORDER_H_
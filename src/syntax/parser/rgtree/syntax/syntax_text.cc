@@ -0,0 +1,239 @@
+#include "syntax/parser/rgtree/syntax/syntax_text.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_preorder.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/walk_event.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+#include "syntax/util/small_vector.h"
+#include "syntax/util/utf8.h"
+
+namespace orion::syntax {
+namespace {
+/**
+ * @brief Yields the text of the tokens within a range, one token at a time.
+ *
+ * Subtrees ending before the range are skipped whole, so reaching the first
+ * chunk costs O(depth * fan-out) rather than a walk over every earlier
+ * token.
+ */
+class ChunkCursor {
+ public:
+  /**
+   * @brief Constructs a cursor over part of a tree's text.
+   *
+   * @param root The root of the tree.
+   * @param range The range to yield, relative to `root`.
+   */
+  ChunkCursor(const GreenNode& root, const TextRange range)
+      : walk_(root), it_(walk_.begin()), range_(range) {}
+
+  /**
+   * @brief Returns the next non-empty chunk, trimmed to the range.
+   */
+  std::optional<std::string_view> Next() {
+    for (; it_ != std::default_sentinel; ++it_) {
+      const WalkEvent<GreenWalkItem>& event = *it_;
+      if (event.IsLeave()) {
+        continue;
+      }
+
+      const TextSize start = event.value.offset;
+      const TextSize end = start + event.value.element->Width();
+      if (start >= range_.End()) {
+        return std::nullopt;
+      }
+      if (end <= range_.Start() || start == end) {
+        walk_.SkipSubtree();
+        continue;
+      }
+
+      const GreenToken* token = event.value.element->AsToken();
+      if (token == nullptr) {
+        continue;
+      }
+      ++it_;
+      return Trim(token->Text(), start, end);
+    }
+    return std::nullopt;
+  }
+
+ private:
+  /**
+   * @brief Cuts the parts of a token outside the range from its text.
+   */
+  std::string_view Trim(const std::string_view text, const TextSize start,
+                        const TextSize end) const noexcept {
+    // Only the first and last chunks need scanning for a byte offset.
+    const size_t first =
+        start < range_.Start()
+            ? Utf8Offset(text, static_cast<size_t>(range_.Start() - start))
+            : 0;
+    const size_t last =
+        range_.End() < end
+            ? Utf8Offset(text, static_cast<size_t>(range_.End() - start))
+            : text.size();
+    return text.substr(first, last - first);
+  }
+
+  /** The walk over the tree's tokens. */
+  GreenPreorderWithTokens walk_;
+
+  /** The position of the walk. */
+  GreenPreorderWithTokens::Iterator it_;
+
+  /** The range to yield. */
+  TextRange range_;
+};
+
+TextRange RelativeTo(const TextRange range, const TextSize origin) {
+  return TextRange(range.Start() - origin, range.End() - origin);
+}
+
+bool IsLeadByte(const char byte) noexcept {
+  return (static_cast<unsigned char>(byte) & 0xC0) != 0x80;
+}
+}  // namespace
+
+SyntaxText::SyntaxText(SyntaxNode node, const TextRange range)
+    : node_(std::move(node)), range_(range) {
+  if (!node_.Range().ContainsRange(range_)) {
+    throw std::invalid_argument("text range is outside the node");
+  }
+}
+
+std::optional<char32_t> SyntaxText::CharAt(const TextSize offset) const {
+  if (offset >= Len()) {
+    return std::nullopt;
+  }
+
+  ChunkCursor chunks(node_.Green(), RelativeTo(range_, node_.Offset()));
+  auto remaining = static_cast<size_t>(offset);
+  while (const std::optional<std::string_view> chunk = chunks.Next()) {
+    const size_t count = CountCodepoints(*chunk);
+    if (remaining < count) {
+      return DecodeUtf8At(*chunk, Utf8Offset(*chunk, remaining));
+    }
+    remaining -= count;
+  }
+  return std::nullopt;
+}
+
+std::optional<TextSize> SyntaxText::Find(const std::string_view needle) const {
+  if (needle.empty()) {
+    return TextSize();
+  }
+
+  // Knuth-Morris-Pratt over the bytes, so a match may straddle chunks
+  // without any backtracking into earlier ones.
+  SmallVector<uint32_t, 64> border;
+  border.PushBack(0);
+  for (size_t i = 1, k = 0; i < needle.size(); ++i) {
+    while (k > 0 && needle[i] != needle[k]) {
+      k = border[k - 1];
+    }
+    if (needle[i] == needle[k]) {
+      ++k;
+    }
+    border.PushBack(static_cast<uint32_t>(k));
+  }
+
+  const size_t needle_codepoints = CountCodepoints(needle);
+  ChunkCursor chunks(node_.Green(), RelativeTo(range_, node_.Offset()));
+  size_t matched = 0;
+  size_t codepoints = 0;
+  while (const std::optional<std::string_view> chunk = chunks.Next()) {
+    for (const char byte : *chunk) {
+      codepoints += IsLeadByte(byte) ? 1 : 0;
+      while (matched > 0 && byte != needle[matched]) {
+        matched = border[matched - 1];
+      }
+      if (byte == needle[matched]) {
+        ++matched;
+      }
+      if (matched == needle.size()) {
+        return TextSize::Of(codepoints - needle_codepoints);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<TextSize> SyntaxText::Find(const char32_t ch) const {
+  // At most four bytes, which fit in the string's inline buffer.
+  std::string encoded;
+  AppendUtf8(encoded, ch);
+  return Find(std::string_view(encoded));
+}
+
+SyntaxText SyntaxText::Slice(const TextRange range) const {
+  if (range.End() > Len()) {
+    throw std::invalid_argument("slice is out of range");
+  }
+  return {node_, range.Shift(range_.Start())};
+}
+
+std::string SyntaxText::ToString() const {
+  std::string out;
+  ChunkCursor chunks(node_.Green(), RelativeTo(range_, node_.Offset()));
+  while (const std::optional<std::string_view> chunk = chunks.Next()) {
+    out.append(*chunk);
+  }
+  return out;
+}
+
+bool SyntaxText::operator==(std::string_view other) const {
+  ChunkCursor chunks(node_.Green(), RelativeTo(range_, node_.Offset()));
+  while (const std::optional<std::string_view> chunk = chunks.Next()) {
+    if (!other.starts_with(*chunk)) {
+      return false;
+    }
+    other.remove_prefix(chunk->size());
+  }
+  return other.empty();
+}
+
+bool SyntaxText::operator==(const SyntaxText& other) const {
+  if (Len() != other.Len()) {
+    return false;
+  }
+
+  // Tokens rarely line up between two texts, so compare the common prefix of
+  // the current chunks and refill whichever runs out.
+  ChunkCursor lhs_chunks(node_.Green(), RelativeTo(range_, node_.Offset()));
+  ChunkCursor rhs_chunks(other.node_.Green(),
+                         RelativeTo(other.range_, other.node_.Offset()));
+  std::string_view lhs;
+  std::string_view rhs;
+  while (true) {
+    if (lhs.empty()) {
+      lhs = lhs_chunks.Next().value_or(std::string_view());
+    }
+    if (rhs.empty()) {
+      rhs = rhs_chunks.Next().value_or(std::string_view());
+    }
+    if (lhs.empty() || rhs.empty()) {
+      return lhs.empty() && rhs.empty();
+    }
+
+    const size_t common = std::min(lhs.size(), rhs.size());
+    if (lhs.substr(0, common) != rhs.substr(0, common)) {
+      return false;
+    }
+    lhs.remove_prefix(common);
+    rhs.remove_prefix(common);
+  }
+}
+}  // namespace orion::syntax
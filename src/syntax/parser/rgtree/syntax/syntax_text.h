@@ -0,0 +1,135 @@
+#ifndef SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_TEXT_H_
+#define SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_TEXT_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief A lazy view of the text under a node.
+ *
+ * The text of a tree is scattered across its tokens, so building it as one
+ * string copies every token. A `SyntaxText` instead walks the tokens within
+ * its range on demand and treats each token's text as a chunk of a rope.
+ * Queries stream over the chunks without copying them; only `ToString`
+ * builds a string.
+ *
+ * Offsets and lengths are in code points, like every `TextSize` in the tree,
+ * and are relative to the start of the view.
+ *
+ * @code
+ * SyntaxText text = node.Text();
+ * if (text.Contains("TODO")) {
+ *   SyntaxText rest = text.Slice(TextRange(*text.Find("TODO"), text.Len()));
+ * }
+ * @endcode
+ */
+class SyntaxText {
+ public:
+  /**
+   * @brief Constructs a view of part of the text under a node.
+   *
+   * @param node The node whose text is viewed.
+   * @param range The absolute range to view.
+   * @throws std::invalid_argument If `range` is not within the node.
+   */
+  SyntaxText(SyntaxNode node, TextRange range);
+
+  /**
+   * @brief Returns the absolute range the view covers.
+   */
+  [[nodiscard]] TextRange Range() const noexcept { return range_; }
+
+  /**
+   * @brief Returns the length of the text in code points.
+   */
+  [[nodiscard]] TextSize Len() const noexcept { return range_.Len(); }
+
+  /**
+   * @brief Checks if the text is empty.
+   */
+  [[nodiscard]] bool IsEmpty() const noexcept { return range_.IsEmpty(); }
+
+  /**
+   * @brief Returns the code point at an offset.
+   *
+   * @param offset The offset into the view.
+   * @return The code point, or `std::nullopt` if `offset` is past the end.
+   */
+  [[nodiscard]] std::optional<char32_t> CharAt(TextSize offset) const;
+
+  /**
+   * @brief Finds the first occurrence of a string.
+   *
+   * Matches may span tokens. The search is linear in the length of the text.
+   *
+   * @param needle The UTF-8 text to find.
+   * @return The offset of the first match, or `std::nullopt` if none.
+   */
+  [[nodiscard]] std::optional<TextSize> Find(std::string_view needle) const;
+
+  /**
+   * @brief Finds the first occurrence of a code point.
+   *
+   * @param ch The code point to find.
+   * @return The offset of the first match, or `std::nullopt` if none.
+   */
+  [[nodiscard]] std::optional<TextSize> Find(char32_t ch) const;
+
+  /**
+   * @brief Checks if the text contains a string.
+   */
+  [[nodiscard]] bool Contains(const std::string_view needle) const {
+    return Find(needle).has_value();
+  }
+
+  /**
+   * @brief Checks if the text contains a code point.
+   */
+  [[nodiscard]] bool Contains(const char32_t ch) const {
+    return Find(ch).has_value();
+  }
+
+  /**
+   * @brief Returns a view of part of this text.
+   *
+   * @param range The range to view, relative to the start of this view.
+   * @return A view sharing this view's node.
+   * @throws std::invalid_argument If `range` ends past `Len()`.
+   */
+  [[nodiscard]] SyntaxText Slice(TextRange range) const;
+
+  /**
+   * @brief Copies the text into a string.
+   */
+  [[nodiscard]] std::string ToString() const;
+
+  /**
+   * @brief Compares the text with a string, without copying either.
+   */
+  bool operator==(std::string_view other) const;
+
+  /**
+   * @brief Compares the text of two views, without copying either.
+   */
+  bool operator==(const SyntaxText& other) const;
+
+ private:
+  /** The node whose text is viewed, keeping its tokens alive. */
+  SyntaxNode node_;
+
+  /** The absolute range of the view. */
+  TextRange range_;
+};
+
+inline SyntaxText SyntaxNode::Text() const { return {*this, Range()}; }
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_TEXT_H_
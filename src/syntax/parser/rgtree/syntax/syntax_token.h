@@ -1,147 +1,222 @@
 #ifndef SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_TOKEN_H_
 #define SYNTAX_PARSER_RGTREE_SYNTAX_SYNTAX_TOKEN_H_
 
-#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <string_view>
+#include <utility>
 
 #include "syntax/parser/rgtree/green/green_token.h"
 #include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_node_data.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
 
 namespace orion::syntax {
 
 /**
- * @brief Represents the data associated with a syntax token.
+ * @brief Represents a syntax token in the syntax tree.
  *
- * `SyntaxTokenData` holds the offset of the token, a pointer to its parent
- * syntax node, and the associated green token.
+ * Like `SyntaxNode`, a `SyntaxToken` is a pooled, reference-counted cursor
+ * into a green tree. A token always has a parent node.
  */
-class SyntaxTokenData {
+class SyntaxToken {
  public:
   /**
-   * @brief Constructs a `SyntaxTokenData` with the specified offset, parent
-   * node, and green token.
+   * @brief Deleted default constructor.
    *
-   * @param offset The offset of the token in the source.
-   * @param parent Pointer to the parent `SyntaxNode`.
-   * @param green The associated `GreenToken`.
+   * A `SyntaxToken` always refers to a token of a tree.
    */
-  explicit SyntaxTokenData(const size_t offset, std::optional<SyntaxNode> parent,
-                           GreenToken green)
-      : offset_(offset), parent_(std::move(parent)), green_(std::move(green)) {}
+  SyntaxToken() = delete;
+
+  SyntaxToken(const SyntaxToken& other) noexcept : data_(other.data_) {
+    data_->Retain();
+  }
+
+  // Moving only shares the data, like a copy, so a moved-from handle stays
+  // valid and no handle is ever null.
+  SyntaxToken(SyntaxToken&& other) noexcept : data_(other.data_) {
+    data_->Retain();
+  }
+
+  SyntaxToken& operator=(const SyntaxToken& other) noexcept {
+    other.data_->Retain();
+    SyntaxNodeData::Release(data_);
+    data_ = other.data_;
+    return *this;
+  }
+
+  SyntaxToken& operator=(SyntaxToken&& other) noexcept {
+    std::swap(data_, other.data_);
+    return *this;
+  }
 
   /**
-   * @brief Deleted default constructor.
-   *
-   * A `SyntaxTokenData` must always be constructed with an offset and a green
-   * token.
+   * @brief Releases the handle, and its ancestors iteratively if it was the
+   * last reference to them.
    */
-  SyntaxTokenData() = delete;
+  ~SyntaxToken() { SyntaxNodeData::Release(data_); }
 
-  /** Defaulted copy and move constructors. */
-  SyntaxTokenData(const SyntaxTokenData&) = default;
-  SyntaxTokenData(SyntaxTokenData&&) = default;
+  /**
+   * @brief Returns the kind of the token.
+   */
+  [[nodiscard]] SyntaxKind Kind() const noexcept { return Green().Kind(); }
 
   /**
-   * @brief Returns the offset of the token.
-   *
-   * @return The token's offset in the source.
+   * @brief Returns the text of the token.
    */
-  [[nodiscard]] size_t Offset() const { return offset_; }
+  [[nodiscard]] std::string_view Text() const { return Green().Text(); }
 
   /**
-   * @brief Returns the optional parent syntax node.
-   *
-   * @return A reference to the optional parent `SyntaxNode`.
+   * @brief Returns the absolute offset of the token.
+   */
+  [[nodiscard]] TextSize Offset() const noexcept { return data_->Offset(); }
+
+  /**
+   * @brief Returns the range of text the token covers.
    */
-  [[nodiscard]] const std::optional<SyntaxNode>& Parent() const {
-    return parent_;
+  [[nodiscard]] TextRange Range() const {
+    return TextRange::At(Offset(), Green().Width());
   }
 
   /**
    * @brief Returns the associated green token.
    *
-   * @return A reference to the `GreenToken`.
+   * @return A reference to the `GreenToken`, valid while this handle lives.
+   */
+  [[nodiscard]] const GreenToken& Green() const noexcept {
+    return *data_->Green().AsToken();
+  }
+
+  /**
+   * @brief Returns the index of the token among its parent's children.
+   */
+  [[nodiscard]] size_t IndexInParent() const noexcept {
+    return data_->Index();
+  }
+
+  /**
+   * @brief Returns the parent node.
+   */
+  [[nodiscard]] SyntaxNode Parent() const noexcept {
+    data_->Parent()->Retain();
+    return SyntaxNode(data_->Parent());
+  }
+
+  /**
+   * @brief Returns the next sibling, node or token.
+   */
+  [[nodiscard]] std::optional<SyntaxElement> NextSiblingOrToken() const;
+
+  /**
+   * @brief Returns the previous sibling, node or token.
+   */
+  [[nodiscard]] std::optional<SyntaxElement> PrevSiblingOrToken() const;
+
+  /**
+   * @brief Compares two tokens by position.
+   *
+   * @param other The other token to compare with.
+   * @return `true` if both handles refer to the same token of the same tree.
    */
-  [[nodiscard]] const GreenToken& Green() const { return green_; }
+  bool operator==(const SyntaxToken& other) const noexcept {
+    return &data_->Green() == &other.data_->Green() &&
+           Offset() == other.Offset();
+  }
 
  private:
-  /** The offset of the token in the source. */
-  const size_t offset_;
+  friend class SyntaxElement;
 
-  /** The parent syntax node, if any. */
-  const std::optional<SyntaxNode> parent_;
+  /**
+   * @brief Adopts one reference to `data`.
+   */
+  explicit SyntaxToken(SyntaxNodeData* data) noexcept : data_(data) {}
 
-  /** The associated green token. */
-  const GreenToken green_;
+  /** The token data, never `nullptr`: moving shares it like a copy. */
+  SyntaxNodeData* data_;
 };
 
 /**
- * @brief Represents a syntax token in the syntax tree.
+ * @brief How many tokens touch an offset.
+ */
+enum class TokenAtOffsetKind : uint8_t {
+  /** The node is empty, so no token touches the offset. */
+  kNone,
+
+  /** One token contains the offset, or the offset is at the tree's edge. */
+  kSingle,
+
+  /** The offset is the boundary between two tokens. */
+  kBetween,
+};
+
+/**
+ * @brief The tokens found at an offset by `SyntaxNode::TokenAtOffset`.
  *
- * `SyntaxToken` encapsulates `SyntaxTokenData` and provides access to
- * the token's properties and methods for interacting with the syntax tree.
+ * An offset inside a token finds only that token, but an offset on a
+ * boundary touches both the token ending there and the token starting there.
+ * Callers usually pick one side with `LeftBiased` or `RightBiased`.
  */
-class SyntaxToken {
+class TokensAtOffset {
  public:
   /**
-   * @brief Constructs a `SyntaxToken` with the specified offset, parent node,
-   * and green token.
-   *
-   * @param offset The offset of the token in the source.
-   * @param parent Pointer to the parent `SyntaxNode`.
-   * @param green The associated `GreenToken`.
+   * @brief Constructs a `kNone` result.
    */
-  explicit SyntaxToken(size_t offset, const SyntaxNode& parent,
-                       const GreenToken& green)
-      : data_(std::make_shared<SyntaxTokenData>(
-            offset, std::make_optional(parent), green)) {}
+  TokensAtOffset() = default;
 
   /**
-   * @brief Constructs a `SyntaxToken` with the specified offset and green
-   * token, with no parent.
+   * @brief Constructs a `kSingle` result.
    *
-   * @param offset The offset of the token in the source.
-   * @param green The associated `GreenToken`.
+   * @param token The token at the offset.
    */
-  explicit SyntaxToken(size_t offset, const GreenToken& green)
-      : data_(std::make_shared<SyntaxTokenData>(offset, std::nullopt, green)) {}
+  explicit TokensAtOffset(SyntaxToken token) noexcept
+      : left_(std::move(token)) {}
 
   /**
-   * @brief Deleted default constructor.
+   * @brief Constructs a `kBetween` result.
    *
-   * A `SyntaxToken` must always be constructed with an offset and a green
-   * token.
+   * @param left The token ending at the offset.
+   * @param right The token starting at the offset.
    */
-  SyntaxToken() = delete;
+  explicit TokensAtOffset(SyntaxToken left, SyntaxToken right) noexcept
+      : left_(std::move(left)), right_(std::move(right)) {}
 
   /**
-   * @brief Returns the offset of the token.
-   *
-   * @return The token's offset in the source.
+   * @brief Returns how many tokens touch the offset.
    */
-  [[nodiscard]] size_t Offset() const noexcept { return data_->Offset(); }
+  [[nodiscard]] TokenAtOffsetKind Kind() const noexcept {
+    if (right_.has_value()) {
+      return TokenAtOffsetKind::kBetween;
+    }
+    return left_.has_value() ? TokenAtOffsetKind::kSingle
+                             : TokenAtOffsetKind::kNone;
+  }
 
   /**
-   * @brief Returns the optional parent syntax node.
-   *
-   * @return A reference to the optional parent `SyntaxNode`.
+   * @brief Returns the token ending at the offset on a boundary, otherwise
+   * the single token.
    */
-  [[nodiscard]] const std::optional<SyntaxNode>& Parent() const noexcept {
-    return data_->Parent();
+  [[nodiscard]] const std::optional<SyntaxToken>& LeftBiased() const noexcept {
+    return left_;
   }
 
   /**
-   * @brief Returns the associated green token.
-   *
-   * @return A reference to the `GreenToken`.
+   * @brief Returns the token starting at the offset on a boundary, otherwise
+   * the single token.
    */
-  [[nodiscard]] const GreenToken& Green() const noexcept {
-    return data_->Green();
+  [[nodiscard]] const std::optional<SyntaxToken>& RightBiased()
+      const noexcept {
+    return right_.has_value() ? right_ : left_;
   }
 
  private:
-  /** Pointer to the token data. */
-  const std::shared_ptr<SyntaxTokenData> data_;
+  /** The single token, or the left token of a boundary. */
+  std::optional<SyntaxToken> left_;
+
+  /** The right token of a boundary. */
+  std::optional<SyntaxToken> right_;
 };
 
 }  // namespace orion::syntax
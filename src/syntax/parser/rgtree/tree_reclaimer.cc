@@ -0,0 +1,76 @@
+#include "syntax/parser/rgtree/tree_reclaimer.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace orion::syntax {
+TreeReclaimer::~TreeReclaimer() {
+  {
+    const std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  work_available_.notify_one();
+
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+
+  // Anything queued without a worker is released here instead.
+  queue_.clear();
+}
+
+TreeReclaimer& TreeReclaimer::Global() {
+  static TreeReclaimer reclaimer;
+  return reclaimer;
+}
+
+void TreeReclaimer::Flush() {
+  std::unique_lock lock(mutex_);
+  drained_.wait(lock, [this] { return queue_.empty() && !busy_; });
+}
+
+size_t TreeReclaimer::Pending() const {
+  const std::lock_guard lock(mutex_);
+  return queue_.size();
+}
+
+void TreeReclaimer::Enqueue(std::shared_ptr<const void> tree) {
+  {
+    const std::lock_guard lock(mutex_);
+    queue_.push_back(std::move(tree));
+    if (!worker_.joinable()) {
+      worker_ = std::thread(&TreeReclaimer::Run, this);
+    }
+  }
+  work_available_.notify_one();
+}
+
+void TreeReclaimer::Run() {
+  std::vector<std::shared_ptr<const void>> batch;
+
+  std::unique_lock lock(mutex_);
+  while (true) {
+    work_available_.wait(lock,
+                         [this] { return stopping_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+
+    // Release outside the lock so callers can keep queueing meanwhile.
+    std::swap(batch, queue_);
+    busy_ = true;
+    lock.unlock();
+    batch.clear();
+    lock.lock();
+    busy_ = false;
+
+    if (queue_.empty()) {
+      drained_.notify_all();
+    }
+  }
+}
+}  // namespace orion::syntax
@@ -0,0 +1,109 @@
+#ifndef SYNTAX_PARSER_RGTREE_TREE_RECLAIMER_H_
+#define SYNTAX_PARSER_RGTREE_TREE_RECLAIMER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace orion::syntax {
+
+/**
+ * @brief Frees syntax trees on a background thread.
+ *
+ * Releasing a large tree touches every node that is not shared with another
+ * tree, which can take long enough to show up in request latency. Handing the
+ * last reference to `Defer` moves that work onto the reclaimer's thread. If
+ * the caller is not holding the last reference, deferring is merely a cheap
+ * no-op.
+ *
+ * The worker thread is started on the first `Defer`, and the destructor frees
+ * everything still queued before joining it.
+ */
+class TreeReclaimer {
+ public:
+  /**
+   * @brief Constructs a reclaimer without starting its thread.
+   */
+  TreeReclaimer() = default;
+
+  /**
+   * @brief Frees every queued tree and stops the worker thread.
+   */
+  ~TreeReclaimer();
+
+  /** Deleted copy and move constructors and assignment operators. */
+  TreeReclaimer(const TreeReclaimer&) = delete;
+  TreeReclaimer(TreeReclaimer&&) = delete;
+  TreeReclaimer& operator=(const TreeReclaimer&) = delete;
+  TreeReclaimer& operator=(TreeReclaimer&&) = delete;
+
+  /**
+   * @brief Returns the process-wide reclaimer.
+   *
+   * @return A reference to the global `TreeReclaimer`.
+   */
+  [[nodiscard]] static TreeReclaimer& Global();
+
+  /**
+   * @brief Queues a tree to be released on the worker thread.
+   *
+   * @tparam Tree Any shareable tree handle, such as `GreenNode`. Red handles
+   * (`SyntaxNode`) belong to one thread, so defer their green root instead.
+   * @param tree The handle to release.
+   */
+  template <typename Tree>
+  void Defer(Tree&& tree) {
+    Enqueue(std::make_shared<std::decay_t<Tree>>(std::forward<Tree>(tree)));
+  }
+
+  /**
+   * @brief Blocks until every tree queued so far has been released.
+   */
+  void Flush();
+
+  /**
+   * @brief Returns the number of trees waiting to be released.
+   */
+  [[nodiscard]] size_t Pending() const;
+
+ private:
+  /**
+   * @brief Adds a type-erased handle to the queue.
+   */
+  void Enqueue(std::shared_ptr<const void> tree);
+
+  /**
+   * @brief The worker thread's loop.
+   */
+  void Run();
+
+  /** Guards every field below. */
+  mutable std::mutex mutex_;
+
+  /** Signalled when work arrives or the reclaimer stops. */
+  std::condition_variable work_available_;
+
+  /** Signalled when the worker has drained the queue. */
+  std::condition_variable drained_;
+
+  /** Handles waiting to be released. */
+  std::vector<std::shared_ptr<const void>> queue_;
+
+  /** Whether the worker is currently releasing a batch. */
+  bool busy_ = false;
+
+  /** Whether the destructor has asked the worker to stop. */
+  bool stopping_ = false;
+
+  /** The worker thread, started on first use. */
+  std::thread worker_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_RGTREE_TREE_RECLAIMER_H_
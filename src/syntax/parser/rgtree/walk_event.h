@@ -0,0 +1,55 @@
+#ifndef SYNTAX_PARSER_RGTREE_WALK_EVENT_H_
+#define SYNTAX_PARSER_RGTREE_WALK_EVENT_H_
+
+#include <cstdint>
+
+namespace orion::syntax {
+
+/**
+ * @brief Whether a preorder walk is entering or leaving an element.
+ */
+enum class WalkEventKind : uint8_t {
+  /** The walk reached the element; its children come next. */
+  kEnter,
+
+  /** The walk finished the element and all of its children. */
+  kLeave,
+};
+
+/**
+ * @brief An event of a preorder walk.
+ *
+ * Every element yields a `kEnter` event, then the events of its children,
+ * then a `kLeave` event, so a visitor can keep per-subtree state without
+ * recursing.
+ *
+ * @tparam T The element walked over.
+ */
+template <typename T>
+struct WalkEvent {
+  /** Whether the walk is entering or leaving `value`. */
+  WalkEventKind kind;
+
+  /** The element. */
+  T value;
+
+  /**
+   * @brief Returns whether this is a `kEnter` event.
+   */
+  [[nodiscard]] bool IsEnter() const noexcept {
+    return kind == WalkEventKind::kEnter;
+  }
+
+  /**
+   * @brief Returns whether this is a `kLeave` event.
+   */
+  [[nodiscard]] bool IsLeave() const noexcept {
+    return kind == WalkEventKind::kLeave;
+  }
+
+  bool operator==(const WalkEvent& other) const = default;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_RGTREE_WALK_EVENT_H_
@@ -1,14 +1,151 @@
 #ifndef SYNTAX_PARSER_SYNTAX_KIND_H_
 #define SYNTAX_PARSER_SYNTAX_KIND_H_
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <string_view>
+
+#include "syntax/util/hash.h"
 
 namespace orion::syntax {
+
+/**
+ * @brief The kinds of tokens and nodes in a syntax tree.
+ *
+ * Unlike `TokenKind`, which is what the lexer sees, a `SyntaxKind` is what
+ * the tree records: several lexer kinds may map to one syntax kind, and nodes
+ * have kinds of their own. The kinds are listed in `grammar.def`.
+ */
 enum class SyntaxKind : uint16_t {
-    kPlus,
-    kMinus,
-    kError
+#define SYNTAX_TOKEN(Name, text, trait) k##Name,
+#define SYNTAX_NODE(Name, category, slots) k##Name,
+#include "syntax/grammar/grammar.def"
+};
+
+/** The number of `SyntaxKind`s, which size tables indexed by them. */
+inline constexpr size_t kSyntaxKindCount = 0
+#define SYNTAX_TOKEN(Name, text, trait) +1
+#define SYNTAX_NODE(Name, category, slots) +1
+#include "syntax/grammar/grammar.def"
+    ;
+
+/**
+ * @brief How a token kind is treated apart from its position in the grammar.
+ */
+enum class TokenTrait : uint8_t {
+  kPlain,
+
+  /** Skipped over by parsers, but kept in the tree. */
+  kTrivia,
+
+  /** A reserved word. */
+  kKeyword,
 };
+
+/**
+ * @brief The group of interchangeable node kinds a node kind belongs to.
+ */
+enum class NodeCategory : uint8_t {
+  kNone,
+
+  /** An expression, which any `ast::Expr` slot accepts. */
+  kExpr,
+};
+
+/**
+ * @brief What the grammar says about one `SyntaxKind`.
+ */
+struct SyntaxKindInfo {
+  /** The kind's name, without the `k`. */
+  std::string_view name;
+
+  /** The text every token of the kind has, or empty if it varies. */
+  std::string_view text;
+
+  /** Whether the kind is a node rather than a token. */
+  bool is_node;
+
+  TokenTrait trait;
+  NodeCategory category;
+};
+
+/** The grammar's description of every `SyntaxKind`, indexed by kind. */
+inline constexpr std::array<SyntaxKindInfo, kSyntaxKindCount>
+    kSyntaxKindInfos = {{
+#define SYNTAX_TOKEN(Name, text, trait) \
+  {#Name, text, false, TokenTrait::trait, NodeCategory::kNone},
+#define SYNTAX_NODE(Name, category, slots) \
+  {#Name, "", true, TokenTrait::kPlain, NodeCategory::category},
+#include "syntax/grammar/grammar.def"
+    }};
+
+/**
+ * @brief A fingerprint of the kinds' names and order.
+ *
+ * Kinds are stored by number, so anything that writes them out records this
+ * and refuses data written with another grammar: inserting a kind renumbers
+ * those after it while keeping every number in range.
+ */
+inline constexpr uint32_t kSyntaxKindHash = [] {
+  // Each name, its terminator, then whether it is a node.
+  uint32_t hash = kFnv1aBasis;
+  for (const SyntaxKindInfo& info : kSyntaxKindInfos) {
+    hash = Fnv1a(Fnv1a(hash, info.name), '\0');
+    hash = Fnv1a(hash, static_cast<unsigned char>(info.is_node ? 1 : 0));
+  }
+  return hash;
+}();
+
+/**
+ * @brief Returns the grammar's description of a kind.
+ */
+[[nodiscard]] constexpr const SyntaxKindInfo& KindInfo(
+    const SyntaxKind kind) noexcept {
+  return kSyntaxKindInfos[static_cast<size_t>(kind)];
+}
+
+/**
+ * @brief Returns the name of a kind, such as `BinaryExpr`.
+ */
+[[nodiscard]] constexpr std::string_view KindName(
+    const SyntaxKind kind) noexcept {
+  return KindInfo(kind).name;
+}
+
+/**
+ * @brief Returns the text of a token kind with fixed text, such as `+`, or
+ * empty.
+ */
+[[nodiscard]] constexpr std::string_view FixedText(
+    const SyntaxKind kind) noexcept {
+  return KindInfo(kind).text;
+}
+
+/**
+ * @brief Checks if a kind is trivia.
+ */
+[[nodiscard]] constexpr bool IsTrivia(const SyntaxKind kind) noexcept {
+  return KindInfo(kind).trait == TokenTrait::kTrivia;
+}
+
+/**
+ * @brief Checks if a kind is a keyword.
+ */
+[[nodiscard]] constexpr bool IsKeyword(const SyntaxKind kind) noexcept {
+  return KindInfo(kind).trait == TokenTrait::kKeyword;
+}
+
+/**
+ * @brief Checks if a kind is a node kind.
+ */
+[[nodiscard]] constexpr bool IsNode(const SyntaxKind kind) noexcept {
+  return KindInfo(kind).is_node;
+}
+
+static_assert(KindName(SyntaxKind::kBinaryExpr) == "BinaryExpr");
+static_assert(FixedText(SyntaxKind::kPlus) == "+");
+
 }  // namespace orion::syntax
 
-#endif  // SYNTAX_PARSER_RGTREE_SYNTAX_KIND_H_
+#endif  // SYNTAX_PARSER_SYNTAX_KIND_H_
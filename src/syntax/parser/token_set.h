@@ -0,0 +1,49 @@
+#ifndef SYNTAX_PARSER_TOKEN_SET_H_
+#define SYNTAX_PARSER_TOKEN_SET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#include "syntax/lexer/token_kind.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief A set of token kinds, stored as a bit mask.
+ *
+ * Parsers use these as recovery sets: on an error, tokens in the set are
+ * left for an enclosing rule to handle rather than skipped over.
+ */
+class TokenSet {
+ public:
+  /**
+   * @brief Constructs a set of the given kinds.
+   */
+  constexpr TokenSet(const std::initializer_list<TokenKind> kinds) noexcept {
+    for (const TokenKind kind : kinds) {
+      bits_ |= Bit(kind);
+    }
+  }
+
+  /**
+   * @brief Checks if a kind is in the set.
+   */
+  [[nodiscard]] constexpr bool Contains(const TokenKind kind) const noexcept {
+    return (bits_ & Bit(kind)) != 0;
+  }
+
+ private:
+  static constexpr uint64_t Bit(const TokenKind kind) noexcept {
+    return uint64_t{1} << static_cast<size_t>(kind);
+  }
+
+  /** One bit per `TokenKind`. */
+  uint64_t bits_ = 0;
+};
+
+static_assert(kTokenKindCount <= 64, "TokenSet holds one bit per TokenKind");
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_PARSER_TOKEN_SET_H_
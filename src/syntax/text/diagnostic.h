@@ -0,0 +1,90 @@
+#ifndef SYNTAX_TEXT_DIAGNOSTIC_H_
+#define SYNTAX_TEXT_DIAGNOSTIC_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "syntax/text/text_range.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief A problem found in the source, such as an unexpected token.
+ *
+ * Messages are string literals, so recording a diagnostic never allocates
+ * beyond the list it is added to.
+ */
+struct Diagnostic {
+  /** The text the problem is about, empty if something is missing there. */
+  TextRange range;
+
+  /** What is wrong, pointing to static storage. */
+  std::string_view message;
+
+  bool operator==(const Diagnostic& other) const = default;
+};
+
+/**
+ * @brief Every message the front end reports.
+ *
+ * Diagnostics written out, such as to the parse cache, record the index of
+ * their message here rather than its text, so reading them back yields the
+ * same static strings. A message missing here cannot be written out.
+ */
+inline constexpr std::array<std::string_view, 11> kDiagnosticMessages = {
+    // Source files.
+    "invalid UTF-8",
+    // The lexer.
+    "unexpected character",
+    "invalid escape sequence",
+    "unclosed string literal",
+    // The parser.
+    "expected an operand",
+    "expected an operator",
+    "expected the end of the expression",
+    "expected '('",
+    "expected ')'",
+    "unmatched ')'",
+    "expression nested too deeply",
+};
+
+/**
+ * @brief Returns the index of a message in `kDiagnosticMessages`, or
+ * `nullopt` if it is not there.
+ */
+[[nodiscard]] constexpr std::optional<uint32_t> DiagnosticMessageIndex(
+    const std::string_view message) noexcept {
+  const auto found = std::ranges::find(kDiagnosticMessages, message);
+  if (found == kDiagnosticMessages.end()) {
+    return std::nullopt;
+  }
+  return static_cast<uint32_t>(found - kDiagnosticMessages.begin());
+}
+
+/**
+ * @brief Merges two lists of diagnostics, each in source order, into one.
+ *
+ * Where both have a diagnostic at the same offset, the one from `first`
+ * comes first.
+ */
+[[nodiscard]] inline std::vector<Diagnostic> MergeDiagnostics(
+    const std::span<const Diagnostic> first,
+    const std::span<const Diagnostic> second) {
+  std::vector<Diagnostic> merged;
+  merged.reserve(first.size() + second.size());
+  std::ranges::merge(first, second, std::back_inserter(merged),
+                     [](const Diagnostic& a, const Diagnostic& b) {
+                       return a.range.Start() < b.range.Start();
+                     });
+  return merged;
+}
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_TEXT_DIAGNOSTIC_H_
@@ -0,0 +1,138 @@
+#ifndef SYNTAX_TEXT_OFFSET_MAP_H_
+#define SYNTAX_TEXT_OFFSET_MAP_H_
+
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief A text edit: the range it replaced and the length of the new text.
+ */
+struct TextEdit {
+  /** The replaced range, in old offsets. */
+  TextRange old_range;
+
+  /** The length of the text that replaced it. */
+  TextSize new_len;
+
+  bool operator==(const TextEdit& other) const = default;
+};
+
+/**
+ * @brief Maps offsets in a text to offsets in an edited copy of it.
+ *
+ * Edits are recorded in order of their old ranges, which may touch but not
+ * overlap. An offset before an edit is unchanged and an offset after it is
+ * shifted by the change in length. An offset inside a replaced range maps to
+ * the same distance into the replacement, clamped to its end, and an offset
+ * at an insertion point moves past the inserted text.
+ *
+ * `Map` is a binary search over the edits.
+ */
+class OffsetMap {
+ public:
+  /**
+   * @brief Constructs a map with no edits.
+   */
+  OffsetMap() = default;
+
+  /**
+   * @brief Records an edit after every edit recorded so far.
+   *
+   * @param old_range The replaced range, in old offsets.
+   * @param new_len The length of the new text.
+   * @throws std::invalid_argument If `old_range` starts before the end of the
+   * previous edit.
+   */
+  void Add(const TextRange old_range, const TextSize new_len) {
+    if (!edits_.empty() && old_range.Start() < edits_.back().old_range.End()) {
+      throw std::invalid_argument("edits must be added in order");
+    }
+
+    Shift shift = shifts_.empty() ? Shift() : shifts_.back();
+    shift.removed += old_range.Len();
+    shift.inserted += new_len;
+
+    edits_.push_back({old_range, new_len});
+    shifts_.push_back(shift);
+  }
+
+  /**
+   * @brief Maps an old offset to the edited text.
+   *
+   * @param offset The offset in the old text.
+   * @return The corresponding offset in the new text.
+   */
+  [[nodiscard]] TextSize Map(const TextSize offset) const {
+    // The last edit starting at or before the offset.
+    const auto after = std::upper_bound(
+        edits_.begin(), edits_.end(), offset,
+        [](const TextSize value, const TextEdit& edit) {
+          return value < edit.old_range.Start();
+        });
+    if (after == edits_.begin()) {
+      return offset;
+    }
+
+    const auto index = static_cast<size_t>(after - edits_.begin()) - 1;
+    const TextEdit& edit = edits_[index];
+    const Shift& shift = shifts_[index];
+    if (offset >= edit.old_range.End()) {
+      return offset + shift.inserted - shift.removed;
+    }
+
+    // Inside the replaced range: keep the distance into the replacement.
+    // Ordered so that no intermediate value is negative.
+    const TextSize start = edit.old_range.End() +
+                           (shift.inserted - edit.new_len) - shift.removed;
+    return start + std::min(offset - edit.old_range.Start(), edit.new_len);
+  }
+
+  /**
+   * @brief Maps an old range to the edited text.
+   *
+   * @param range The range in the old text.
+   * @return The range between the mapped start and end.
+   */
+  [[nodiscard]] TextRange Map(const TextRange range) const {
+    return TextRange(Map(range.Start()), Map(range.End()));
+  }
+
+  /**
+   * @brief Returns the recorded edits, in order.
+   */
+  [[nodiscard]] std::span<const TextEdit> Edits() const noexcept {
+    return edits_;
+  }
+
+  /**
+   * @brief Returns whether no edits were recorded.
+   */
+  [[nodiscard]] bool IsEmpty() const noexcept { return edits_.empty(); }
+
+ private:
+  /**
+   * @brief The total length removed and inserted by an edit and every edit
+   * before it.
+   */
+  struct Shift {
+    TextSize removed;
+    TextSize inserted;
+  };
+
+  /** The edits, in order. */
+  std::vector<TextEdit> edits_;
+
+  /** The running totals after each edit. */
+  std::vector<Shift> shifts_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_TEXT_OFFSET_MAP_H_
@@ -0,0 +1,166 @@
+#ifndef SYNTAX_TEXT_TEXT_RANGE_H_
+#define SYNTAX_TEXT_TEXT_RANGE_H_
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "syntax/text/text_size.h"
+
+namespace orion::syntax {
+
+/**
+ * @brief A half-open range `[start, end)` within a source text.
+ *
+ * Both ends are `TextSize`s, so a range occupies eight bytes.
+ */
+class TextRange {
+ public:
+  /**
+   * @brief Constructs a range with the given start and end positions.
+   *
+   * @param start The starting position of the range (inclusive).
+   * @param end The ending position of the range (exclusive).
+   * @throws std::invalid_argument If `start` is after `end`.
+   */
+  constexpr explicit TextRange(const TextSize start, const TextSize end)
+      : start_(start), end_(end) {
+    if (start > end) {
+      throw std::invalid_argument("text range start is after its end");
+    }
+  }
+
+  /**
+   * @brief Deleted default constructor.
+   *
+   * `TextRange` objects must be explicitly constructed with a start and end
+   * value.
+   */
+  TextRange() = delete;
+
+  /**
+   * @brief Constructs a range from its start and length.
+   *
+   * @param start The starting position of the range.
+   * @param length The length of the range.
+   * @return The range `[start, start + length)`.
+   */
+  [[nodiscard]] static constexpr TextRange At(const TextSize start,
+                                              const TextSize length) {
+    return TextRange(start, start + length);
+  }
+
+  /**
+   * @brief Constructs an empty range at an offset.
+   *
+   * @param offset The position of the range.
+   * @return The range `[offset, offset)`.
+   */
+  [[nodiscard]] static constexpr TextRange Empty(const TextSize offset) {
+    return TextRange(offset, offset);
+  }
+
+  /**
+   * @brief Returns the starting position of the range.
+   *
+   * @return The start position (inclusive).
+   */
+  [[nodiscard]] constexpr TextSize Start() const noexcept { return start_; }
+
+  /**
+   * @brief Returns the ending position of the range.
+   *
+   * @return The end position (exclusive).
+   */
+  [[nodiscard]] constexpr TextSize End() const noexcept { return end_; }
+
+  /**
+   * @brief Returns the length of the range.
+   *
+   * @return `End() - Start()`.
+   */
+  [[nodiscard]] constexpr TextSize Len() const noexcept {
+    return TextSize(end_.Raw() - start_.Raw());
+  }
+
+  /**
+   * @brief Checks if the range is empty.
+   *
+   * @return `true` if the range has zero length, otherwise `false`.
+   */
+  [[nodiscard]] constexpr bool IsEmpty() const noexcept {
+    return start_ == end_;
+  }
+
+  /**
+   * @brief Checks if an offset lies within the range, excluding its end.
+   *
+   * @param offset The offset to check.
+   * @return `true` if `Start() <= offset < End()`.
+   */
+  [[nodiscard]] constexpr bool Contains(const TextSize offset) const noexcept {
+    return start_ <= offset && offset < end_;
+  }
+
+  /**
+   * @brief Checks if an offset lies within the range, including its end.
+   *
+   * @param offset The offset to check.
+   * @return `true` if `Start() <= offset <= End()`.
+   */
+  [[nodiscard]] constexpr bool ContainsInclusive(
+      const TextSize offset) const noexcept {
+    return start_ <= offset && offset <= end_;
+  }
+
+  /**
+   * @brief Checks if another range lies entirely within this one.
+   *
+   * @param other The range to check.
+   * @return `true` if `other` is a subrange of this range.
+   */
+  [[nodiscard]] constexpr bool ContainsRange(
+      const TextRange& other) const noexcept {
+    return start_ <= other.start_ && other.end_ <= end_;
+  }
+
+  /**
+   * @brief Returns the smallest range covering both ranges.
+   *
+   * @param other The other range.
+   * @return The covering range.
+   */
+  [[nodiscard]] constexpr TextRange Cover(const TextRange& other) const {
+    return TextRange(std::min(start_, other.start_),
+                     std::max(end_, other.end_));
+  }
+
+  /**
+   * @brief Returns the range moved forward by an offset.
+   *
+   * @param offset The distance to move.
+   * @return The shifted range.
+   */
+  [[nodiscard]] constexpr TextRange Shift(const TextSize offset) const {
+    return TextRange(start_ + offset, end_ + offset);
+  }
+
+  /**
+   * @brief Compares two `TextRange` objects for equality.
+   *
+   * @param other The other `TextRange` to compare with.
+   * @return `true` if both ranges have the same start and end values,
+   * otherwise `false`.
+   */
+  constexpr bool operator==(const TextRange& other) const noexcept = default;
+
+ private:
+  /** The starting position of the range (inclusive). */
+  TextSize start_;
+
+  /** The ending position of the range (exclusive). */
+  TextSize end_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_TEXT_TEXT_RANGE_H_
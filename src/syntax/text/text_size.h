@@ -0,0 +1,100 @@
+#ifndef SYNTAX_TEXT_TEXT_SIZE_H_
+#define SYNTAX_TEXT_TEXT_SIZE_H_
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace orion::syntax {
+
+/**
+ * @brief A 32-bit offset or length within a source text.
+ *
+ * Offsets count the code points seen by the lexer. Source files are limited to
+ * 4 GiB, so 32 bits suffice and halve the size of every span, width and
+ * offset stored in tokens and trees. All arithmetic is checked: overflowing or
+ * underflowing throws `std::overflow_error` instead of wrapping.
+ */
+class TextSize {
+ public:
+  /**
+   * @brief Constructs a zero size.
+   */
+  constexpr TextSize() noexcept : raw_(0) {}
+
+  /**
+   * @brief Constructs a size from a 32-bit value.
+   *
+   * Explicit so that wider integers cannot narrow into a size silently; those
+   * go through `Of`.
+   *
+   * @param raw The size.
+   */
+  constexpr explicit TextSize(const uint32_t raw) noexcept : raw_(raw) {}
+
+  /**
+   * @brief Constructs a size from a `size_t`, checking that it fits.
+   *
+   * @param value The size.
+   * @return The size as a `TextSize`.
+   * @throws std::overflow_error If `value` does not fit in 32 bits.
+   */
+  [[nodiscard]] static constexpr TextSize Of(const size_t value) {
+    if (value > std::numeric_limits<uint32_t>::max()) {
+      throw std::overflow_error("text size does not fit in 32 bits");
+    }
+
+    return TextSize(static_cast<uint32_t>(value));
+  }
+
+  /**
+   * @brief Returns the size as a 32-bit value.
+   *
+   * @return The raw size.
+   */
+  [[nodiscard]] constexpr uint32_t Raw() const noexcept { return raw_; }
+
+  /**
+   * @brief Converts the size to a `size_t`, for indexing.
+   */
+  constexpr explicit operator size_t() const noexcept { return raw_; }
+
+  constexpr TextSize& operator+=(const TextSize other) {
+    if (raw_ > std::numeric_limits<uint32_t>::max() - other.raw_) {
+      throw std::overflow_error("text size addition overflowed");
+    }
+
+    raw_ += other.raw_;
+    return *this;
+  }
+
+  constexpr TextSize& operator-=(const TextSize other) {
+    if (other.raw_ > raw_) {
+      throw std::overflow_error("text size subtraction underflowed");
+    }
+
+    raw_ -= other.raw_;
+    return *this;
+  }
+
+  friend constexpr TextSize operator+(TextSize lhs, const TextSize rhs) {
+    return lhs += rhs;
+  }
+
+  friend constexpr TextSize operator-(TextSize lhs, const TextSize rhs) {
+    return lhs -= rhs;
+  }
+
+  constexpr bool operator==(const TextSize& other) const noexcept = default;
+  constexpr auto operator<=>(const TextSize& other) const noexcept = default;
+
+ private:
+  /** The size. */
+  uint32_t raw_;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_TEXT_TEXT_SIZE_H_
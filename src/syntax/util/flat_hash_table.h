@@ -0,0 +1,274 @@
+#ifndef SYNTAX_UTIL_FLAT_HASH_TABLE_H_
+#define SYNTAX_UTIL_FLAT_HASH_TABLE_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// https://abseil.io/about/design/swisstables
+namespace orion::syntax {
+
+/**
+ * @brief Insert-only open-addressing hash table with SwissTable-style control
+ * bytes.
+ *
+ * Slots are stored in one flat array next to a parallel array of one-byte
+ * control words. A control word is either `kEmpty` or the low seven bits of
+ * the slot's hash, so a probe compares sixteen candidates at once and only
+ * touches a slot when those seven bits match. The full 64-bit hash is stored
+ * with every slot and compared before the caller's equality predicate.
+ *
+ * The table never hashes or compares keys itself: callers pass a precomputed
+ * hash and a predicate, which allows lookups by a key type different from the
+ * stored value (for example `(kind, text)` against a stored token).
+ *
+ * @tparam T The stored value. Must be default constructible and movable.
+ *
+ * @note Pointers returned by `Find` and `FindOrInsert` are invalidated by any
+ * subsequent insertion.
+ */
+template <typename T>
+class FlatHashTable {
+ public:
+  /**
+   * @brief Constructs an empty table. No memory is allocated until the first
+   * insertion.
+   */
+  FlatHashTable() = default;
+
+  /**
+   * @brief Looks up a value.
+   *
+   * @param hash The hash of the key.
+   * @param eq Predicate returning `true` when a stored value matches the key.
+   * @return A pointer to the matching value, or `nullptr`.
+   */
+  template <typename Eq>
+  [[nodiscard]] const T* Find(const uint64_t hash, Eq&& eq) const {
+    if (slots_.empty()) {
+      return nullptr;
+    }
+
+    const auto [index, found] = Probe(hash, eq);
+    return found ? &slots_[index].value : nullptr;
+  }
+
+  /**
+   * @brief Looks up a value and inserts a new one when it is missing.
+   *
+   * @param hash The hash of the key.
+   * @param eq Predicate returning `true` when a stored value matches the key.
+   * @param make Factory invoked only on a miss to produce the value to store.
+   * If it throws, nothing is inserted.
+   * @return A pointer to the stored value, and `true` if it was inserted.
+   */
+  template <typename Eq, typename Make>
+  std::pair<const T*, bool> FindOrInsert(const uint64_t hash, Eq&& eq,
+                                         Make&& make) {
+    auto [index, found] =
+        slots_.empty() ? std::pair<size_t, bool>(0, false) : Probe(hash, eq);
+    if (found) {
+      return {&slots_[index].value, false};
+    }
+
+    // Only a miss grows the table, so hits never pay for a rehash. Growing
+    // moves every slot, so the free slot is looked up again, without calling
+    // `eq` on values already known not to match.
+    if (size_ + 1 > growth_limit_) {
+      Grow();
+      index = FindEmpty(hash);
+    }
+
+    // Runs the factory before claiming the slot, so a throwing factory leaves
+    // the table unchanged.
+    slots_[index].value = make();
+    slots_[index].hash = hash;
+    ctrl_[index] = H2(hash);
+    ++size_;
+
+    return {&slots_[index].value, true};
+  }
+
+  /**
+   * @brief Invokes `fn` for every stored value, in unspecified order.
+   */
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      if (ctrl_[i] != kEmpty) {
+        fn(slots_[i].value);
+      }
+    }
+  }
+
+  /**
+   * @brief Removes every value and releases the table's memory.
+   */
+  void Clear() noexcept {
+    ctrl_.clear();
+    slots_.clear();
+    ctrl_.shrink_to_fit();
+    slots_.shrink_to_fit();
+    size_ = 0;
+    growth_limit_ = 0;
+  }
+
+  /**
+   * @brief Returns the number of stored values.
+   */
+  [[nodiscard]] size_t Size() const noexcept { return size_; }
+
+  /**
+   * @brief Returns the number of slots currently allocated.
+   */
+  [[nodiscard]] size_t Capacity() const noexcept { return slots_.size(); }
+
+ private:
+  /** Number of control bytes examined per probe step. */
+  static constexpr size_t kGroupWidth = 16;
+
+  /** Control byte marking an empty slot; full slots have the high bit clear. */
+  static constexpr uint8_t kEmpty = 0x80;
+
+  /**
+   * @brief A slot holding a value together with its full hash.
+   */
+  struct Slot {
+    /** The full hash of the stored value. */
+    uint64_t hash = 0;
+
+    /** The stored value. */
+    T value{};
+  };
+
+  /** Returns the seven hash bits stored in the control byte. */
+  [[nodiscard]] static uint8_t H2(const uint64_t hash) noexcept {
+    return static_cast<uint8_t>(hash & 0x7f);
+  }
+
+  /** Returns the bits used to select the first probed group. */
+  [[nodiscard]] static size_t H1(const uint64_t hash) noexcept {
+    return static_cast<size_t>(hash >> 7);
+  }
+
+  /**
+   * @brief Returns a bitmask of the bytes in a group equal to `byte`.
+   */
+  [[nodiscard]] static uint32_t MatchGroup(const uint8_t* group,
+                                           const uint8_t byte) noexcept {
+#if defined(__SSE2__)
+    const __m128i ctrl =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(byte));
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, needle)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; ++i) {
+      mask |= static_cast<uint32_t>(group[i] == byte) << i;
+    }
+    return mask;
+#endif
+  }
+
+  /**
+   * @brief Walks the probe sequence for `hash`.
+   *
+   * @return The index of the matching slot and `true`, or the index of the
+   * first empty slot on the sequence and `false`.
+   */
+  template <typename Eq>
+  [[nodiscard]] std::pair<size_t, bool> Probe(const uint64_t hash,
+                                              Eq& eq) const {
+    const size_t group_mask = slots_.size() / kGroupWidth - 1;
+    const uint8_t h2 = H2(hash);
+
+    size_t group = H1(hash) & group_mask;
+    for (size_t step = 1;; ++step) {
+      const size_t base = group * kGroupWidth;
+      const uint8_t* ctrl = ctrl_.data() + base;
+
+      for (uint32_t candidates = MatchGroup(ctrl, h2); candidates != 0;
+           candidates &= candidates - 1) {
+        const size_t index = base + std::countr_zero(candidates);
+        if (slots_[index].hash == hash && eq(slots_[index].value)) {
+          return {index, true};
+        }
+      }
+
+      // Values are never erased, so the first group with an empty slot ends
+      // the probe sequence.
+      if (const uint32_t empty = MatchGroup(ctrl, kEmpty); empty != 0) {
+        return {base + std::countr_zero(empty), false};
+      }
+
+      // Triangular probing visits every group when the count is a power of
+      // two.
+      group = (group + step) & group_mask;
+    }
+  }
+
+  /**
+   * @brief Returns the first empty slot on the probe sequence for `hash`,
+   * looking only at control bytes.
+   */
+  [[nodiscard]] size_t FindEmpty(const uint64_t hash) const noexcept {
+    const size_t group_mask = slots_.size() / kGroupWidth - 1;
+
+    size_t group = H1(hash) & group_mask;
+    for (size_t step = 1;; ++step) {
+      const size_t base = group * kGroupWidth;
+      if (const uint32_t empty = MatchGroup(ctrl_.data() + base, kEmpty);
+          empty != 0) {
+        return base + std::countr_zero(empty);
+      }
+      group = (group + step) & group_mask;
+    }
+  }
+
+  /**
+   * @brief Doubles the capacity and reinserts every value.
+   */
+  void Grow() {
+    const size_t capacity =
+        slots_.empty() ? kGroupWidth : slots_.size() * 2;
+
+    std::vector<uint8_t> old_ctrl(capacity, kEmpty);
+    std::vector<Slot> old_slots(capacity);
+    std::swap(old_ctrl, ctrl_);
+    std::swap(old_slots, slots_);
+    growth_limit_ = capacity - capacity / 8;
+
+    for (size_t i = 0; i < old_slots.size(); ++i) {
+      if (old_ctrl[i] == kEmpty) {
+        continue;
+      }
+
+      const size_t index = FindEmpty(old_slots[i].hash);
+      ctrl_[index] = old_ctrl[i];
+      slots_[index] = std::move(old_slots[i]);
+    }
+  }
+
+  /** Control bytes, one per slot. */
+  std::vector<uint8_t> ctrl_;
+
+  /** Slot storage, parallel to `ctrl_`. */
+  std::vector<Slot> slots_;
+
+  /** Number of full slots. */
+  size_t size_ = 0;
+
+  /** Number of values that may be stored before the table grows. */
+  size_t growth_limit_ = 0;
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_UTIL_FLAT_HASH_TABLE_H_
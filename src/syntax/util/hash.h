@@ -0,0 +1,115 @@
+#ifndef SYNTAX_UTIL_HASH_H_
+#define SYNTAX_UTIL_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace orion::syntax {
+
+/** Seed used when no explicit seed is provided. */
+constexpr uint64_t kDefaultHashSeed = 0x9e3779b97f4a7c15ULL;
+
+/**
+ * @brief Finalizes a 64-bit value so that every input bit affects every output
+ * bit.
+ *
+ * This is the `splitmix64` finalizer, which has full avalanche and is cheap
+ * enough to use on every probe.
+ *
+ * @param value The value to mix.
+ * @return The mixed value.
+ */
+[[nodiscard]] constexpr uint64_t Mix64(uint64_t value) noexcept {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+/**
+ * @brief Combines a value into an existing hash.
+ *
+ * Unlike XOR, the combination is order-sensitive: `Combine(Combine(s, a), b)`
+ * and `Combine(Combine(s, b), a)` differ for `a != b`.
+ *
+ * @param seed The hash accumulated so far.
+ * @param value The value to fold into the hash.
+ * @return The combined hash.
+ */
+[[nodiscard]] constexpr uint64_t HashCombine(const uint64_t seed,
+                                             const uint64_t value) noexcept {
+  return Mix64(seed + 0x9e3779b97f4a7c15ULL + Mix64(value) + (seed << 6) +
+               (seed >> 2));
+}
+
+/**
+ * @brief Hashes an arbitrary byte range.
+ *
+ * Consumes eight bytes at a time and finishes with a full avalanche, so it is
+ * suitable both for hash tables and as a content fingerprint.
+ *
+ * @param data Pointer to the first byte.
+ * @param length Number of bytes to hash.
+ * @param seed Optional seed.
+ * @return The 64-bit hash of the bytes.
+ */
+[[nodiscard]] inline uint64_t HashBytes(
+    const void* data, const size_t length,
+    const uint64_t seed = kDefaultHashSeed) noexcept {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  uint64_t hash =
+      seed ^ (static_cast<uint64_t>(length) * 0xff51afd7ed558ccdULL);
+
+  size_t remaining = length;
+  while (remaining >= sizeof(uint64_t)) {
+    uint64_t block;
+    std::memcpy(&block, bytes, sizeof(block));
+    hash = (hash ^ Mix64(block)) * 0x9fb21c651e98df25ULL;
+    hash = (hash << 29) | (hash >> 35);
+    bytes += sizeof(uint64_t);
+    remaining -= sizeof(uint64_t);
+  }
+
+  uint64_t tail = 0;
+  std::memcpy(&tail, bytes, remaining);
+  hash ^= Mix64(tail ^ remaining);
+
+  return Mix64(hash);
+}
+
+/** Offset basis of 32-bit FNV-1a: the hash of no bytes. */
+inline constexpr uint32_t kFnv1aBasis = 2166136261u;
+
+/**
+ * @brief Folds one byte into a 32-bit FNV-1a hash.
+ *
+ * Far weaker than `HashBytes`, but usable in constant expressions, so it is
+ * what fingerprints compile-time tables such as the kind names.
+ *
+ * @param hash The hash accumulated so far, starting from `kFnv1aBasis`.
+ * @param byte The byte to fold in.
+ * @return The updated hash.
+ */
+[[nodiscard]] constexpr uint32_t Fnv1a(const uint32_t hash,
+                                       const unsigned char byte) noexcept {
+  return (hash ^ byte) * 16777619u;
+}
+
+/**
+ * @brief Folds every byte of `text` into a 32-bit FNV-1a hash, in order.
+ */
+[[nodiscard]] constexpr uint32_t Fnv1a(uint32_t hash,
+                                       const std::string_view text) noexcept {
+  for (const char c : text) {
+    hash = Fnv1a(hash, static_cast<unsigned char>(c));
+  }
+  return hash;
+}
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_UTIL_HASH_H_
@@ -0,0 +1,205 @@
+#ifndef SYNTAX_UTIL_SMALL_VECTOR_H_
+#define SYNTAX_UTIL_SMALL_VECTOR_H_
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace orion::syntax {
+
+/**
+ * @brief A vector of trivially copyable values that stores its first `N`
+ * elements inline.
+ *
+ * Stacks that are usually shallow, such as the open nodes of a builder, never
+ * touch the heap as long as they stay within `N` elements. Once spilled, the
+ * heap buffer is kept by `Clear()`, so a vector reused across many short jobs
+ * stops allocating after the first deep one.
+ *
+ * Elements are relocated with `memcpy`, which is why they must be trivially
+ * copyable.
+ *
+ * @tparam T The element type.
+ * @tparam N The number of elements stored inline.
+ */
+template <typename T, size_t N>
+class SmallVector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SmallVector relocates elements with memcpy");
+  static_assert(N > 0, "SmallVector needs inline storage");
+
+ public:
+  /**
+   * @brief Constructs an empty vector using the inline storage.
+   */
+  SmallVector() noexcept : data_(InlineData()) {}
+
+  /**
+   * @brief Releases the heap buffer, if any.
+   */
+  ~SmallVector() { Deallocate(); }
+
+  /** Copy constructor and copy assignment. */
+  SmallVector(const SmallVector& other) : SmallVector() { *this = other; }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      Clear();
+      Reserve(other.size_);
+      std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+      size_ = other.size_;
+    }
+    return *this;
+  }
+
+  /** Move constructor and move assignment, stealing a spilled buffer. */
+  SmallVector(SmallVector&& other) noexcept : SmallVector() {
+    *this = std::move(other);
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+
+    Deallocate();
+    if (other.IsInline()) {
+      data_ = InlineData();
+      capacity_ = N;
+      std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+    } else {
+      data_ = std::exchange(other.data_, other.InlineData());
+      capacity_ = std::exchange(other.capacity_, N);
+    }
+    size_ = std::exchange(other.size_, 0);
+
+    return *this;
+  }
+
+  /**
+   * @brief Appends an element.
+   *
+   * @param value The element to append.
+   */
+  void PushBack(const T& value) {
+    if (size_ == capacity_) {
+      // `value` may live in the buffer that is about to be released.
+      const T copy = value;
+      Reserve(capacity_ * 2);
+      data_[size_++] = copy;
+      return;
+    }
+    data_[size_++] = value;
+  }
+
+  /**
+   * @brief Constructs an element at the end.
+   *
+   * @param args The arguments forwarded to `T`'s aggregate initialization.
+   * @return A reference to the new element.
+   */
+  template <typename... Args>
+  T& EmplaceBack(Args&&... args) {
+    PushBack(T{std::forward<Args>(args)...});
+    return Back();
+  }
+
+  /**
+   * @brief Removes the last element. The vector must not be empty.
+   */
+  void PopBack() noexcept { --size_; }
+
+  /**
+   * @brief Returns the last element. The vector must not be empty.
+   */
+  [[nodiscard]] T& Back() noexcept { return data_[size_ - 1]; }
+  [[nodiscard]] const T& Back() const noexcept { return data_[size_ - 1]; }
+
+  [[nodiscard]] T& operator[](const size_t index) noexcept {
+    return data_[index];
+  }
+  [[nodiscard]] const T& operator[](const size_t index) const noexcept {
+    return data_[index];
+  }
+
+  [[nodiscard]] T* begin() noexcept { return data_; }
+  [[nodiscard]] T* end() noexcept { return data_ + size_; }
+  [[nodiscard]] const T* begin() const noexcept { return data_; }
+  [[nodiscard]] const T* end() const noexcept { return data_ + size_; }
+
+  /**
+   * @brief Ensures space for at least `capacity` elements.
+   *
+   * @param capacity The number of elements to make room for.
+   */
+  void Reserve(const size_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+
+    T* data = std::allocator<T>().allocate(capacity);
+    std::memcpy(data, data_, size_ * sizeof(T));
+    Deallocate();
+    data_ = data;
+    capacity_ = capacity;
+  }
+
+  /**
+   * @brief Removes every element, keeping the current buffer.
+   */
+  void Clear() noexcept { size_ = 0; }
+
+  /**
+   * @brief Returns the number of elements.
+   */
+  [[nodiscard]] size_t Size() const noexcept { return size_; }
+
+  /**
+   * @brief Checks if the vector has no elements.
+   */
+  [[nodiscard]] bool Empty() const noexcept { return size_ == 0; }
+
+  /**
+   * @brief Returns the number of elements that fit without reallocating.
+   */
+  [[nodiscard]] size_t Capacity() const noexcept { return capacity_; }
+
+  /**
+   * @brief Checks if the elements are still stored inline.
+   */
+  [[nodiscard]] bool IsInline() const noexcept {
+    return data_ == InlineData();
+  }
+
+ private:
+  [[nodiscard]] T* InlineData() noexcept {
+    return reinterpret_cast<T*>(inline_);
+  }
+  [[nodiscard]] const T* InlineData() const noexcept {
+    return reinterpret_cast<const T*>(inline_);
+  }
+
+  void Deallocate() noexcept {
+    if (!IsInline()) {
+      std::allocator<T>().deallocate(data_, capacity_);
+    }
+  }
+
+  /** The current buffer, either `inline_` or a heap allocation. */
+  T* data_;
+
+  /** Number of elements. */
+  size_t size_ = 0;
+
+  /** Number of elements the current buffer can hold. */
+  size_t capacity_ = N;
+
+  /** Inline storage for the first `N` elements. */
+  alignas(T) std::byte inline_[N * sizeof(T)];
+};
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_UTIL_SMALL_VECTOR_H_
@@ -0,0 +1,84 @@
+#include "syntax/util/thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace orion::syntax {
+ThreadPool::ThreadPool(const size_t threads) {
+  const size_t count = std::max<size_t>(threads, 1);
+  threads_.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    threads_.emplace_back(&ThreadPool::Run, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  work_available_.notify_all();
+
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+size_t ThreadPool::DefaultThreadCount() noexcept {
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::Submit(Task task) {
+  {
+    const std::lock_guard lock(mutex_);
+    tasks_.push_back(std::move(task));
+    ++pending_;
+  }
+  work_available_.notify_one();
+}
+
+void ThreadPool::Wait() {
+  std::unique_lock lock(mutex_);
+  idle_.wait(lock, [this] { return pending_ == 0; });
+
+  if (error_ != nullptr) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+}
+
+void ThreadPool::Run() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock lock(mutex_);
+      work_available_.wait(lock,
+                           [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    std::exception_ptr error;
+    try {
+      task();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    task = nullptr;
+
+    const std::lock_guard lock(mutex_);
+    if (error != nullptr && error_ == nullptr) {
+      error_ = std::move(error);
+    }
+    if (--pending_ == 0) {
+      idle_.notify_all();
+    }
+  }
+}
+}  // namespace orion::syntax
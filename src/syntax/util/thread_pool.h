@@ -0,0 +1,142 @@
+#ifndef SYNTAX_UTIL_THREAD_POOL_H_
+#define SYNTAX_UTIL_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace orion::syntax {
+
+/**
+ * @brief A fixed set of worker threads sharing one FIFO task queue.
+ *
+ * Tasks run in submission order, so submitting the most expensive tasks
+ * first keeps them from landing at the end and stretching the tail. Work is
+ * usually handed out through `ParallelFor`, whose tasks balance themselves by
+ * pulling indices from a shared counter; the queue only ever holds one task
+ * per worker then, so a single lock is plenty.
+ *
+ * @code
+ * ThreadPool pool;
+ * for (const Job& job : jobs) {
+ *   pool.Submit([&job] { Run(job); });
+ * }
+ * pool.Wait();
+ * @endcode
+ */
+class ThreadPool {
+ public:
+  /** A unit of work. */
+  using Task = std::function<void()>;
+
+  /**
+   * @brief Starts the worker threads.
+   *
+   * @param threads The number of workers, at least one.
+   */
+  explicit ThreadPool(size_t threads = DefaultThreadCount());
+
+  /**
+   * @brief Finishes every submitted task, then stops the workers.
+   */
+  ~ThreadPool();
+
+  /** Deleted copy and move constructors and assignment operators. */
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /**
+   * @brief Returns the number of hardware threads, or one if unknown.
+   */
+  [[nodiscard]] static size_t DefaultThreadCount() noexcept;
+
+  /**
+   * @brief Returns the number of workers.
+   */
+  [[nodiscard]] size_t Size() const noexcept { return threads_.size(); }
+
+  /**
+   * @brief Queues a task. May be called from inside a task.
+   *
+   * @param task The task to run.
+   */
+  void Submit(Task task);
+
+  /**
+   * @brief Blocks until every task submitted so far, including tasks they
+   * submitted, has finished. Must not be called from inside a task.
+   *
+   * @throws Whatever the first failing task threw, if any task failed since
+   * the last `Wait`.
+   */
+  void Wait();
+
+ private:
+  /**
+   * @brief The worker loop.
+   */
+  void Run();
+
+  /** The worker threads. */
+  std::vector<std::thread> threads_;
+
+  /** Guards every field below. */
+  std::mutex mutex_;
+
+  /** The queued tasks, oldest first. */
+  std::deque<Task> tasks_;
+
+  /** Signalled when a task is queued or the pool stops. */
+  std::condition_variable work_available_;
+
+  /** Signalled when the last pending task finishes. */
+  std::condition_variable idle_;
+
+  /** The number of tasks submitted but not yet finished. */
+  size_t pending_ = 0;
+
+  /** The first exception thrown by a task since the last `Wait`. */
+  std::exception_ptr error_;
+
+  /** Whether the destructor has asked the workers to stop. */
+  bool stopping_ = false;
+};
+
+/**
+ * @brief Calls `body(slot, index)` for every index below `count` on the pool,
+ * then waits for all of them.
+ *
+ * At most `pool.Size()` tasks pull indices from a shared counter, rather than
+ * one task per index, so a task that draws a slow index simply takes fewer of
+ * the rest. `slot` is below `pool.Size()` and no two calls running at the
+ * same time share one; callers index per-thread state, such as a
+ * `GreenBuilder`, with it. Indices are handed out in increasing order.
+ *
+ * @throws Whatever the first failing call threw, as `Wait` does.
+ */
+template <typename Body>
+void ParallelFor(ThreadPool& pool, const size_t count, const Body& body) {
+  std::atomic<size_t> next = 0;
+  const size_t tasks = std::min(pool.Size(), count);
+  for (size_t slot = 0; slot < tasks; ++slot) {
+    pool.Submit([&body, &next, count, slot] {
+      for (size_t index = next++; index < count; index = next++) {
+        body(slot, index);
+      }
+    });
+  }
+  pool.Wait();
+}
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_UTIL_THREAD_POOL_H_
@@ -0,0 +1,236 @@
+#include "syntax/util/utf8.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace orion::syntax {
+namespace {
+constexpr char32_t kMaxCodepoint = 0x10FFFF;
+constexpr char32_t kSurrogateFirst = 0xD800;
+constexpr char32_t kSurrogateLast = 0xDFFF;
+
+bool IsContinuation(const unsigned char byte) noexcept {
+  return (byte & 0xC0) == 0x80;
+}
+
+// Returns the length of the run of ASCII bytes at the start of `source`.
+size_t AsciiPrefix(const std::string_view source) noexcept {
+  const char* data = source.data();
+  const size_t size = source.size();
+  size_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+  // A byte is ASCII when its high bit is clear, which `movemask` gathers
+  // for sixteen bytes at once.
+  for (; i + 16 <= size; i += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    if (_mm_movemask_epi8(block) != 0) {
+      break;
+    }
+  }
+#endif
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    if ((word & 0x8080808080808080ULL) != 0) {
+      break;
+    }
+  }
+  while (i < size && static_cast<unsigned char>(data[i]) < 0x80) {
+    ++i;
+  }
+  return i;
+}
+
+// Measures the multi-byte sequence starting at `i` against the table of
+// RFC 3629, section 4. Returns the length the lead byte announces, or zero if
+// no well-formed sequence starts with it, and stores in `valid` how many
+// bytes from `i` form a prefix of a well-formed sequence.
+size_t MeasureSequence(const std::string_view source, const size_t i,
+                       size_t& valid) noexcept {
+  const auto byte = [&source, i](const size_t n) {
+    return static_cast<unsigned char>(source[i + n]);
+  };
+  const auto in = [](const unsigned char value, const unsigned char low,
+                     const unsigned char high) {
+    return value >= low && value <= high;
+  };
+
+  const unsigned char lead = byte(0);
+  size_t length;
+  unsigned char low = 0x80;
+  unsigned char high = 0xBF;
+  if (in(lead, 0xC2, 0xDF)) {
+    length = 2;
+  } else if (in(lead, 0xE0, 0xEF)) {
+    length = 3;
+    low = lead == 0xE0 ? 0xA0 : 0x80;
+    high = lead == 0xED ? 0x9F : 0xBF;
+  } else if (in(lead, 0xF0, 0xF4)) {
+    length = 4;
+    low = lead == 0xF0 ? 0x90 : 0x80;
+    high = lead == 0xF4 ? 0x8F : 0xBF;
+  } else {
+    valid = 0;
+    return 0;
+  }
+
+  valid = 1;
+  if (i + 1 < source.size() && in(byte(1), low, high)) {
+    valid = 2;
+    while (valid < length && i + valid < source.size() &&
+           IsContinuation(byte(valid))) {
+      ++valid;
+    }
+  }
+  return length;
+}
+
+// Returns the length of the well-formed multi-byte sequence starting at `i`,
+// or zero if it is malformed.
+size_t SequenceLength(const std::string_view source, const size_t i) noexcept {
+  size_t valid;
+  const size_t length = MeasureSequence(source, i, valid);
+  return valid == length ? length : 0;
+}
+
+// Decodes the sequence starting at `i`, storing its length in `consumed`.
+// Accepts exactly what `SequenceLength` does; anything else decodes to one
+// U+FFFD per maximal ill-formed subpart, so overlong forms, surrogates and
+// values past U+10FFFF never decode to a code point.
+char32_t DecodeAt(const std::string_view source, const size_t i,
+                  size_t& consumed) noexcept {
+  const auto lead = static_cast<unsigned char>(source[i]);
+  if (lead < 0x80) {
+    consumed = 1;
+    return lead;
+  }
+
+  size_t valid;
+  const size_t length = MeasureSequence(source, i, valid);
+  if (length == 0 || valid != length) {
+    consumed = valid == 0 ? 1 : valid;
+    return kReplacementCharacter;
+  }
+
+  char32_t ch = lead & (0x7F >> length);
+  for (size_t n = 1; n < length; ++n) {
+    ch = (ch << 6) | (source[i + n] & 0x3F);
+  }
+  consumed = length;
+  return ch;
+}
+}  // namespace
+
+void AppendUtf8(std::string& out, char32_t ch) {
+  if (ch > kMaxCodepoint || (ch >= kSurrogateFirst && ch <= kSurrogateLast)) {
+    ch = kReplacementCharacter;
+  }
+
+  if (ch < 0x80) {
+    out.push_back(static_cast<char>(ch));
+  } else if (ch < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (ch >> 6)));
+    out.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+  } else if (ch < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (ch >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (ch >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((ch >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+  }
+}
+
+std::string EncodeUtf8(const std::u32string_view source) {
+  std::string out;
+  out.reserve(source.size());
+
+  for (const char32_t ch : source) {
+    AppendUtf8(out, ch);
+  }
+
+  return out;
+}
+
+std::u32string DecodeUtf8(const std::string_view source) {
+  std::u32string out;
+  out.reserve(source.size());
+
+  size_t i = 0;
+  while (i < source.size()) {
+    // ASCII widens without decoding.
+    const size_t ascii = AsciiPrefix(source.substr(i));
+    const auto* bytes = reinterpret_cast<const unsigned char*>(source.data());
+    out.append(bytes + i, bytes + i + ascii);
+    i += ascii;
+    if (i == source.size()) {
+      break;
+    }
+
+    size_t consumed;
+    out.push_back(DecodeAt(source, i, consumed));
+    i += consumed;
+  }
+
+  return out;
+}
+
+size_t ValidateUtf8(const std::string_view source) noexcept {
+  size_t i = 0;
+  while (i < source.size()) {
+    i += AsciiPrefix(source.substr(i));
+    if (i == source.size()) {
+      break;
+    }
+
+    const size_t length = SequenceLength(source, i);
+    if (length == 0) {
+      return i;
+    }
+    i += length;
+  }
+  return source.size();
+}
+
+char32_t DecodeUtf8At(const std::string_view source,
+                      const size_t offset) noexcept {
+  size_t consumed;
+  return DecodeAt(source, offset, consumed);
+}
+
+size_t CountCodepoints(const std::string_view source) noexcept {
+  size_t count = 0;
+
+  for (const char ch : source) {
+    count += !IsContinuation(static_cast<unsigned char>(ch));
+  }
+
+  return count;
+}
+
+size_t Utf8Offset(const std::string_view source,
+                  const size_t codepoints) noexcept {
+  size_t seen = 0;
+  for (size_t i = 0; i < source.size(); ++i) {
+    if (!IsContinuation(static_cast<unsigned char>(source[i]))) {
+      if (seen == codepoints) {
+        return i;
+      }
+      ++seen;
+    }
+  }
+
+  return source.size();
+}
+}  // namespace orion::syntax
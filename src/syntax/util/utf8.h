@@ -0,0 +1,88 @@
+#ifndef SYNTAX_UTIL_UTF8_H_
+#define SYNTAX_UTIL_UTF8_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace orion::syntax {
+
+/** Code point substituted for malformed or out-of-range input. */
+constexpr char32_t kReplacementCharacter = U'\uFFFD';
+
+/**
+ * @brief Appends the UTF-8 encoding of a code point to a string.
+ *
+ * Surrogates and values above U+10FFFF are encoded as U+FFFD.
+ *
+ * @param out The string to append to.
+ * @param ch The code point to encode.
+ */
+void AppendUtf8(std::string& out, char32_t ch);
+
+/**
+ * @brief Encodes a UTF-32 string as UTF-8.
+ *
+ * @param source The UTF-32 text.
+ * @return The UTF-8 encoded text.
+ */
+[[nodiscard]] std::string EncodeUtf8(std::u32string_view source);
+
+/**
+ * @brief Decodes UTF-8 text into UTF-32.
+ *
+ * Accepts exactly what `ValidateUtf8` does. Each maximal ill-formed subpart,
+ * including overlong forms, surrogates and values past U+10FFFF, decodes to
+ * one U+FFFD.
+ *
+ * @param source The UTF-8 text.
+ * @return The decoded UTF-32 text.
+ */
+[[nodiscard]] std::u32string DecodeUtf8(std::string_view source);
+
+/**
+ * @brief Finds the first malformed sequence in UTF-8 text.
+ *
+ * Overlong encodings, surrogates, code points above U+10FFFF and truncated
+ * sequences are malformed, as in RFC 3629. Runs of ASCII, the bulk of source
+ * code, are checked sixteen bytes at a time and only multi-byte sequences
+ * one by one, so validating costs a small fraction of decoding.
+ *
+ * @param source The UTF-8 text.
+ * @return The byte offset of the first malformed sequence, or `source.size()`
+ * if the text is valid.
+ */
+[[nodiscard]] size_t ValidateUtf8(std::string_view source) noexcept;
+
+/**
+ * @brief Counts the code points in UTF-8 text.
+ *
+ * @param source The UTF-8 text.
+ * @return The number of code points, counting every non-continuation byte.
+ */
+[[nodiscard]] size_t CountCodepoints(std::string_view source) noexcept;
+
+/**
+ * @brief Decodes the code point starting at a byte offset.
+ *
+ * @param source The UTF-8 text.
+ * @param offset The byte offset of the sequence, less than `source.size()`.
+ * @return The code point, or U+FFFD for a malformed sequence.
+ */
+[[nodiscard]] char32_t DecodeUtf8At(std::string_view source,
+                                    size_t offset) noexcept;
+
+/**
+ * @brief Finds the byte offset of a code point in UTF-8 text.
+ *
+ * @param source The UTF-8 text.
+ * @param codepoints The number of code points before the one to find.
+ * @return The byte offset, or `source.size()` if the text has no more than
+ * `codepoints` code points.
+ */
+[[nodiscard]] size_t Utf8Offset(std::string_view source,
+                                size_t codepoints) noexcept;
+
+}  // namespace orion::syntax
+
+#endif  // SYNTAX_UTIL_UTF8_H_
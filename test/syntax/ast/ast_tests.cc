@@ -0,0 +1,114 @@
+#include "syntax/ast/ast.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+
+#include "syntax/lexer/token_kind.h"
+#include "syntax/parser/abstract_parser.h"
+#include "syntax/parser/binding_power.h"
+#include "syntax/parser/parser.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_token.h"
+#include "syntax/parser/syntax_kind.h"
+
+namespace {
+namespace ast = orion::syntax::ast;
+using orion::syntax::SyntaxKind;
+using orion::syntax::SyntaxNode;
+using orion::syntax::TokenKind;
+
+// Parses an expression and returns the body of its root.
+ast::Expr Body(const std::string& source) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(
+      orion::syntax::ParseExpression(
+          std::u32string(source.begin(), source.end()))
+          .root);
+  return *ast::Root::Cast(root)->Body();
+}
+
+TEST(AstTest, CastsOnlyMatchingKinds) {
+  const ast::Expr body = Body("1 + 2");
+
+  EXPECT_EQ(SyntaxKind::kBinaryExpr, body.Kind());
+  EXPECT_TRUE(body.As<ast::BinaryExpr>().has_value());
+  EXPECT_FALSE(body.As<ast::PrefixExpr>().has_value());
+  EXPECT_FALSE(ast::Root::Cast(body.Syntax()).has_value());
+  EXPECT_FALSE(ast::Expr::CanCast(SyntaxKind::kRoot));
+  EXPECT_FALSE(ast::Expr::CanCast(SyntaxKind::kError));
+}
+
+TEST(AstTest, NamesBinaryExprChildren) {
+  const ast::BinaryExpr binary = *Body("1 + 2 * x").As<ast::BinaryExpr>();
+
+  EXPECT_EQ("1", binary.Lhs()->As<ast::Literal>()->Token()->Text());
+  EXPECT_EQ("+", binary.Op()->Text());
+
+  const ast::BinaryExpr rhs = *binary.Rhs()->As<ast::BinaryExpr>();
+  EXPECT_EQ("*", rhs.Op()->Text());
+  EXPECT_EQ("x", rhs.Rhs()->As<ast::NameRef>()->Name()->Text());
+}
+
+TEST(AstTest, NamesParenAndPrefixChildren) {
+  const ast::PrefixExpr prefix = *Body("-(a)").As<ast::PrefixExpr>();
+  EXPECT_EQ("-", prefix.Op()->Text());
+
+  const ast::ParenExpr paren = *prefix.Operand()->As<ast::ParenExpr>();
+  EXPECT_EQ("(", paren.LParen()->Text());
+  EXPECT_EQ(SyntaxKind::kNameRef, paren.Inner()->Kind());
+  EXPECT_EQ(")", paren.RParen()->Text());
+}
+
+TEST(AstTest, LeavesMissingSlotsEmpty) {
+  // The left operand is missing, so the operator fills the next token slot.
+  const ast::BinaryExpr leading = *Body("* 2").As<ast::BinaryExpr>();
+  EXPECT_FALSE(leading.Lhs().has_value());
+  EXPECT_EQ("*", leading.Op()->Text());
+  EXPECT_EQ(SyntaxKind::kLiteral, leading.Rhs()->Kind());
+
+  const ast::BinaryExpr trailing = *Body("1 +").As<ast::BinaryExpr>();
+  EXPECT_TRUE(trailing.Lhs().has_value());
+  EXPECT_EQ("+", trailing.Op()->Text());
+  EXPECT_FALSE(trailing.Rhs().has_value());
+
+  const ast::ParenExpr unclosed = *Body("(1").As<ast::ParenExpr>();
+  EXPECT_TRUE(unclosed.Inner().has_value());
+  EXPECT_FALSE(unclosed.RParen().has_value());
+}
+
+TEST(AstTest, SkipsErrorNodesInSlots) {
+  // The stray `2` is wrapped in an error node, which fits no slot.
+  const ast::ParenExpr paren = *Body("(1 2)").As<ast::ParenExpr>();
+
+  EXPECT_EQ("1", paren.Inner()->As<ast::Literal>()->Token()->Text());
+  EXPECT_EQ(")", paren.RParen()->Text());
+
+  // An error in an operand's place is not an expression.
+  const ast::BinaryExpr binary = *Body("1 + )").As<ast::BinaryExpr>();
+  EXPECT_FALSE(binary.Rhs().has_value());
+}
+
+TEST(GrammarTablesTest, DescribeKinds) {
+  EXPECT_EQ("NumericLiteral", KindName(SyntaxKind::kNumericLiteral));
+  EXPECT_EQ("DoubleLit", KindName(TokenKind::kDoubleLit));
+  EXPECT_EQ("%", FixedText(SyntaxKind::kPercent));
+  EXPECT_TRUE(FixedText(SyntaxKind::kIdentifier).empty());
+  EXPECT_TRUE(IsTrivia(SyntaxKind::kComment));
+  EXPECT_FALSE(IsTrivia(SyntaxKind::kDot));
+  EXPECT_TRUE(IsKeyword(SyntaxKind::kBooleanLiteral));
+  EXPECT_TRUE(IsNode(SyntaxKind::kRoot));
+  EXPECT_FALSE(IsNode(SyntaxKind::kRParen));
+}
+
+TEST(GrammarTablesTest, MapLexerTokens) {
+  EXPECT_EQ(SyntaxKind::kNumericLiteral,
+            orion::syntax::ToSyntaxKind(TokenKind::kBigDecimalLiteral));
+  EXPECT_EQ(SyntaxKind::kError,
+            orion::syntax::ToSyntaxKind(TokenKind::kEof));
+  EXPECT_TRUE(orion::syntax::IsTrivia(TokenKind::kNewline));
+  EXPECT_TRUE(orion::syntax::IsPrefixOperator(TokenKind::kMinus));
+  EXPECT_FALSE(orion::syntax::IsPrefixOperator(TokenKind::kAsterisk));
+  EXPECT_EQ(3, orion::syntax::InfixBindingPower(TokenKind::kPercent).left);
+}
+}  // namespace
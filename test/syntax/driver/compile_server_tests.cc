@@ -0,0 +1,298 @@
+#include "syntax/driver/compile_server.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include "syntax/driver/front_end.h"
+#include "syntax/interner/interner.h"
+#include "syntax/io/unix_socket.h"
+#include "syntax/testing/temp_file.h"
+#include "syntax/util/thread_pool.h"
+
+namespace {
+using orion::syntax::CompileServer;
+using orion::syntax::Interner;
+using orion::syntax::test::WriteFile;
+
+constexpr size_t kLargeBudget = size_t{1} << 30;
+
+// The reply without its summary line, which holds timings.
+std::string WithoutSummary(const std::string& reply) {
+  const size_t start = reply.find("summary ");
+  if (start == std::string::npos) {
+    return reply;
+  }
+  return reply.substr(0, start) + reply.substr(reply.find('\n', start) + 1);
+}
+
+TEST(CompileServerTest, RepliesLikeParse) {
+  const std::string good = WriteFile("server_good.orn", "(1 + 2) * x").string();
+  const std::string bad = WriteFile("server_bad.orn", "1 +").string();
+  orion::syntax::ThreadPool pool(2);
+  CompileServer server(kLargeBudget, pool);
+
+  const std::string reply =
+      WithoutSummary(server.Handle("parse\n" + good + "\n" + bad + "\n"));
+
+  EXPECT_EQ("stdout " + good + ": ok\n" + "stderr " + bad +
+                ":3: expected an operand\n" + "exit 1\n",
+            reply);
+  EXPECT_EQ(2, server.EntryCount());
+}
+
+TEST(CompileServerTest, AnswersUnchangedFilesFromMemory) {
+  const std::string a = WriteFile("server_same_a.orn", "a + b").string();
+  const std::string b = WriteFile("server_same_b.orn", "-c").string();
+  const std::string request = "parse\n" + a + "\n" + b + "\n";
+  orion::syntax::ThreadPool pool(2);
+  CompileServer server(kLargeBudget, pool);
+
+  const std::string first = server.Handle(request);
+  const std::string second = server.Handle(request);
+
+  EXPECT_EQ(WithoutSummary(first), WithoutSummary(second));
+  EXPECT_NE(std::string::npos, second.find("2 from memory, 0 parsed"));
+  EXPECT_EQ(2, server.Stats().requests);
+  EXPECT_EQ(4, server.Stats().files);
+  EXPECT_EQ(2, server.Stats().hits);
+  EXPECT_EQ(2, server.Stats().misses);
+}
+
+TEST(CompileServerTest, ReparsesChangedFiles) {
+  const std::string path = WriteFile("server_changed.orn", "1").string();
+  orion::syntax::ThreadPool pool(2);
+  CompileServer server(kLargeBudget, pool);
+
+  EXPECT_EQ("stdout " + path + ": ok\nexit 0\n",
+            WithoutSummary(server.Handle("parse\n" + path)));
+  WriteFile("server_changed.orn", "1 +");
+  EXPECT_EQ("stderr " + path + ":3: expected an operand\nexit 1\n",
+            WithoutSummary(server.Handle("parse\n" + path)));
+
+  EXPECT_EQ(0, server.Stats().hits);
+  EXPECT_EQ(2, server.Stats().misses);
+  EXPECT_EQ(1, server.EntryCount());
+}
+
+TEST(CompileServerTest, ReportsUnreadableFilesWithoutCachingThem) {
+  const std::string path =
+      (std::filesystem::path(testing::TempDir()) / "server_missing.orn")
+          .string();
+  orion::syntax::ThreadPool pool(2);
+  CompileServer server(kLargeBudget, pool);
+
+  const std::string reply = WithoutSummary(server.Handle("parse\n" + path));
+
+  EXPECT_TRUE(reply.starts_with("stderr " + path + ": ")) << reply;
+  EXPECT_TRUE(reply.ends_with("exit 1\n")) << reply;
+  EXPECT_EQ(0, server.EntryCount());
+}
+
+TEST(CompileServerTest, EvictsTheLeastRecentlyUsedBeyondTheBudget) {
+  // `b` and `c` have names and contents of the same length, so their entries
+  // are estimated at the same size.
+  const std::string a = WriteFile("server_lru_a.orn", "x * y").string();
+  const std::string b = WriteFile("server_lru_b.orn", "1 + 2").string();
+  const std::string c = WriteFile("server_lru_c.orn", "3 + 4").string();
+  orion::syntax::ThreadPool pool(2);
+
+  size_t two_entries = 0;
+  {
+    CompileServer measure(kLargeBudget, pool);
+    (void)measure.Handle("parse\n" + a + "\n" + b);
+    two_entries = measure.MemoryUsed();
+    // Interns every spelling `server` will see, so the text it counts against
+    // its budget stays the same throughout.
+    (void)measure.Handle("parse\n" + c);
+  }
+  CompileServer server(two_entries + Interner::Global().Bytes(), pool);
+
+  (void)server.Handle("parse\n" + a);
+  (void)server.Handle("parse\n" + b);
+  (void)server.Handle("parse\n" + a);
+  (void)server.Handle("parse\n" + c);
+  EXPECT_EQ(1, server.Stats().evictions);
+  EXPECT_EQ(2, server.EntryCount());
+  EXPECT_LE(server.MemoryUsed(), two_entries);
+  EXPECT_EQ(0, server.Stats().interner_resets);
+
+  (void)server.Handle("parse\n" + a);
+  EXPECT_EQ(2, server.Stats().hits);
+  (void)server.Handle("parse\n" + b);
+  EXPECT_EQ(2, server.Stats().hits);
+}
+
+TEST(CompileServerTest, StillRepliesWhenNothingFitsTheBudget) {
+  const std::string path = WriteFile("server_tiny.orn", "1").string();
+  orion::syntax::ThreadPool pool(1);
+  CompileServer server(1, pool);
+
+  EXPECT_EQ("stdout " + path + ": ok\nexit 0\n",
+            WithoutSummary(server.Handle("parse\n" + path)));
+  EXPECT_EQ(0, server.EntryCount());
+  EXPECT_EQ(0, server.MemoryUsed());
+  EXPECT_EQ(1, server.Stats().evictions);
+}
+
+TEST(CompileServerTest, KeepsGreenCachesWithinTheBudget) {
+  constexpr size_t kBudget = 32 * 1024;
+  orion::syntax::ThreadPool pool(2);
+  CompileServer server(kBudget, pool);
+
+  // Every version has new identifiers, so without clearing, the caches
+  // would keep every tree alive.
+  const std::string path = WriteFile("server_churn.orn", "").string();
+  for (size_t i = 0; i < 200; ++i) {
+    const std::string n = std::to_string(i);
+    WriteFile("server_churn.orn", "(a" + n + " + b" + n + ") * c" + n +
+                                      " - " + n + " / d" + n);
+    (void)server.Handle("parse\n" + path);
+    EXPECT_LE(server.MemoryUsed() + server.CacheMemoryUsed() +
+                  Interner::Global().Bytes(),
+              kBudget);
+  }
+
+  EXPECT_GT(server.Stats().cache_clears, 0);
+  EXPECT_LE(server.EntryCount(), 1);
+  EXPECT_EQ(200, server.Stats().misses);
+}
+
+TEST(CompileServerTest, ReleasesInternedTextBeyondTheBudget) {
+  constexpr size_t kBudget = 16 * 1024;
+  const std::string path =
+      WriteFile("server_long_name.orn", std::string(2 * kBudget, 'x')).string();
+  orion::syntax::ThreadPool pool(1);
+  CompileServer server(kBudget, pool);
+
+  EXPECT_EQ("stdout " + path + ": ok\nexit 0\n",
+            WithoutSummary(server.Handle("parse\n" + path)));
+  EXPECT_EQ(1, server.Stats().interner_resets);
+  EXPECT_EQ(0, server.EntryCount());
+  EXPECT_EQ(0, Interner::Global().Bytes());
+
+  // Nothing cached survived the reset, so the file is parsed afresh.
+  (void)server.Handle("parse\n" + path);
+  EXPECT_EQ(2, server.Stats().misses);
+}
+
+TEST(CompileServerTest, ReleasesInternedTextBeforeItCrowdsOutEntries) {
+  constexpr size_t kBudget = 64 * 1024;
+  // One spelling that nearly fills the budget, leaving no room for entries.
+  const std::string crowded =
+      WriteFile("server_crowded.orn", std::string(kBudget - 64, 'x')).string();
+  const std::string small = WriteFile("server_uncrowded.orn", "a + b").string();
+  orion::syntax::ThreadPool pool(1);
+  CompileServer server(kBudget, pool);
+
+  (void)server.Handle("parse\n" + crowded);
+  EXPECT_EQ(1, server.Stats().interner_resets);
+  EXPECT_LE(Interner::Global().Bytes(), kBudget / 2);
+
+  (void)server.Handle("parse\n" + small);
+  (void)server.Handle("parse\n" + small);
+  EXPECT_EQ(1, server.EntryCount());
+  EXPECT_EQ(1, server.Stats().hits);
+  EXPECT_EQ(1, server.Stats().interner_resets);
+}
+
+TEST(CompileServerTest, OwnsTheGlobalInterner) {
+  const std::filesystem::path path = WriteFile("server_owned.orn", "1");
+  orion::syntax::ThreadPool pool(1);
+
+  {
+    const CompileServer server(kLargeBudget, pool);
+    EXPECT_TRUE(Interner::Global().Owned());
+    EXPECT_THROW(CompileServer(kLargeBudget, pool), std::logic_error);
+    EXPECT_THROW(orion::syntax::FrontEnd(std::span(&path, 1), pool),
+                 std::logic_error);
+  }
+
+  EXPECT_FALSE(Interner::Global().Owned());
+}
+
+TEST(CompileServerTest, StopsOnRequest) {
+  orion::syntax::ThreadPool pool(1);
+  CompileServer server(kLargeBudget, pool);
+
+  EXPECT_EQ("stderr orion: unknown request 'build'\nexit 2\n",
+            server.Handle("build\n"));
+  EXPECT_FALSE(server.Stopping());
+  EXPECT_EQ("exit 0\n", server.Handle("stop\n"));
+  EXPECT_TRUE(server.Stopping());
+}
+
+#if !defined(_WIN32)
+TEST(CompileServerTest, ServesRequestsOverAUnixSocket) {
+  const std::string path = WriteFile("server_socket.orn", "1 + 1").string();
+  const std::filesystem::path socket_path =
+      std::filesystem::path(testing::TempDir()) / "server_test.sock";
+  orion::syntax::ThreadPool pool(1);
+  CompileServer server(kLargeBudget, pool);
+  const orion::syntax::UnixSocket listener =
+      orion::syntax::UnixSocket::Listen(socket_path);
+
+  std::thread serving([&listener, &server] {
+    const orion::syntax::UnixSocket client = listener.Accept();
+    client.WriteAll(server.Handle(client.ReadAll()));
+  });
+  const orion::syntax::UnixSocket client =
+      orion::syntax::UnixSocket::Connect(socket_path);
+  client.WriteAll("parse\n" + path + "\n");
+  client.FinishWriting();
+  const std::string reply = client.ReadAll();
+  serving.join();
+
+  EXPECT_EQ("stdout " + path + ": ok\nexit 0\n", WithoutSummary(reply));
+  std::filesystem::remove(socket_path);
+}
+
+TEST(CompileServerTest, SocketsRejectOversizedRequests) {
+  const std::filesystem::path socket_path =
+      std::filesystem::path(testing::TempDir()) / "server_oversized.sock";
+  const orion::syntax::UnixSocket listener =
+      orion::syntax::UnixSocket::Listen(socket_path);
+
+  std::thread client([&socket_path] {
+    const orion::syntax::UnixSocket socket =
+        orion::syntax::UnixSocket::Connect(socket_path);
+    socket.WriteAll(std::string(100, 'x'));
+    socket.FinishWriting();
+  });
+  const orion::syntax::UnixSocket server = listener.Accept();
+
+  EXPECT_THROW((void)server.ReadAll(10), std::system_error);
+  client.join();
+  std::filesystem::remove(socket_path);
+}
+
+TEST(CompileServerTest, SocketsTimeOutOnStalledClients) {
+  const std::filesystem::path socket_path =
+      std::filesystem::path(testing::TempDir()) / "server_stalled.sock";
+  const orion::syntax::UnixSocket listener =
+      orion::syntax::UnixSocket::Listen(socket_path);
+
+  // The client connects but never finishes its request.
+  const orion::syntax::UnixSocket client =
+      orion::syntax::UnixSocket::Connect(socket_path);
+  client.WriteAll("parse\n");
+  const orion::syntax::UnixSocket server = listener.Accept();
+  server.SetTimeout(std::chrono::milliseconds(50));
+
+  try {
+    (void)server.ReadAll();
+    FAIL() << "expected a timeout";
+  } catch (const std::system_error& e) {
+    EXPECT_EQ(std::errc::timed_out, e.code());
+  }
+  std::filesystem::remove(socket_path);
+}
+#endif
+}  // namespace
@@ -0,0 +1,236 @@
+#include "syntax/driver/front_end.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "syntax/driver/parse_cache.h"
+#include "syntax/driver/time_report.h"
+#include "syntax/lexer/token.h"
+#include "syntax/lexer/token_kind.h"
+#include "syntax/parser/parser.h"
+#include "syntax/parser/rgtree/green/green_cache.h"
+#include "syntax/testing/temp_file.h"
+#include "syntax/text/text_size.h"
+#include "syntax/util/thread_pool.h"
+
+namespace {
+using orion::syntax::FrontEnd;
+using orion::syntax::Phase;
+using orion::syntax::SourceUnit;
+using orion::syntax::test::WriteFile;
+
+TEST(FrontEndTest, StopsAfterTheRequestedPhase) {
+  const std::vector<std::filesystem::path> paths = {
+      WriteFile("front_end_lex.orn", "1 + x")};
+  orion::syntax::ThreadPool pool(2);
+  FrontEnd front_end(paths, pool);
+
+  front_end.RunThrough(Phase::kLex);
+
+  const SourceUnit& unit = front_end.Units()[0];
+  EXPECT_EQ(5, unit.bytes);
+  EXPECT_EQ(5, unit.tokens.size());
+  EXPECT_TRUE(unit.text.empty());
+  EXPECT_TRUE(unit.events.empty());
+  EXPECT_FALSE(unit.root.has_value());
+  ASSERT_EQ(2, front_end.Report().phases.size());
+  EXPECT_EQ(Phase::kLex, front_end.Report().phases[1].phase);
+}
+
+TEST(FrontEndTest, BuildsTheSameTreeAsParseExpression) {
+  const std::vector<std::filesystem::path> paths = {
+      WriteFile("front_end_a.orn", "(1 + 2) * x"),
+      WriteFile("front_end_b.orn", "1 +"),
+      std::filesystem::path(testing::TempDir()) / "front_end_missing.orn",
+  };
+  orion::syntax::ThreadPool pool(2);
+  FrontEnd front_end(paths, pool);
+
+  front_end.RunThrough(Phase::kLex);
+  front_end.RunThrough(Phase::kBuild);
+
+  const std::u32string sources[] = {U"(1 + 2) * x", U"1 +"};
+  const std::span<const SourceUnit> units = front_end.Units();
+  ASSERT_EQ(3, units.size());
+  for (size_t i = 0; i < 2; ++i) {
+    const orion::syntax::ParseResult expected =
+        orion::syntax::ParseExpression(sources[i]);
+    ASSERT_TRUE(units[i].root.has_value());
+    EXPECT_EQ(expected.root.Hash(), units[i].root->Hash());
+    EXPECT_EQ(expected.diagnostics, units[i].diagnostics);
+  }
+  EXPECT_EQ(1, units[1].diagnostics.size());
+  EXPECT_FALSE(units[2].error.empty());
+  EXPECT_FALSE(units[2].root.has_value());
+}
+
+TEST(FrontEndTest, KeepsTheInputOrder) {
+  // Sizes out of order, so scheduling largest first reorders them.
+  const std::vector<std::filesystem::path> paths = {
+      WriteFile("front_end_small.orn", "a + a"),
+      WriteFile("front_end_large.orn", "a + a + a + a + a + a + a + a"),
+      WriteFile("front_end_medium.orn", "a + a + a + a"),
+  };
+  orion::syntax::ThreadPool pool(2);
+  FrontEnd front_end(paths, pool);
+
+  front_end.RunThrough(Phase::kBuild);
+
+  const std::span<const SourceUnit> units = front_end.Units();
+  ASSERT_EQ(3, units.size());
+  const uint64_t bytes[] = {5, 29, 13};
+  for (size_t i = 0; i < units.size(); ++i) {
+    EXPECT_EQ(paths[i], units[i].path);
+    EXPECT_EQ(bytes[i], units[i].bytes);
+    EXPECT_TRUE(units[i].root.has_value());
+  }
+}
+
+TEST(FrontEndTest, ParsesCrlfLineBreaks) {
+  const std::vector<std::filesystem::path> paths = {
+      WriteFile("front_end_crlf.orn", "1+2\r\n"),
+      WriteFile("front_end_lf.orn", "1+2\n"),
+  };
+  orion::syntax::ThreadPool pool(2);
+  FrontEnd front_end(paths, pool);
+
+  front_end.RunThrough(Phase::kLex);
+
+  const std::span<const SourceUnit> units = front_end.Units();
+  ASSERT_EQ(2, units.size());
+  EXPECT_EQ(orion::syntax::TokenKind::kNewline,
+            units[0].tokens.back().GetKind<orion::syntax::TokenKind>());
+  EXPECT_EQ(units[1].tokens.size(), units[0].tokens.size());
+
+  front_end.RunThrough(Phase::kBuild);
+
+  EXPECT_TRUE(units[0].error.empty());
+  EXPECT_TRUE(units[0].diagnostics.empty());
+  ASSERT_TRUE(units[0].root.has_value());
+  EXPECT_EQ(units[1].root->Width() + orion::syntax::TextSize(1),
+            units[0].root->Width());
+}
+
+TEST(FrontEndTest, ReleasesEachBufferOnceUsed) {
+  const std::vector<std::filesystem::path> paths = {
+      WriteFile("front_end_release.orn", "a + (b)")};
+  orion::syntax::ThreadPool pool(1);
+  FrontEnd front_end(paths, pool);
+
+  front_end.RunThrough(Phase::kParse);
+
+  const SourceUnit& unit = front_end.Units()[0];
+  EXPECT_TRUE(unit.text.empty());
+  EXPECT_EQ(7, unit.tokens.size());
+  EXPECT_FALSE(unit.events.empty());
+
+  front_end.RunThrough(Phase::kBuild);
+
+  EXPECT_TRUE(unit.tokens.empty());
+  EXPECT_TRUE(unit.events.empty());
+  EXPECT_EQ(7, unit.token_count);
+  ASSERT_TRUE(unit.root.has_value());
+  EXPECT_EQ(orion::syntax::TextSize(7), unit.root->Width());
+}
+
+TEST(FrontEndTest, ProcessesNoFiles) {
+  orion::syntax::ThreadPool pool(1);
+  FrontEnd front_end({}, pool);
+
+  front_end.RunThrough(Phase::kBuild);
+
+  EXPECT_TRUE(front_end.Units().empty());
+  EXPECT_EQ(orion::syntax::kPhaseCount, front_end.Report().phases.size());
+}
+
+TEST(FrontEndTest, ReportsEveryPhase) {
+  const std::vector<std::filesystem::path> paths = {
+      WriteFile("front_end_report.orn", "a + a + a")};
+  orion::syntax::ThreadPool pool(1);
+  FrontEnd front_end(paths, pool);
+
+  front_end.RunThrough(Phase::kBuild);
+
+  const orion::syntax::TimeReport report = front_end.Report();
+  ASSERT_EQ(orion::syntax::kPhaseCount, report.phases.size());
+  for (const orion::syntax::PhaseTiming& timing : report.phases) {
+    EXPECT_EQ(9, timing.bytes);
+    EXPECT_GE(timing.wall_seconds, 0);
+  }
+  EXPECT_EQ(0, report.phases[0].tokens);
+  EXPECT_EQ(9, report.phases[1].tokens);
+  EXPECT_EQ(0, report.phases[1].nodes);
+
+  // The root, two sums and three names.
+  EXPECT_EQ(6, report.phases[3].nodes);
+  EXPECT_GT(report.cache.token_lookups, 0);
+  EXPECT_GT(report.cache.token_hits, 0);
+}
+
+TEST(FrontEndTest, BuildsWithTheGivenNodeCachePolicy) {
+  const std::vector<std::filesystem::path> paths = {
+      WriteFile("front_end_adaptive.orn", "(a + b) * (a + b) * (a + b)")};
+  orion::syntax::ThreadPool pool(1);
+  FrontEnd front_end(paths, pool, nullptr,
+                     orion::syntax::NodeCachePolicy::kAdaptive);
+
+  front_end.RunThrough(Phase::kBuild);
+
+  const SourceUnit& unit = front_end.Units()[0];
+  ASSERT_TRUE(unit.root.has_value());
+  const orion::syntax::ParseResult expected =
+      orion::syntax::ParseExpression(U"(a + b) * (a + b) * (a + b)");
+  EXPECT_EQ(expected.root.Hash(), unit.root->Hash());
+  EXPECT_EQ(orion::syntax::NodeCachePolicy::kAdaptive,
+            front_end.Report().node_cache_policy);
+}
+
+TEST(FrontEndTest, SkipsTheFrontEndForCachedFiles) {
+  const std::filesystem::path directory =
+      std::filesystem::path(testing::TempDir()) / "front_end_cache";
+  std::filesystem::remove_all(directory);
+  const std::vector<std::filesystem::path> paths = {
+      WriteFile("front_end_cached_a.orn", "(1 + 2) * x"),
+      WriteFile("front_end_cached_b.orn", "1 +")};
+  orion::syntax::ThreadPool pool(2);
+  orion::syntax::ParseCache cache(directory, uint64_t{1} << 30);
+
+  FrontEnd cold(paths, pool, &cache);
+  cold.RunThrough(Phase::kLex);
+  std::vector<std::vector<orion::syntax::Token>> lexed;
+  for (const SourceUnit& unit : cold.Units()) {
+    lexed.push_back(unit.tokens);
+  }
+  cold.RunThrough(Phase::kBuild);
+  FrontEnd warm(paths, pool, &cache);
+  warm.RunThrough(Phase::kRead);
+  for (size_t i = 0; i < paths.size(); ++i) {
+    EXPECT_EQ(lexed[i], warm.Units()[i].tokens);
+  }
+  warm.RunThrough(Phase::kBuild);
+
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const SourceUnit& built = cold.Units()[i];
+    const SourceUnit& loaded = warm.Units()[i];
+    EXPECT_FALSE(built.cached);
+    EXPECT_TRUE(loaded.cached);
+    EXPECT_TRUE(loaded.text.empty());
+    EXPECT_TRUE(loaded.events.empty());
+    EXPECT_EQ(built.diagnostics, loaded.diagnostics);
+    ASSERT_TRUE(loaded.root.has_value());
+    EXPECT_EQ(built.root->Hash(), loaded.root->Hash());
+  }
+
+  const orion::syntax::TimeReport report = warm.Report();
+  EXPECT_EQ(2, report.parse_cache.hits);
+  EXPECT_EQ(2, report.parse_cache.misses);
+  EXPECT_EQ(2, report.parse_cache.stores);
+  EXPECT_EQ(0, report.phases[1].tokens);
+  EXPECT_EQ(0, report.phases[3].nodes);
+}
+}  // namespace
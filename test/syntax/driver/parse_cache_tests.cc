@@ -0,0 +1,231 @@
+#include "syntax/driver/parse_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "syntax/lexer/lexer.h"
+#include "syntax/lexer/token.h"
+#include "syntax/parser/build_green.h"
+#include "syntax/parser/event.h"
+#include "syntax/parser/parser.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/util/utf8.h"
+
+namespace {
+using orion::syntax::CachedParse;
+using orion::syntax::ParseCache;
+
+constexpr uint64_t kLargeCap = uint64_t{1} << 30;
+
+// A fresh, empty cache directory for one test.
+std::filesystem::path CacheDirectory(const std::string& name) {
+  const std::filesystem::path path =
+      std::filesystem::path(testing::TempDir()) / name;
+  std::filesystem::remove_all(path);
+  return path;
+}
+
+struct Parsed {
+  std::vector<orion::syntax::Token> tokens;
+  orion::syntax::GreenNode root;
+  std::vector<orion::syntax::Diagnostic> diagnostics;
+};
+
+Parsed ParseSource(const std::string& source) {
+  const std::u32string text = orion::syntax::DecodeUtf8(source);
+  orion::syntax::Lexer lexer(text);
+  std::vector<orion::syntax::Token> tokens = lexer.Tokenize();
+  orion::syntax::Parser parser(tokens);
+  const std::vector<orion::syntax::Event> events = parser.Parse();
+  orion::syntax::GreenNode root = orion::syntax::BuildGreen(events, tokens);
+  return {std::move(tokens), std::move(root),
+          orion::syntax::MergeDiagnostics(lexer.Diagnostics(),
+                                          parser.Diagnostics())};
+}
+
+// Stores a source's results and returns its key.
+uint64_t StoreSource(ParseCache& cache, const std::string& source) {
+  const Parsed parsed = ParseSource(source);
+  const uint64_t key = ParseCache::Key(source);
+  EXPECT_TRUE(cache.Store(key, source.size(), parsed.tokens, parsed.root,
+                          parsed.diagnostics));
+  return key;
+}
+
+TEST(ParseCacheTest, RoundTripsTokensTreeAndDiagnostics) {
+  const std::string source = "(1 + x) * -\n";
+  ParseCache cache(CacheDirectory("parse_cache_round_trip"), kLargeCap);
+  const Parsed parsed = ParseSource(source);
+  ASSERT_FALSE(parsed.diagnostics.empty());
+
+  const uint64_t key = StoreSource(cache, source);
+  const std::optional<CachedParse> loaded = cache.Load(key, source.size());
+
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(parsed.tokens, loaded->tokens);
+  EXPECT_EQ(parsed.diagnostics, loaded->diagnostics);
+  EXPECT_EQ(parsed.root.Hash(), loaded->root.Hash());
+  EXPECT_EQ(parsed.root.Width(), loaded->root.Width());
+  EXPECT_EQ(1, cache.Stats().hits);
+  EXPECT_EQ(1, cache.Stats().stores);
+}
+
+TEST(ParseCacheTest, KeysDependOnlyOnContent) {
+  EXPECT_EQ(ParseCache::Key("a + b"), ParseCache::Key("a + b"));
+  EXPECT_NE(ParseCache::Key("a + b"), ParseCache::Key("a + c"));
+}
+
+TEST(ParseCacheTest, MissesSourcesItHasNotSeen) {
+  ParseCache cache(CacheDirectory("parse_cache_miss"), kLargeCap);
+  const uint64_t key = StoreSource(cache, "1");
+
+  EXPECT_FALSE(cache.Load(ParseCache::Key("2"), 1).has_value());
+  EXPECT_FALSE(cache.Load(key, 2).has_value());
+  EXPECT_EQ(2, cache.Stats().misses);
+}
+
+TEST(ParseCacheTest, DropsCorruptEntries) {
+  ParseCache cache(CacheDirectory("parse_cache_corrupt"), kLargeCap);
+  const uint64_t key = StoreSource(cache, "1 + 2");
+  std::filesystem::resize_file(cache.EntryPath(key), 48);
+
+  EXPECT_FALSE(cache.Load(key, 5).has_value());
+  EXPECT_FALSE(std::filesystem::exists(cache.EntryPath(key)));
+
+  StoreSource(cache, "1 + 2");
+  EXPECT_TRUE(cache.Load(key, 5).has_value());
+}
+
+// Rewrites the record of type `Record` at `offset` in a stored entry.
+template <typename Record, typename Edit>
+void EditRecord(const std::filesystem::path& path, const std::streamoff offset,
+                Edit edit) {
+  std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+  Record record;
+  stream.seekg(offset);
+  stream.read(reinterpret_cast<char*>(&record), sizeof(record));
+  edit(record);
+  stream.seekp(offset);
+  stream.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+// Rewrites the first token record of a stored entry.
+template <typename Edit>
+void EditFirstToken(const std::filesystem::path& path, Edit edit) {
+  EditRecord<orion::syntax::ParseCacheToken>(
+      path, sizeof(orion::syntax::ParseCacheHeader), edit);
+}
+
+// Rewrites the first diagnostic record of a stored entry.
+template <typename Edit>
+void EditFirstDiagnostic(const std::filesystem::path& path, Edit edit) {
+  orion::syntax::ParseCacheHeader header;
+  std::ifstream(path, std::ios::binary)
+      .read(reinterpret_cast<char*>(&header), sizeof(header));
+  EditRecord<orion::syntax::ParseCacheDiagnostic>(
+      path,
+      sizeof(header) +
+          header.token_count * sizeof(orion::syntax::ParseCacheToken),
+      edit);
+}
+
+TEST(ParseCacheTest, DropsEntriesWithTokenKindsOutOfRange) {
+  ParseCache cache(CacheDirectory("parse_cache_bad_kind"), kLargeCap);
+  const uint64_t key = StoreSource(cache, "1 + 2");
+  EditFirstToken(cache.EntryPath(key), [](orion::syntax::ParseCacheToken& t) {
+    t.kind = 0xFFFF;
+  });
+
+  EXPECT_FALSE(cache.Load(key, 5).has_value());
+  EXPECT_FALSE(std::filesystem::exists(cache.EntryPath(key)));
+  EXPECT_EQ(1, cache.Stats().misses);
+}
+
+TEST(ParseCacheTest, DropsEntriesWithTokensPastTheSource) {
+  ParseCache cache(CacheDirectory("parse_cache_bad_span"), kLargeCap);
+  const uint64_t key = StoreSource(cache, "1 + 2");
+  EditFirstToken(cache.EntryPath(key), [](orion::syntax::ParseCacheToken& t) {
+    t.end = 6;
+  });
+
+  EXPECT_FALSE(cache.Load(key, 5).has_value());
+  EXPECT_FALSE(std::filesystem::exists(cache.EntryPath(key)));
+}
+
+TEST(ParseCacheTest, LoadsMessagesFromTheStaticTable) {
+  const std::string source = "(1 + x) * -\n";
+  ParseCache cache(CacheDirectory("parse_cache_messages"), kLargeCap);
+  const uint64_t key = StoreSource(cache, source);
+  const std::optional<CachedParse> loaded = cache.Load(key, source.size());
+
+  ASSERT_TRUE(loaded.has_value());
+  ASSERT_FALSE(loaded->diagnostics.empty());
+  for (const orion::syntax::Diagnostic& diagnostic : loaded->diagnostics) {
+    const std::optional<uint32_t> index =
+        orion::syntax::DiagnosticMessageIndex(diagnostic.message);
+    ASSERT_TRUE(index.has_value());
+    EXPECT_EQ(orion::syntax::kDiagnosticMessages[*index].data(),
+              diagnostic.message.data());
+  }
+}
+
+TEST(ParseCacheTest, DropsEntriesWithUnknownMessages) {
+  const std::string source = "1 +";
+  ParseCache cache(CacheDirectory("parse_cache_bad_message"), kLargeCap);
+  const uint64_t key = StoreSource(cache, source);
+  EditFirstDiagnostic(cache.EntryPath(key),
+                      [](orion::syntax::ParseCacheDiagnostic& diagnostic) {
+                        diagnostic.message =
+                            orion::syntax::kDiagnosticMessages.size();
+                      });
+
+  EXPECT_FALSE(cache.Load(key, source.size()).has_value());
+  EXPECT_FALSE(std::filesystem::exists(cache.EntryPath(key)));
+}
+
+TEST(ParseCacheTest, RefusesMessagesOutsideTheTable) {
+  ParseCache cache(CacheDirectory("parse_cache_foreign_message"), kLargeCap);
+  const Parsed parsed = ParseSource("1");
+  const std::vector<orion::syntax::Diagnostic> diagnostics = {
+      {orion::syntax::TextRange(orion::syntax::TextSize(0),
+                                orion::syntax::TextSize(1)),
+       "not a front end message"}};
+
+  EXPECT_FALSE(cache.Store(ParseCache::Key("1"), 1, parsed.tokens,
+                           parsed.root, diagnostics));
+  EXPECT_FALSE(std::filesystem::exists(cache.EntryPath(ParseCache::Key("1"))));
+}
+
+TEST(ParseCacheTest, TrimRemovesTheLeastRecentlyUsed) {
+  const std::filesystem::path directory = CacheDirectory("parse_cache_trim");
+  ParseCache probe(directory, kLargeCap);
+  const uint64_t a = StoreSource(probe, "a + a");
+  const uint64_t b = StoreSource(probe, "b + b");
+  const uint64_t c = StoreSource(probe, "c + c");
+  const uint64_t entry_size = std::filesystem::file_size(probe.EntryPath(a));
+
+  // Oldest first: b, then c, then a.
+  const auto now = std::filesystem::file_time_type::clock::now();
+  std::filesystem::last_write_time(probe.EntryPath(b),
+                                   now - std::chrono::hours(3));
+  std::filesystem::last_write_time(probe.EntryPath(c),
+                                   now - std::chrono::hours(2));
+  std::filesystem::last_write_time(probe.EntryPath(a),
+                                   now - std::chrono::hours(1));
+
+  ParseCache cache(directory, 2 * entry_size);
+  cache.Trim();
+
+  EXPECT_EQ(1, cache.Stats().evictions);
+  EXPECT_FALSE(std::filesystem::exists(cache.EntryPath(b)));
+  EXPECT_TRUE(cache.Load(a, 5).has_value());
+  EXPECT_TRUE(cache.Load(c, 5).has_value());
+}
+}  // namespace
@@ -0,0 +1,80 @@
+#include "syntax/driver/time_report.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace {
+using orion::syntax::Phase;
+using orion::syntax::TimeReport;
+
+TimeReport MakeReport() {
+  TimeReport report;
+  report.phases.push_back({Phase::kRead, 0.5, 0.25, 1000, 0, 0});
+  report.phases.push_back({Phase::kLex, 0.5, 1.0, 1000, 200, 0});
+  report.peak_rss_bytes = 4 * 1024 * 1024;
+  report.cache.node_lookups = 8;
+  report.cache.node_hits = 2;
+  report.cache.token_lookups = 200;
+  report.cache.token_hits = 150;
+  return report;
+}
+
+TEST(TimeReportTest, NamesPhases) {
+  EXPECT_EQ("read", orion::syntax::PhaseName(Phase::kRead));
+  EXPECT_EQ("build", orion::syntax::PhaseName(Phase::kBuild));
+}
+
+TEST(TimeReportTest, FormatsText) {
+  const std::string text = orion::syntax::FormatTimeReport(MakeReport());
+
+  EXPECT_NE(std::string::npos, text.find("read"));
+  EXPECT_NE(std::string::npos, text.find("lex"));
+  EXPECT_NE(std::string::npos, text.find("total"));
+  EXPECT_NE(std::string::npos, text.find("4.0 MiB"));
+  EXPECT_NE(std::string::npos, text.find("2 / 8 (25.0%)"));
+  EXPECT_NE(std::string::npos, text.find("150 / 200 (75.0%)"));
+  EXPECT_NE(std::string::npos, text.find("node cache policy fixed"));
+}
+
+TEST(TimeReportTest, FormatsJson) {
+  const std::string json = orion::syntax::FormatTimeReportJson(MakeReport());
+
+  EXPECT_EQ('{', json.front());
+  EXPECT_NE(std::string::npos,
+            json.find("{\"name\":\"lex\",\"wall_seconds\":0.5,"
+                      "\"cpu_seconds\":1,\"bytes\":1000,\"tokens\":200,"
+                      "\"nodes\":0,\"bytes_per_second\":2000,"
+                      "\"tokens_per_second\":400,\"nodes_per_second\":0}"));
+  EXPECT_NE(std::string::npos,
+            json.find("\"total\":{\"wall_seconds\":1,\"cpu_seconds\":1.25"));
+  EXPECT_NE(std::string::npos, json.find("\"peak_rss_bytes\":4194304"));
+  EXPECT_NE(std::string::npos, json.find("\"token_hit_rate\":0.75"));
+  EXPECT_NE(std::string::npos,
+            json.find("\"green_cache\":{\"policy\":\"fixed\","));
+}
+
+TEST(TimeReportTest, ShowsTheParseCacheOnlyWhenUsed) {
+  TimeReport report = MakeReport();
+  EXPECT_EQ(std::string::npos,
+            orion::syntax::FormatTimeReport(report).find("parse cache"));
+
+  report.parse_cache.hits = 3;
+  report.parse_cache.misses = 1;
+  report.parse_cache.stores = 1;
+  EXPECT_NE(std::string::npos,
+            orion::syntax::FormatTimeReport(report).find(
+                "parse cache hits  3 / 4 (75.0%), 1 stored, 0 evicted"));
+  EXPECT_NE(std::string::npos,
+            orion::syntax::FormatTimeReportJson(report).find(
+                "\"parse_cache\":{\"hits\":3,\"misses\":1,\"stores\":1,"
+                "\"evictions\":0}"));
+}
+
+TEST(TimeReportTest, MeasuresTheProcess) {
+  EXPECT_GE(orion::syntax::ProcessCpuSeconds(), 0);
+#if !defined(_WIN32)
+  EXPECT_GT(orion::syntax::PeakRssBytes(), 0);
+#endif
+}
+}  // namespace
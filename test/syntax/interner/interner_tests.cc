@@ -0,0 +1,134 @@
+#include "syntax/interner/interner.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "syntax/interner/symbol.h"
+
+namespace {
+TEST(InternerTest, InternSameTextReturnsSameSymbol) {
+  orion::syntax::Interner interner;
+
+  const orion::syntax::Symbol symbol1 = interner.Intern(std::string_view("x"));
+  const orion::syntax::Symbol symbol2 = interner.Intern(std::string_view("x"));
+
+  EXPECT_EQ(symbol1, symbol2);
+  EXPECT_EQ(1, interner.Size());
+  EXPECT_EQ(1, interner.Bytes());
+}
+
+TEST(InternerTest, InternDifferentTextReturnsDifferentSymbols) {
+  orion::syntax::Interner interner;
+
+  const orion::syntax::Symbol symbol1 = interner.Intern(std::string_view("x"));
+  const orion::syntax::Symbol symbol2 = interner.Intern(std::string_view("y"));
+
+  EXPECT_NE(symbol1, symbol2);
+  EXPECT_EQ("x", interner.Resolve(symbol1));
+  EXPECT_EQ("y", interner.Resolve(symbol2));
+}
+
+TEST(InternerTest, InternEmptyText) {
+  orion::syntax::Interner interner;
+
+  const orion::syntax::Symbol symbol = interner.Intern(std::string_view());
+
+  EXPECT_TRUE(symbol.IsEmpty());
+  EXPECT_EQ(orion::syntax::Symbol(), symbol);
+  EXPECT_EQ("", interner.Resolve(symbol));
+  EXPECT_EQ(0, interner.Width(symbol));
+  EXPECT_EQ(0, interner.Size());
+}
+
+TEST(InternerTest, InternUtf32StoresUtf8) {
+  orion::syntax::Interner interner;
+
+  const orion::syntax::Symbol utf32 =
+      interner.Intern(std::u32string_view(U"🍕a"));
+  const orion::syntax::Symbol utf8 =
+      interner.Intern(std::string_view("\xF0\x9F\x8D\x95" "a"));
+
+  EXPECT_EQ(utf32, utf8);
+  EXPECT_EQ(5, interner.Resolve(utf32).size());
+  EXPECT_EQ(2, interner.Width(utf32));
+}
+
+TEST(InternerTest, ResolveSurvivesGrowth) {
+  orion::syntax::Interner interner;
+
+  const orion::syntax::Symbol first =
+      interner.Intern(std::string_view("first"));
+  const std::string_view text = interner.Resolve(first);
+
+  for (int i = 0; i < 100000; ++i) {
+    (void)interner.Intern(std::to_string(i));
+  }
+
+  EXPECT_EQ(100001, interner.Size());
+  EXPECT_EQ(text.data(), interner.Resolve(first).data());
+  EXPECT_EQ(first, interner.Intern(std::string_view("first")));
+  EXPECT_EQ("99999", interner.Resolve(interner.Intern(std::string("99999"))));
+}
+
+TEST(InternerTest, ClearForgetsEverything) {
+  orion::syntax::Interner interner;
+  for (int i = 0; i < 1000; ++i) {
+    (void)interner.Intern(std::to_string(i));
+  }
+
+  orion::syntax::Interner::Owner owner(interner);
+  owner.Clear();
+
+  EXPECT_EQ(0, interner.Size());
+  EXPECT_EQ(0, interner.Bytes());
+  const orion::syntax::Symbol symbol = interner.Intern(std::string_view("7"));
+  EXPECT_EQ("7", interner.Resolve(symbol));
+  EXPECT_EQ(1, interner.Size());
+}
+
+TEST(InternerTest, AllowsOneOwnerAtATime) {
+  orion::syntax::Interner interner;
+  EXPECT_FALSE(interner.Owned());
+
+  {
+    const orion::syntax::Interner::Owner owner(interner);
+    EXPECT_TRUE(interner.Owned());
+    EXPECT_THROW(orion::syntax::Interner::Owner second(interner),
+                 std::logic_error);
+  }
+
+  EXPECT_FALSE(interner.Owned());
+  const orion::syntax::Interner::Owner owner(interner);
+  EXPECT_TRUE(interner.Owned());
+}
+
+TEST(InternerTest, InternFromManyThreads) {
+  orion::syntax::Interner interner;
+  constexpr int kThreads = 8;
+  constexpr int kSymbols = 1000;
+
+  std::vector<std::vector<orion::syntax::Symbol>> symbols(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kSymbols; ++i) {
+        symbols[t].push_back(interner.Intern(std::to_string(i)));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  // Every thread observes the same symbol for the same text.
+  EXPECT_EQ(kSymbols, interner.Size());
+  for (int t = 1; t < kThreads; ++t) {
+    EXPECT_EQ(symbols[0], symbols[t]);
+  }
+}
+}  // namespace
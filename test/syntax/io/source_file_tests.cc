@@ -0,0 +1,85 @@
+#include "syntax/io/source_file.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "syntax/testing/temp_file.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+using orion::syntax::SourceFile;
+using orion::syntax::test::WriteFile;
+
+TEST(SourceFileTest, ReadsPlainText) {
+  const SourceFile file =
+      SourceFile::Open(WriteFile("source_file_plain.or", "1 + 2\n"));
+
+  EXPECT_FALSE(file.HasBom());
+  EXPECT_EQ("1 + 2\n", file.Text());
+  EXPECT_EQ(file.Bytes(), file.Text());
+  EXPECT_FALSE(file.InvalidUtf8Offset().has_value());
+  EXPECT_TRUE(file.CrlfOffsets().empty());
+  EXPECT_TRUE(file.Diagnostics().empty());
+  EXPECT_EQ(U"1 + 2\n", file.Decode());
+}
+
+TEST(SourceFileTest, SkipsByteOrderMark) {
+  const SourceFile file = SourceFile::Open(
+      WriteFile("source_file_bom.or", "\xEF\xBB\xBF" "a\xC3\xA9"));
+
+  EXPECT_TRUE(file.HasBom());
+  EXPECT_EQ(6, file.Bytes().size());
+  EXPECT_EQ("a\xC3\xA9", file.Text());
+  EXPECT_EQ(U"aé", file.Decode());
+}
+
+TEST(SourceFileTest, RecordsCrlfLineBreaks) {
+  const SourceFile file = SourceFile::Open(
+      WriteFile("source_file_crlf.or", "a\r\nb\rc\n\r\n\r"));
+
+  const std::vector<size_t> expected = {1, 7};
+  EXPECT_EQ(expected, std::vector<size_t>(file.CrlfOffsets().begin(),
+                                          file.CrlfOffsets().end()));
+  EXPECT_EQ(U"a\r\nb\rc\n\r\n\r", file.Decode());
+}
+
+TEST(SourceFileTest, ReportsMalformedUtf8InCodePoints) {
+  const SourceFile file = SourceFile::Open(
+      WriteFile("source_file_invalid.or", "\xC3\xA9 + \xC0\xAF + \xFF"));
+
+  ASSERT_TRUE(file.InvalidUtf8Offset().has_value());
+  EXPECT_EQ(5, *file.InvalidUtf8Offset());
+
+  const std::vector<orion::syntax::Diagnostic> diagnostics =
+      file.Diagnostics();
+  ASSERT_EQ(1, diagnostics.size());
+  EXPECT_EQ(orion::syntax::TextRange(orion::syntax::TextSize(4),
+                                     orion::syntax::TextSize(5)),
+            diagnostics[0].range);
+  EXPECT_EQ("invalid UTF-8", diagnostics[0].message);
+}
+
+TEST(SourceFileTest, OpensEmptyFiles) {
+  const SourceFile file =
+      SourceFile::Open(WriteFile("source_file_empty.or", ""));
+
+  EXPECT_TRUE(file.Bytes().empty());
+  EXPECT_FALSE(file.HasBom());
+  EXPECT_FALSE(file.InvalidUtf8Offset().has_value());
+  EXPECT_TRUE(file.Decode().empty());
+}
+
+TEST(SourceFileTest, ThrowsForMissingFiles) {
+  EXPECT_THROW(SourceFile::Open(std::filesystem::path(testing::TempDir()) /
+                                "source_file_missing.or"),
+               std::system_error);
+}
+}  // namespace
@@ -2,17 +2,22 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "syntax/lexer/lexer.h"
 #include "syntax/lexer/span.h"
 #include "syntax/lexer/token_kind.h"
+#include "syntax/text/text_size.h"
 
 namespace orion::syntax {
 std::optional<Token> BuildToken(const TokenKind kind, const size_t start,
                                 const size_t stop,
                                 const std::u32string& source) {
   return std::make_optional(
-      Token(static_cast<uint16_t>(kind), Span(start, stop), source));
+      Token(static_cast<uint16_t>(kind),
+            Span(TextSize::Of(start), TextSize::Of(stop)), source));
 }
 
 std::optional<Token> BuildToken(const TokenKind kind,
@@ -44,6 +49,10 @@ INSTANTIATE_TEST_SUITE_P(
         SingleTokenTestCase{orion::syntax::TokenKind::kSlash, U"/", "Slash"},
         SingleTokenTestCase{orion::syntax::TokenKind::kPercent, U"%",
                             "Percent"},
+        SingleTokenTestCase{orion::syntax::TokenKind::kLParen, U"(",
+                            "LParen"},
+        SingleTokenTestCase{orion::syntax::TokenKind::kRParen, U")",
+                            "RParen"},
 
         // Identifiers
         SingleTokenTestCase{orion::syntax::TokenKind::kIdentifier, U"_",
@@ -214,4 +223,96 @@ TEST(LexerTest, MultipleIntLit) {
   EXPECT_EQ(expected_2, lexer.TryNextToken());
   EXPECT_EQ(expected_3, lexer.TryNextToken());
 }
-}  // namespace
\ No newline at end of file
+
+TEST(LexerTest, EndOfInput) {
+  auto lexer = orion::syntax::Lexer(U"1");
+  EXPECT_TRUE(lexer.TryNextToken().has_value());
+  EXPECT_EQ(std::nullopt, lexer.TryNextToken());
+}
+
+TEST(LexerTest, Tokenize) {
+  auto lexer = orion::syntax::Lexer(U"1 + x");
+  const std::vector<orion::syntax::Token> tokens = lexer.Tokenize();
+
+  ASSERT_EQ(5, tokens.size());
+  EXPECT_EQ(orion::syntax::TokenKind::kPlus,
+            tokens[2].GetKind<orion::syntax::TokenKind>());
+  EXPECT_EQ(orion::syntax::TokenKind::kIdentifier,
+            tokens[4].GetKind<orion::syntax::TokenKind>());
+}
+
+TEST(LexerTest, TokenizeWrapsUnknownCharacters) {
+  auto lexer = orion::syntax::Lexer(U"1 #$ 2");
+  const std::vector<orion::syntax::Token> tokens = lexer.Tokenize();
+
+  ASSERT_EQ(6, tokens.size());
+  EXPECT_EQ(orion::syntax::BuildToken(orion::syntax::TokenKind::kError, 2, 3,
+                                      U"#"),
+            tokens[2]);
+  EXPECT_EQ(orion::syntax::BuildToken(orion::syntax::TokenKind::kError, 3, 4,
+                                      U"$"),
+            tokens[3]);
+  ASSERT_EQ(2, lexer.Diagnostics().size());
+  EXPECT_EQ("unexpected character", lexer.Diagnostics()[0].message);
+  EXPECT_EQ(tokens[3].Span(), lexer.Diagnostics()[1].range);
+}
+
+TEST(LexerTest, TakesCrlfAsOneLineBreak) {
+  auto lexer = orion::syntax::Lexer(U"1\r\n\n\r\n2\r");
+  const std::vector<orion::syntax::Token> tokens = lexer.Tokenize();
+
+  ASSERT_EQ(4, tokens.size());
+  EXPECT_EQ(orion::syntax::BuildToken(orion::syntax::TokenKind::kNewline, 1, 6,
+                                      U"\r\n\n\r\n"),
+            tokens[1]);
+  // A lone carriage return is not a line break.
+  EXPECT_EQ(orion::syntax::TokenKind::kError,
+            tokens[3].GetKind<orion::syntax::TokenKind>());
+  ASSERT_EQ(1, lexer.Diagnostics().size());
+  EXPECT_EQ("unexpected character", lexer.Diagnostics()[0].message);
+}
+
+TEST(LexerTest, KeepsMalformedStringLiterals) {
+  auto unclosed = orion::syntax::Lexer(U"\"ab");
+  EXPECT_EQ(orion::syntax::BuildToken(orion::syntax::TokenKind::kStringLiteral,
+                                      0, 3, U"\"ab"),
+            unclosed.TryNextToken());
+  ASSERT_EQ(1, unclosed.Diagnostics().size());
+  EXPECT_EQ("unclosed string literal", unclosed.Diagnostics()[0].message);
+
+  auto escape = orion::syntax::Lexer(U"\"a\\qb\"");
+  EXPECT_EQ(orion::syntax::BuildToken(orion::syntax::TokenKind::kStringLiteral,
+                                      0, 6, U"\"a\\qb\""),
+            escape.TryNextToken());
+  ASSERT_EQ(1, escape.Diagnostics().size());
+  EXPECT_EQ("invalid escape sequence", escape.Diagnostics()[0].message);
+}
+
+TEST(LexerTest, NumbersStopBeforeIncompleteExponents) {
+  auto lexer = orion::syntax::Lexer(U"1e 2.");
+  const std::vector<orion::syntax::Token> tokens = lexer.Tokenize();
+
+  ASSERT_EQ(4, tokens.size());
+  EXPECT_EQ(orion::syntax::BuildToken(orion::syntax::TokenKind::kIntLiteral, 0,
+                                      1, U"1"),
+            tokens[0]);
+  EXPECT_EQ(orion::syntax::BuildToken(orion::syntax::TokenKind::kIdentifier, 1,
+                                      2, U"e"),
+            tokens[1]);
+  EXPECT_EQ(orion::syntax::BuildToken(orion::syntax::TokenKind::kFloatLiteral,
+                                      3, 5, U"2."),
+            tokens[3]);
+  EXPECT_TRUE(lexer.Diagnostics().empty());
+}
+
+// The lexer views its source, so it must not accept one about to be
+// destroyed.
+static_assert(std::is_constructible_v<orion::syntax::Lexer,
+                                      const std::u32string&>);
+static_assert(std::is_constructible_v<orion::syntax::Lexer,
+                                      std::u32string_view>);
+static_assert(std::is_constructible_v<orion::syntax::Lexer,
+                                      const char32_t (&)[4]>);
+static_assert(!std::is_constructible_v<orion::syntax::Lexer,
+                                       std::u32string&&>);
+}  // namespace
@@ -0,0 +1,132 @@
+#include "syntax/parser/build_green.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "syntax/lexer/span.h"
+#include "syntax/lexer/token.h"
+#include "syntax/parser/event_sink.h"
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+std::vector<orion::syntax::Token> Tokens(
+    const std::vector<std::u32string_view>& texts) {
+  std::vector<orion::syntax::Token> tokens;
+  orion::syntax::TextSize offset;
+  for (const std::u32string_view text : texts) {
+    const auto length = orion::syntax::TextSize::Of(text.size());
+    tokens.emplace_back(0, orion::syntax::Span::At(offset, length), text);
+    offset += length;
+  }
+  return tokens;
+}
+
+TEST(BuildGreenTest, BuildsNestedNodes) {
+  const auto tokens = Tokens({U"a", U"+", U"b"});
+  orion::syntax::EventSink sink;
+
+  const orion::syntax::Marker root = sink.Start();
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+  const orion::syntax::Marker inner = sink.Start();
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+  sink.Complete(inner, orion::syntax::SyntaxKind::kMinus);
+  sink.Complete(root, orion::syntax::SyntaxKind::kError);
+
+  const orion::syntax::GreenNode tree =
+      orion::syntax::BuildGreen(sink.Events(), tokens);
+
+  EXPECT_EQ(orion::syntax::SyntaxKind::kError, tree.Kind());
+  EXPECT_EQ(orion::syntax::TextSize(3), tree.Width());
+  ASSERT_EQ(2, tree.Children().size());
+  EXPECT_EQ(orion::syntax::SyntaxKind::kMinus,
+            tree.Children()[1].AsNode()->Kind());
+}
+
+TEST(BuildGreenTest, ForwardParentWrapsCompletedNode) {
+  // Mirrors parsing `a + b`: the left operand is completed before the binary
+  // node around it is known.
+  const auto tokens = Tokens({U"a", U"+", U"b"});
+  orion::syntax::EventSink sink;
+
+  const orion::syntax::Marker lhs = sink.Start();
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+  const orion::syntax::CompletedMarker completed =
+      sink.Complete(lhs, orion::syntax::SyntaxKind::kMinus);
+  const orion::syntax::Marker binary = sink.Precede(completed);
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+  sink.Complete(binary, orion::syntax::SyntaxKind::kError);
+
+  const orion::syntax::GreenNode tree =
+      orion::syntax::BuildGreen(sink.Events(), tokens);
+
+  EXPECT_EQ(orion::syntax::SyntaxKind::kError, tree.Kind());
+  ASSERT_EQ(3, tree.Children().size());
+  const orion::syntax::GreenNode* operand = tree.Children()[0].AsNode();
+  ASSERT_NE(nullptr, operand);
+  EXPECT_EQ(orion::syntax::SyntaxKind::kMinus, operand->Kind());
+  EXPECT_EQ(orion::syntax::TextSize(1), operand->Width());
+}
+
+TEST(BuildGreenTest, GluesMultipleLexerTokens) {
+  const auto tokens = Tokens({U"<", U"="});
+  orion::syntax::EventSink sink;
+
+  const orion::syntax::Marker root = sink.Start();
+  sink.Token(orion::syntax::SyntaxKind::kPlus, 2);
+  sink.Complete(root, orion::syntax::SyntaxKind::kError);
+
+  const orion::syntax::GreenNode tree =
+      orion::syntax::BuildGreen(sink.Events(), tokens);
+
+  ASSERT_EQ(1, tree.Children().size());
+  EXPECT_EQ("<=", tree.Children()[0].AsToken()->Text());
+}
+
+TEST(BuildGreenTest, ReusesBuilderAndCache) {
+  const auto tokens = Tokens({U"a"});
+  orion::syntax::EventSink sink;
+  const orion::syntax::Marker root = sink.Start();
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+  sink.Complete(root, orion::syntax::SyntaxKind::kError);
+
+  orion::syntax::GreenBuilder builder;
+  const orion::syntax::GreenNode first =
+      orion::syntax::BuildGreen(sink.Events(), tokens, builder);
+  const orion::syntax::GreenNode second =
+      orion::syntax::BuildGreen(sink.Events(), tokens, builder);
+
+  EXPECT_EQ(first, second);
+}
+
+TEST(BuildGreenTest, ThrowsWhenTokensRunOut) {
+  const auto tokens = Tokens({U"a"});
+  orion::syntax::EventSink sink;
+  const orion::syntax::Marker root = sink.Start();
+  sink.Token(orion::syntax::SyntaxKind::kPlus, 2);
+  sink.Complete(root, orion::syntax::SyntaxKind::kError);
+
+  EXPECT_THROW((void)orion::syntax::BuildGreen(sink.Events(), tokens),
+               std::invalid_argument);
+}
+
+TEST(BuildGreenTest, ThrowsOnSeveralRoots) {
+  const auto tokens = Tokens({U"a", U"b"});
+  orion::syntax::EventSink sink;
+  for (int i = 0; i < 2; ++i) {
+    const orion::syntax::Marker root = sink.Start();
+    sink.Token(orion::syntax::SyntaxKind::kPlus);
+    sink.Complete(root, orion::syntax::SyntaxKind::kError);
+  }
+
+  EXPECT_THROW((void)orion::syntax::BuildGreen(sink.Events(), tokens),
+               std::invalid_argument);
+}
+}  // namespace
@@ -0,0 +1,77 @@
+#include "syntax/parser/event_sink.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "syntax/parser/event.h"
+#include "syntax/parser/syntax_kind.h"
+
+namespace {
+TEST(EventSinkTest, CompleteRecordsStartAndFinish) {
+  orion::syntax::EventSink sink;
+
+  const orion::syntax::Marker marker = sink.Start();
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+  sink.Complete(marker, orion::syntax::SyntaxKind::kError);
+
+  const auto events = sink.Events();
+  ASSERT_EQ(3, events.size());
+  EXPECT_EQ(orion::syntax::EventKind::kStart, events[0].kind);
+  EXPECT_EQ(orion::syntax::SyntaxKind::kError, events[0].syntax_kind);
+  EXPECT_EQ(orion::syntax::EventKind::kToken, events[1].kind);
+  EXPECT_EQ(1, events[1].token_count);
+  EXPECT_EQ(orion::syntax::EventKind::kFinish, events[2].kind);
+}
+
+TEST(EventSinkTest, AbandonTrailingMarkerDropsIt) {
+  orion::syntax::EventSink sink;
+
+  sink.Abandon(sink.Start());
+
+  EXPECT_TRUE(sink.Events().empty());
+}
+
+TEST(EventSinkTest, AbandonInnerMarkerLeavesTombstone) {
+  orion::syntax::EventSink sink;
+
+  const orion::syntax::Marker marker = sink.Start();
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+  sink.Abandon(marker);
+
+  ASSERT_EQ(2, sink.Events().size());
+  EXPECT_EQ(orion::syntax::EventKind::kTombstone, sink.Events()[0].kind);
+}
+
+TEST(EventSinkTest, PrecedeLinksForwardParent) {
+  orion::syntax::EventSink sink;
+
+  const orion::syntax::Marker inner = sink.Start();
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+  const orion::syntax::CompletedMarker completed =
+      sink.Complete(inner, orion::syntax::SyntaxKind::kMinus);
+  const orion::syntax::Marker outer = sink.Precede(completed);
+
+  EXPECT_EQ(3, outer.Position());
+  EXPECT_EQ(3, sink.Events()[0].forward_parent);
+}
+
+TEST(EventSinkTest, CompleteTwiceThrows) {
+  orion::syntax::EventSink sink;
+
+  const orion::syntax::Marker marker = sink.Start();
+  sink.Complete(marker, orion::syntax::SyntaxKind::kError);
+
+  EXPECT_THROW(sink.Complete(marker, orion::syntax::SyntaxKind::kError),
+               std::invalid_argument);
+}
+
+TEST(EventSinkTest, ClearKeepsCapacityForReuse) {
+  orion::syntax::EventSink sink;
+  sink.Token(orion::syntax::SyntaxKind::kPlus);
+
+  sink.Clear();
+
+  EXPECT_TRUE(sink.Events().empty());
+}
+}  // namespace
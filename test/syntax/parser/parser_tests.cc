@@ -0,0 +1,238 @@
+#include "syntax/parser/parser.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+
+#include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+using orion::syntax::Diagnostic;
+using orion::syntax::GreenElement;
+using orion::syntax::GreenNode;
+using orion::syntax::ParseExpression;
+using orion::syntax::SyntaxKind;
+using orion::syntax::TextSize;
+
+std::string NodeName(const SyntaxKind kind) {
+  switch (kind) {
+    case SyntaxKind::kLiteral:
+      return "lit";
+    case SyntaxKind::kNameRef:
+      return "name";
+    case SyntaxKind::kPrefixExpr:
+      return "prefix";
+    case SyntaxKind::kBinaryExpr:
+      return "bin";
+    case SyntaxKind::kParenExpr:
+      return "paren";
+    case SyntaxKind::kError:
+      return "error";
+    case SyntaxKind::kRoot:
+      return "root";
+    default:
+      return "?";
+  }
+}
+
+// Prints a tree as nested lists, leaving out whitespace.
+std::string Dump(const GreenElement& element) {
+  if (const GreenNode* node = element.AsNode(); node != nullptr) {
+    std::string out = "(" + NodeName(node->Kind());
+    for (const GreenElement& child : node->Children()) {
+      const std::string text = Dump(child);
+      if (!text.empty()) {
+        out += " " + text;
+      }
+    }
+    return out + ")";
+  }
+
+  const orion::syntax::GreenToken& token = *element.AsToken();
+  return token.Kind() == SyntaxKind::kWhitespace ? ""
+                                                 : std::string(token.Text());
+}
+
+std::string Parse(const std::u32string& source) {
+  return Dump(ParseExpression(source).root);
+}
+
+// Prints the diagnostics of a parse as `start..end: message` lines.
+std::string Errors(const std::u32string& source) {
+  std::string out;
+  for (const Diagnostic& diagnostic : ParseExpression(source).diagnostics) {
+    out += std::to_string(static_cast<size_t>(diagnostic.range.Start())) +
+           ".." + std::to_string(static_cast<size_t>(diagnostic.range.End())) +
+           ": " + std::string(diagnostic.message) + "\n";
+  }
+  return out;
+}
+
+TEST(ParserTest, ParsesOperands) {
+  EXPECT_EQ("(root (lit 1))", Parse(U"1"));
+  EXPECT_EQ("(root (name x))", Parse(U"x"));
+  EXPECT_EQ("(root (lit \"s\"))", Parse(U"\"s\""));
+  EXPECT_EQ("(root (lit true))", Parse(U"true"));
+}
+
+TEST(ParserTest, InfixIsLeftAssociative) {
+  EXPECT_EQ("(root (bin (bin (lit 1) - (lit 2)) - (lit 3)))",
+            Parse(U"1 - 2 - 3"));
+  EXPECT_EQ("(root (bin (bin (lit 1) / (lit 2)) % (lit 3)))",
+            Parse(U"1 / 2 % 3"));
+}
+
+TEST(ParserTest, MultiplicationBindsTighter) {
+  EXPECT_EQ("(root (bin (lit 1) + (bin (lit 2) * (lit 3))))",
+            Parse(U"1 + 2 * 3"));
+  EXPECT_EQ("(root (bin (bin (bin (lit 1) * (lit 2)) + (lit 3)) - (lit 4)))",
+            Parse(U"1 * 2 + 3 - 4"));
+  EXPECT_EQ("(root (bin (bin (lit 1) + (bin (lit 2) * (lit 3))) + (lit 4)))",
+            Parse(U"1 + 2 * 3 + 4"));
+}
+
+TEST(ParserTest, PrefixOperatorsTakeOneOperand) {
+  EXPECT_EQ("(root (bin (prefix - (lit 1)) * (lit 2)))", Parse(U"-1 * 2"));
+  EXPECT_EQ("(root (bin (lit 1) - (prefix - (prefix + (name x)))))",
+            Parse(U"1 - - + x"));
+}
+
+TEST(ParserTest, KeepsTrivia) {
+  const std::u32string source = U"  1 +\n 2 ";
+  const GreenNode root = ParseExpression(source).root;
+
+  EXPECT_EQ(SyntaxKind::kRoot, root.Kind());
+  EXPECT_EQ(TextSize::Of(source.size()), root.Width());
+  EXPECT_EQ(SyntaxKind::kWhitespace, root.Children().front().AsToken()->Kind());
+  EXPECT_EQ(SyntaxKind::kWhitespace, root.Children().back().AsToken()->Kind());
+}
+
+TEST(ParserTest, ValidInputHasNoDiagnostics) {
+  EXPECT_EQ("", Errors(U"(1 + x) * -\"s\""));
+}
+
+TEST(ParserTest, ReportsMissingOperands) {
+  EXPECT_EQ("(root)", Parse(U""));
+  EXPECT_EQ("0..0: expected an operand\n", Errors(U""));
+
+  EXPECT_EQ("(root (bin (lit 1) +))", Parse(U"1 +"));
+  EXPECT_EQ("3..3: expected an operand\n", Errors(U"1 +"));
+
+  EXPECT_EQ("(root (bin * (lit 2)))", Parse(U"* 2"));
+  EXPECT_EQ("0..1: expected an operand\n", Errors(U"* 2"));
+
+  EXPECT_EQ("(root (bin (prefix -) * (lit 1)))", Parse(U"- * 1"));
+  EXPECT_EQ("2..3: expected an operand\n", Errors(U"- * 1"));
+}
+
+TEST(ParserTest, WrapsStrayExpressionsInErrorNodes) {
+  EXPECT_EQ("(root (lit 1) (error (bin (lit 2) * (lit 3))))",
+            Parse(U"1 2 * 3"));
+  EXPECT_EQ("2..3: expected an operator\n", Errors(U"1 2 * 3"));
+
+  EXPECT_EQ("(root (bin (lit 1) + (lit 2)) (error )))", Parse(U"1 + 2)"));
+  EXPECT_EQ("5..6: unmatched ')'\n", Errors(U"1 + 2)"));
+}
+
+TEST(ParserTest, RecoversInsideParentheses) {
+  EXPECT_EQ("(root (paren ( (bin (lit 1) + (lit 2))))", Parse(U"(1 + 2"));
+  EXPECT_EQ("6..6: expected ')'\n", Errors(U"(1 + 2"));
+
+  // The stray operand stays inside the group, which still closes.
+  EXPECT_EQ("(root (bin (paren ( (lit 1) (error (lit 2)) )) * (lit 3)))",
+            Parse(U"(1 2) * 3"));
+  EXPECT_EQ("3..4: expected an operator\n", Errors(U"(1 2) * 3"));
+
+  EXPECT_EQ("(root (bin (paren ( (bin (lit 1) +) )) + (lit 2)))",
+            Parse(U"(1 +) + 2"));
+}
+
+TEST(ParserTest, ReportsLexerErrorsOnce) {
+  EXPECT_EQ("(root (lit 1) (error #) (error (lit 2)))", Parse(U"1 # 2"));
+  EXPECT_EQ(
+      "2..3: unexpected character\n"
+      "4..5: expected an operator\n",
+      Errors(U"1 # 2"));
+
+  EXPECT_EQ("(root (bin (lit 1) + (error #)))", Parse(U"1 + #"));
+  EXPECT_EQ("4..5: unexpected character\n", Errors(U"1 + #"));
+}
+
+TEST(ParserTest, BrokenInputIsLossless) {
+  for (const std::u32string source :
+       {U"", U"  ", U"1 +", U")(", U"((1", U"1 2 3", U". + .", U"# $ %",
+        U"\"open", U"(1 + ) * (2", U" * / % "}) {
+    const orion::syntax::ParseResult parse = ParseExpression(source);
+
+    EXPECT_EQ(SyntaxKind::kRoot, parse.root.Kind());
+    EXPECT_EQ(TextSize::Of(source.size()), parse.root.Width());
+    EXPECT_FALSE(parse.diagnostics.empty());
+  }
+}
+
+TEST(ParserTest, ParsesLongChainsWithoutRecursion) {
+  constexpr size_t kTerms = 200'000;
+
+  std::u32string chain = U"1";
+  std::u32string prefixes;
+  for (size_t i = 1; i < kTerms; ++i) {
+    chain += U"+1";
+    prefixes += U"-";
+  }
+  prefixes += U"1";
+
+  const GreenNode sum = ParseExpression(chain).root;
+  EXPECT_EQ(TextSize::Of(chain.size()), sum.Width());
+  EXPECT_EQ(SyntaxKind::kBinaryExpr, sum.Children()[0].AsNode()->Kind());
+
+  const GreenNode negation = ParseExpression(prefixes).root;
+  EXPECT_EQ(TextSize::Of(prefixes.size()), negation.Width());
+  EXPECT_EQ(SyntaxKind::kPrefixExpr, negation.Children()[0].AsNode()->Kind());
+}
+
+TEST(ParserTest, ParsesDeepNestingWithoutRecursion) {
+  constexpr size_t kDepth = 100'000;
+
+  std::u32string source;
+  for (size_t i = 0; i < kDepth; ++i) {
+    source += U"-(1 * ";
+  }
+  source += U"x";
+  source.append(kDepth, U')');
+
+  // Each level nests a prefix, a group and a product.
+  orion::syntax::GreenBuilder builder;
+  const orion::syntax::ParseResult parse =
+      ParseExpression(source, builder, 3 * kDepth + 1);
+  EXPECT_TRUE(parse.diagnostics.empty());
+  EXPECT_EQ(TextSize::Of(source.size()), parse.root.Width());
+}
+
+TEST(ParserTest, SkipsOperandsNestedTooDeeply) {
+  const auto parse = [](const std::u32string& source) {
+    orion::syntax::GreenBuilder builder;
+    return ParseExpression(source, builder, 2);
+  };
+
+  const orion::syntax::ParseResult parens = parse(U"((((1) + 2)) * 3) - 4");
+  EXPECT_EQ(
+      "(root (bin (paren ( (bin (paren ( (error ( ( 1 ) + 2 )) )) * (lit 3)) "
+      ")) - (lit 4)))",
+      Dump(parens.root));
+  ASSERT_EQ(1, parens.diagnostics.size());
+  EXPECT_EQ("expression nested too deeply", parens.diagnostics[0].message);
+  EXPECT_EQ(TextSize(2), parens.diagnostics[0].range.Start());
+
+  const orion::syntax::ParseResult prefixes = parse(U"- - - -x + 1");
+  EXPECT_EQ("(root (bin (prefix - (prefix - (error - - x))) + (lit 1)))",
+            Dump(prefixes.root));
+  ASSERT_EQ(1, prefixes.diagnostics.size());
+}
+}  // namespace
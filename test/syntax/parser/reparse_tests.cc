@@ -0,0 +1,195 @@
+#include "syntax/parser/reparse.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "syntax/parser/parser.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_editor.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_text.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/diagnostic.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+#include "syntax/util/utf8.h"
+
+namespace {
+using orion::syntax::Diagnostic;
+using orion::syntax::GreenNode;
+using orion::syntax::ParseExpression;
+using orion::syntax::Reparse;
+using orion::syntax::SyntaxEdit;
+using orion::syntax::SyntaxKind;
+using orion::syntax::SyntaxNode;
+using orion::syntax::TextRange;
+using orion::syntax::TextSize;
+
+TextRange Range(const uint32_t start, const uint32_t end) {
+  return TextRange(TextSize(start), TextSize(end));
+}
+
+// Returns the `index`-th child node of `node`.
+GreenNode Child(const GreenNode& node, const size_t index) {
+  return *node.Children()[index].AsNode();
+}
+
+std::vector<Diagnostic> Diagnostics(const SyntaxNode& root) {
+  return ParseExpression(orion::syntax::DecodeUtf8(root.Text().ToString()))
+      .diagnostics;
+}
+
+// Applies an edit and checks that the result and its diagnostics match a
+// full parse of the new text.
+SyntaxEdit Edit(const SyntaxNode& root, const TextRange range,
+                const std::u32string& text) {
+  std::vector<Diagnostic> diagnostics = Diagnostics(root);
+  SyntaxEdit edit = Reparse(root, range, text, diagnostics);
+
+  const std::string source = edit.root.Text().ToString();
+  const orion::syntax::ParseResult expected =
+      ParseExpression(orion::syntax::DecodeUtf8(source));
+  EXPECT_EQ(expected.root.Hash(), edit.root.Green().Hash()) << source;
+  EXPECT_EQ(expected.diagnostics, diagnostics) << source;
+  return edit;
+}
+
+TEST(ReparseTest, RelexesOneToken) {
+  // (root (bin (paren ...) * (name foo)))
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"(1 + 2) * foo").root);
+
+  const SyntaxEdit edit = Edit(root, Range(13, 13), U"d");
+
+  EXPECT_EQ("(1 + 2) * food", edit.root.Text().ToString());
+  const GreenNode old_binary = Child(root.Green(), 0);
+  const GreenNode new_binary = Child(edit.root.Green(), 0);
+  EXPECT_NE(old_binary, new_binary);
+  EXPECT_EQ(Child(old_binary, 0), Child(new_binary, 0));
+  EXPECT_EQ(TextSize(14), edit.offsets.Map(TextSize(13)));
+}
+
+TEST(ReparseTest, RelexesTrivia) {
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"(1) + 2").root);
+
+  const SyntaxEdit edit = Edit(root, Range(3, 4), U"\t\t");
+
+  EXPECT_EQ("(1)\t\t+ 2", edit.root.Text().ToString());
+  EXPECT_EQ(Child(Child(root.Green(), 0), 0),
+            Child(Child(edit.root.Green(), 0), 0));
+}
+
+TEST(ReparseTest, ReparsesEnclosingParentheses) {
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"(1 + 2) * (3 + 4)").root);
+
+  const SyntaxEdit edit = Edit(root, Range(3, 4), U"*");
+
+  EXPECT_EQ("(1 * 2) * (3 + 4)", edit.root.Text().ToString());
+  const GreenNode old_binary = Child(root.Green(), 0);
+  const GreenNode new_binary = Child(edit.root.Green(), 0);
+  EXPECT_EQ(SyntaxKind::kParenExpr, Child(new_binary, 0).Kind());
+  EXPECT_NE(Child(old_binary, 0), Child(new_binary, 0));
+  EXPECT_EQ(Child(old_binary, 4), Child(new_binary, 4));
+}
+
+TEST(ReparseTest, ReparsesNestedParentheses) {
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"a + ((b) - c)").root);
+
+  const SyntaxEdit edit = Edit(root, Range(9, 10), U"% (d + e) *");
+
+  EXPECT_EQ("a + ((b) % (d + e) * c)", edit.root.Text().ToString());
+  EXPECT_EQ(Child(Child(root.Green(), 0), 0),
+            Child(Child(edit.root.Green(), 0), 0));
+}
+
+TEST(ReparseTest, FallsBackWhenTokensSplit) {
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"ab * 2").root);
+
+  const SyntaxEdit edit = Edit(root, Range(1, 1), U"+");
+
+  EXPECT_EQ("a+b * 2", edit.root.Text().ToString());
+  EXPECT_EQ(SyntaxKind::kBinaryExpr,
+            Child(Child(edit.root.Green(), 0), 2).Kind());
+}
+
+TEST(ReparseTest, FallsBackWhenKindChanges) {
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"1 + tru").root);
+
+  const SyntaxEdit edit = Edit(root, Range(7, 7), U"e");
+
+  EXPECT_EQ("1 + true", edit.root.Text().ToString());
+}
+
+TEST(ReparseTest, FallsBackWhenParenthesesDoNotBalance) {
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"(1) + (2)").root);
+
+  const SyntaxEdit edit = Edit(root, Range(1, 2), U"1) + (3");
+
+  EXPECT_EQ("(1) + (3) + (2)", edit.root.Text().ToString());
+}
+
+TEST(ReparseTest, FallsBackForUnclosedParentheses) {
+  // The missing `)` and operand are reported at the end, past the trivia.
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"(a+ \n").root);
+
+  const SyntaxEdit edit = Edit(root, Range(2, 3), U")");
+
+  EXPECT_EQ("(a) \n", edit.root.Text().ToString());
+}
+
+TEST(ReparseTest, MovesDiagnosticsOutsideTheEdit) {
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"(x) + 1 2").root);
+  std::vector<Diagnostic> diagnostics = Diagnostics(root);
+  ASSERT_EQ(1, diagnostics.size());
+
+  const SyntaxEdit edit = Reparse(root, Range(2, 2), U"y", diagnostics);
+
+  EXPECT_EQ("(xy) + 1 2", edit.root.Text().ToString());
+  EXPECT_EQ(Child(root.Green(), 2), Child(edit.root.Green(), 2));
+  ASSERT_EQ(1, diagnostics.size());
+  EXPECT_EQ(Range(9, 10), diagnostics[0].range);
+}
+
+TEST(ReparseTest, ReparsesEditsThatBreakTheSource) {
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"(1 + 2) * 3").root);
+
+  const SyntaxEdit edit = Edit(root, Range(5, 6), U"");
+
+  EXPECT_EQ("(1 + ) * 3", edit.root.Text().ToString());
+  EXPECT_EQ("(1 + ) + 3", Edit(edit.root, Range(7, 8), U"+")
+                              .root.Text()
+                              .ToString());
+}
+
+TEST(ReparseTest, ReparsesEditsThatFixTheSource) {
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(ParseExpression(U"(1 +) * 3").root);
+
+  const SyntaxEdit edit = Edit(root, Range(4, 4), U" 2");
+
+  EXPECT_EQ("(1 + 2) * 3", edit.root.Text().ToString());
+}
+
+TEST(ReparseTest, RejectsInvalidEdits) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(ParseExpression(U"(1)").root);
+  std::vector<Diagnostic> diagnostics;
+
+  EXPECT_THROW((void)Reparse(root, Range(2, 4), U"", diagnostics),
+               std::invalid_argument);
+  EXPECT_THROW(
+      (void)Reparse(*root.FirstChild(), Range(0, 1), U"", diagnostics),
+      std::invalid_argument);
+}
+}  // namespace
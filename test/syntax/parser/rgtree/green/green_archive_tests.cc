@@ -0,0 +1,195 @@
+#include "syntax/parser/rgtree/green/green_archive.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+constexpr uint64_t kTestContentHash = 0x0123456789abcdefULL;
+
+// Returns the message `FromBytes` rejects `bytes` with, or nothing if it
+// accepts them.
+std::string RejectionOf(const std::string& bytes) {
+  try {
+    (void)orion::syntax::GreenArchive::FromBytes(bytes);
+  } catch (const std::invalid_argument& e) {
+    return e.what();
+  }
+  return "";
+}
+
+// Applies `edit` to the record of type `Record` at `offset` in `bytes`.
+template <typename Record, typename Edit>
+std::string EditRecord(std::string bytes, const size_t offset, Edit edit) {
+  Record record;
+  std::memcpy(&record, bytes.data() + offset, sizeof(Record));
+  edit(record);
+  std::memcpy(bytes.data() + offset, &record, sizeof(Record));
+  return bytes;
+}
+
+// Builds `(a + bb) (a + bb)` where both operands are the same shared node.
+orion::syntax::GreenNode BuildSharedTree() {
+  const orion::syntax::GreenToken a(orion::syntax::SyntaxKind::kMinus, U"a");
+  const orion::syntax::GreenToken plus(orion::syntax::SyntaxKind::kPlus, U"+");
+  const orion::syntax::GreenToken bb(orion::syntax::SyntaxKind::kMinus,
+                                     U"bb");
+  const orion::syntax::GreenNode inner(orion::syntax::SyntaxKind::kError,
+                                       {a, plus, bb});
+  return orion::syntax::GreenNode(orion::syntax::SyntaxKind::kError,
+                                  {inner, inner});
+}
+
+TEST(GreenArchiveTest, RoundTripPreservesStructure) {
+  const orion::syntax::GreenNode root = BuildSharedTree();
+  const auto archive = orion::syntax::GreenArchive::FromBytes(
+      orion::syntax::SerializeGreenTree(root, kTestContentHash));
+
+  const orion::syntax::GreenNodeView view = archive.Root();
+  EXPECT_EQ(root.Kind(), view.Kind());
+  EXPECT_EQ(root.Width(), view.Width());
+  ASSERT_EQ(2, view.ChildCount());
+  EXPECT_EQ(orion::syntax::TextSize(4), view.ChildOffset(1));
+
+  const auto inner = view.Child(0).AsNode();
+  ASSERT_TRUE(inner.has_value());
+  ASSERT_EQ(3, inner->ChildCount());
+  EXPECT_EQ("bb", inner->Child(2).AsToken()->Text());
+  EXPECT_EQ(orion::syntax::SyntaxKind::kPlus,
+            inner->Child(1).AsToken()->Kind());
+}
+
+TEST(GreenArchiveTest, SharedNodesAreWrittenOnce) {
+  const auto archive = orion::syntax::GreenArchive::FromBytes(
+      orion::syntax::SerializeGreenTree(BuildSharedTree(), kTestContentHash));
+
+  EXPECT_EQ(2, archive.NodeCount());
+  EXPECT_EQ(3, archive.TokenCount());
+  EXPECT_EQ(archive.Root().Child(0).AsNode()->Id(),
+            archive.Root().Child(1).AsNode()->Id());
+}
+
+TEST(GreenArchiveTest, MaterializePreservesSharing) {
+  const orion::syntax::GreenNode root = BuildSharedTree();
+  const auto archive = orion::syntax::GreenArchive::FromBytes(
+      orion::syntax::SerializeGreenTree(root, kTestContentHash));
+
+  const orion::syntax::GreenNode rebuilt = archive.Materialize();
+  EXPECT_EQ(root.Width(), rebuilt.Width());
+  ASSERT_EQ(2, rebuilt.Children().size());
+  EXPECT_EQ(rebuilt.Children()[0], rebuilt.Children()[1]);
+  const orion::syntax::GreenNode* inner = rebuilt.Children()[0].AsNode();
+  ASSERT_NE(nullptr, inner);
+  EXPECT_EQ("a", inner->Children()[0].AsToken()->Text());
+}
+
+TEST(GreenArchiveTest, RoundTripsDeepTreesWithoutRecursion) {
+  constexpr size_t kDepth = 100'000;
+
+  orion::syntax::GreenNode root(
+      orion::syntax::SyntaxKind::kError,
+      {orion::syntax::GreenToken(orion::syntax::SyntaxKind::kMinus, U"a")});
+  for (size_t i = 0; i < kDepth; ++i) {
+    root = orion::syntax::GreenNode(orion::syntax::SyntaxKind::kError, {root});
+  }
+
+  const auto archive = orion::syntax::GreenArchive::FromBytes(
+      orion::syntax::SerializeGreenTree(root, kTestContentHash));
+  const orion::syntax::GreenNode rebuilt = archive.Materialize();
+  EXPECT_EQ(root.Hash(), rebuilt.Hash());
+  EXPECT_EQ(root.Width(), rebuilt.Width());
+}
+
+TEST(GreenArchiveTest, OpenMapsFile) {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "green_archive_test.ogrn";
+  orion::syntax::SaveGreenTree(path, BuildSharedTree(), kTestContentHash);
+
+  {
+    const auto archive = orion::syntax::GreenArchive::Open(path);
+    EXPECT_EQ(kTestContentHash, archive.ContentHash());
+    EXPECT_TRUE(orion::syntax::IsArchiveCurrent(archive, kTestContentHash));
+    EXPECT_FALSE(orion::syntax::IsArchiveCurrent(archive, 0));
+    EXPECT_EQ(orion::syntax::TextSize(8), archive.Root().Width());
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(GreenArchiveTest, RejectsCorruptInput) {
+  const std::string bytes =
+      orion::syntax::SerializeGreenTree(BuildSharedTree(), kTestContentHash);
+
+  EXPECT_THROW((void)orion::syntax::GreenArchive::FromBytes(bytes.substr(0, 8)),
+               std::invalid_argument);
+
+  std::string bad_magic = bytes;
+  bad_magic[0] = 'X';
+  EXPECT_THROW((void)orion::syntax::GreenArchive::FromBytes(bad_magic),
+               std::invalid_argument);
+
+  EXPECT_THROW(
+      (void)orion::syntax::GreenArchive::FromBytes(bytes + std::string(4, 0)),
+      std::invalid_argument);
+}
+
+TEST(GreenArchiveTest, RejectsKindsOutOfRange) {
+  using orion::syntax::GreenArchiveNode;
+  using orion::syntax::GreenArchiveToken;
+  const std::string bytes =
+      orion::syntax::SerializeGreenTree(BuildSharedTree(), kTestContentHash);
+  constexpr size_t kTokens = sizeof(orion::syntax::GreenArchiveHeader);
+  const size_t nodes = kTokens + 3 * sizeof(GreenArchiveToken);
+
+  EXPECT_NE(std::string::npos,
+            RejectionOf(EditRecord<GreenArchiveToken>(
+                            bytes, kTokens,
+                            [](GreenArchiveToken& token) {
+                              token.kind = orion::syntax::kSyntaxKindCount;
+                            }))
+                .find("token kind out of range"));
+  EXPECT_NE(std::string::npos,
+            RejectionOf(EditRecord<GreenArchiveNode>(
+                            bytes, nodes,
+                            [](GreenArchiveNode& node) { node.kind = 0xFFFF; }))
+                .find("node kind out of range"));
+}
+
+TEST(GreenArchiveTest, RejectsTokenWidthsThatDisagreeWithTheirText) {
+  using orion::syntax::GreenArchiveToken;
+  const std::string bytes =
+      orion::syntax::SerializeGreenTree(BuildSharedTree(), kTestContentHash);
+  ASSERT_EQ("", RejectionOf(bytes));
+
+  EXPECT_NE(std::string::npos,
+            RejectionOf(EditRecord<GreenArchiveToken>(
+                            bytes, sizeof(orion::syntax::GreenArchiveHeader),
+                            [](GreenArchiveToken& token) { ++token.width; }))
+                .find("token width mismatch"));
+}
+
+TEST(GreenArchiveTest, RejectsArchivesOfAnotherGrammar) {
+  using orion::syntax::GreenArchiveHeader;
+  const std::string bytes =
+      orion::syntax::SerializeGreenTree(BuildSharedTree(), kTestContentHash);
+
+  EXPECT_NE(std::string::npos,
+            RejectionOf(EditRecord<GreenArchiveHeader>(
+                            bytes, 0,
+                            [](GreenArchiveHeader& header) {
+                              header.grammar ^= 1;
+                            }))
+                .find("another grammar"));
+}
+}  // namespace
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "syntax/parser/rgtree/green/green_builder.h"
+#include "syntax/parser/rgtree/green/green_cache.h"
 #include "syntax/parser/rgtree/green/green_element.h"
 #include "syntax/parser/rgtree/green/green_node.h"
 #include "syntax/parser/rgtree/green/green_token.h"
@@ -33,4 +34,68 @@ TEST(GreenBuilderTest, FinishNodeThrowsWhenNoNodes) {
   auto builder = orion::syntax::GreenBuilder();
   EXPECT_THROW({ builder.FinishNode(); }, std::invalid_argument);
 }
+
+TEST(GreenBuilderTest, NestedNodesKeepSiblings) {
+  auto builder = orion::syntax::GreenBuilder();
+
+  builder.StartNode(kTestSyntaxKind);
+  builder.Token(orion::syntax::SyntaxKind::kPlus, U"+");
+  builder.StartNode(kTestSyntaxKind);
+  builder.Token(orion::syntax::SyntaxKind::kMinus, U"-");
+  builder.FinishNode();
+  builder.FinishNode();
+  const orion::syntax::GreenNode root = builder.Finish();
+
+  ASSERT_EQ(2, root.Children().size());
+  EXPECT_TRUE(root.Children()[0].IsToken());
+  EXPECT_TRUE(root.Children()[1].IsNode());
+}
+
+TEST(GreenBuilderTest, ResetDiscardsPartialTree) {
+  auto builder = orion::syntax::GreenBuilder();
+
+  builder.StartNode(kTestSyntaxKind);
+  builder.Token(orion::syntax::SyntaxKind::kPlus, U"+");
+  builder.Reset();
+
+  EXPECT_EQ(0, builder.ParentsSize());
+  EXPECT_EQ(0, builder.ChildrenSize());
+
+  builder.StartNode(kTestSyntaxKind);
+  builder.FinishNode();
+  EXPECT_EQ(0, builder.Finish().Children().size());
+}
+
+TEST(GreenBuilderTest, OwnedCacheUsesTheGivenPolicy) {
+  EXPECT_EQ(orion::syntax::NodeCachePolicy::kFixed,
+            orion::syntax::GreenBuilder().Cache().Policy());
+  EXPECT_EQ(orion::syntax::NodeCachePolicy::kAdaptive,
+            orion::syntax::GreenBuilder(
+                orion::syntax::NodeCachePolicy::kAdaptive)
+                .Cache()
+                .Policy());
+}
+
+TEST(GreenBuilderTest, ExternalCacheIsSharedAcrossBuilders) {
+  orion::syntax::GreenCache cache(orion::syntax::kMaxNodeSize);
+
+  const auto build = [&cache] {
+    orion::syntax::GreenBuilder builder(cache);
+    builder.StartNode(kTestSyntaxKind);
+    builder.Token(orion::syntax::SyntaxKind::kPlus, U"+");
+    builder.FinishNode();
+    return builder.Finish();
+  };
+
+  const orion::syntax::GreenNode first = build();
+  const orion::syntax::GreenNode second = build();
+
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(1, cache.TokenSize());
+}
+
+TEST(GreenBuilderTest, FinishThrowsWhenNothingWasBuilt) {
+  auto builder = orion::syntax::GreenBuilder();
+  EXPECT_THROW({ (void)builder.Finish(); }, std::invalid_argument);
+}
 }  // namespace
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "syntax/parser/rgtree/green/green_element.h"
 #include "syntax/parser/rgtree/green/green_node.h"
 #include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/rgtree/tree_reclaimer.h"
 #include "syntax/parser/syntax_kind.h"
 
 namespace {
@@ -192,4 +193,158 @@ TEST(GreenCacheTest, GetNodeDuplicateNodesOverMaxCacheSize) {
   EXPECT_EQ(1, cache.TokenSize());
   EXPECT_EQ(0, cache.NodeSize());
 }
-}  // namespace
\ No newline at end of file
+
+TEST(GreenCacheTest, GetTokenHitReturnsSameToken) {
+  auto cache = orion::syntax::GreenCache(kMaxCachedNodeSize);
+  auto [hash1, token1] = cache.GetToken(kTestSyntaxKind1, kTestSource1);
+  auto [hash2, token2] = cache.GetToken(kTestSyntaxKind1, kTestSource1);
+
+  // The second lookup returns the cached token rather than a new one.
+  EXPECT_EQ(hash1, hash2);
+  EXPECT_EQ(token1, token2);
+  EXPECT_EQ(3, token1.UseCount());
+  EXPECT_EQ(1, cache.TokenSize());
+}
+
+TEST(GreenCacheTest, GetNodeChildOrderMatters) {
+  auto cache = orion::syntax::GreenCache(kMaxCachedNodeSize);
+
+  const orion::syntax::CachedGreenElement entry1 =
+      cache.GetToken(kTestSyntaxKind1, kTestSource1);
+
+  const orion::syntax::CachedGreenElement entry2 =
+      cache.GetToken(kTestSyntaxKind2, kTestSource2);
+
+  auto children1 = std::vector{entry1, entry2};
+  auto children2 = std::vector{entry2, entry1};
+
+  auto [hash1, node1] =
+      cache.GetNode(orion::syntax::SyntaxKind::kError, children1, 0);
+  auto [hash2, node2] =
+      cache.GetNode(orion::syntax::SyntaxKind::kError, children2, 0);
+
+  // Swapping children must produce a distinct node.
+  EXPECT_NE(hash1, hash2);
+  EXPECT_NE(node1, node2);
+  EXPECT_EQ(2, cache.NodeSize());
+}
+
+std::vector<orion::syntax::CachedGreenElement> DistinctChildren(
+    orion::syntax::GreenCache& cache, const size_t count, const size_t seed) {
+  std::vector<orion::syntax::CachedGreenElement> children;
+  for (size_t i = 0; i < count; ++i) {
+    const std::u32string text(1 + (seed + i) % 7, U'a' + (seed + i) % 26);
+    children.push_back(cache.GetToken(kTestSyntaxKind1, text));
+  }
+  return children;
+}
+
+TEST(GreenCacheTest, StatsCountHitsAndMisses) {
+  auto cache = orion::syntax::GreenCache(kMaxCachedNodeSize);
+
+  for (int i = 0; i < 2; ++i) {
+    auto children = std::vector{cache.GetToken(kTestSyntaxKind1, kTestSource1)};
+    (void)cache.GetNode(orion::syntax::SyntaxKind::kError, children, 0);
+  }
+
+  const orion::syntax::GreenCacheStats& stats = cache.Stats();
+  EXPECT_EQ(2, stats.token_lookups);
+  EXPECT_EQ(1, stats.token_hits);
+  EXPECT_EQ(1, stats.token_misses);
+  EXPECT_EQ(2, stats.node_lookups);
+  EXPECT_EQ(1, stats.node_hits);
+  EXPECT_EQ(1, stats.node_misses);
+  EXPECT_EQ(0, stats.hash_collisions);
+  EXPECT_GT(stats.bytes_saved, 0);
+  EXPECT_EQ(2, stats.child_counts[1]);
+
+  cache.ResetStats();
+  EXPECT_EQ(0, cache.Stats().node_lookups);
+}
+
+TEST(GreenCacheTest, StatsCountSkippedLargeNodes) {
+  auto cache = orion::syntax::GreenCache(kMaxCachedNodeSize);
+  auto children = DistinctChildren(cache, kMaxCachedNodeSize + 1, 0);
+
+  (void)cache.GetNode(orion::syntax::SyntaxKind::kError, children, 0);
+
+  EXPECT_EQ(1, cache.Stats().node_skips);
+  EXPECT_EQ(0, cache.NodeSize());
+}
+
+TEST(GreenCacheTest, AdaptivePolicyRaisesLimitForRepeatedNodes) {
+  auto cache = orion::syntax::GreenCache(
+      kMaxCachedNodeSize, orion::syntax::NodeCachePolicy::kAdaptive);
+  const size_t size = kMaxCachedNodeSize + 1;
+
+  // The same four-child node over and over: sampled lookups almost all hit.
+  for (int i = 0; i < 5000; ++i) {
+    auto children = DistinctChildren(cache, size, 0);
+    (void)cache.GetNode(orion::syntax::SyntaxKind::kError, children, 0);
+  }
+
+  EXPECT_GE(cache.MaxCachedNodeSize(orion::syntax::SyntaxKind::kError), size);
+  EXPECT_EQ(kMaxCachedNodeSize,
+            cache.MaxCachedNodeSize(orion::syntax::SyntaxKind::kPlus));
+}
+
+TEST(GreenCacheTest, AdaptivePolicyLowersLimitForUniqueNodes) {
+  auto cache = orion::syntax::GreenCache(
+      kMaxCachedNodeSize, orion::syntax::NodeCachePolicy::kAdaptive);
+
+  // Every three-child node is different, so lookups at the limit never hit.
+  for (size_t i = 0; i < 200; ++i) {
+    auto children = DistinctChildren(cache, kMaxCachedNodeSize, i * 3);
+    (void)cache.GetNode(orion::syntax::SyntaxKind::kError, children, 0);
+  }
+
+  EXPECT_LT(cache.MaxCachedNodeSize(orion::syntax::SyntaxKind::kError),
+            kMaxCachedNodeSize);
+}
+
+TEST(GreenCacheTest, FixedPolicyNeverChangesLimit) {
+  auto cache = orion::syntax::GreenCache(kMaxCachedNodeSize);
+
+  for (size_t i = 0; i < 200; ++i) {
+    auto children = DistinctChildren(cache, kMaxCachedNodeSize, i * 3);
+    (void)cache.GetNode(orion::syntax::SyntaxKind::kError, children, 0);
+  }
+
+  EXPECT_EQ(kMaxCachedNodeSize,
+            cache.MaxCachedNodeSize(orion::syntax::SyntaxKind::kError));
+}
+
+TEST(GreenCacheTest, ClearReleasesCachedElements) {
+  auto cache = orion::syntax::GreenCache(kMaxCachedNodeSize);
+  EXPECT_EQ(0, cache.MemoryUsage());
+
+  auto [hash, token] = cache.GetToken(kTestSyntaxKind1, kTestSource1);
+  for (size_t i = 0; i < 100; ++i) {
+    auto children = DistinctChildren(cache, kMaxCachedNodeSize, i * 3);
+    (void)cache.GetNode(orion::syntax::SyntaxKind::kError, children, 0);
+  }
+  EXPECT_GT(cache.MemoryUsage(), 0);
+
+  cache.Clear();
+
+  EXPECT_EQ(0, cache.MemoryUsage());
+  EXPECT_EQ(0, cache.NodeSize());
+  EXPECT_EQ(0, cache.TokenSize());
+  // Only the token held here is still alive.
+  EXPECT_EQ(1, token.UseCount());
+}
+
+TEST(GreenCacheTest, ClearCanDeferReleasingElements) {
+  auto cache = orion::syntax::GreenCache(kMaxCachedNodeSize);
+  auto [hash, token] = cache.GetToken(kTestSyntaxKind1, kTestSource1);
+  EXPECT_EQ(2, token.UseCount());
+
+  orion::syntax::TreeReclaimer reclaimer;
+  cache.Clear(reclaimer);
+  EXPECT_EQ(0, cache.MemoryUsage());
+  EXPECT_EQ(0, cache.TokenSize());
+  reclaimer.Flush();
+
+  EXPECT_EQ(1, token.UseCount());
+}
+}  // namespace
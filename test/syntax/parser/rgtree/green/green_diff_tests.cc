@@ -0,0 +1,134 @@
+#include "syntax/parser/rgtree/green/green_diff.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+orion::syntax::GreenToken Token(const std::u32string& text) {
+  return orion::syntax::GreenToken(orion::syntax::SyntaxKind::kPlus, text);
+}
+
+orion::syntax::GreenNode Node(
+    std::vector<orion::syntax::GreenElement> children) {
+  return orion::syntax::GreenNode(orion::syntax::SyntaxKind::kError,
+                                  std::move(children));
+}
+
+orion::syntax::TextRange Range(const uint32_t start, const uint32_t end) {
+  return orion::syntax::TextRange(orion::syntax::TextSize(start),
+                                  orion::syntax::TextSize(end));
+}
+
+TEST(GreenDiffTest, SharedRootHasNoEdits) {
+  const orion::syntax::GreenNode root = Node({Token(U"a"), Token(U"b")});
+
+  EXPECT_TRUE(orion::syntax::GreenDiff(root, root).empty());
+}
+
+TEST(GreenDiffTest, StructurallyEqualTreesHaveNoEdits) {
+  // Built separately, so no data is shared.
+  const orion::syntax::GreenNode lhs = Node({Node({Token(U"a")}), Token(U"b")});
+  const orion::syntax::GreenNode rhs = Node({Node({Token(U"a")}), Token(U"b")});
+
+  EXPECT_EQ(lhs.Hash(), rhs.Hash());
+  EXPECT_TRUE(orion::syntax::GreenDiff(lhs, rhs).empty());
+}
+
+TEST(GreenDiffTest, ReplacedToken) {
+  const orion::syntax::GreenNode unchanged = Node({Token(U"xy")});
+  const orion::syntax::GreenNode lhs =
+      Node({unchanged, Node({Token(U"a"), Token(U"b")})});
+  const orion::syntax::GreenNode rhs =
+      Node({unchanged, Node({Token(U"a"), Token(U"cc")})});
+
+  const auto edits = orion::syntax::GreenDiff(lhs, rhs);
+  ASSERT_EQ(1, edits.size());
+  EXPECT_EQ(orion::syntax::GreenEditKind::kReplace, edits[0].kind);
+  EXPECT_EQ(Range(3, 4), edits[0].old_range);
+  EXPECT_EQ(Range(3, 5), edits[0].new_range);
+  EXPECT_EQ("b", edits[0].old_element.AsToken()->Text());
+  EXPECT_EQ("cc", edits[0].new_element.AsToken()->Text());
+}
+
+TEST(GreenDiffTest, InsertedChild) {
+  const orion::syntax::GreenNode lhs =
+      Node({Token(U"a"), Token(U"b"), Token(U"c")});
+  const orion::syntax::GreenNode rhs =
+      Node({Token(U"a"), Token(U"b"), Token(U"new"), Token(U"c")});
+
+  const auto edits = orion::syntax::GreenDiff(lhs, rhs);
+  ASSERT_EQ(1, edits.size());
+  EXPECT_EQ(orion::syntax::GreenEditKind::kInsert, edits[0].kind);
+  EXPECT_EQ(Range(2, 2), edits[0].old_range);
+  EXPECT_EQ(Range(2, 5), edits[0].new_range);
+}
+
+TEST(GreenDiffTest, DeletedChild) {
+  const orion::syntax::GreenNode lhs =
+      Node({Token(U"a"), Token(U"gone"), Token(U"b"), Token(U"c")});
+  const orion::syntax::GreenNode rhs = Node({Token(U"a"), Token(U"b"),
+                                             Token(U"c")});
+
+  const auto edits = orion::syntax::GreenDiff(lhs, rhs);
+  ASSERT_EQ(1, edits.size());
+  EXPECT_EQ(orion::syntax::GreenEditKind::kDelete, edits[0].kind);
+  EXPECT_EQ(Range(1, 5), edits[0].old_range);
+  EXPECT_EQ(Range(1, 1), edits[0].new_range);
+}
+
+TEST(GreenDiffTest, AlignsAroundChangesInTheMiddle) {
+  // A deletion near the start and a replacement near the end are reported
+  // separately rather than as replacements of every child in between.
+  const orion::syntax::GreenNode lhs = Node({Token(U"a"), Token(U"x"),
+                                             Token(U"b"), Token(U"c"),
+                                             Token(U"d"), Token(U"e")});
+  const orion::syntax::GreenNode rhs = Node(
+      {Token(U"a"), Token(U"b"), Token(U"c"), Token(U"D"), Token(U"e")});
+
+  const auto edits = orion::syntax::GreenDiff(lhs, rhs);
+  ASSERT_EQ(2, edits.size());
+  EXPECT_EQ(orion::syntax::GreenEditKind::kDelete, edits[0].kind);
+  EXPECT_EQ(Range(1, 2), edits[0].old_range);
+  EXPECT_EQ(orion::syntax::GreenEditKind::kReplace, edits[1].kind);
+  EXPECT_EQ(Range(4, 5), edits[1].old_range);
+  EXPECT_EQ(Range(3, 4), edits[1].new_range);
+}
+
+TEST(GreenDiffTest, KindChangeReplacesWholeNode) {
+  const orion::syntax::GreenNode lhs = Node({Node({Token(U"a")})});
+  const orion::syntax::GreenNode rhs = Node({orion::syntax::GreenNode(
+      orion::syntax::SyntaxKind::kMinus, {Token(U"a")})});
+
+  const auto edits = orion::syntax::GreenDiff(lhs, rhs);
+  ASSERT_EQ(1, edits.size());
+  EXPECT_EQ(orion::syntax::GreenEditKind::kReplace, edits[0].kind);
+  EXPECT_TRUE(edits[0].old_element.IsNode());
+}
+
+TEST(GreenDiffTest, DiffsDeepTreesWithoutRecursion) {
+  constexpr size_t kDepth = 100'000;
+
+  orion::syntax::GreenNode lhs = Node({Token(U"a")});
+  orion::syntax::GreenNode rhs = Node({Token(U"b")});
+  for (size_t i = 0; i < kDepth; ++i) {
+    lhs = Node({lhs});
+    rhs = Node({rhs});
+  }
+
+  const auto edits = orion::syntax::GreenDiff(lhs, rhs);
+  ASSERT_EQ(1, edits.size());
+  EXPECT_EQ(orion::syntax::GreenEditKind::kReplace, edits[0].kind);
+  EXPECT_EQ("a", edits[0].old_element.AsToken()->Text());
+}
+}  // namespace
@@ -0,0 +1,151 @@
+#include "syntax/parser/rgtree/green/green_node.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+constexpr orion::syntax::SyntaxKind kTestSyntaxKind =
+    orion::syntax::SyntaxKind::kError;
+
+orion::syntax::GreenNode BuildWideNode(const size_t count) {
+  std::vector<orion::syntax::GreenElement> children;
+  for (size_t i = 0; i < count; ++i) {
+    // Children alternate between widths of 1 and 2.
+    children.emplace_back(orion::syntax::GreenToken(
+        orion::syntax::SyntaxKind::kPlus, i % 2 == 0 ? U"a" : U"bb"));
+  }
+  return orion::syntax::GreenNode(kTestSyntaxKind, children);
+}
+
+TEST(GreenNodeTest, Width) {
+  const orion::syntax::GreenNode node = BuildWideNode(4);
+
+  EXPECT_EQ(orion::syntax::TextSize(6), node.Width());
+}
+
+TEST(GreenNodeTest, ChildOffsets) {
+  const orion::syntax::GreenNode node = BuildWideNode(4);
+
+  EXPECT_EQ(orion::syntax::TextSize(0), node.ChildOffset(0));
+  EXPECT_EQ(orion::syntax::TextSize(1), node.ChildOffset(1));
+  EXPECT_EQ(orion::syntax::TextSize(3), node.ChildOffset(2));
+  EXPECT_EQ(orion::syntax::TextSize(4), node.ChildOffset(3));
+}
+
+TEST(GreenNodeTest, ChildAtOffset) {
+  const orion::syntax::GreenNode node = BuildWideNode(4);
+
+  EXPECT_EQ(0, node.ChildAtOffset(orion::syntax::TextSize(0))->index);
+  EXPECT_EQ(1, node.ChildAtOffset(orion::syntax::TextSize(1))->index);
+  EXPECT_EQ(1, node.ChildAtOffset(orion::syntax::TextSize(2))->index);
+  EXPECT_EQ(3, node.ChildAtOffset(orion::syntax::TextSize(5))->index);
+}
+
+TEST(GreenNodeTest, ChildAtOffsetPastEnd) {
+  const orion::syntax::GreenNode node = BuildWideNode(4);
+
+  EXPECT_FALSE(node.ChildAtOffset(orion::syntax::TextSize(6)).has_value());
+  EXPECT_FALSE(node.ChildAtOffset(orion::syntax::TextSize(100)).has_value());
+}
+
+TEST(GreenNodeTest, ChildAtOffsetWideNode) {
+  constexpr size_t kChildren = 10000;
+  const orion::syntax::GreenNode node = BuildWideNode(kChildren);
+
+  for (size_t i = 0; i < kChildren; ++i) {
+    const std::optional<orion::syntax::GreenChild> child =
+        node.ChildAtOffset(node.ChildOffset(i));
+    ASSERT_TRUE(child.has_value());
+    EXPECT_EQ(i, child->index);
+  }
+}
+
+TEST(GreenNodeTest, ChildrenWithOffsets) {
+  const orion::syntax::GreenNode node = BuildWideNode(5);
+
+  orion::syntax::TextSize expected_offset;
+  size_t expected_index = 0;
+  for (const orion::syntax::GreenChild child : node.ChildrenWithOffsets()) {
+    EXPECT_EQ(expected_index, child.index);
+    EXPECT_EQ(expected_offset, child.offset);
+    EXPECT_EQ(node.Children()[expected_index], child.element);
+    expected_offset += child.element.Width();
+    ++expected_index;
+  }
+
+  EXPECT_EQ(5, expected_index);
+  EXPECT_EQ(node.Width(), expected_offset);
+}
+TEST(GreenNodeTest, DeepTreeDestructsWithoutRecursion) {
+  // Deep enough to overflow the stack if each level were released by a
+  // nested destructor call.
+  constexpr size_t kDepth = 200000;
+
+  std::optional<orion::syntax::GreenNode> node = orion::syntax::GreenNode(
+      kTestSyntaxKind,
+      {orion::syntax::GreenToken(orion::syntax::SyntaxKind::kPlus, U"x")});
+  for (size_t i = 0; i < kDepth; ++i) {
+    node = orion::syntax::GreenNode(kTestSyntaxKind, {*node});
+  }
+
+  EXPECT_EQ(orion::syntax::TextSize(1), node->Width());
+  node.reset();
+}
+
+TEST(GreenNodeTest, DestructionKeepsSharedChildren) {
+  const orion::syntax::GreenNode shared = BuildWideNode(2);
+
+  std::optional<orion::syntax::GreenNode> parent =
+      orion::syntax::GreenNode(kTestSyntaxKind, {shared});
+  parent.reset();
+
+  ASSERT_EQ(2, shared.Children().size());
+  EXPECT_EQ(1, shared.UseCount());
+}
+
+TEST(GreenNodeTest, ChildrenAndOffsetsFollowTheNode) {
+  // An odd count leaves padding between the offsets and the children.
+  const orion::syntax::GreenNode node = BuildWideNode(3);
+
+  const auto* end = reinterpret_cast<const std::byte*>(&node.Data() + 1);
+  const auto* children =
+      reinterpret_cast<const std::byte*>(node.Children().data());
+  EXPECT_GE(children, end + 3 * sizeof(orion::syntax::TextSize));
+  EXPECT_LT(children, end + 3 * sizeof(orion::syntax::TextSize) +
+                          alignof(orion::syntax::GreenElement));
+  EXPECT_EQ(orion::syntax::TextSize(3), node.ChildOffset(2));
+  EXPECT_EQ(orion::syntax::TextSize(1), node.Children()[2].Width());
+}
+
+TEST(GreenNodeTest, RejectsEmptyChildren) {
+  EXPECT_THROW(orion::syntax::GreenNode(kTestSyntaxKind,
+                                        {orion::syntax::GreenElement()}),
+               std::invalid_argument);
+}
+
+TEST(GreenNodeTest, RejectsWidthPast32Bits) {
+  // Sharing each level's node twice doubles the width cheaply.
+  orion::syntax::GreenNode node(
+      kTestSyntaxKind,
+      {orion::syntax::GreenToken(orion::syntax::SyntaxKind::kPlus, U"a")});
+  for (int i = 0; i < 31; ++i) {
+    node = orion::syntax::GreenNode(kTestSyntaxKind, {node, node});
+  }
+  ASSERT_EQ(orion::syntax::TextSize(uint32_t{1} << 31), node.Width());
+
+  EXPECT_THROW(orion::syntax::GreenNode(kTestSyntaxKind, {node, node}),
+               std::overflow_error);
+}
+
+}  // namespace
@@ -0,0 +1,114 @@
+#include "syntax/parser/rgtree/green/green_preorder.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/rgtree/walk_event.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/testing/sample_trees.h"
+
+namespace {
+using orion::syntax::GreenElement;
+using orion::syntax::GreenNode;
+using orion::syntax::GreenPreorder;
+using orion::syntax::GreenPreorderWithTokens;
+using orion::syntax::GreenToken;
+using orion::syntax::GreenWalkItem;
+using orion::syntax::SyntaxKind;
+using orion::syntax::WalkEvent;
+using orion::syntax::test::NestedTree;
+
+// Renders events as "+kind@offset" and "-kind@offset".
+template <typename Walk>
+std::vector<std::string> Render(Walk& walk) {
+  std::vector<std::string> events;
+  for (const WalkEvent<GreenWalkItem>& event : walk) {
+    const GreenElement& element = *event.value.element;
+    std::string text = event.IsEnter() ? "+" : "-";
+    if (const GreenToken* token = element.AsToken(); token != nullptr) {
+      text += token->Text();
+    } else {
+      text += orion::syntax::KindName(element.AsNode()->Kind());
+    }
+    text += "@" + std::to_string(static_cast<size_t>(event.value.offset));
+    events.push_back(std::move(text));
+  }
+  return events;
+}
+
+TEST(GreenPreorderTest, VisitsNodesWithOffsets) {
+  const GreenNode root = NestedTree();
+  GreenPreorder walk = root.Preorder();
+
+  EXPECT_EQ((std::vector<std::string>{"+Error@0", "+Minus@0", "-Minus@0",
+                                      "+Plus@4", "-Plus@4", "-Error@0"}),
+            Render(walk));
+}
+
+TEST(GreenPreorderTest, VisitsTokens) {
+  const GreenNode root = NestedTree();
+  GreenPreorderWithTokens walk = root.PreorderWithTokens();
+
+  EXPECT_EQ((std::vector<std::string>{"+Error@0", "+Minus@0", "+a@0", "-a@0",
+                                      "+bc@1", "-bc@1", "-Minus@0", "+d@3",
+                                      "-d@3", "+Plus@4", "-Plus@4",
+                                      "-Error@0"}),
+            Render(walk));
+}
+
+TEST(GreenPreorderTest, SkipSubtreePrunesChildren) {
+  const GreenNode root = NestedTree();
+  GreenPreorderWithTokens walk = root.PreorderWithTokens();
+
+  std::vector<std::string> events;
+  for (const WalkEvent<GreenWalkItem>& event : walk) {
+    const GreenElement& element = *event.value.element;
+    if (event.IsEnter() && element.IsNode() &&
+        element.AsNode()->Kind() == SyntaxKind::kMinus) {
+      walk.SkipSubtree();
+    }
+    if (const GreenToken* token = element.AsToken(); token != nullptr) {
+      events.emplace_back(token->Text());
+    }
+  }
+
+  EXPECT_EQ((std::vector<std::string>{"d", "d"}), events);
+}
+
+TEST(GreenPreorderTest, SkippingRootEndsWalk) {
+  const GreenNode root = NestedTree();
+  GreenPreorder walk = root.Preorder();
+
+  size_t count = 0;
+  for ([[maybe_unused]] const WalkEvent<GreenWalkItem>& event : walk) {
+    walk.SkipSubtree();
+    ++count;
+  }
+
+  EXPECT_EQ(2, count);
+}
+
+TEST(GreenPreorderTest, WalksDeepTreesWithoutRecursion) {
+  constexpr size_t kDepth = 100000;
+
+  GreenNode green(SyntaxKind::kPlus, {GreenToken(SyntaxKind::kError, U"x")});
+  for (size_t i = 0; i < kDepth; ++i) {
+    green = GreenNode(SyntaxKind::kMinus, {green});
+  }
+
+  size_t enters = 0;
+  size_t leaves = 0;
+  for (const WalkEvent<GreenWalkItem>& event : green.PreorderWithTokens()) {
+    ++(event.IsEnter() ? enters : leaves);
+  }
+
+  EXPECT_EQ(kDepth + 2, enters);
+  EXPECT_EQ(kDepth + 2, leaves);
+}
+}  // namespace
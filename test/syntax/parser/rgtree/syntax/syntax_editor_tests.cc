@@ -0,0 +1,171 @@
+#include "syntax/parser/rgtree/syntax/syntax_editor.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/rgtree/syntax/syntax_element.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/syntax/syntax_preorder.h"
+#include "syntax/parser/rgtree/walk_event.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/testing/sample_trees.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+using orion::syntax::GreenElement;
+using orion::syntax::GreenNode;
+using orion::syntax::GreenToken;
+using orion::syntax::SyntaxEdit;
+using orion::syntax::SyntaxEditor;
+using orion::syntax::SyntaxElement;
+using orion::syntax::SyntaxKind;
+using orion::syntax::SyntaxNode;
+using orion::syntax::TextSize;
+using orion::syntax::WalkEvent;
+using orion::syntax::test::FlatTree;
+
+GreenToken Token(const std::u32string& text) {
+  return GreenToken(SyntaxKind::kError, text);
+}
+
+std::string Text(const SyntaxNode& node) {
+  std::string text;
+  for (const WalkEvent<SyntaxElement>& event : node.PreorderWithTokens()) {
+    if (event.IsEnter() && event.value.IsToken()) {
+      text += event.value.AsToken()->Text();
+    }
+  }
+  return text;
+}
+
+TEST(SyntaxEditorTest, ReplaceChildOfRoot) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+  const SyntaxEdit edit = root.ReplaceChild(0, Token(U"++"));
+
+  EXPECT_EQ("++a-bc", Text(edit.root));
+  EXPECT_EQ("+a-bc", Text(root));
+  EXPECT_EQ(TextSize(0), edit.offsets.Map(TextSize(0)));
+  EXPECT_EQ(TextSize(2), edit.offsets.Map(TextSize(1)));
+  EXPECT_EQ(TextSize(6), edit.offsets.Map(TextSize(5)));
+
+  // Untouched children are shared with the old tree.
+  const std::span<const GreenElement> old = root.Green().Children();
+  const std::span<const GreenElement> edited = edit.root.Green().Children();
+  for (size_t i = 1; i < old.size(); ++i) {
+    EXPECT_EQ(old[i], edited[i]);
+  }
+}
+
+TEST(SyntaxEditorTest, ReplaceChildRebuildsOnlyTheSpine) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+  const SyntaxEdit edit = root.LastChild()->ReplaceChild(0, Token(U"xyz"));
+
+  EXPECT_EQ("+a-xyz", Text(edit.root));
+  EXPECT_EQ(TextSize(3), edit.offsets.Map(TextSize(3)));
+  EXPECT_EQ(TextSize(6), edit.offsets.Map(TextSize(5)));
+
+  const std::span<const GreenElement> old = root.Green().Children();
+  const std::span<const GreenElement> edited = edit.root.Green().Children();
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(old[i], edited[i]);
+  }
+  EXPECT_NE(old[4], edited[4]);
+}
+
+TEST(SyntaxEditorTest, InsertChildren) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  const SyntaxEdit appended = root.InsertChildren(5, {Token(U"!")});
+  EXPECT_EQ("+a-bc!", Text(appended.root));
+  EXPECT_EQ(TextSize(4), appended.offsets.Map(TextSize(4)));
+
+  const SyntaxEdit inner =
+      root.FirstChild()->InsertChildren(0, {Token(U"("), Token(U"(")});
+  EXPECT_EQ("+((a-bc", Text(inner.root));
+  EXPECT_EQ(TextSize(3), inner.offsets.Map(TextSize(1)));
+}
+
+TEST(SyntaxEditorTest, RemoveChildren) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+  const SyntaxEdit edit = root.RemoveChildren(1, 2);
+
+  EXPECT_EQ("+bc", Text(edit.root));
+  EXPECT_EQ(3, edit.root.Green().Children().size());
+  EXPECT_EQ(TextSize(1), edit.offsets.Map(TextSize(2)));
+  EXPECT_EQ(TextSize(2), edit.offsets.Map(TextSize(4)));
+}
+
+TEST(SyntaxEditorTest, BatchesEditsIntoOneRebuild) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  SyntaxEditor editor(*root.FirstChild());
+  editor.ReplaceChild(*root.LastChild(), 0, Token(U"xyz"));
+  editor.RemoveChildren(root, 0, 1);
+  editor.ReplaceChild(*root.FirstChild(), 0, Token(U"AA"));
+  const SyntaxEdit edit = editor.Finish();
+
+  EXPECT_EQ("AA-xyz", Text(edit.root));
+  EXPECT_EQ(3, edit.offsets.Edits().size());
+  EXPECT_EQ(TextSize(0), edit.offsets.Map(TextSize(1)));
+  EXPECT_EQ(TextSize(2), edit.offsets.Map(TextSize(2)));
+  EXPECT_EQ(TextSize(6), edit.offsets.Map(TextSize(5)));
+
+  // The plus node between the edits is shared.
+  EXPECT_EQ(root.Green().Children()[3], edit.root.Green().Children()[2]);
+}
+
+TEST(SyntaxEditorTest, RejectsConflictingEdits) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  SyntaxEditor inside(root);
+  inside.RemoveChildren(root, 4, 1);
+  inside.ReplaceChild(*root.LastChild(), 0, Token(U"x"));
+  EXPECT_THROW(static_cast<void>(inside.Finish()), std::invalid_argument);
+
+  SyntaxEditor overlapping(root);
+  overlapping.RemoveChildren(root, 1, 2);
+  overlapping.ReplaceChild(root, 2, Token(U"x"));
+  EXPECT_THROW(static_cast<void>(overlapping.Finish()),
+               std::invalid_argument);
+}
+
+TEST(SyntaxEditorTest, RejectsInvalidEdits) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+  const SyntaxNode other = SyntaxNode::CreateRoot(FlatTree());
+
+  SyntaxEditor editor(root);
+  EXPECT_THROW(editor.ReplaceChild(other, 0, Token(U"x")),
+               std::invalid_argument);
+  EXPECT_THROW(editor.ReplaceChild(root, 5, Token(U"x")),
+               std::invalid_argument);
+  EXPECT_THROW(editor.RemoveChildren(root, 4, 2), std::invalid_argument);
+  EXPECT_THROW(editor.InsertChildren(root, 6, {}), std::invalid_argument);
+}
+
+TEST(SyntaxEditorTest, DeepEditRebuildsEveryAncestor) {
+  constexpr size_t kDepth = 1000;
+
+  GreenNode green(SyntaxKind::kPlus, {Token(U"x")});
+  for (size_t i = 0; i < kDepth; ++i) {
+    green = GreenNode(SyntaxKind::kMinus, {green, Token(U";")});
+  }
+  const SyntaxNode root = SyntaxNode::CreateRoot(green);
+
+  SyntaxNode leaf = root;
+  while (std::optional<SyntaxNode> child = leaf.FirstChild()) {
+    leaf = *child;
+  }
+  const SyntaxEdit edit = leaf.ReplaceChild(0, Token(U"yy"));
+
+  EXPECT_EQ(root.Green().Width() + TextSize(1), edit.root.Green().Width());
+  EXPECT_EQ(TextSize(kDepth + 2), edit.offsets.Map(TextSize::Of(kDepth + 1)));
+}
+}  // namespace
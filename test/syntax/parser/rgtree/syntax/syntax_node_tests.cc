@@ -0,0 +1,352 @@
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/rgtree/syntax/syntax_element.h"
+#include "syntax/parser/rgtree/syntax/syntax_node_data.h"
+#include "syntax/parser/rgtree/syntax/syntax_token.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/testing/sample_trees.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+using orion::syntax::GreenElement;
+using orion::syntax::GreenNode;
+using orion::syntax::GreenToken;
+using orion::syntax::SyntaxElement;
+using orion::syntax::SyntaxKind;
+using orion::syntax::SyntaxNode;
+using orion::syntax::SyntaxNodeData;
+using orion::syntax::SyntaxToken;
+using orion::syntax::TextRange;
+using orion::syntax::TextSize;
+using orion::syntax::TokenAtOffsetKind;
+using orion::syntax::TokensAtOffset;
+using orion::syntax::test::FlatTree;
+
+TextRange Range(const uint32_t start, const uint32_t end) {
+  return TextRange(TextSize(start), TextSize(end));
+}
+
+TEST(SyntaxNodeTest, RootHasNoParentOrSiblings) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  EXPECT_EQ(SyntaxKind::kError, root.Kind());
+  EXPECT_EQ(TextSize(0), root.Offset());
+  EXPECT_EQ(TextSize(5), root.Range().End());
+  EXPECT_FALSE(root.Parent().has_value());
+  EXPECT_FALSE(root.NextSibling().has_value());
+  EXPECT_FALSE(root.PrevSiblingOrToken().has_value());
+}
+
+TEST(SyntaxNodeTest, NavigatesChildNodes) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  const std::optional<SyntaxNode> first = root.FirstChild();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(SyntaxKind::kMinus, first->Kind());
+  EXPECT_EQ(1, first->IndexInParent());
+  EXPECT_EQ(TextSize(1), first->Offset());
+
+  const std::optional<SyntaxNode> second = first->NextSibling();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(SyntaxKind::kPlus, second->Kind());
+  EXPECT_EQ(TextSize(3), second->Offset());
+  EXPECT_FALSE(second->FirstChild().has_value());
+
+  const std::optional<SyntaxNode> last = root.LastChild();
+  ASSERT_TRUE(last.has_value());
+  EXPECT_EQ(TextSize(3), last->Offset());
+  EXPECT_EQ(4, last->IndexInParent());
+  EXPECT_EQ(*second, *last->PrevSibling());
+  EXPECT_FALSE(last->NextSibling().has_value());
+
+  EXPECT_EQ(root, *first->Parent());
+  EXPECT_FALSE(first->PrevSibling().has_value());
+}
+
+TEST(SyntaxNodeTest, NavigatesChildrenWithTokens) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  std::vector<SyntaxKind> kinds;
+  std::vector<size_t> offsets;
+  for (const SyntaxElement& child : root.ChildrenWithTokens()) {
+    kinds.push_back(child.Kind());
+    offsets.push_back(static_cast<size_t>(child.Offset()));
+    EXPECT_EQ(root, *child.Parent());
+  }
+
+  EXPECT_EQ((std::vector{SyntaxKind::kPlus, SyntaxKind::kMinus,
+                         SyntaxKind::kMinus, SyntaxKind::kPlus,
+                         SyntaxKind::kMinus}),
+            kinds);
+  EXPECT_EQ((std::vector<size_t>{0, 1, 2, 3, 3}), offsets);
+
+  const std::optional<SyntaxElement> plus = root.FirstChildOrToken();
+  ASSERT_TRUE(plus.has_value());
+  ASSERT_TRUE(plus->IsToken());
+  EXPECT_EQ("+", plus->AsToken()->Text());
+  EXPECT_TRUE(plus->NextSiblingOrToken()->IsNode());
+
+  const std::optional<SyntaxElement> last = root.LastChildOrToken();
+  ASSERT_TRUE(last.has_value());
+  EXPECT_TRUE(last->IsNode());
+  EXPECT_TRUE(last->PrevSiblingOrToken()->IsNode());
+}
+
+TEST(SyntaxNodeTest, TokenKnowsItsPosition) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+  const SyntaxNode bc = *root.LastChild();
+
+  const std::optional<SyntaxElement> element = bc.FirstChildOrToken();
+  ASSERT_TRUE(element.has_value());
+  const SyntaxToken token = *element->AsToken();
+
+  EXPECT_EQ("bc", token.Text());
+  EXPECT_EQ(TextSize(3), token.Range().Start());
+  EXPECT_EQ(TextSize(5), token.Range().End());
+  EXPECT_EQ(bc, token.Parent());
+  EXPECT_FALSE(token.NextSiblingOrToken().has_value());
+}
+
+TEST(SyntaxNodeTest, ChildrenSkipTokens) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  size_t count = 0;
+  for (const SyntaxNode& child : root.Children()) {
+    EXPECT_NE(SyntaxKind::kError, child.Kind());
+    ++count;
+  }
+  EXPECT_EQ(3, count);
+}
+
+TEST(SyntaxNodeTest, DescendantsArePreorder) {
+  const GreenNode leaf(SyntaxKind::kPlus, {});
+  const GreenNode inner(SyntaxKind::kMinus, {leaf, leaf});
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(GreenNode(SyntaxKind::kError, {inner, leaf}));
+
+  std::vector<SyntaxKind> kinds;
+  for (const SyntaxNode& node : root.Descendants()) {
+    kinds.push_back(node.Kind());
+  }
+
+  EXPECT_EQ((std::vector{SyntaxKind::kError, SyntaxKind::kMinus,
+                         SyntaxKind::kPlus, SyntaxKind::kPlus,
+                         SyntaxKind::kPlus}),
+            kinds);
+
+  // A walk from an inner node stays below it.
+  size_t count = 0;
+  for ([[maybe_unused]] const SyntaxNode& node :
+       root.FirstChild()->Descendants()) {
+    ++count;
+  }
+  EXPECT_EQ(3, count);
+}
+
+TEST(SyntaxNodeTest, AncestorsStartAtSelf) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+  const SyntaxNode child = *root.FirstChild();
+
+  std::vector<SyntaxKind> kinds;
+  for (const SyntaxNode& node : child.Ancestors()) {
+    kinds.push_back(node.Kind());
+  }
+
+  EXPECT_EQ((std::vector{SyntaxKind::kMinus, SyntaxKind::kError}), kinds);
+}
+
+TEST(SyntaxNodeTest, RepeatedWalksDoNotAllocate) {
+  std::vector<GreenElement> children;
+  for (size_t i = 0; i < 64; ++i) {
+    children.emplace_back(GreenNode(
+        SyntaxKind::kMinus, {GreenToken(SyntaxKind::kPlus, U"x")}));
+  }
+  const SyntaxNode root =
+      SyntaxNode::CreateRoot(GreenNode(SyntaxKind::kError, children));
+
+  const auto walk = [&root] {
+    size_t count = 0;
+    for (const SyntaxNode& node : root.Descendants()) {
+      for (const SyntaxElement& child : node.ChildrenWithTokens()) {
+        count += child.IsToken() ? 1 : 0;
+      }
+    }
+    return count;
+  };
+
+  // The first walk may fill the pool.
+  EXPECT_EQ(64, walk());
+
+  const uint64_t before = SyntaxNodeData::HeapAllocations();
+  EXPECT_EQ(64, walk());
+  EXPECT_EQ(before, SyntaxNodeData::HeapAllocations());
+}
+
+TEST(SyntaxNodeTest, DeepParentChainDestructsWithoutRecursion) {
+  constexpr size_t kDepth = 200000;
+
+  GreenNode green(SyntaxKind::kPlus, {});
+  for (size_t i = 0; i < kDepth; ++i) {
+    green = GreenNode(SyntaxKind::kMinus, {green});
+  }
+
+  // Only the deepest node is referenced, so dropping it frees every ancestor.
+  std::optional<SyntaxNode> node = SyntaxNode::CreateRoot(std::move(green));
+  size_t depth = 0;
+  while (std::optional<SyntaxNode> child = node->FirstChild()) {
+    node = std::move(child);
+    ++depth;
+  }
+  EXPECT_EQ(kDepth, depth);
+  EXPECT_EQ(SyntaxKind::kPlus, node->Kind());
+
+  node.reset();
+}
+
+TEST(SyntaxNodeTest, ReleasesHandlesAfterThreadPoolTeardown) {
+  std::thread thread([] {
+    // Constructed before the thread's data pool, so destroyed after it.
+    thread_local std::optional<SyntaxNode> held;
+    const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+    held = root.FirstChild();
+  });
+  thread.join();
+
+  EXPECT_EQ(SyntaxKind::kMinus,
+            SyntaxNode::CreateRoot(FlatTree()).FirstChild()->Kind());
+}
+
+TEST(SyntaxNodeTest, TokenAtOffsetInsideToken) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  const TokensAtOffset tokens = root.TokenAtOffset(TextSize(4));
+  ASSERT_EQ(TokenAtOffsetKind::kSingle, tokens.Kind());
+  EXPECT_EQ("bc", tokens.LeftBiased()->Text());
+  EXPECT_EQ(*tokens.LeftBiased(), *tokens.RightBiased());
+  EXPECT_EQ(SyntaxKind::kMinus, tokens.LeftBiased()->Parent().Kind());
+}
+
+TEST(SyntaxNodeTest, TokenAtOffsetOnBoundary) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  const TokensAtOffset between = root.TokenAtOffset(TextSize(1));
+  ASSERT_EQ(TokenAtOffsetKind::kBetween, between.Kind());
+  EXPECT_EQ("+", between.LeftBiased()->Text());
+  EXPECT_EQ("a", between.RightBiased()->Text());
+
+  // The empty node between "-" and "bc" is skipped.
+  const TokensAtOffset skipped = root.TokenAtOffset(TextSize(3));
+  ASSERT_EQ(TokenAtOffsetKind::kBetween, skipped.Kind());
+  EXPECT_EQ("-", skipped.LeftBiased()->Text());
+  EXPECT_EQ("bc", skipped.RightBiased()->Text());
+}
+
+TEST(SyntaxNodeTest, TokenAtOffsetAtEdges) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  const TokensAtOffset start = root.TokenAtOffset(TextSize(0));
+  ASSERT_EQ(TokenAtOffsetKind::kSingle, start.Kind());
+  EXPECT_EQ("+", start.LeftBiased()->Text());
+
+  const TokensAtOffset end = root.TokenAtOffset(TextSize(5));
+  ASSERT_EQ(TokenAtOffsetKind::kSingle, end.Kind());
+  EXPECT_EQ("bc", end.RightBiased()->Text());
+
+  EXPECT_EQ(TokenAtOffsetKind::kNone, root.TokenAtOffset(TextSize(6)).Kind());
+
+  const SyntaxNode empty =
+      SyntaxNode::CreateRoot(GreenNode(SyntaxKind::kError, {}));
+  EXPECT_EQ(TokenAtOffsetKind::kNone, empty.TokenAtOffset(TextSize(0)).Kind());
+}
+
+TEST(SyntaxNodeTest, CoveringElement) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  const SyntaxElement token = root.CoveringElement(Range(3, 5));
+  ASSERT_TRUE(token.IsToken());
+  EXPECT_EQ("bc", token.AsToken()->Text());
+
+  const SyntaxElement spanning = root.CoveringElement(Range(1, 3));
+  EXPECT_EQ(SyntaxElement(root), spanning);
+
+  const SyntaxElement inside = root.CoveringElement(Range(4, 4));
+  ASSERT_TRUE(inside.IsToken());
+  EXPECT_EQ("bc", inside.AsToken()->Text());
+
+  // An empty range on a boundary resolves to the left neighbour.
+  const SyntaxElement boundary = root.CoveringElement(Range(3, 3));
+  ASSERT_TRUE(boundary.IsToken());
+  EXPECT_EQ("-", boundary.AsToken()->Text());
+
+  EXPECT_THROW(static_cast<void>(root.CoveringElement(Range(0, 6))),
+               std::invalid_argument);
+}
+
+TEST(SyntaxNodeTest, CoveringElementFromInnerNode) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+  const SyntaxNode bc = *root.LastChild();
+
+  EXPECT_EQ(bc, *bc.CoveringElement(Range(3, 5)).Parent());
+  EXPECT_THROW(static_cast<void>(bc.CoveringElement(Range(2, 4))),
+               std::invalid_argument);
+}
+
+TEST(SyntaxNodeTest, QueriesDoNotAllocate) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+  static_cast<void>(root.TokenAtOffset(TextSize(3)));
+
+  const uint64_t before = SyntaxNodeData::HeapAllocations();
+  for (uint32_t raw = 0; raw <= 5; ++raw) {
+    const TextSize offset(raw);
+    static_cast<void>(root.TokenAtOffset(offset));
+    static_cast<void>(root.CoveringElement(TextRange::Empty(offset)));
+  }
+  EXPECT_EQ(before, SyntaxNodeData::HeapAllocations());
+}
+
+TEST(SyntaxNodeTest, DestructionKeepsSharedAncestors) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+
+  std::optional<SyntaxNode> child = root.FirstChild();
+  const SyntaxNode sibling = *child->NextSibling();
+  child.reset();
+
+  EXPECT_EQ(root, sibling.Parent());
+  EXPECT_EQ(TextSize(0), root.Offset());
+  EXPECT_FALSE(root.Parent().has_value());
+}
+
+TEST(SyntaxNodeTest, MovedFromHandlesStayValid) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(FlatTree());
+  SyntaxNode node = *root.FirstChild();
+  SyntaxToken token = *root.FirstChildOrToken()->AsToken();
+
+  const SyntaxNode moved_node = std::move(node);
+  const SyntaxToken moved_token = std::move(token);
+  // Reading from the moved-from handles is the point of the test.
+  const SyntaxNode node_copy = node;
+  const SyntaxToken token_copy = token;
+  SyntaxNode assigned = root;
+  assigned = node;
+
+  EXPECT_EQ(moved_node, node_copy);
+  EXPECT_EQ(moved_node, assigned);
+  EXPECT_EQ(moved_node, node);
+  EXPECT_EQ(moved_token, token_copy);
+  EXPECT_EQ(SyntaxKind::kMinus, node.Kind());
+}
+}  // namespace
@@ -0,0 +1,85 @@
+#include "syntax/parser/rgtree/syntax/syntax_preorder.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "syntax/parser/rgtree/syntax/syntax_element.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/rgtree/walk_event.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/testing/sample_trees.h"
+
+namespace {
+using orion::syntax::SyntaxElement;
+using orion::syntax::SyntaxKind;
+using orion::syntax::SyntaxNode;
+using orion::syntax::SyntaxPreorder;
+using orion::syntax::SyntaxPreorderWithTokens;
+using orion::syntax::WalkEvent;
+using orion::syntax::test::NestedTree;
+
+TEST(SyntaxPreorderTest, VisitsNodes) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(NestedTree());
+
+  std::vector<std::string> events;
+  for (const WalkEvent<SyntaxNode>& event : root.Preorder()) {
+    events.push_back(
+        (event.IsEnter() ? "+" : "-") +
+        std::string(orion::syntax::KindName(event.value.Kind())) + "@" +
+        std::to_string(static_cast<size_t>(event.value.Offset())));
+  }
+
+  EXPECT_EQ((std::vector<std::string>{"+Error@0", "+Minus@0", "-Minus@0",
+                                      "+Plus@4", "-Plus@4", "-Error@0"}),
+            events);
+}
+
+TEST(SyntaxPreorderTest, VisitsTokens) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(NestedTree());
+
+  std::vector<std::string> tokens;
+  size_t leaves = 0;
+  for (const WalkEvent<SyntaxElement>& event : root.PreorderWithTokens()) {
+    if (event.IsLeave()) {
+      ++leaves;
+    } else if (event.value.IsToken()) {
+      tokens.emplace_back(event.value.AsToken()->Text());
+    }
+  }
+
+  EXPECT_EQ((std::vector<std::string>{"a", "bc", "d"}), tokens);
+  EXPECT_EQ(6, leaves);
+}
+
+TEST(SyntaxPreorderTest, SkipSubtreePrunesChildren) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(NestedTree());
+  SyntaxPreorderWithTokens walk = root.PreorderWithTokens();
+
+  std::vector<std::string> tokens;
+  for (const WalkEvent<SyntaxElement>& event : walk) {
+    if (event.IsEnter() && event.value.Kind() == SyntaxKind::kMinus) {
+      walk.SkipSubtree();
+    }
+    if (event.IsEnter() && event.value.IsToken()) {
+      tokens.emplace_back(event.value.AsToken()->Text());
+    }
+  }
+
+  EXPECT_EQ((std::vector<std::string>{"d"}), tokens);
+}
+
+TEST(SyntaxPreorderTest, WalkFromInnerNodeStaysBelowIt) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(NestedTree());
+  SyntaxPreorder walk = root.FirstChild()->Preorder();
+
+  size_t count = 0;
+  for (const WalkEvent<SyntaxNode>& event : walk) {
+    EXPECT_EQ(SyntaxKind::kMinus, event.value.Kind());
+    ++count;
+  }
+
+  EXPECT_EQ(2, count);
+}
+}  // namespace
@@ -0,0 +1,118 @@
+#include "syntax/parser/rgtree/syntax/syntax_text.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/rgtree/syntax/syntax_node.h"
+#include "syntax/parser/syntax_kind.h"
+#include "syntax/testing/sample_trees.h"
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+using orion::syntax::GreenNode;
+using orion::syntax::GreenToken;
+using orion::syntax::SyntaxKind;
+using orion::syntax::SyntaxNode;
+using orion::syntax::SyntaxText;
+using orion::syntax::TextRange;
+using orion::syntax::TextSize;
+using orion::syntax::test::SplitTextTree;
+
+TextSize Size(const size_t value) { return TextSize::Of(value); }
+
+TEST(SyntaxTextTest, ToString) {
+  const SyntaxText text = SyntaxNode::CreateRoot(SplitTextTree()).Text();
+
+  EXPECT_EQ(Size(7), text.Len());
+  EXPECT_EQ("abcédéf", text.ToString());
+  EXPECT_EQ("déf", SyntaxNode::CreateRoot(SplitTextTree())
+                       .LastChild()
+                       ->Text()
+                       .ToString());
+}
+
+TEST(SyntaxTextTest, CharAt) {
+  const SyntaxText text = SyntaxNode::CreateRoot(SplitTextTree()).Text();
+
+  EXPECT_EQ(U'a', text.CharAt(Size(0)));
+  EXPECT_EQ(U'c', text.CharAt(Size(2)));
+  EXPECT_EQ(U'é', text.CharAt(Size(3)));
+  EXPECT_EQ(U'é', text.CharAt(Size(5)));
+  EXPECT_EQ(U'f', text.CharAt(Size(6)));
+  EXPECT_EQ(std::nullopt, text.CharAt(Size(7)));
+}
+
+TEST(SyntaxTextTest, FindAcrossTokens) {
+  const SyntaxText text = SyntaxNode::CreateRoot(SplitTextTree()).Text();
+
+  EXPECT_EQ(Size(0), text.Find(""));
+  EXPECT_EQ(Size(1), text.Find("bc"));
+  EXPECT_EQ(Size(3), text.Find("édé"));
+  EXPECT_EQ(Size(3), text.Find(U'é'));
+  EXPECT_EQ(std::nullopt, text.Find("ca"));
+  EXPECT_TRUE(text.Contains("abcédéf"));
+  EXPECT_TRUE(text.Contains(U'f'));
+  EXPECT_FALSE(text.Contains(U'g'));
+}
+
+TEST(SyntaxTextTest, FindRestartsPartialMatches) {
+  const SyntaxNode root = SyntaxNode::CreateRoot(
+      GreenNode(SyntaxKind::kError, {GreenToken(SyntaxKind::kError, U"aab"),
+                                     GreenToken(SyntaxKind::kError, U"aaab")}));
+
+  EXPECT_EQ(Size(3), root.Text().Find("aaab"));
+  EXPECT_EQ(Size(1), root.Text().Find("aba"));
+}
+
+TEST(SyntaxTextTest, Slice) {
+  const SyntaxText text = SyntaxNode::CreateRoot(SplitTextTree()).Text();
+
+  const SyntaxText middle = text.Slice(TextRange(Size(1), Size(6)));
+  EXPECT_EQ(TextRange(Size(1), Size(6)), middle.Range());
+  EXPECT_EQ("bcédé", middle.ToString());
+  EXPECT_EQ(U'c', middle.CharAt(Size(1)));
+  EXPECT_EQ(Size(2), middle.Find(U'é'));
+  EXPECT_FALSE(middle.Contains(U'f'));
+
+  const SyntaxText inner = middle.Slice(TextRange(Size(3), Size(4)));
+  EXPECT_EQ("d", inner.ToString());
+  EXPECT_TRUE(text.Slice(TextRange(Size(3), Size(3))).IsEmpty());
+  EXPECT_EQ("", text.Slice(TextRange(Size(3), Size(3))).ToString());
+
+  EXPECT_THROW((void)middle.Slice(TextRange(Size(0), Size(6))),
+               std::invalid_argument);
+  const SyntaxNode ab = *SyntaxNode::CreateRoot(SplitTextTree()).FirstChild();
+  EXPECT_THROW(SyntaxText(ab, TextRange(Size(0), Size(3))),
+               std::invalid_argument);
+}
+
+TEST(SyntaxTextTest, EqualsString) {
+  const SyntaxText text = SyntaxNode::CreateRoot(SplitTextTree()).Text();
+
+  EXPECT_TRUE(text == "abcédéf");
+  EXPECT_FALSE(text == "abcédé");
+  EXPECT_FALSE(text == "abcédéfg");
+  EXPECT_FALSE(text == "abdédéf");
+}
+
+TEST(SyntaxTextTest, EqualsOtherText) {
+  const SyntaxText text = SyntaxNode::CreateRoot(SplitTextTree()).Text();
+  const SyntaxNode other = SyntaxNode::CreateRoot(GreenNode(
+      SyntaxKind::kPlus, {GreenToken(SyntaxKind::kError, U"a"),
+                          GreenToken(SyntaxKind::kError, U"bcédé"),
+                          GreenToken(SyntaxKind::kError, U"f")}));
+
+  EXPECT_TRUE(text == other.Text());
+  EXPECT_TRUE(text.Slice(TextRange(Size(2), Size(5))) ==
+              other.Text().Slice(TextRange(Size(2), Size(5))));
+  EXPECT_FALSE(text.Slice(TextRange(Size(1), Size(4))) ==
+               other.Text().Slice(TextRange(Size(2), Size(5))));
+  EXPECT_FALSE(text == other.Text().Slice(TextRange(Size(0), Size(6))));
+}
+}  // namespace
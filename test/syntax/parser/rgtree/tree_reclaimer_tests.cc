@@ -0,0 +1,61 @@
+#include "syntax/parser/rgtree/tree_reclaimer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "syntax/parser/rgtree/green/green_element.h"
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/syntax_kind.h"
+
+namespace {
+orion::syntax::GreenNode BuildDeepTree(const size_t depth) {
+  orion::syntax::GreenNode node(orion::syntax::SyntaxKind::kError, {});
+  for (size_t i = 0; i < depth; ++i) {
+    node = orion::syntax::GreenNode(orion::syntax::SyntaxKind::kError, {node});
+  }
+  return node;
+}
+
+TEST(TreeReclaimerTest, FlushReleasesDeferredTrees) {
+  orion::syntax::TreeReclaimer reclaimer;
+  const auto marker = std::make_shared<int>(0);
+  const std::weak_ptr<int> watch = marker;
+
+  reclaimer.Defer(BuildDeepTree(1000));
+  reclaimer.Defer(std::shared_ptr<int>(marker));
+  reclaimer.Flush();
+
+  EXPECT_EQ(0, reclaimer.Pending());
+  EXPECT_EQ(1, marker.use_count());
+  EXPECT_FALSE(watch.expired());
+}
+
+TEST(TreeReclaimerTest, DestructorReleasesQueuedTrees) {
+  std::weak_ptr<int> watch;
+  {
+    orion::syntax::TreeReclaimer reclaimer;
+    auto value = std::make_shared<int>(1);
+    watch = value;
+    reclaimer.Defer(std::move(value));
+  }
+
+  EXPECT_TRUE(watch.expired());
+}
+
+TEST(TreeReclaimerTest, FlushWithoutWorkReturns) {
+  orion::syntax::TreeReclaimer reclaimer;
+
+  reclaimer.Flush();
+
+  EXPECT_EQ(0, reclaimer.Pending());
+}
+
+TEST(TreeReclaimerTest, GlobalReclaimerIsShared) {
+  EXPECT_EQ(&orion::syntax::TreeReclaimer::Global(),
+            &orion::syntax::TreeReclaimer::Global());
+}
+}  // namespace
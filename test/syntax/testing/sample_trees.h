@@ -0,0 +1,57 @@
+#ifndef SYNTAX_TESTING_SAMPLE_TREES_H_
+#define SYNTAX_TESTING_SAMPLE_TREES_H_
+
+#include "syntax/parser/rgtree/green/green_node.h"
+#include "syntax/parser/rgtree/green/green_token.h"
+#include "syntax/parser/syntax_kind.h"
+
+namespace orion::syntax::test {
+
+/**
+ * @brief Builds `(Error (Minus "a" "bc") "d" (Plus))`, which nests a node
+ * with tokens beside a token and an empty node.
+ *
+ * The kinds only tell the nodes apart; the tree is not valid Orion.
+ */
+inline GreenNode NestedTree() {
+  const GreenNode minus(SyntaxKind::kMinus,
+                        {GreenToken(SyntaxKind::kError, U"a"),
+                         GreenToken(SyntaxKind::kError, U"bc")});
+  return GreenNode(SyntaxKind::kError,
+                   {minus, GreenToken(SyntaxKind::kError, U"d"),
+                    GreenNode(SyntaxKind::kPlus, {})});
+}
+
+/**
+ * @brief Builds `(Error "+" (Minus "a") "-" (Plus) (Minus "bc"))`, whose root
+ * alternates tokens and nodes, one of them empty.
+ */
+inline GreenNode FlatTree() {
+  return GreenNode(
+      SyntaxKind::kError,
+      {GreenToken(SyntaxKind::kPlus, U"+"),
+       GreenNode(SyntaxKind::kMinus, {GreenToken(SyntaxKind::kError, U"a")}),
+       GreenToken(SyntaxKind::kMinus, U"-"), GreenNode(SyntaxKind::kPlus, {}),
+       GreenNode(SyntaxKind::kMinus, {GreenToken(SyntaxKind::kError, U"bc")})});
+}
+
+/**
+ * @brief Builds `(Error (Minus "ab" "") "cé" (Plus) (Minus "d" "éf"))`, whose
+ * text `abcédéf` has multi-byte code points split across tokens and an empty
+ * token and node along the way.
+ */
+inline GreenNode SplitTextTree() {
+  const GreenNode ab(SyntaxKind::kMinus,
+                     {GreenToken(SyntaxKind::kError, U"ab"),
+                      GreenToken(SyntaxKind::kError, U"")});
+  const GreenNode def(SyntaxKind::kMinus,
+                      {GreenToken(SyntaxKind::kError, U"d"),
+                       GreenToken(SyntaxKind::kError, U"éf")});
+  return GreenNode(SyntaxKind::kError,
+                   {ab, GreenToken(SyntaxKind::kError, U"cé"),
+                    GreenNode(SyntaxKind::kPlus, {}), def});
+}
+
+}  // namespace orion::syntax::test
+
+#endif  // SYNTAX_TESTING_SAMPLE_TREES_H_
@@ -0,0 +1,31 @@
+#ifndef SYNTAX_TESTING_TEMP_FILE_H_
+#define SYNTAX_TESTING_TEMP_FILE_H_
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+namespace orion::syntax::test {
+
+/**
+ * @brief Writes a file in the test's temporary directory, replacing any
+ * earlier contents.
+ *
+ * @param name The file name, unique to the test that writes it.
+ * @param contents The bytes to write, which may include NULs.
+ * @return The path of the file.
+ */
+inline std::filesystem::path WriteFile(const std::string_view name,
+                                       const std::string_view contents) {
+  const std::filesystem::path path =
+      std::filesystem::path(::testing::TempDir()) / name;
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  stream.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  return path;
+}
+
+}  // namespace orion::syntax::test
+
+#endif  // SYNTAX_TESTING_TEMP_FILE_H_
@@ -0,0 +1,82 @@
+#include "syntax/text/offset_map.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "syntax/text/text_range.h"
+#include "syntax/text/text_size.h"
+
+namespace {
+using orion::syntax::OffsetMap;
+using orion::syntax::TextRange;
+using orion::syntax::TextSize;
+
+TextRange Range(const uint32_t start, const uint32_t end) {
+  return TextRange(TextSize(start), TextSize(end));
+}
+
+TEST(OffsetMapTest, EmptyMapIsIdentity) {
+  const OffsetMap map;
+
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(TextSize(42), map.Map(TextSize(42)));
+}
+
+TEST(OffsetMapTest, ShiftsOffsetsAfterAnEdit) {
+  OffsetMap map;
+  // "abcdef" -> "abXYZef": "cd" replaced by three characters.
+  map.Add(Range(2, 4), TextSize(3));
+
+  EXPECT_EQ(TextSize(1), map.Map(TextSize(1)));
+  EXPECT_EQ(TextSize(2), map.Map(TextSize(2)));
+  EXPECT_EQ(TextSize(3), map.Map(TextSize(3)));
+  EXPECT_EQ(TextSize(5), map.Map(TextSize(4)));
+  EXPECT_EQ(TextSize(7), map.Map(TextSize(6)));
+}
+
+TEST(OffsetMapTest, ClampsOffsetsInsideShrunkRange) {
+  OffsetMap map;
+  map.Add(Range(2, 6), TextSize(1));
+
+  EXPECT_EQ(TextSize(2), map.Map(TextSize(2)));
+  EXPECT_EQ(TextSize(3), map.Map(TextSize(3)));
+  EXPECT_EQ(TextSize(3), map.Map(TextSize(5)));
+  EXPECT_EQ(TextSize(3), map.Map(TextSize(6)));
+}
+
+TEST(OffsetMapTest, InsertionPointMovesPastInsertedText) {
+  OffsetMap map;
+  map.Add(Range(3, 3), TextSize(2));
+
+  EXPECT_EQ(TextSize(2), map.Map(TextSize(2)));
+  EXPECT_EQ(TextSize(5), map.Map(TextSize(3)));
+}
+
+TEST(OffsetMapTest, CombinesSeveralEdits) {
+  OffsetMap map;
+  map.Add(Range(1, 3), TextSize(0));  // Deletes two characters.
+  map.Add(Range(3, 3), TextSize(4));  // Inserts four.
+  map.Add(Range(5, 8), TextSize(1));  // Shrinks three to one.
+
+  EXPECT_EQ(TextSize(0), map.Map(TextSize(0)));
+  EXPECT_EQ(TextSize(1), map.Map(TextSize(2)));
+  EXPECT_EQ(TextSize(5), map.Map(TextSize(3)));
+  EXPECT_EQ(TextSize(7), map.Map(TextSize(5)));
+  EXPECT_EQ(TextSize(8), map.Map(TextSize(6)));
+  EXPECT_EQ(TextSize(8), map.Map(TextSize(8)));
+  EXPECT_EQ(TextSize(12), map.Map(TextSize(12)));
+  EXPECT_EQ(Range(5, 8), map.Map(Range(3, 6)));
+  EXPECT_EQ(3, map.Edits().size());
+}
+
+TEST(OffsetMapTest, RejectsEditsOutOfOrder) {
+  OffsetMap map;
+  map.Add(Range(4, 6), TextSize(1));
+
+  EXPECT_THROW(map.Add(Range(5, 7), TextSize(1)), std::invalid_argument);
+  EXPECT_THROW(map.Add(Range(0, 1), TextSize(1)), std::invalid_argument);
+  EXPECT_NO_THROW(map.Add(Range(6, 6), TextSize(1)));
+}
+}  // namespace
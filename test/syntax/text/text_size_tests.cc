@@ -0,0 +1,108 @@
+#include "syntax/text/text_size.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "syntax/lexer/token.h"
+#include "syntax/text/text_range.h"
+
+namespace {
+constexpr uint32_t kMax = std::numeric_limits<uint32_t>::max();
+
+TEST(TextSizeTest, IsFourBytes) {
+  EXPECT_EQ(4, sizeof(orion::syntax::TextSize));
+  EXPECT_EQ(8, sizeof(orion::syntax::TextRange));
+}
+
+TEST(TextSizeTest, TokenIsSixteenBytes) {
+  // Kind, span, and symbol.
+  EXPECT_EQ(16, sizeof(orion::syntax::Token));
+}
+
+TEST(TextSizeTest, Of) {
+  EXPECT_EQ(orion::syntax::TextSize(7), orion::syntax::TextSize::Of(7));
+  EXPECT_EQ(orion::syntax::TextSize(kMax), orion::syntax::TextSize::Of(kMax));
+}
+
+TEST(TextSizeTest, WideIntegersDoNotConvertImplicitly) {
+  EXPECT_FALSE((std::is_convertible_v<size_t, orion::syntax::TextSize>));
+  EXPECT_FALSE((std::is_convertible_v<uint32_t, orion::syntax::TextSize>));
+}
+
+TEST(TextSizeTest, OfThrowsWhenTooLarge) {
+  EXPECT_THROW(
+      { (void)orion::syntax::TextSize::Of(size_t{kMax} + 1); },
+      std::overflow_error);
+}
+
+TEST(TextSizeTest, Arithmetic) {
+  const orion::syntax::TextSize a(5);
+  const orion::syntax::TextSize b(3);
+
+  EXPECT_EQ(orion::syntax::TextSize(8), a + b);
+  EXPECT_EQ(orion::syntax::TextSize(2), a - b);
+  EXPECT_LT(b, a);
+}
+
+TEST(TextSizeTest, AdditionThrowsOnOverflow) {
+  const orion::syntax::TextSize max(kMax);
+  EXPECT_THROW({ (void)(max + orion::syntax::TextSize(1)); },
+               std::overflow_error);
+}
+
+TEST(TextSizeTest, SubtractionThrowsOnUnderflow) {
+  EXPECT_THROW(
+      { (void)(orion::syntax::TextSize(1) - orion::syntax::TextSize(2)); },
+      std::overflow_error);
+}
+
+TEST(TextRangeTest, Len) {
+  const orion::syntax::TextRange range(orion::syntax::TextSize(2),
+                                       orion::syntax::TextSize(6));
+
+  EXPECT_EQ(orion::syntax::TextSize(4), range.Len());
+  EXPECT_FALSE(range.IsEmpty());
+  EXPECT_TRUE(orion::syntax::TextRange::Empty(orion::syntax::TextSize(3))
+                  .IsEmpty());
+}
+
+TEST(TextRangeTest, ConstructorThrowsWhenReversed) {
+  EXPECT_THROW(
+      {
+        (void)orion::syntax::TextRange(orion::syntax::TextSize(2),
+                                       orion::syntax::TextSize(1));
+      },
+      std::invalid_argument);
+}
+
+TEST(TextRangeTest, Contains) {
+  const orion::syntax::TextRange range(orion::syntax::TextSize(2),
+                                       orion::syntax::TextSize(4));
+
+  EXPECT_FALSE(range.Contains(orion::syntax::TextSize(1)));
+  EXPECT_TRUE(range.Contains(orion::syntax::TextSize(2)));
+  EXPECT_FALSE(range.Contains(orion::syntax::TextSize(4)));
+  EXPECT_TRUE(range.ContainsInclusive(orion::syntax::TextSize(4)));
+  EXPECT_TRUE(range.ContainsRange(orion::syntax::TextRange::At(
+      orion::syntax::TextSize(3), orion::syntax::TextSize(1))));
+}
+
+TEST(TextRangeTest, CoverAndShift) {
+  const orion::syntax::TextRange a(orion::syntax::TextSize(1),
+                                   orion::syntax::TextSize(3));
+  const orion::syntax::TextRange b(orion::syntax::TextSize(5),
+                                   orion::syntax::TextSize(6));
+
+  EXPECT_EQ(orion::syntax::TextRange(orion::syntax::TextSize(1),
+                                     orion::syntax::TextSize(6)),
+            a.Cover(b));
+  EXPECT_EQ(orion::syntax::TextRange(orion::syntax::TextSize(3),
+                                     orion::syntax::TextSize(5)),
+            a.Shift(orion::syntax::TextSize(2)));
+}
+}  // namespace
@@ -0,0 +1,144 @@
+#include "syntax/util/flat_hash_table.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Every key deliberately shares the same hash to exercise collision handling.
+constexpr uint64_t kCollidingHash = 42;
+
+TEST(FlatHashTableTest, FindOnEmptyTable) {
+  const orion::syntax::FlatHashTable<std::string> table;
+
+  EXPECT_EQ(nullptr, table.Find(kCollidingHash, [](const std::string&) {
+    return true;
+  }));
+  EXPECT_EQ(0, table.Size());
+}
+
+TEST(FlatHashTableTest, FindOrInsertDeduplicates) {
+  orion::syntax::FlatHashTable<std::string> table;
+  const std::string key = "hello";
+  const auto matches = [&](const std::string& value) { return value == key; };
+
+  const auto [first, inserted1] =
+      table.FindOrInsert(kCollidingHash, matches, [&] { return key; });
+  const auto [second, inserted2] =
+      table.FindOrInsert(kCollidingHash, matches, [&] { return key; });
+
+  EXPECT_TRUE(inserted1);
+  EXPECT_FALSE(inserted2);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(1, table.Size());
+}
+
+TEST(FlatHashTableTest, ThrowingFactoryInsertsNothing) {
+  orion::syntax::FlatHashTable<std::string> table;
+  const std::string key = "hello";
+  const auto matches = [&](const std::string& value) { return value == key; };
+
+  EXPECT_THROW(table.FindOrInsert(kCollidingHash, matches,
+                                  []() -> std::string {
+                                    throw std::length_error("full");
+                                  }),
+               std::length_error);
+  EXPECT_EQ(0, table.Size());
+  EXPECT_EQ(nullptr, table.Find(kCollidingHash, matches));
+
+  const auto [value, inserted] =
+      table.FindOrInsert(kCollidingHash, matches, [&] { return key; });
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(key, *value);
+}
+
+TEST(FlatHashTableTest, CollidingKeysStayDistinct) {
+  orion::syntax::FlatHashTable<std::string> table;
+
+  for (int i = 0; i < 100; ++i) {
+    const std::string key = std::to_string(i);
+    table.FindOrInsert(
+        kCollidingHash, [&](const std::string& value) { return value == key; },
+        [&] { return key; });
+  }
+
+  EXPECT_EQ(100, table.Size());
+  for (int i = 0; i < 100; ++i) {
+    const std::string key = std::to_string(i);
+    const std::string* found = table.Find(
+        kCollidingHash, [&](const std::string& value) { return value == key; });
+    ASSERT_NE(nullptr, found);
+    EXPECT_EQ(key, *found);
+  }
+}
+
+TEST(FlatHashTableTest, HitsAtTheGrowthLimitDoNotGrow) {
+  orion::syntax::FlatHashTable<uint64_t> table;
+  const auto insert = [&](const uint64_t key) {
+    return table.FindOrInsert(
+        key * 0x9e3779b97f4a7c15ULL,
+        [&](const uint64_t value) { return value == key; },
+        [&] { return key; });
+  };
+
+  // The first 16 slots take 14 values before the table has to grow.
+  const uint64_t* first = insert(0).first;
+  for (uint64_t i = 1; i < 14; ++i) {
+    insert(i);
+  }
+  ASSERT_EQ(16, table.Capacity());
+
+  const auto [found, inserted] = insert(0);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(first, found);
+  EXPECT_EQ(16, table.Capacity());
+
+  EXPECT_TRUE(insert(14).second);
+  EXPECT_EQ(32, table.Capacity());
+  EXPECT_EQ(15, table.Size());
+}
+
+TEST(FlatHashTableTest, MissThatGrowsComparesEachValueOnce) {
+  orion::syntax::FlatHashTable<uint64_t> table;
+  size_t comparisons = 0;
+  const auto insert = [&](const uint64_t key) {
+    return table.FindOrInsert(
+        kCollidingHash,
+        [&](const uint64_t value) {
+          ++comparisons;
+          return value == key;
+        },
+        [&] { return key; });
+  };
+
+  for (uint64_t i = 0; i < 14; ++i) {
+    insert(i);
+  }
+  ASSERT_EQ(16, table.Capacity());
+
+  comparisons = 0;
+  EXPECT_TRUE(insert(14).second);
+  EXPECT_EQ(32, table.Capacity());
+  EXPECT_EQ(14, comparisons);
+}
+
+TEST(FlatHashTableTest, GrowsPastInitialCapacity) {
+  orion::syntax::FlatHashTable<uint64_t> table;
+
+  for (uint64_t i = 0; i < 10000; ++i) {
+    const uint64_t hash = i * 0x9e3779b97f4a7c15ULL;
+    table.FindOrInsert(
+        hash, [&](const uint64_t value) { return value == i; },
+        [&] { return i; });
+  }
+
+  EXPECT_EQ(10000, table.Size());
+  EXPECT_GE(table.Capacity(), table.Size());
+
+  size_t visited = 0;
+  table.ForEach([&](const uint64_t) { ++visited; });
+  EXPECT_EQ(10000, visited);
+}
+}  // namespace
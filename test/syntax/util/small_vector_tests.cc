@@ -0,0 +1,80 @@
+#include "syntax/util/small_vector.h"
+
+#include <gtest/gtest.h>
+
+#include <utility>
+
+namespace {
+TEST(SmallVectorTest, StaysInlineWithinCapacity) {
+  orion::syntax::SmallVector<int, 4> vector;
+
+  for (int i = 0; i < 4; ++i) {
+    vector.PushBack(i);
+  }
+
+  EXPECT_TRUE(vector.IsInline());
+  EXPECT_EQ(4, vector.Size());
+  EXPECT_EQ(3, vector.Back());
+}
+
+TEST(SmallVectorTest, SpillsToHeapAndKeepsElements) {
+  orion::syntax::SmallVector<int, 4> vector;
+
+  for (int i = 0; i < 100; ++i) {
+    vector.PushBack(i);
+  }
+
+  EXPECT_FALSE(vector.IsInline());
+  ASSERT_EQ(100, vector.Size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, vector[i]);
+  }
+}
+
+TEST(SmallVectorTest, ClearKeepsCapacity) {
+  orion::syntax::SmallVector<int, 4> vector;
+  for (int i = 0; i < 100; ++i) {
+    vector.PushBack(i);
+  }
+  const size_t capacity = vector.Capacity();
+
+  vector.Clear();
+
+  EXPECT_TRUE(vector.Empty());
+  EXPECT_EQ(capacity, vector.Capacity());
+}
+
+TEST(SmallVectorTest, PushBackOwnElementWhileGrowing) {
+  orion::syntax::SmallVector<int, 1> vector;
+  vector.PushBack(7);
+
+  vector.PushBack(vector.Back());
+
+  EXPECT_EQ(7, vector[1]);
+}
+
+TEST(SmallVectorTest, MoveStealsHeapBuffer) {
+  orion::syntax::SmallVector<int, 2> source;
+  for (int i = 0; i < 10; ++i) {
+    source.PushBack(i);
+  }
+  const int* data = source.begin();
+
+  const orion::syntax::SmallVector<int, 2> target = std::move(source);
+
+  EXPECT_EQ(data, target.begin());
+  EXPECT_EQ(10, target.Size());
+  EXPECT_TRUE(source.IsInline());
+}
+
+TEST(SmallVectorTest, CopyIsIndependent) {
+  orion::syntax::SmallVector<int, 2> source;
+  source.PushBack(1);
+
+  orion::syntax::SmallVector<int, 2> copy = source;
+  copy.PushBack(2);
+
+  EXPECT_EQ(1, source.Size());
+  EXPECT_EQ(2, copy.Size());
+}
+}  // namespace
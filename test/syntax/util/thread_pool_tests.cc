@@ -0,0 +1,131 @@
+#include "syntax/util/thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+TEST(ThreadPoolTest, RunsEverySubmittedTask) {
+  orion::syntax::ThreadPool pool(4);
+  std::atomic<size_t> count = 0;
+
+  for (size_t i = 0; i < 1000; ++i) {
+    pool.Submit([&count] { ++count; });
+  }
+  pool.Wait();
+
+  EXPECT_EQ(1000, count);
+}
+
+TEST(ThreadPoolTest, HasAtLeastOneWorker) {
+  const orion::syntax::ThreadPool pool(0);
+
+  EXPECT_EQ(1, pool.Size());
+  EXPECT_GE(orion::syntax::ThreadPool::DefaultThreadCount(), 1);
+}
+
+TEST(ThreadPoolTest, WaitsForNestedTasks) {
+  orion::syntax::ThreadPool pool(2);
+  std::atomic<size_t> count = 0;
+
+  for (size_t i = 0; i < 10; ++i) {
+    pool.Submit([&pool, &count] {
+      for (size_t j = 0; j < 10; ++j) {
+        pool.Submit([&count] { ++count; });
+      }
+    });
+  }
+  pool.Wait();
+
+  EXPECT_EQ(100, count);
+}
+
+TEST(ThreadPoolTest, IdleWorkersRunNestedTasks) {
+  orion::syntax::ThreadPool pool(4);
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  std::atomic<size_t> remaining = 64;
+  std::thread::id parent;
+
+  // The parent keeps its worker busy until its children are done, so they
+  // can only run on the other workers.
+  pool.Submit([&] {
+    parent = std::this_thread::get_id();
+    for (size_t i = 0; i < 64; ++i) {
+      pool.Submit([&] {
+        {
+          const std::lock_guard lock(mutex);
+          threads.insert(std::this_thread::get_id());
+        }
+        --remaining;
+      });
+    }
+
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (remaining > 0 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+  });
+  pool.Wait();
+
+  EXPECT_EQ(0, remaining);
+  EXPECT_FALSE(threads.contains(parent));
+}
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+  orion::syntax::ThreadPool pool(4);
+  std::vector<std::atomic<size_t>> visits(1000);
+  std::atomic<bool> slots_in_range = true;
+
+  orion::syntax::ParallelFor(
+      pool, visits.size(), [&](const size_t slot, const size_t index) {
+        if (slot >= pool.Size()) {
+          slots_in_range = false;
+        }
+        ++visits[index];
+      });
+
+  EXPECT_TRUE(slots_in_range);
+  for (const std::atomic<size_t>& count : visits) {
+    EXPECT_EQ(1, count);
+  }
+}
+
+TEST(ThreadPoolTest, WaitRethrowsTaskException) {
+  orion::syntax::ThreadPool pool(2);
+  std::atomic<size_t> count = 0;
+
+  pool.Submit([] { throw std::runtime_error("task failed"); });
+  for (size_t i = 0; i < 10; ++i) {
+    pool.Submit([&count] { ++count; });
+  }
+
+  EXPECT_THROW(pool.Wait(), std::runtime_error);
+  EXPECT_EQ(10, count);
+
+  // The error is reported once.
+  pool.Submit([&count] { ++count; });
+  EXPECT_NO_THROW(pool.Wait());
+  EXPECT_EQ(11, count);
+}
+
+TEST(ThreadPoolTest, DestructorFinishesQueuedTasks) {
+  std::atomic<size_t> count = 0;
+  {
+    orion::syntax::ThreadPool pool(2);
+    for (size_t i = 0; i < 100; ++i) {
+      pool.Submit([&count] { ++count; });
+    }
+  }
+
+  EXPECT_EQ(100, count);
+}
+}  // namespace
@@ -0,0 +1,121 @@
+#include "syntax/util/utf8.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+namespace {
+TEST(Utf8Test, EncodeAscii) {
+  EXPECT_EQ("hello", orion::syntax::EncodeUtf8(U"hello"));
+}
+
+TEST(Utf8Test, EncodeMultibyte) {
+  EXPECT_EQ("\xC3\xA9\xE4\xBC\x82\xF0\x9F\x8D\x95",
+            orion::syntax::EncodeUtf8(U"é伂🍕"));
+}
+
+TEST(Utf8Test, EncodeSurrogateAsReplacement) {
+  const std::u32string surrogate(1, char32_t{0xD800});
+  EXPECT_EQ("\xEF\xBF\xBD", orion::syntax::EncodeUtf8(surrogate));
+}
+
+TEST(Utf8Test, DecodeRoundTrip) {
+  const std::u32string source = U"_AA伂告🍕 \"x\"";
+  EXPECT_EQ(source,
+            orion::syntax::DecodeUtf8(orion::syntax::EncodeUtf8(source)));
+}
+
+TEST(Utf8Test, DecodeMalformedAsReplacement) {
+  EXPECT_EQ(U"a�b", orion::syntax::DecodeUtf8("a\xFF" "b"));
+  EXPECT_EQ(U"a�", orion::syntax::DecodeUtf8("a\xE4\xBC"));
+}
+
+TEST(Utf8Test, DecodeRejectsOverlongForms) {
+  // 0xC0 0xAB would be an overlong `+`; neither byte starts a valid
+  // sequence.
+  EXPECT_EQ(U"1 \uFFFD\uFFFD 2", orion::syntax::DecodeUtf8("1 \xC0\xAB 2"));
+  EXPECT_EQ(U"\uFFFD\uFFFD\uFFFD",
+            orion::syntax::DecodeUtf8("\xE0\x80\xAF"));
+}
+
+TEST(Utf8Test, DecodeRejectsSurrogates) {
+  EXPECT_EQ(U"a\uFFFD\uFFFD\uFFFDb",
+            orion::syntax::DecodeUtf8("a\xED\xA0\x80" "b"));
+}
+
+TEST(Utf8Test, DecodeRejectsValuesBeyondTheLastCodePoint) {
+  EXPECT_EQ(U"\uFFFD\uFFFD\uFFFD\uFFFD",
+            orion::syntax::DecodeUtf8("\xF4\x90\x80\x80"));
+  EXPECT_EQ(U"\uFFFD\uFFFD\uFFFD\uFFFD",
+            orion::syntax::DecodeUtf8("\xF7\xBF\xBF\xBF"));
+}
+
+TEST(Utf8Test, DecodeReplacesEachMaximalIllFormedSubpart) {
+  // A truncated sequence is one subpart, up to the byte that breaks it.
+  EXPECT_EQ(U"\uFFFDa", orion::syntax::DecodeUtf8("\xF0\x9F\x8D" "a"));
+  EXPECT_EQ(U"\uFFFD\uFFFD", orion::syntax::DecodeUtf8("\xE4\xBC\xE4"));
+  EXPECT_EQ(U"\U0010FFFF", orion::syntax::DecodeUtf8("\xF4\x8F\xBF\xBF"));
+}
+
+TEST(Utf8Test, CountCodepoints) {
+  EXPECT_EQ(0, orion::syntax::CountCodepoints(""));
+  EXPECT_EQ(3, orion::syntax::CountCodepoints(
+                   "\xC3\xA9\xE4\xBC\x82\xF0\x9F\x8D\x95"));
+}
+
+TEST(Utf8Test, DecodeLongAsciiRuns) {
+  const std::string ascii(100, 'x');
+  EXPECT_EQ(std::u32string(100, U'x'), orion::syntax::DecodeUtf8(ascii));
+  EXPECT_EQ(std::u32string(40, U'x') + U"é" + std::u32string(30, U'x'),
+            orion::syntax::DecodeUtf8(ascii.substr(0, 40) + "\xC3\xA9" +
+                                      ascii.substr(0, 30)));
+}
+
+TEST(Utf8Test, ValidateAcceptsWellFormedText) {
+  EXPECT_EQ(0, orion::syntax::ValidateUtf8(""));
+  const std::string text = std::string(37, 'a') +
+                           "\xC3\xA9\xE4\xBC\x82\xF0\x9F\x8D\x95" +
+                           "\xF4\x8F\xBF\xBF" + std::string(21, 'b');
+  EXPECT_EQ(text.size(), orion::syntax::ValidateUtf8(text));
+}
+
+TEST(Utf8Test, ValidateFindsMalformedSequences) {
+  // Overlong encodings.
+  EXPECT_EQ(1, orion::syntax::ValidateUtf8("a\xC0\xAF"));
+  EXPECT_EQ(1, orion::syntax::ValidateUtf8("a\xE0\x80\xAF"));
+  EXPECT_EQ(1, orion::syntax::ValidateUtf8("a\xF0\x80\x80\xAF"));
+  // A surrogate.
+  EXPECT_EQ(1, orion::syntax::ValidateUtf8("a\xED\xA0\x80"));
+  // Above U+10FFFF.
+  EXPECT_EQ(1, orion::syntax::ValidateUtf8("a\xF4\x90\x80\x80"));
+  // Truncated, and a stray continuation byte.
+  EXPECT_EQ(1, orion::syntax::ValidateUtf8("a\xE4\xBC"));
+  EXPECT_EQ(1, orion::syntax::ValidateUtf8("a\x80"));
+}
+
+TEST(Utf8Test, ValidateFindsErrorsAfterLongAsciiRuns) {
+  for (size_t prefix = 0; prefix < 40; ++prefix) {
+    const std::string text = std::string(prefix, 'x') + "\xFF" +
+                             std::string(20, 'y');
+    EXPECT_EQ(prefix, orion::syntax::ValidateUtf8(text));
+  }
+}
+
+TEST(Utf8Test, DecodeAt) {
+  const std::string_view text = "a\xC3\xA9\xF0\x9F\x8D\x95";
+  EXPECT_EQ(U'a', orion::syntax::DecodeUtf8At(text, 0));
+  EXPECT_EQ(U'\u00E9', orion::syntax::DecodeUtf8At(text, 1));
+  EXPECT_EQ(U'\U0001F355', orion::syntax::DecodeUtf8At(text, 3));
+  EXPECT_EQ(U'\uFFFD', orion::syntax::DecodeUtf8At(text, 2));
+}
+
+TEST(Utf8Test, Utf8Offset) {
+  const std::string_view text = "a\xC3\xA9\xF0\x9F\x8D\x95";
+  EXPECT_EQ(0, orion::syntax::Utf8Offset(text, 0));
+  EXPECT_EQ(1, orion::syntax::Utf8Offset(text, 1));
+  EXPECT_EQ(3, orion::syntax::Utf8Offset(text, 2));
+  EXPECT_EQ(7, orion::syntax::Utf8Offset(text, 3));
+  EXPECT_EQ(7, orion::syntax::Utf8Offset(text, 10));
+}
+}  // namespace